@@ -0,0 +1,690 @@
+#include "texture_uploader.h"
+#include "../utils/debug_utils.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace ump {
+
+size_t UploadFormat::BytesPerPixel() const {
+    size_t components = 4;
+    switch (format) {
+        case GL_RED:  components = 1; break;
+        case GL_RG:   components = 2; break;
+        case GL_RGB:  components = 3; break;
+        default:      components = 4; break;
+    }
+
+    switch (type) {
+        case GL_UNSIGNED_BYTE:  return components;
+        case GL_UNSIGNED_SHORT:
+        case GL_HALF_FLOAT:     return components * 2;
+        case GL_FLOAT:          return components * 4;
+        case GL_UNSIGNED_INT_2_10_10_10_REV: return 4;  // Packed RGBA in one word
+        default:                return 0;
+    }
+}
+
+GLenum StorageInternalFormat(GLenum format, GLenum type) {
+    static const GLenum kUnorm8[4] = { GL_R8, GL_RG8, GL_RGB8, GL_RGBA8 };
+    static const GLenum kUnorm16[4] = { GL_R16, GL_RG16, GL_RGB16, GL_RGBA16 };
+    static const GLenum kHalf[4] = { GL_R16F, GL_RG16F, GL_RGB16F, GL_RGBA16F };
+
+    int index = 3;
+    switch (format) {
+        case GL_RED: index = 0; break;
+        case GL_RG:  index = 1; break;
+        case GL_RGB: index = 2; break;
+        default:     break;
+    }
+
+    switch (type) {
+        case GL_UNSIGNED_INT_2_10_10_10_REV: return GL_RGB10_A2;
+        case GL_UNSIGNED_BYTE:  return kUnorm8[index];
+        case GL_UNSIGNED_SHORT: return kUnorm16[index];
+        default:                return kHalf[index];  // Half and float sources
+    }
+}
+
+TextureUploader& TextureUploader::Shared() {
+    static TextureUploader uploader;
+    return uploader;
+}
+
+//=============================================================================
+// Staging (any thread)
+//=============================================================================
+
+std::shared_ptr<StagedUpload> TextureUploader::Reserve(const UploadFormat& format) {
+    if (!format.IsValid()) {
+        return nullptr;
+    }
+
+    const size_t size = AlignUp(format.ByteSize(), kRegionAlignment);
+
+    std::lock_guard<std::mutex> lock(ringMutex_);
+    if (!ringBase_ || size > ringBytes_) {
+        return nullptr;
+    }
+
+    // Regions abandoned before upload can be reclaimed without GL
+    ReclaimLocked(false);
+
+    // Live regions are contiguous (circularly) from the oldest to the newest
+    size_t offset = 0;
+    bool found = false;
+    if (liveRegions_.empty()) {
+        ringHead_ = 0;
+        found = true;
+    } else {
+        const size_t tail = liveRegions_.front()->offset_;
+        const bool wrapped = liveRegions_.back()->offset_ < tail;
+        if (!wrapped) {
+            if (ringHead_ + size <= ringBytes_) {
+                offset = ringHead_;
+                found = true;
+            } else if (size <= tail) {
+                offset = 0;
+                found = true;
+            }
+        } else if (ringHead_ + size <= tail) {
+            offset = ringHead_;
+            found = true;
+        }
+    }
+
+    if (!found) {
+        stageFailures_++;
+        return nullptr;
+    }
+
+    auto staged = std::make_shared<StagedUpload>();
+    staged->format_ = format;
+    staged->data_ = ringBase_ + offset;
+    staged->offset_ = offset;
+    staged->size_ = size;
+    ringHead_ = offset + size;
+    liveRegions_.push_back(staged);
+    return staged;
+}
+
+std::shared_ptr<StagedUpload> TextureUploader::Stage(const UploadFormat& format, const void* pixels) {
+    if (!pixels) {
+        return nullptr;
+    }
+
+    auto staged = Reserve(format);
+    if (staged) {
+        // Coherent mapping: visible to the GPU once Upload() is issued after this
+        std::memcpy(staged->Data(), pixels, format.ByteSize());
+    }
+    return staged;
+}
+
+void TextureUploader::ReleaseTexture(GLuint texture) {
+    if (texture == 0) return;
+    std::lock_guard<std::mutex> lock(ringMutex_);
+    releasedTextures_.push_back(texture);
+}
+
+void TextureUploader::SetFrameBudgetMs(double ms) {
+    std::lock_guard<std::mutex> lock(ringMutex_);
+    budgetMs_ = std::max(0.0, ms);
+}
+
+double TextureUploader::GetFrameBudgetMs() const {
+    std::lock_guard<std::mutex> lock(ringMutex_);
+    return budgetMs_;
+}
+
+void TextureUploader::SetRingBytes(size_t bytes) {
+    std::lock_guard<std::mutex> lock(ringMutex_);
+    requestedRingBytes_ = bytes;
+}
+
+TextureUploader::Stats TextureUploader::GetStats() const {
+    std::lock_guard<std::mutex> lock(ringMutex_);
+    Stats stats;
+    stats.ring_bytes = ringBytes_;
+    for (const auto& region : liveRegions_) {
+        stats.ring_used_bytes += region->size_;
+    }
+    stats.budget_ms = budgetMs_;
+    stats.last_frame_ms = lastFrameMs_;
+    stats.staged_uploads = stagedUploads_;
+    stats.direct_uploads = directUploads_;
+    stats.stage_failures = stageFailures_;
+    stats.textures_created = texturesCreated_;
+    stats.textures_recycled = texturesRecycled_;
+    stats.idle_textures = idleTextureCount_;
+    return stats;
+}
+
+void TextureUploader::ReclaimLocked(bool wait) {
+    // Regions are freed in allocation order so the ring stays contiguous
+    while (!liveRegions_.empty()) {
+        auto& front = liveRegions_.front();
+        if (front->submitted_) {
+            if (!wait) break;  // Fences can only be polled on the GL thread
+            GLenum status = glClientWaitSync(front->fence_, 0, 0);
+            if (status != GL_ALREADY_SIGNALED && status != GL_CONDITION_SATISFIED) {
+                break;
+            }
+            glDeleteSync(front->fence_);
+            front->fence_ = nullptr;
+        } else if (front.use_count() > 1) {
+            break;  // Still being filled or waiting for Upload()
+        }
+        liveRegions_.pop_front();
+    }
+}
+
+//=============================================================================
+// Uploads (main thread)
+//=============================================================================
+
+void TextureUploader::CreateRing() {
+    ringInitAttempted_ = true;
+    hasTexStorage_ = GLAD_GL_VERSION_4_2 || GLAD_GL_ARB_texture_storage;
+    hasClearTexture_ = GLAD_GL_VERSION_4_4 || GLAD_GL_ARB_clear_texture;
+
+    if (!(GLAD_GL_VERSION_4_4 || GLAD_GL_ARB_buffer_storage)) {
+        Debug::Log("TextureUploader: Persistent buffers unavailable - using direct uploads");
+        return;
+    }
+
+    size_t bytes;
+    {
+        std::lock_guard<std::mutex> lock(ringMutex_);
+        bytes = requestedRingBytes_;
+    }
+    if (bytes == 0) return;
+
+    const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+    GLuint pbo = 0;
+    glGenBuffers(1, &pbo);
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, pbo);
+    glBufferStorage(GL_PIXEL_UNPACK_BUFFER, static_cast<GLsizeiptr>(bytes), nullptr, flags);
+    void* mapped = glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, static_cast<GLsizeiptr>(bytes), flags);
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+
+    if (!mapped) {
+        Debug::Log("TextureUploader: Failed to map " + std::to_string(bytes >> 20) +
+                   "MB upload ring (GL error " + std::to_string(glGetError()) + ") - using direct uploads");
+        glDeleteBuffers(1, &pbo);
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(ringMutex_);
+    pbo_ = pbo;
+    ringBase_ = static_cast<uint8_t*>(mapped);
+    ringBytes_ = bytes;
+    ringHead_ = 0;
+
+    Debug::Log("TextureUploader: Created " + std::to_string(bytes >> 20) + "MB persistent upload ring");
+}
+
+void TextureUploader::BeginFrame() {
+    if (!ringInitAttempted_) {
+        CreateRing();
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(ringMutex_);
+        lastFrameMs_ = frameSpentMs_;
+        frameSpentMs_ = 0.0;
+        ReclaimLocked(true);
+    }
+
+    RecycleReleased();
+}
+
+bool TextureUploader::HasFrameBudget() const {
+    std::lock_guard<std::mutex> lock(ringMutex_);
+    return frameSpentMs_ < budgetMs_;
+}
+
+void TextureUploader::AddUploadTime(std::chrono::steady_clock::time_point start) {
+    const double ms = std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - start).count();
+    std::lock_guard<std::mutex> lock(ringMutex_);
+    frameSpentMs_ += ms;
+}
+
+GLuint TextureUploader::AcquireTexture(const UploadFormat& format) {
+    const TextureKey key{format.TextureWidth(), format.TextureHeight(), format.internal_format};
+
+    auto it = idleTextures_.find(key);
+    if (it != idleTextures_.end() && !it->second.empty()) {
+        GLuint texture = it->second.back();
+        it->second.pop_back();
+        idleTextureCount_--;
+        std::lock_guard<std::mutex> lock(ringMutex_);
+        texturesRecycled_++;
+        return texture;
+    }
+
+    GLuint texture = 0;
+    glGenTextures(1, &texture);
+    if (texture == 0) {
+        return 0;
+    }
+
+    glBindTexture(GL_TEXTURE_2D, texture);
+    if (hasTexStorage_) {
+        glTexStorage2D(GL_TEXTURE_2D, 1, format.internal_format, format.TextureWidth(), format.TextureHeight());
+    } else {
+        glTexImage2D(GL_TEXTURE_2D, 0, format.internal_format, format.TextureWidth(), format.TextureHeight(), 0,
+                     format.format, format.type, nullptr);
+    }
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+
+    // Compact storage samples like RGBA: one channel shows as gray, and packed
+    // 10-bit video's 2 padding bits aren't alpha (RGB/RG formats read alpha 1)
+    switch (format.internal_format) {
+        case GL_R8:
+        case GL_R16:
+        case GL_R16F: {
+            const GLint swizzle[4] = { GL_RED, GL_RED, GL_RED, GL_ONE };
+            glTexParameteriv(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_RGBA, swizzle);
+            break;
+        }
+        case GL_RGB10_A2:
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_A, GL_ONE);
+            break;
+        default:
+            break;
+    }
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    textureKeys_[texture] = key;
+    std::lock_guard<std::mutex> lock(ringMutex_);
+    texturesCreated_++;
+    return texture;
+}
+
+void TextureUploader::ClearTexture(GLuint texture, const UploadFormat& format) {
+    // Recycled textures hold the previous frame - clear what the region won't cover
+    const float color[4] = { 0.0f, 0.0f, 0.0f, format.pad_alpha };
+    if (hasClearTexture_) {
+        glClearTexImage(texture, 0, GL_RGBA, GL_FLOAT, color);
+        return;
+    }
+
+    if (clearFbo_ == 0) {
+        glGenFramebuffers(1, &clearFbo_);
+    }
+    GLint previousFbo = 0;
+    glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &previousFbo);
+    const GLboolean scissor = glIsEnabled(GL_SCISSOR_TEST);
+
+    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, clearFbo_);
+    glFramebufferTexture2D(GL_DRAW_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, texture, 0);
+    const bool renderable = glCheckFramebufferStatus(GL_DRAW_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE;
+    if (renderable) {
+        glDisable(GL_SCISSOR_TEST);
+        glClearBufferfv(GL_COLOR, 0, color);
+    }
+    glFramebufferTexture2D(GL_DRAW_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, 0, 0);
+
+    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, static_cast<GLuint>(previousFbo));
+    if (scissor) {
+        glEnable(GL_SCISSOR_TEST);
+    }
+
+    // Formats that can't be render targets (RGB16F on some drivers) have no
+    // stored alpha - upload zeros instead
+    if (!renderable) {
+        UploadFormat zeros = format;
+        zeros.width = format.TextureWidth();
+        zeros.height = format.TextureHeight();
+        std::vector<uint8_t> black(zeros.ByteSize(), 0);
+        glBindTexture(GL_TEXTURE_2D, texture);
+        SetUnpackAlignment(zeros);
+        glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, zeros.width, zeros.height, zeros.format, zeros.type, black.data());
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+        glBindTexture(GL_TEXTURE_2D, 0);
+    }
+}
+
+void TextureUploader::SetUnpackAlignment(const UploadFormat& format) {
+    // Rows are tightly packed: RGB half / single channel rows needn't be 4-byte multiples
+    const size_t rowBytes = static_cast<size_t>(format.width) * format.BytesPerPixel();
+    glPixelStorei(GL_UNPACK_ALIGNMENT, (rowBytes % 4 == 0) ? 4 : 1);
+}
+
+void TextureUploader::RecycleReleased() {
+    std::vector<GLuint> released;
+    {
+        std::lock_guard<std::mutex> lock(ringMutex_);
+        released.swap(releasedTextures_);
+    }
+
+    std::vector<GLuint> toDelete;
+    for (GLuint texture : released) {
+        auto it = textureKeys_.find(texture);
+        if (it != textureKeys_.end() && idleTextureCount_ < kMaxIdleTextures) {
+            idleTextures_[it->second].push_back(texture);
+            idleTextureCount_++;
+            continue;
+        }
+        if (it != textureKeys_.end()) {
+            textureKeys_.erase(it);
+        }
+        toDelete.push_back(texture);
+    }
+
+    if (!toDelete.empty()) {
+        glDeleteTextures(static_cast<GLsizei>(toDelete.size()), toDelete.data());
+    }
+}
+
+GLuint TextureUploader::Upload(const std::shared_ptr<StagedUpload>& staged) {
+    if (!staged) {
+        return 0;
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    const UploadFormat& format = staged->format_;
+
+    GLuint texture = AcquireTexture(format);
+    if (texture == 0) {
+        return 0;
+    }
+
+    if (format.IsPlaced()) {
+        ClearTexture(texture, format);
+    }
+
+    // Source is an offset into the bound unpack buffer - the copy runs asynchronously
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, pbo_);
+    glBindTexture(GL_TEXTURE_2D, texture);
+    SetUnpackAlignment(format);
+    glTexSubImage2D(GL_TEXTURE_2D, 0, format.x_offset, format.y_offset, format.width, format.height,
+                    format.format, format.type, reinterpret_cast<const void*>(staged->offset_));
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+    glBindTexture(GL_TEXTURE_2D, 0);
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+
+    GLsync fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    {
+        std::lock_guard<std::mutex> lock(ringMutex_);
+        staged->fence_ = fence;
+        staged->submitted_ = true;
+        stagedUploads_++;
+    }
+
+    AddUploadTime(start);
+    return texture;
+}
+
+GLuint TextureUploader::UploadNow(const UploadFormat& format, const void* pixels) {
+    if (!format.IsValid() || !pixels) {
+        return 0;
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+
+    GLuint texture = AcquireTexture(format);
+    if (texture == 0) {
+        return 0;
+    }
+
+    if (format.IsPlaced()) {
+        ClearTexture(texture, format);
+    }
+
+    glBindTexture(GL_TEXTURE_2D, texture);
+    SetUnpackAlignment(format);
+    glTexSubImage2D(GL_TEXTURE_2D, 0, format.x_offset, format.y_offset, format.width, format.height,
+                    format.format, format.type, pixels);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    {
+        std::lock_guard<std::mutex> lock(ringMutex_);
+        directUploads_++;
+    }
+
+    AddUploadTime(start);
+    return texture;
+}
+
+void TextureUploader::Shutdown() {
+    {
+        std::lock_guard<std::mutex> lock(ringMutex_);
+        for (auto& region : liveRegions_) {
+            if (region->fence_) {
+                glClientWaitSync(region->fence_, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000000);  // 1s
+                glDeleteSync(region->fence_);
+                region->fence_ = nullptr;
+            }
+            region->data_ = nullptr;
+        }
+        liveRegions_.clear();
+
+        if (pbo_ != 0) {
+            glBindBuffer(GL_PIXEL_UNPACK_BUFFER, pbo_);
+            glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+            glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+            glDeleteBuffers(1, &pbo_);
+            pbo_ = 0;
+        }
+        ringBase_ = nullptr;
+        ringBytes_ = 0;
+        ringHead_ = 0;
+    }
+
+    RecycleReleased();
+    for (auto& pair : idleTextures_) {
+        if (!pair.second.empty()) {
+            glDeleteTextures(static_cast<GLsizei>(pair.second.size()), pair.second.data());
+        }
+    }
+    idleTextures_.clear();
+    idleTextureCount_ = 0;
+    textureKeys_.clear();
+    if (clearFbo_ != 0) {
+        glDeleteFramebuffers(1, &clearFbo_);
+        clearFbo_ = 0;
+    }
+    ringInitAttempted_ = false;
+}
+
+//=============================================================================
+// Self-check (main thread)
+//=============================================================================
+
+namespace {
+    UploadFormat CheckFormat(int width, int height, GLenum format) {
+        UploadFormat result;
+        result.width = width;
+        result.height = height;
+        result.format = format;
+        result.type = GL_UNSIGNED_BYTE;
+        result.internal_format = StorageInternalFormat(format, GL_UNSIGNED_BYTE);
+        return result;
+    }
+
+    // Deterministic and different per check, so a stale texture never matches
+    std::vector<uint8_t> CheckPattern(const UploadFormat& format, uint32_t seed) {
+        std::vector<uint8_t> data(format.ByteSize());
+        for (size_t i = 0; i < data.size(); ++i) {
+            data[i] = static_cast<uint8_t>((i * 31 + seed * 97 + (i >> 8)) & 0xFF);
+        }
+        return data;
+    }
+
+    std::vector<uint8_t> ReadTexture(GLuint texture, const UploadFormat& format) {
+        UploadFormat whole = format;
+        whole.width = format.TextureWidth();
+        whole.height = format.TextureHeight();
+        std::vector<uint8_t> data(whole.ByteSize());
+        glBindTexture(GL_TEXTURE_2D, texture);
+        glPixelStorei(GL_PACK_ALIGNMENT, 1);
+        glGetTexImage(GL_TEXTURE_2D, 0, format.format, format.type, data.data());
+        glPixelStorei(GL_PACK_ALIGNMENT, 4);
+        glBindTexture(GL_TEXTURE_2D, 0);
+        return data;
+    }
+
+    // Placed region matches 'pixels', the rest is (0, 0, 0, 255)
+    bool PlacedMatches(const std::vector<uint8_t>& texture, const UploadFormat& format,
+                       const std::vector<uint8_t>& pixels) {
+        const size_t bpp = format.BytesPerPixel();
+        for (int y = 0; y < format.TextureHeight(); ++y) {
+            for (int x = 0; x < format.TextureWidth(); ++x) {
+                const uint8_t* texel = &texture[(static_cast<size_t>(y) * format.TextureWidth() + x) * bpp];
+                const int px = x - format.x_offset;
+                const int py = y - format.y_offset;
+                if (px >= 0 && px < format.width && py >= 0 && py < format.height) {
+                    const uint8_t* source = &pixels[(static_cast<size_t>(py) * format.width + px) * bpp];
+                    if (std::memcmp(texel, source, bpp) != 0) return false;
+                } else if (texel[0] != 0 || texel[1] != 0 || texel[2] != 0 || texel[3] != 255) {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+}
+
+TextureUploader::SelfCheckResult TextureUploader::RunSelfCheck() {
+    SelfCheckResult result;
+    result.ran = true;
+
+    while (glGetError() != GL_NO_ERROR) {}  // Only count errors raised here
+    BeginFrame();  // Creates the ring on first use
+    {
+        std::lock_guard<std::mutex> lock(ringMutex_);
+        result.ring = ringBase_ != nullptr;
+    }
+    result.clear_texture = hasClearTexture_;
+
+    auto check = [&result](const std::string& name, bool passed) {
+        result.total++;
+        if (passed) {
+            result.passed++;
+        } else if (result.failure.empty()) {
+            result.failure = name;
+        }
+    };
+
+    // Ring when available, client memory otherwise
+    auto upload = [this, &result, &check](const std::string& name, const UploadFormat& format,
+                                          const std::vector<uint8_t>& pixels) {
+        auto staged = Stage(format, pixels.data());
+        check(name + ": staged in ring", !result.ring || staged != nullptr);
+        return staged ? Upload(staged) : UploadNow(format, pixels.data());
+    };
+
+    std::vector<GLuint> textures;
+    uint32_t seed = 1;
+
+    // 1. Whole textures: ring (RGBA8, odd-width RGB8 rows), Reserve() filled in place, direct
+    for (const UploadFormat& format : { CheckFormat(64, 32, GL_RGBA), CheckFormat(33, 17, GL_RGB) }) {
+        const auto pixels = CheckPattern(format, seed++);
+        const GLuint texture = upload("ring upload", format, pixels);
+        check("ring upload: texture", texture != 0);
+        if (texture != 0) {
+            check("ring upload: readback", ReadTexture(texture, format) == pixels);
+            textures.push_back(texture);
+        }
+    }
+    {
+        const UploadFormat format = CheckFormat(48, 24, GL_RGBA);
+        const auto pixels = CheckPattern(format, seed++);
+        auto reserved = Reserve(format);
+        check("reserve: region", !result.ring || reserved != nullptr);
+        GLuint texture = 0;
+        if (reserved) {
+            std::memcpy(reserved->Data(), pixels.data(), pixels.size());
+            texture = Upload(reserved);
+        } else {
+            texture = UploadNow(format, pixels.data());
+        }
+        check("reserve: texture", texture != 0);
+        if (texture != 0) {
+            check("reserve: readback", ReadTexture(texture, format) == pixels);
+            textures.push_back(texture);
+        }
+    }
+    {
+        const UploadFormat format = CheckFormat(31, 9, GL_RGB);
+        const auto pixels = CheckPattern(format, seed++);
+        const GLuint texture = UploadNow(format, pixels.data());
+        check("direct upload: texture", texture != 0);
+        if (texture != 0) {
+            check("direct upload: readback", ReadTexture(texture, format) == pixels);
+            textures.push_back(texture);
+        }
+    }
+
+    // 2. Fences: once the GPU is done, BeginFrame() hands every region back
+    if (result.ring) {
+        glFinish();
+        BeginFrame();
+        std::lock_guard<std::mutex> lock(ringMutex_);
+        check("fences: ring reclaimed", liveRegions_.empty());
+    }
+
+    // 3. Placed uploads into a recycled texture that still holds a full frame,
+    //    cleared with glClearTexImage (when available) and with the FBO fallback
+    const bool hadClearTexture = hasClearTexture_;
+    for (bool clearTexture : { true, false }) {
+        if (clearTexture && !hadClearTexture) continue;
+        hasClearTexture_ = clearTexture;
+        const std::string name = clearTexture ? "placed (glClearTexImage)" : "placed (FBO clear)";
+
+        UploadFormat full = CheckFormat(40, 20, GL_RGBA);
+        const std::vector<uint8_t> white(full.ByteSize(), 0xFF);
+        const GLuint previous = UploadNow(full, white.data());
+        ReleaseTexture(previous);
+        BeginFrame();  // Recycles it for the placed upload below
+
+        UploadFormat placed = CheckFormat(16, 8, GL_RGBA);
+        placed.texture_width = full.width;
+        placed.texture_height = full.height;
+        placed.x_offset = 5;
+        placed.y_offset = 3;
+        placed.pad_alpha = 1.0f;
+        const auto pixels = CheckPattern(placed, seed++);
+
+        uint64_t recycledBefore;
+        {
+            std::lock_guard<std::mutex> lock(ringMutex_);
+            recycledBefore = texturesRecycled_;
+        }
+        const GLuint texture = upload(name, placed, pixels);
+        {
+            std::lock_guard<std::mutex> lock(ringMutex_);
+            check(name + ": recycled texture", texturesRecycled_ > recycledBefore);
+        }
+        check(name + ": texture", texture != 0);
+        if (texture != 0) {
+            check(name + ": readback", PlacedMatches(ReadTexture(texture, placed), placed, pixels));
+            textures.push_back(texture);
+        }
+    }
+    hasClearTexture_ = hadClearTexture;
+
+    check("gl errors", glGetError() == GL_NO_ERROR);
+
+    for (GLuint texture : textures) {
+        ReleaseTexture(texture);
+    }
+
+    result.ok = result.passed == result.total;
+    Debug::Log("TextureUploader: Self-check " + std::string(result.ok ? "passed" : "FAILED") + " (" +
+               std::to_string(result.passed) + "/" + std::to_string(result.total) +
+               (result.ring ? ", ring" : ", direct only") +
+               (result.clear_texture ? ", glClearTexImage" : "") + ")" +
+               (result.failure.empty() ? "" : " - " + result.failure));
+    lastSelfCheck_ = result;
+    return result;
+}
+
+} // namespace ump
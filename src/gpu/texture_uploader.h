@@ -0,0 +1,223 @@
+#pragma once
+
+#include <glad/gl.h>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+
+namespace ump {
+
+//=============================================================================
+// TextureUploader - asynchronous texture uploads through a persistent PBO ring
+//
+// Creating a texture with glTexImage2D from client memory blocks the main
+// thread for the whole copy (66 MB for a 4K RGBA half frame). Instead:
+// - Worker threads Stage() pixels into a persistent, coherently mapped pixel
+//   unpack buffer (no GL calls off the main thread - they only memcpy)
+// - The main thread issues glTexSubImage2D from the PBO into a recycled
+//   immutable-storage texture (glTexStorage2D), fenced so the ring region is
+//   only reused once the GPU has consumed it
+// - Uploads are metered against a per-frame millisecond budget; callers
+//   with a backlog check HasFrameBudget() and carry the rest to next frame
+//
+// Falls back to plain client-memory uploads if GL 4.4 / ARB_buffer_storage
+// isn't available (or the ring is full), so software GL (Mesa llvmpipe)
+// exercises the same paths.
+//=============================================================================
+
+// Texture storage description (rows are tightly packed)
+struct UploadFormat {
+    int width = 0;
+    int height = 0;
+    GLenum internal_format = GL_RGBA8;
+    GLenum format = GL_RGBA;
+    GLenum type = GL_UNSIGNED_BYTE;
+
+    // Placed uploads (EXR data windows): the pixels cover width x height at
+    // (x_offset, y_offset) of a larger texture, cleared to (0, 0, 0, pad_alpha)
+    int texture_width = 0;         // 0 = width
+    int texture_height = 0;        // 0 = height
+    int x_offset = 0;
+    int y_offset = 0;
+    float pad_alpha = 0.0f;
+
+    size_t BytesPerPixel() const;
+    size_t ByteSize() const { return static_cast<size_t>(width) * height * BytesPerPixel(); }
+    bool IsValid() const { return width > 0 && height > 0 && BytesPerPixel() > 0; }
+    int TextureWidth() const { return texture_width ? texture_width : width; }
+    int TextureHeight() const { return texture_height ? texture_height : height; }
+    bool IsPlaced() const { return TextureWidth() != width || TextureHeight() != height; }
+};
+
+// GL internal format storing 'format'/'type' pixels as-is: RGBA8/16/16F, the
+// RGB/RG/R variants for compact storage, RGB10_A2 for packed 10-bit
+GLenum StorageInternalFormat(GLenum format, GLenum type);
+
+// A region of the PBO ring holding one frame's pixels, ready for Upload()
+// Dropping the last reference without uploading returns the region to the ring.
+class StagedUpload {
+public:
+    const UploadFormat& Format() const { return format_; }
+    uint8_t* Data() const { return data_; }
+
+private:
+    friend class TextureUploader;
+
+    UploadFormat format_;
+    uint8_t* data_ = nullptr;
+    size_t offset_ = 0;
+    size_t size_ = 0;              // Aligned size reserved in the ring
+    bool submitted_ = false;       // glTexSubImage2D issued (guarded by ring mutex)
+    GLsync fence_ = nullptr;       // Signalled once the GPU has read the region
+};
+
+class TextureUploader {
+public:
+    struct Stats {
+        size_t ring_bytes = 0;         // 0 = PBO ring unavailable (client-memory uploads)
+        size_t ring_used_bytes = 0;
+        double budget_ms = 0.0;
+        double last_frame_ms = 0.0;    // Upload time spent in the previous frame
+        uint64_t staged_uploads = 0;   // Uploads sourced from the PBO ring
+        uint64_t direct_uploads = 0;   // Uploads from client memory
+        uint64_t stage_failures = 0;   // Stage() calls that found the ring full
+        uint64_t textures_created = 0;
+        uint64_t textures_recycled = 0;
+        size_t idle_textures = 0;
+    };
+
+    // Known pixels through each upload path, read back with glGetTexImage
+    struct SelfCheckResult {
+        bool ran = false;
+        bool ok = false;
+        bool ring = false;             // PBO ring available (else direct uploads only)
+        bool clear_texture = false;    // glClearTexImage available (the FBO clear is checked either way)
+        int passed = 0;
+        int total = 0;
+        std::string failure;           // First failed check
+    };
+
+    static constexpr size_t kDefaultRingBytes = size_t(256) << 20;  // ~3 4K half frames
+    static constexpr double kDefaultBudgetMs = 4.0;
+
+    // Process-wide uploader (GL objects belong to the main context)
+    static TextureUploader& Shared();
+
+    TextureUploader() = default;
+    ~TextureUploader() = default;  // GL objects are released in Shutdown()
+
+    TextureUploader(const TextureUploader&) = delete;
+    TextureUploader& operator=(const TextureUploader&) = delete;
+
+    //-------------------------------------------------------------------------
+    // Any thread
+    //-------------------------------------------------------------------------
+
+    // Copy pixels into the ring. Returns nullptr if the ring is unavailable or
+    // full - the caller keeps its CPU copy and uses UploadNow() instead.
+    std::shared_ptr<StagedUpload> Stage(const UploadFormat& format, const void* pixels);
+
+    // Reserve a ring region to decode into directly (fill Data() before Upload())
+    std::shared_ptr<StagedUpload> Reserve(const UploadFormat& format);
+
+    // Return a texture created by this uploader for reuse (deferred to BeginFrame)
+    void ReleaseTexture(GLuint texture);
+
+    void SetFrameBudgetMs(double ms);
+    double GetFrameBudgetMs() const;
+
+    // Ring size used the next time the ring is (re)created
+    void SetRingBytes(size_t bytes);
+
+    Stats GetStats() const;
+
+    //-------------------------------------------------------------------------
+    // Main thread (GL context current)
+    //-------------------------------------------------------------------------
+
+    // Once per UI frame: resets the budget, reclaims fenced ring regions and
+    // recycles released textures. Creates the ring on first call.
+    void BeginFrame();
+
+    // Time left in this frame's upload budget
+    bool HasFrameBudget() const;
+
+    // Upload a staged region / client memory into a recycled texture.
+    // Both always upload (the displayed frame can't wait) but count against the budget.
+    GLuint Upload(const std::shared_ptr<StagedUpload>& staged);
+    GLuint UploadNow(const UploadFormat& format, const void* pixels);
+
+    // Stage/Reserve -> Upload through the ring, UploadNow, placed uploads
+    // into a recycled texture (glClearTexImage and FBO clears) and fence
+    // reclaim. Needs only a current GL 3.3+ context - works headless under
+    // Mesa llvmpipe (LIBGL_ALWAYS_SOFTWARE=1). Best run while paused: a ring
+    // filled by playback falls back to direct uploads.
+    SelfCheckResult RunSelfCheck();
+    const SelfCheckResult& GetLastSelfCheck() const { return lastSelfCheck_; }
+
+    // Delete every GL object (call before the context is destroyed)
+    void Shutdown();
+
+private:
+    using TextureKey = std::tuple<int, int, GLenum>;  // width, height, internal format
+
+    static size_t AlignUp(size_t value, size_t alignment) {
+        return (value + alignment - 1) / alignment * alignment;
+    }
+
+    void CreateRing();
+    void ReclaimLocked(bool wait);
+    GLuint AcquireTexture(const UploadFormat& format);
+    void ClearTexture(GLuint texture, const UploadFormat& format);
+    static void SetUnpackAlignment(const UploadFormat& format);
+    void RecycleReleased();
+    void AddUploadTime(std::chrono::steady_clock::time_point start);
+
+    static constexpr size_t kRegionAlignment = 256;
+    static constexpr size_t kMaxIdleTextures = 24;
+
+    // PBO ring (ringMutex_ guards everything below except pbo_/ringBase_, which
+    // only change on the main thread while no regions are live)
+    mutable std::mutex ringMutex_;
+    GLuint pbo_ = 0;
+    uint8_t* ringBase_ = nullptr;
+    size_t ringBytes_ = 0;
+    size_t requestedRingBytes_ = kDefaultRingBytes;
+    size_t ringHead_ = 0;                                   // Next free offset
+    std::deque<std::shared_ptr<StagedUpload>> liveRegions_;  // Allocation order
+    bool ringInitAttempted_ = false;
+
+    // Texture recycling (main thread, except releasedTextures_)
+    std::map<TextureKey, std::vector<GLuint>> idleTextures_;
+    std::unordered_map<GLuint, TextureKey> textureKeys_;    // Textures we created
+    size_t idleTextureCount_ = 0;
+    std::vector<GLuint> releasedTextures_;                   // Guarded by ringMutex_
+    bool hasTexStorage_ = false;
+    bool hasClearTexture_ = false;
+    GLuint clearFbo_ = 0;                                    // Placed-upload clears without glClearTexImage
+
+    // Per-frame budget (main thread)
+    double budgetMs_ = kDefaultBudgetMs;                    // Guarded by ringMutex_
+    double frameSpentMs_ = 0.0;
+    double lastFrameMs_ = 0.0;
+
+    // Stats (guarded by ringMutex_)
+    uint64_t stagedUploads_ = 0;
+    uint64_t directUploads_ = 0;
+    uint64_t stageFailures_ = 0;
+    uint64_t texturesCreated_ = 0;
+    uint64_t texturesRecycled_ = 0;
+
+    SelfCheckResult lastSelfCheck_;                          // Main thread
+};
+
+} // namespace ump
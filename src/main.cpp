@@ -64,6 +64,7 @@ extern "C" {
 // ============================================================================
 #include "player/video_player.h"
 #include "player/thumbnail_cache.h"
+#include "gpu/texture_uploader.h"
 #include "utils/exiftool_helper.h"
 #include "utils/debug_utils.h"
 #include "utils/frame_indexing.h"
@@ -136,6 +137,7 @@ static struct {
     bool enable_nvidia_decode = false;    // NVIDIA hardware decode setting
     int max_batch_size = 8;               // Frames per extraction batch
     int max_concurrent_batches = 8;       // Number of parallel extraction threads
+    int reverse_read_ahead_seconds = 4;   // Seconds decoded behind the playhead when rewinding
 
     // EXR SEQUENCE SETTINGS - Auto-configured based on CPU
     int exr_oiio_threads = 8;             // EXR I/O worker thread count (1-16) - auto-detected (will be 8-16 for modern CPUs)
@@ -238,9 +240,15 @@ void AutoConfigureEXRThreading(decltype(cache_settings)& settings) {
 // Create DirectEXRCacheConfig from current cache_settings (NEW: Simplified config)
 // Global EXR cache settings (visible to project_manager)
 double g_exr_cache_gb = 18.0;
+double g_exr_compressed_cache_gb = 0.0;  // Compressed second RAM tier for evicted frames (0 = off)
 float g_read_behind_seconds = 0.5f;
 int g_exr_thread_count = 16;  // DirectEXRCache parallel I/O threads
 int g_exr_transcode_threads = 8;  // EXRTranscoder parallel transcode threads
+int g_frame_read_backend = 0;  // ump::ReadBackend: 0 = mmap, 1 = pread, 2 = io_uring
+bool g_frame_direct_io = false;  // O_DIRECT frame reads (bypass the OS page cache)
+bool g_exr_multi_layer_cache = false;  // Decode + cache every EXR layer per load (instant layer switch)
+bool g_exr_draft_playback = true;  // Reduced-resolution loads while decode can't sustain the fps
+bool g_dedup_identical_frames = false;  // Identical frames share one buffer/texture (video + image sequences)
 
 // Global disk cache settings
 std::string g_custom_cache_path = "";  // Empty = use default %LOCALAPPDATA%
@@ -254,8 +262,14 @@ ump::DirectEXRCacheConfig GetCurrentEXRCacheConfig() {
 
     // Use UI-configured values
     config.cacheGB = g_exr_cache_gb;
+    config.compressedCacheGB = g_exr_compressed_cache_gb;
     config.readBehindSeconds = g_read_behind_seconds;
     config.threadCount = static_cast<size_t>(g_exr_thread_count);
+    config.readBackend = static_cast<ump::ReadBackend>(g_frame_read_backend);
+    config.directIO = g_frame_direct_io;
+    config.multiLayerCache = g_exr_multi_layer_cache;
+    config.draftPlayback = g_exr_draft_playback;
+    config.dedupFrames = g_dedup_identical_frames;
 
     return config;
 }
@@ -969,6 +983,9 @@ public:
                 }
             }
 
+            // New upload budget for this frame; reclaims PBO regions the GPU has consumed
+            ump::TextureUploader::Shared().BeginFrame();
+
             if (video_player) {
                 video_player->UpdateFromMPVEvents();
                 video_player->UpdateVideoTexture();
@@ -983,6 +1000,8 @@ public:
                     timeline_manager->Update(video_player.get());
                 }
 
+                video_player->UpdateFastSeekSpeed();
+
                 // Only update fast seeking if timeline manager isn't using cached frames
                 if (!timeline_manager || !timeline_manager->IsHoldingCachedFrame()) {
                     video_player->UpdateFastSeek();
@@ -1088,6 +1107,10 @@ public:
             Debug::Log("Cleanup: No video player to clean up");
         }
 
+        // Release the upload ring and recycled textures while the context is alive
+        Debug::Log("Cleanup: Releasing texture uploader...");
+        ump::TextureUploader::Shared().Shutdown();
+
         // Shutdown ImGui and related contexts
         Debug::Log("Cleanup: Shutting down ImGui OpenGL3...");
         ImGui_ImplOpenGL3_Shutdown();
@@ -2993,6 +3016,14 @@ private:
             ImGui::Text("Cache Hits: %zu", stats.cache_hits);
             ImGui::Text("Cache Misses: %zu", stats.cache_misses);
             ImGui::Text("Hit Ratio: %.1f%%", stats.hit_ratio * 100.0f);
+            if (stats.dedup_frames > 0) {
+                ImGui::Text("Shared Frames: %zu (%.1f MB not uploaded)",
+                            stats.dedup_frames, stats.dedup_bytes / (1024.0 * 1024.0));
+            }
+            if (stats.frames_delivered > 0) {
+                ImGui::Text("Decoded per Frame: %.2f (%zu decoded)",
+                            static_cast<double>(stats.frames_decoded) / stats.frames_delivered, stats.frames_decoded);
+            }
 
             ImGui::Spacing();
 
@@ -3739,6 +3770,14 @@ private:
             ImGui::TextColored(ImVec4(0.7f, 0.7f, 0.7f, 1.0f), "Maximum duration of video cached around current position");
             ImGui::TextColored(ImVec4(0.7f, 0.7f, 0.7f, 1.0f), "Frames beyond this window are automatically evicted");
 
+            // Reverse read-ahead (rewind decodes GOPs behind the playhead)
+            ImGui::Spacing();
+            ImGui::Text("Reverse Read-Ahead:");
+            if (ImGui::SliderInt("##ReverseReadAheadSlider", &cache_settings.reverse_read_ahead_seconds, 1, 30, "%d seconds")) {
+                settings_changed = true;
+            }
+            ImGui::TextColored(ImVec4(0.7f, 0.7f, 0.7f, 1.0f), "Video decoded behind the playhead while rewinding");
+
             // Memory Estimates Section
             ImGui::Spacing();
             ImGui::Separator();
@@ -3902,6 +3941,27 @@ private:
                         estimated_4k_frames, estimated_4k_seconds);
                     if (font_mono) ImGui::PopFont();
 
+                    // Compressed tier below the cache (RAM)
+                    ImGui::Spacing();
+                    ImGui::Text("Compressed Cache Size:");
+                    float compressed_cache_gb_float = static_cast<float>(g_exr_compressed_cache_gb);
+                    if (ImGui::SliderFloat("##ImageSeqCompressedCacheSize", &compressed_cache_gb_float, 0.0f, 64.0f,
+                                           compressed_cache_gb_float > 0.0f ? "%.1f GB" : "Off")) {
+                        g_exr_compressed_cache_gb = static_cast<double>(compressed_cache_gb_float);
+                        settings_changed = true;
+                    }
+                    ImGui::SameLine();
+                    ImGui::TextDisabled("(?)");
+                    if (ImGui::IsItemHovered()) {
+                        ImGui::SetTooltip(
+                            "Second RAM tier, in addition to the cache size above.\n\n"
+                            "Frames evicted from the cache are kept losslessly\n"
+                            "compressed (typically 1.5-2.5x for half-float EXR) and\n"
+                            "decompressed when playback reaches them again, instead\n"
+                            "of reading and decoding the files.\n\n"
+                            "Useful for looping sequences larger than the cache.");
+                    }
+
                     // Read-Behind Time
                     ImGui::Spacing();
                     ImGui::Separator();
@@ -4059,6 +4119,93 @@ private:
                     ImGui::TextColored(ImVec4(0.7f, 0.7f, 0.7f, 1.0f),
                         "Current: %d parallel loaders", g_exr_thread_count);
 
+                    // Frame read backend
+                    ImGui::Spacing();
+                    ImGui::Text("Frame Read Backend:");
+                    const char* backend_preview = ump::ReadBackendName(static_cast<ump::ReadBackend>(g_frame_read_backend));
+                    if (ImGui::BeginCombo("##FrameReadBackend", backend_preview)) {
+                        for (int b = 0; b < static_cast<int>(ump::ReadBackend::Count); b++) {
+                            const ump::ReadBackend backend = static_cast<ump::ReadBackend>(b);
+                            const bool available = ump::FrameFileReader::IsAvailable(backend);
+                            if (ImGui::Selectable(ump::ReadBackendName(backend), g_frame_read_backend == b,
+                                                  available ? 0 : ImGuiSelectableFlags_Disabled)) {
+                                g_frame_read_backend = b;
+                                settings_changed = true;
+                            }
+                        }
+                        ImGui::EndCombo();
+                    }
+                    ImGui::SameLine();
+                    ImGui::TextDisabled("(?)");
+                    if (ImGui::IsItemHovered()) {
+                        ImGui::SetTooltip(
+                            "How image sequence frames are read from disk.\n\n"
+                            "  - mmap: decoders map the file (default)\n"
+                            "  - pread: whole file read into memory, then decoded\n"
+                            "  - io_uring: batched whole-file reads (Linux)\n\n"
+                            "pread/io_uring scale better with many threads on large\n"
+                            "DWAA/DWAB files. Use Benchmark in the cache status panel\n"
+                            "to compare them on your storage.");
+                    }
+
+                    if (g_frame_read_backend != static_cast<int>(ump::ReadBackend::Mapped)) {
+                        if (ImGui::Checkbox("Direct I/O (bypass OS cache)", &g_frame_direct_io)) {
+                            settings_changed = true;
+                        }
+                        ImGui::SameLine();
+                        ImGui::TextDisabled("(?)");
+                        if (ImGui::IsItemHovered()) {
+                            ImGui::SetTooltip(
+                                "Read with O_DIRECT so sequences larger than RAM don't\n"
+                                "evict everything else from the OS file cache.\n"
+                                "Falls back to buffered reads where unsupported.");
+                        }
+                    }
+
+                    // Multi-layer EXR caching
+                    ImGui::Spacing();
+                    if (ImGui::Checkbox("Cache all EXR layers", &g_exr_multi_layer_cache)) {
+                        settings_changed = true;
+                    }
+                    ImGui::SameLine();
+                    ImGui::TextDisabled("(?)");
+                    if (ImGui::IsItemHovered()) {
+                        ImGui::SetTooltip(
+                            "Decode every layer of a multi-layer EXR in each frame read\n"
+                            "(up to 8) and keep them all cached, so switching layers\n"
+                            "shows cached frames instantly instead of reloading.\n\n"
+                            "The cache budget is shared between the layers, so each\n"
+                            "layer caches fewer frames ahead of the playhead.");
+                    }
+
+                    // Draft playback
+                    if (ImGui::Checkbox("Draft resolution when playback falls behind", &g_exr_draft_playback)) {
+                        settings_changed = true;
+                    }
+                    ImGui::SameLine();
+                    ImGui::TextDisabled("(?)");
+                    if (ImGui::IsItemHovered()) {
+                        ImGui::SetTooltip(
+                            "When frames can't be decoded as fast as the sequence plays\n"
+                            "(e.g. multilayer DWAB), load them at 1/2 or 1/4 resolution.\n\n"
+                            "Full resolution returns when paused or once the cache\n"
+                            "has caught up; draft frames are replaced as they reload.");
+                    }
+
+                    // Content deduplication
+                    if (ImGui::Checkbox("Share identical frames", &g_dedup_identical_frames)) {
+                        settings_changed = true;
+                    }
+                    ImGui::SameLine();
+                    ImGui::TextDisabled("(?)");
+                    if (ImGui::IsItemHovered()) {
+                        ImGui::SetTooltip(
+                            "Held frames, slates and duplicated frames are cached once:\n"
+                            "identical content shares one buffer and one GPU texture.\n\n"
+                            "Image sequences compare files (sampled, then fully hashed)\n"
+                            "and skip decoding duplicates; videos compare decoded frames.");
+                    }
+
                     // Image Sequence Transcode Threading Settings
                     ImGui::Spacing();
                     ImGui::Separator();
@@ -4271,6 +4418,8 @@ private:
                     // Apply threading settings
                     config.max_batch_size = cache_settings.max_batch_size;
                     config.max_concurrent_batches = cache_settings.max_concurrent_batches;
+                    config.reverse_read_ahead_seconds = cache_settings.reverse_read_ahead_seconds;
+                    config.dedup_identical_frames = g_dedup_identical_frames;
 
                     project_manager->SetCacheConfig(config);
 
@@ -4327,6 +4476,7 @@ private:
                 cache_settings.enable_nvidia_decode = false;
                 cache_settings.max_batch_size = 8;
                 cache_settings.max_concurrent_batches = 8;
+                cache_settings.reverse_read_ahead_seconds = 4;
 
                 // EXR settings - Auto-configure based on CPU
                 AutoConfigureEXRThreading(cache_settings);
@@ -4454,7 +4604,7 @@ private:
             if (timeline_manager && (timeline_manager->IsScrubbing() || timeline_manager->IsHoldingCachedFrame())) {
                 GLuint cached_texture_id = 0;
                 int cached_width = 0, cached_height = 0;
-                double current_time = timeline_manager->GetUIPosition();
+                double current_time = timeline_manager->GetDisplayPosition();
 
                 if (timeline_manager->GetCachedFrameForScrubbing(current_time, cached_texture_id, cached_width, cached_height)) {
                     // Use cached frame for instant scrubbing feedback
@@ -9458,6 +9608,9 @@ private:
                 if (j["video_cache"].contains("max_concurrent_batches")) {
                     cache_settings.max_concurrent_batches = j["video_cache"]["max_concurrent_batches"].get<int>();
                 }
+                if (j["video_cache"].contains("reverse_read_ahead_seconds")) {
+                    cache_settings.reverse_read_ahead_seconds = j["video_cache"]["reverse_read_ahead_seconds"].get<int>();
+                }
                 if (j["video_cache"].contains("pipeline_mode")) {
                     std::string mode_str = j["video_cache"]["pipeline_mode"].get<std::string>();
                     cache_settings.current_pipeline_mode = StringToPipelineMode(mode_str);
@@ -9472,6 +9625,9 @@ private:
                 if (j["exr_cache"].contains("read_behind_seconds")) {
                     g_read_behind_seconds = j["exr_cache"]["read_behind_seconds"].get<float>();
                 }
+                if (j["exr_cache"].contains("compressed_cache_gb")) {
+                    g_exr_compressed_cache_gb = j["exr_cache"]["compressed_cache_gb"].get<double>();
+                }
             }
 
             // Performance settings (image sequence I/O + EXR transcode)
@@ -9482,6 +9638,22 @@ private:
                 if (j["performance"].contains("exr_transcode_threads")) {
                     g_exr_transcode_threads = j["performance"]["exr_transcode_threads"].get<int>();
                 }
+                if (j["performance"].contains("frame_read_backend")) {
+                    g_frame_read_backend = std::clamp(j["performance"]["frame_read_backend"].get<int>(),
+                                                      0, static_cast<int>(ump::ReadBackend::Count) - 1);
+                }
+                if (j["performance"].contains("frame_direct_io")) {
+                    g_frame_direct_io = j["performance"]["frame_direct_io"].get<bool>();
+                }
+                if (j["performance"].contains("exr_multi_layer_cache")) {
+                    g_exr_multi_layer_cache = j["performance"]["exr_multi_layer_cache"].get<bool>();
+                }
+                if (j["performance"].contains("exr_draft_playback")) {
+                    g_exr_draft_playback = j["performance"]["exr_draft_playback"].get<bool>();
+                }
+                if (j["performance"].contains("dedup_identical_frames")) {
+                    g_dedup_identical_frames = j["performance"]["dedup_identical_frames"].get<bool>();
+                }
             }
 
             // Disk cache settings
@@ -9621,15 +9793,22 @@ private:
             j["video_cache"]["enable_nvidia_decode"] = cache_settings.enable_nvidia_decode;
             j["video_cache"]["max_batch_size"] = cache_settings.max_batch_size;
             j["video_cache"]["max_concurrent_batches"] = cache_settings.max_concurrent_batches;
+            j["video_cache"]["reverse_read_ahead_seconds"] = cache_settings.reverse_read_ahead_seconds;
             j["video_cache"]["pipeline_mode"] = PipelineModeToString(cache_settings.current_pipeline_mode);
 
             // Image sequence cache settings (EXR/TIFF/PNG/JPEG)
             j["exr_cache"]["cache_gb"] = g_exr_cache_gb;
             j["exr_cache"]["read_behind_seconds"] = g_read_behind_seconds;
+            j["exr_cache"]["compressed_cache_gb"] = g_exr_compressed_cache_gb;
 
             // Performance settings (image sequence I/O + EXR transcode)
             j["performance"]["exr_io_threads"] = g_exr_thread_count;
             j["performance"]["exr_transcode_threads"] = g_exr_transcode_threads;
+            j["performance"]["frame_read_backend"] = g_frame_read_backend;
+            j["performance"]["frame_direct_io"] = g_frame_direct_io;
+            j["performance"]["exr_multi_layer_cache"] = g_exr_multi_layer_cache;
+            j["performance"]["exr_draft_playback"] = g_exr_draft_playback;
+            j["performance"]["dedup_identical_frames"] = g_dedup_identical_frames;
 
             // Disk cache settings
             j["disk_cache"]["custom_path"] = g_custom_cache_path;
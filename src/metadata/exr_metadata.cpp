@@ -1,12 +1,6 @@
 #include "exr_metadata.h"
 #include "../utils/exr_layer_detector.h"
-#include <OpenEXR/ImfInputFile.h>
-#include <OpenEXR/ImfMultiPartInputFile.h>
-#include <OpenEXR/ImfHeader.h>
-#include <OpenEXR/ImfChannelList.h>
-#include <OpenEXR/ImfCompression.h>
-#include <OpenEXR/ImfStringAttribute.h>
-#include <OpenEXR/ImfChromaticitiesAttribute.h>
+#include "../utils/exr_layout_cache.h"
 #include <Imath/ImathBox.h>
 #include <algorithm>
 #include <cstdio>
@@ -18,30 +12,29 @@ void EXRMetadata::DetectAndCacheExtendedProperties() {
     }
 
     try {
-        // Open EXR file
-        Imf::MultiPartInputFile file(file_path.c_str());
-        const Imf::Header& header = file.header(0);
+        // Header layout shared with the loaders and layer detection - parsed once per sequence
+        const auto layout = ump::EXRLayoutCache::Shared().Get(file_path);
 
         // Get compression type
         const char* compressionNames[] = {
             "None", "RLE", "ZIPS", "ZIP", "PIZ", "PXR24",
             "B44", "B44A", "DWAA", "DWAB"
         };
-        int compressionType = static_cast<int>(header.compression());
+        int compressionType = static_cast<int>(layout->compression);
         if (compressionType >= 0 && compressionType < 10) {
             compression = compressionNames[compressionType];
         }
 
         // Check if tiled
-        is_tiled = header.hasTileDescription();
+        is_tiled = layout->tiled;
 
         // Get multi-part info
-        is_multi_part = (file.parts() > 1);
-        part_count = file.parts();
+        is_multi_part = (layout->parts > 1);
+        part_count = layout->parts;
 
         // Get window dimensions
-        const Imath::Box2i displayWindow = header.displayWindow();
-        const Imath::Box2i dataWindow = header.dataWindow();
+        const Imath::Box2i displayWindow = layout->display_window;
+        const Imath::Box2i dataWindow = layout->data_window;
 
         display_width = displayWindow.max.x - displayWindow.min.x + 1;
         display_height = displayWindow.max.y - displayWindow.min.y + 1;
@@ -132,13 +125,11 @@ void EXRMetadata::DetectAndCacheExtendedProperties() {
             }
         }
 
-        // Try to get color space attributes (may not be present)
-        if (header.findTypedAttribute<Imf::StringAttribute>("colorspace")) {
-            colorspace = header.typedAttribute<Imf::StringAttribute>("colorspace").value();
-        }
+        // Color space attributes (may not be present)
+        colorspace = layout->colorspace;
 
-        if (header.findTypedAttribute<Imf::ChromaticitiesAttribute>("chromaticities")) {
-            const Imf::Chromaticities& chroma = header.typedAttribute<Imf::ChromaticitiesAttribute>("chromaticities").value();
+        if (layout->chromaticities) {
+            const Imf::Chromaticities& chroma = *layout->chromaticities;
             // Format as string for display
             char buf[256];
             snprintf(buf, sizeof(buf), "R(%.3f,%.3f) G(%.3f,%.3f) B(%.3f,%.3f) W(%.3f,%.3f)",
@@ -0,0 +1,337 @@
+#include "compressed_frame_cache.h"
+#include "../utils/task_scheduler.h"
+
+#include <OpenEXR/openexr_compression.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+
+namespace ump {
+
+namespace {
+    constexpr int kDeflateLevel = 1;    // libdeflate's fastest
+
+    size_t ElementBytes(GLenum type) {
+        switch (type) {
+            case GL_UNSIGNED_SHORT:
+            case GL_HALF_FLOAT:
+                return 2;
+            case GL_FLOAT:
+            case GL_UNSIGNED_INT_2_10_10_10_REV:
+                return 4;
+            default:
+                return 1;
+        }
+    }
+
+    // Every field but the pixels
+    PixelData CopyHeader(const PixelData& pixels) {
+        PixelData header;
+        header.width = pixels.width;
+        header.height = pixels.height;
+        header.gl_format = pixels.gl_format;
+        header.gl_type = pixels.gl_type;
+        header.pipeline_mode = pixels.pipeline_mode;
+        header.draft_level = pixels.draft_level;
+        header.full_width = pixels.full_width;
+        header.full_height = pixels.full_height;
+        header.region_x = pixels.region_x;
+        header.region_y = pixels.region_y;
+        header.region_width = pixels.region_width;
+        header.region_height = pixels.region_height;
+        header.opaque = pixels.opaque;
+        return header;
+    }
+
+    double RunningAverage(double average, double sample, uint64_t count) {
+        return count <= 1 ? sample : average + (sample - average) * 0.1;
+    }
+}
+
+CompressedFrameCache::CompressedFrameCache() = default;
+
+CompressedFrameCache::~CompressedFrameCache() {
+    std::unique_lock<std::mutex> lock(pendingMutex_);
+    epoch_++;
+    pendingCv_.wait(lock, [this] { return pending_ == 0; });
+}
+
+void CompressedFrameCache::SetMaxBytes(size_t bytes) {
+    enabled_ = bytes > 0;
+    entries_.SetMaxSize(bytes);
+    if (bytes == 0) {
+        Clear();
+    }
+}
+
+void CompressedFrameCache::Store(int frame, std::shared_ptr<PixelData> pixels) {
+    if (!enabled_ || !pixels || pixels->pixels.empty()) {
+        return;
+    }
+
+    // Already held as fine (a frame evicted again after a hit): keep it fresh
+    std::shared_ptr<const Entry> held;
+    if (entries_.Get(frame, held) && held && held->header.draft_level <= pixels->draft_level) {
+        return;
+    }
+
+    // Pixels another frame shares, already compressed
+    if (auto entry = FindSource(pixels)) {
+        entries_.Add(frame, entry, entry->bytes);
+        return;
+    }
+
+    // The queued frame keeps its buffer alive past the hot tier's budget - bounded
+    {
+        std::lock_guard<std::mutex> lock(pendingMutex_);
+        if (pending_ >= kMaxPendingStores) {
+            std::lock_guard<std::mutex> statsLock(statsMutex_);
+            dropped_++;
+            return;
+        }
+        pending_++;
+    }
+
+    const uint64_t epoch = epoch_.load();
+    TaskScheduler::Shared().Post(TaskPriority::Prefetch, [this, frame, pixels = std::move(pixels), epoch]() mutable {
+        std::shared_ptr<const Entry> entry;
+        double ms = 0.0;
+        bool reused = false;
+        if (epoch_.load() == epoch) {
+            // A frame sharing these pixels was evicted alongside and compressed first
+            entry = FindSource(pixels);
+            reused = entry != nullptr;
+            if (!reused) {
+                try {
+                    const auto start = std::chrono::steady_clock::now();
+                    entry = Compress(*pixels);
+                    ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+                } catch (...) {
+                    entry.reset();
+                }
+                if (entry) {
+                    RememberSource(pixels, entry);
+                }
+            }
+        }
+        pixels.reset();  // Back to the buffer pool before the entry is counted
+
+        {
+            // Checked under pendingMutex_: Clear() bumps the epoch with it held
+            std::lock_guard<std::mutex> lock(pendingMutex_);
+            if (entry && epoch_.load() == epoch) {
+                entries_.Add(frame, entry, entry->bytes);
+
+                if (!reused) {
+                    std::lock_guard<std::mutex> statsLock(statsMutex_);
+                    stored_++;
+                    storedRawBytes_ += entry->rawBytes;
+                    storedBytes_ += entry->bytes;
+                    avgCompressMs_ = RunningAverage(avgCompressMs_, ms, stored_);
+                }
+            }
+            pending_--;
+            // Under the lock: the destructor frees pendingCv_ once it sees zero
+            pendingCv_.notify_all();
+        }
+    });
+}
+
+std::shared_ptr<PixelData> CompressedFrameCache::Load(int frame, int maxLevel) {
+    if (!enabled_ || !entries_.Contains(frame)) {
+        return nullptr;
+    }
+    std::shared_ptr<const Entry> entry;
+    if (!entries_.Get(frame, entry) || !entry || entry->header.draft_level > maxLevel) {
+        return nullptr;
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    std::shared_ptr<PixelData> pixels;
+    try {
+        pixels = Decompress(*entry);
+    } catch (...) {
+        pixels.reset();
+    }
+    if (!pixels) {
+        return nullptr;
+    }
+    const double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    std::lock_guard<std::mutex> lock(statsMutex_);
+    hits_++;
+    avgDecompressMs_ = RunningAverage(avgDecompressMs_, ms, hits_);
+    return pixels;
+}
+
+void CompressedFrameCache::Clear() {
+    {
+        std::lock_guard<std::mutex> lock(pendingMutex_);
+        epoch_++;
+        entries_.Clear();
+    }
+    std::lock_guard<std::mutex> lock(sourcesMutex_);
+    sources_.clear();
+}
+
+std::shared_ptr<const CompressedFrameCache::Entry> CompressedFrameCache::FindSource(const std::shared_ptr<PixelData>& pixels) {
+    std::lock_guard<std::mutex> lock(sourcesMutex_);
+    auto it = sources_.find(pixels.get());
+    if (it == sources_.end() || it->second.pixels.lock() != pixels) {
+        return nullptr;  // Not compressed, or a freed buffer's address reused
+    }
+    auto entry = it->second.entry.lock();
+    if (entry && entry->header.draft_level != pixels->draft_level) {
+        return nullptr;
+    }
+    return entry;
+}
+
+void CompressedFrameCache::RememberSource(const std::shared_ptr<PixelData>& pixels,
+                                          const std::shared_ptr<const Entry>& entry) {
+    std::lock_guard<std::mutex> lock(sourcesMutex_);
+    if (sources_.size() >= kMaxSources) {
+        for (auto it = sources_.begin(); it != sources_.end();) {
+            if (it->second.pixels.expired() || it->second.entry.expired()) {
+                it = sources_.erase(it);
+            } else {
+                ++it;
+            }
+        }
+        if (sources_.size() >= kMaxSources) {
+            sources_.clear();
+        }
+    }
+    sources_[pixels.get()] = Source{pixels, entry};
+}
+
+CompressedFrameCache::Stats CompressedFrameCache::GetStats() const {
+    Stats stats;
+    stats.enabled = enabled_.load();
+    stats.frames = static_cast<int>(entries_.GetCount());
+    stats.bytes = entries_.GetSize();
+    stats.maxBytes = entries_.GetMaxSize();
+
+    std::lock_guard<std::mutex> lock(statsMutex_);
+    stats.ratio = storedBytes_ > 0 ? static_cast<double>(storedRawBytes_) / storedBytes_ : 0.0;
+    stats.stored = stored_;
+    stats.dropped = dropped_;
+    stats.hits = hits_;
+    stats.avgCompressMs = avgCompressMs_;
+    stats.avgDecompressMs = avgDecompressMs_;
+    return stats;
+}
+
+//=============================================================================
+// Codec: per band, byte planes + delta, then deflate
+//=============================================================================
+
+std::shared_ptr<const CompressedFrameCache::Entry> CompressedFrameCache::Compress(const PixelData& pixels) {
+    auto entry = std::make_shared<Entry>();
+    entry->header = CopyHeader(pixels);
+    entry->rawBytes = pixels.pixels.size();
+    entry->elementBytes = ElementBytes(pixels.gl_type);
+
+    // Whole rows per band, so bands hold whole elements
+    const size_t rowBytes = pixels.height > 0 ? entry->rawBytes / pixels.height : entry->rawBytes;
+    const size_t rowsPerBand = std::max<size_t>(1, kBandBytes / std::max<size_t>(rowBytes, 1));
+    entry->bandBytes = std::max<size_t>(rowsPerBand * rowBytes, 1);
+    const size_t bandCount = (entry->rawBytes + entry->bandBytes - 1) / entry->bandBytes;
+    entry->bands.resize(bandCount);
+
+    TaskScheduler::Shared().ParallelFor(TaskPriority::Prefetch, static_cast<int>(bandCount),
+        TaskScheduler::GetThreadHelperBudget(),
+        [&](int index, size_t) {
+            const size_t offset = static_cast<size_t>(index) * entry->bandBytes;
+            const size_t bytes = std::min(entry->bandBytes, entry->rawBytes - offset);
+            const uint8_t* src = pixels.pixels.data() + offset;
+            Band& band = entry->bands[index];
+            band.rawBytes = bytes;
+
+            // Planes by element byte, then delta (low bytes of neighbours are noise,
+            // high bytes - sign/exponent - repeat and compress)
+            thread_local std::vector<uint8_t> planes;
+            thread_local std::vector<uint8_t> deflated;
+            planes.resize(bytes);
+            const size_t es = entry->elementBytes;
+            const size_t count = bytes / es;
+            for (size_t b = 0; b < es; ++b) {
+                uint8_t* dst = planes.data() + b * count;
+                for (size_t i = 0; i < count; ++i) {
+                    dst[i] = src[i * es + b];
+                }
+            }
+            std::memcpy(planes.data() + count * es, src + count * es, bytes - count * es);
+            uint8_t previous = 0;
+            for (size_t i = 0; i < bytes; ++i) {
+                const uint8_t value = planes[i];
+                planes[i] = static_cast<uint8_t>(value - previous);
+                previous = value;
+            }
+
+            deflated.resize(exr_compress_max_buffer_size(bytes));
+            size_t actual = 0;
+            if (exr_compress_buffer(nullptr, kDeflateLevel, planes.data(), bytes,
+                                    deflated.data(), deflated.size(), &actual) == EXR_ERR_SUCCESS &&
+                actual < bytes) {
+                band.data.assign(deflated.data(), deflated.data() + actual);
+                band.compressed = true;
+            } else {
+                band.data.assign(src, src + bytes);
+            }
+        });
+
+    entry->bytes = sizeof(Entry);
+    for (const Band& band : entry->bands) {
+        entry->bytes += band.data.size();
+    }
+    return entry;
+}
+
+std::shared_ptr<PixelData> CompressedFrameCache::Decompress(const Entry& entry) {
+    auto pixels = std::make_shared<PixelData>(CopyHeader(entry.header));
+    pixels->pixels.resize(entry.rawBytes);
+
+    std::atomic<bool> failed{false};
+    TaskScheduler::Shared().ParallelFor(TaskPriority::PlaybackCritical, static_cast<int>(entry.bands.size()),
+        TaskScheduler::GetThreadHelperBudget(),
+        [&](int index, size_t) {
+            const Band& band = entry.bands[index];
+            uint8_t* dst = pixels->pixels.data() + static_cast<size_t>(index) * entry.bandBytes;
+            if (!band.compressed) {
+                std::memcpy(dst, band.data.data(), band.rawBytes);
+                return;
+            }
+
+            thread_local std::vector<uint8_t> planes;
+            planes.resize(band.rawBytes);
+            size_t actual = 0;
+            if (exr_uncompress_buffer(nullptr, band.data.data(), band.data.size(),
+                                      planes.data(), planes.size(), &actual) != EXR_ERR_SUCCESS ||
+                actual != band.rawBytes) {
+                failed = true;
+                return;
+            }
+
+            uint8_t previous = 0;
+            for (size_t i = 0; i < band.rawBytes; ++i) {
+                previous = static_cast<uint8_t>(previous + planes[i]);
+                planes[i] = previous;
+            }
+            const size_t es = entry.elementBytes;
+            const size_t count = band.rawBytes / es;
+            for (size_t b = 0; b < es; ++b) {
+                const uint8_t* src = planes.data() + b * count;
+                for (size_t i = 0; i < count; ++i) {
+                    dst[i * es + b] = src[i];
+                }
+            }
+            std::memcpy(dst + count * es, planes.data() + count * es, band.rawBytes - count * es);
+        });
+
+    return failed ? nullptr : pixels;
+}
+
+} // namespace ump
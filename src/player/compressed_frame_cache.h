@@ -0,0 +1,128 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "image_loader_interface.h"
+#include "sharded_lru.h"
+
+namespace ump {
+
+//=============================================================================
+// CompressedFrameCache - lossless second RAM tier below the pixel cache
+//
+// Frames leaving the pixel cache (budget eviction or the playhead window)
+// are kept here compressed instead of being dropped, so a loop or scrub back
+// over them decompresses from RAM rather than reading and decoding the file
+// again. Half-float and 16-bit frames compress well once their bytes are
+// regrouped:
+// - The frame is split into bands of rows, compressed independently so
+//   bands run in parallel and a band that doesn't shrink is stored raw
+// - Per band the bytes are split into planes by element byte (all low bytes,
+//   then all high bytes) and delta-coded, then deflated (OpenEXRCore's
+//   libdeflate at its fastest level - the ZIP codec's own preprocessing)
+// - Compression runs as a Prefetch task per evicted frame, decompression in
+//   the load task of a frame the fill requests again (with its helpers)
+// The tier has its own byte budget (0 = off) and LRU; entries stay after a
+// hit, so a frame evicted again is not compressed a second time. Frames that
+// share one buffer (dedup) share its entry too: it is compressed once, and
+// each frame is charged its bytes (the budget errs on the side of evicting).
+//=============================================================================
+
+class CompressedFrameCache {
+public:
+    struct Stats {
+        bool enabled = false;
+        int frames = 0;
+        size_t bytes = 0;                   // Compressed bytes held
+        size_t maxBytes = 0;
+        double ratio = 0.0;                 // Raw / compressed bytes of the frames stored so far
+        uint64_t stored = 0;                // Frames compressed into the tier
+        uint64_t dropped = 0;               // Evictions skipped (compression queue full)
+        uint64_t hits = 0;                  // Frames served from the tier
+        double avgCompressMs = 0.0;
+        double avgDecompressMs = 0.0;
+    };
+
+    CompressedFrameCache();
+    ~CompressedFrameCache();  // Waits for queued compressions
+
+    CompressedFrameCache(const CompressedFrameCache&) = delete;
+    CompressedFrameCache& operator=(const CompressedFrameCache&) = delete;
+
+    // 0 disables the tier and drops its frames
+    void SetMaxBytes(size_t bytes);
+    bool IsEnabled() const { return enabled_.load(); }
+
+    // Frame leaving the hot tier: queued for compression (any thread, cheap -
+    // safe from an LRU eviction callback). Kept unless already held as fine.
+    void Store(int frame, std::shared_ptr<PixelData> pixels);
+
+    // Decompressed copy at 'maxLevel' or finer, nullptr if not held (any thread)
+    std::shared_ptr<PixelData> Load(int frame, int maxLevel);
+
+    // New sequence/layer: drop every frame and the compressions still queued
+    void Clear();
+
+    Stats GetStats() const;
+
+private:
+    struct Band {
+        std::vector<uint8_t> data;          // Deflated planes, or the raw band
+        size_t rawBytes = 0;
+        bool compressed = false;
+    };
+
+    struct Entry {
+        PixelData header;                   // Frame metadata (pixels left empty)
+        size_t rawBytes = 0;
+        size_t elementBytes = 1;            // Plane split stride
+        size_t bandBytes = 0;               // Raw bytes per band (last may be shorter)
+        std::vector<Band> bands;
+        size_t bytes = 0;
+    };
+
+    // Entry already compressed from this buffer, if it and the buffer still live
+    struct Source {
+        std::weak_ptr<PixelData> pixels;
+        std::weak_ptr<const Entry> entry;
+    };
+    std::shared_ptr<const Entry> FindSource(const std::shared_ptr<PixelData>& pixels);
+    void RememberSource(const std::shared_ptr<PixelData>& pixels, const std::shared_ptr<const Entry>& entry);
+
+    static std::shared_ptr<const Entry> Compress(const PixelData& pixels);
+    static std::shared_ptr<PixelData> Decompress(const Entry& entry);
+
+    static constexpr size_t kBandBytes = 1024 * 1024;
+    static constexpr int kMaxPendingStores = 16;    // Evicted frames held for compression at most
+    static constexpr size_t kMaxSources = 4096;
+
+    ShardedLRU<int, std::shared_ptr<const Entry>> entries_;
+    std::atomic<bool> enabled_{false};
+    std::atomic<uint64_t> epoch_{0};                 // Bumped by Clear() - queued stores drop out
+
+    std::mutex sourcesMutex_;
+    std::unordered_map<const PixelData*, Source> sources_;
+
+    // Queued compressions (the destructor waits for them)
+    std::mutex pendingMutex_;
+    std::condition_variable pendingCv_;
+    int pending_ = 0;
+
+    mutable std::mutex statsMutex_;
+    uint64_t storedRawBytes_ = 0;
+    uint64_t storedBytes_ = 0;
+    uint64_t stored_ = 0;
+    uint64_t dropped_ = 0;
+    uint64_t hits_ = 0;
+    double avgCompressMs_ = 0.0;
+    double avgDecompressMs_ = 0.0;
+};
+
+} // namespace ump
@@ -14,6 +14,15 @@
 #include <ImfThreading.h>
 
 #include <algorithm>
+#include <filesystem>
+#include <unordered_map>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
 
 namespace ump {
 
@@ -68,8 +77,32 @@ MemoryMappedIStream::MemoryMappedIStream(const std::string& fileName)
     range.NumberOfBytes = fileSize_;
     PrefetchVirtualMemory(GetCurrentProcess(), 1, &range, 0);
 #else
-    // TODO: Linux mmap implementation
-    throw std::runtime_error("Memory-mapped files not implemented on this platform");
+    fd_ = ::open(fileName.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd_ < 0) {
+        throw std::runtime_error("Cannot open file: " + fileName);
+    }
+
+    struct stat st;
+    if (::fstat(fd_, &st) != 0) {
+        ::close(fd_);
+        throw std::runtime_error("Cannot get file size: " + fileName);
+    }
+    fileSize_ = static_cast<uint64_t>(st.st_size);
+
+    // Empty file: nothing to map, every read throws "past end of file"
+    if (fileSize_ > 0) {
+        void* mapped = ::mmap(nullptr, fileSize_, PROT_READ, MAP_PRIVATE, fd_, 0);
+        if (mapped == MAP_FAILED) {
+            ::close(fd_);
+            throw std::runtime_error("Cannot map file: " + fileName);
+        }
+        mappedData_ = static_cast<char*>(mapped);
+
+        // Decoders read front to back once: aggressive read-ahead, and pages
+        // behind the read position may be reclaimed early
+        ::madvise(mappedData_, fileSize_, MADV_SEQUENTIAL);
+        ::madvise(mappedData_, fileSize_, MADV_WILLNEED);
+    }
 #endif
 }
 
@@ -78,6 +111,9 @@ MemoryMappedIStream::~MemoryMappedIStream() {
     if (mappedData_) UnmapViewOfFile(mappedData_);
     if (hMapping_) CloseHandle(hMapping_);
     if (hFile_ != INVALID_HANDLE_VALUE) CloseHandle(hFile_);
+#else
+    if (mappedData_) ::munmap(mappedData_, fileSize_);
+    if (fd_ >= 0) ::close(fd_);
 #endif
 }
 
@@ -107,10 +143,282 @@ void MemoryMappedIStream::seekg(uint64_t pos) {
     currentPos_ = pos;
 }
 
+//=============================================================================
+// MemoryIStream Implementation
+//=============================================================================
+
+MemoryIStream::MemoryIStream(const std::string& fileName, const uint8_t* data, size_t size)
+    : Imf::IStream(fileName.c_str())
+    , data_(reinterpret_cast<char*>(const_cast<uint8_t*>(data)))
+    , size_(size)
+{
+}
+
+char* MemoryIStream::readMemoryMapped(int n) {
+    if (currentPos_ + n > size_) {
+        throw std::runtime_error("Read past end of file");
+    }
+    char* ptr = data_ + currentPos_;
+    currentPos_ += n;
+    return ptr;
+}
+
+bool MemoryIStream::read(char c[], int n) {
+    if (currentPos_ + n > size_) {
+        throw std::runtime_error("Read past end of file");
+    }
+    std::memcpy(c, data_ + currentPos_, n);
+    currentPos_ += n;
+    return currentPos_ < size_;
+}
+
+uint64_t MemoryIStream::tellg() {
+    return currentPos_;
+}
+
+void MemoryIStream::seekg(uint64_t pos) {
+    currentPos_ = pos;
+}
+
+std::unique_ptr<Imf::IStream> OpenFrameStream(const std::string& path, FileBytes& bytes,
+                                              const CancelToken& cancel) {
+    FrameFileReader& reader = FrameFileReader::Shared();
+    if (!reader.ReadsIntoMemory()) {
+        return std::make_unique<MemoryMappedIStream>(path);
+    }
+    if (!reader.ReadFile(path, bytes, cancel)) {
+        throw std::runtime_error("Cannot read file: " + path);
+    }
+    return std::make_unique<MemoryIStream>(path, bytes.data(), bytes.size());
+}
+
+//=============================================================================
+// Chunk-aligned scanline ranges
+//=============================================================================
+
+int EXRReadRangeLines(Imf::Compression compression) {
+    const int minLines = 64;
+    const int chunkLines = (std::max)(1, Imf::getCompressionNumScanlines(compression));
+    return ((minLines + chunkLines - 1) / chunkLines) * chunkLines;
+}
+
+namespace {
+    // Aligned ranges covering [yMin, yMax]
+    std::vector<std::pair<int, int>> EXRRanges(int yMin, int yMax, int dataWindowMinY, int rangeLines) {
+        std::vector<std::pair<int, int>> ranges;
+        for (int y = yMin; y <= yMax; ) {
+            const int yEnd = (std::min)(EXRAlignedRangeEnd(y, dataWindowMinY, rangeLines), yMax);
+            ranges.emplace_back(y, yEnd);
+            y = yEnd + 1;
+        }
+        return ranges;
+    }
+
+    // Runs read(part, slot, index) for every range: serially on 'part', or
+    // over idle workers when this thread has a helper budget. Helpers open
+    // their own part on first use; slot 0 is always the caller's 'part'.
+    using EXRRangeRead = std::function<void(Imf::InputPart& part, size_t slot, int index)>;
+
+    bool ForEachEXRRange(Imf::InputPart& part, const std::string& path, const FileBytes& bytes,
+                         int rangeCount, const CancelToken& cancel,
+                         const std::function<void(Imf::InputPart& part)>& prepareHelper,
+                         const EXRRangeRead& read) {
+        const size_t helpers = TaskScheduler::GetThreadHelperBudget();
+        if (helpers == 0 || rangeCount < 2) {
+            for (int index = 0; index < rangeCount; ++index) {
+                if (cancel.IsCancelled()) return false;
+                read(part, 0, index);
+            }
+            return true;
+        }
+
+        struct HelperPart {
+            std::unique_ptr<Imf::IStream> stream;
+            std::unique_ptr<Imf::MultiPartInputFile> file;
+            std::unique_ptr<Imf::InputPart> part;
+        };
+        std::vector<HelperPart> helperParts(helpers + 1);
+
+        TaskScheduler::Shared().ParallelFor(TaskPriority::PlaybackCritical, rangeCount, helpers,
+            [&](int index, size_t slot) {
+                if (cancel.IsCancelled()) return;
+                if (slot == 0) {
+                    read(part, 0, index);
+                    return;
+                }
+                HelperPart& helper = helperParts[slot];
+                if (!helper.part) {
+                    if (bytes.empty()) {
+                        helper.stream = std::make_unique<MemoryMappedIStream>(path);
+                    } else {
+                        helper.stream = std::make_unique<MemoryIStream>(path, bytes.data(), bytes.size());
+                    }
+                    helper.file = std::make_unique<Imf::MultiPartInputFile>(*helper.stream);
+                    helper.part = std::make_unique<Imf::InputPart>(*helper.file, 0);
+                    prepareHelper(*helper.part);
+                }
+                read(*helper.part, slot, index);
+            });
+        return !cancel.IsCancelled();
+    }
+}
+
+bool EXRReadRanges(Imf::InputPart& part, const Imf::FrameBuffer& frameBuffer,
+                   const std::string& path, const FileBytes& bytes,
+                   int yMin, int yMax, int dataWindowMinY, Imf::Compression compression,
+                   const CancelToken& cancel) {
+    const auto ranges = EXRRanges(yMin, yMax, dataWindowMinY, EXRReadRangeLines(compression));
+    return ForEachEXRRange(part, path, bytes, static_cast<int>(ranges.size()), cancel,
+        [&](Imf::InputPart& helper) { helper.setFrameBuffer(frameBuffer); },
+        [&](Imf::InputPart& target, size_t, int index) {
+            target.readPixels(ranges[index].first, ranges[index].second);
+        });
+}
+
+bool EXRStoredRegion(const Imath::Box2i& displayWindow, const Imath::Box2i& dataWindow, Imath::Box2i& region) {
+    const Imath::Box2i inter(
+        Imath::V2i((std::max)(displayWindow.min.x, dataWindow.min.x),
+                   (std::max)(displayWindow.min.y, dataWindow.min.y)),
+        Imath::V2i((std::min)(displayWindow.max.x, dataWindow.max.x),
+                   (std::min)(displayWindow.max.y, dataWindow.max.y)));
+    if (inter.min.x > inter.max.x || inter.min.y > inter.max.y) {
+        return false;
+    }
+    region = inter;
+    return true;
+}
+
+bool EXRReadWindow(Imf::InputPart& part, const EXRSliceInserter& insertSlices, size_t pixelBytes,
+                   const Imath::Box2i& displayWindow, const Imath::Box2i& dataWindow,
+                   const std::vector<EXRPlane>& planes,
+                   const std::string& path, const FileBytes& bytes, Imf::Compression compression,
+                   const CancelToken& cancel, int rangeLines) {
+    const Imath::Box2i inter(
+        Imath::V2i((std::max)(displayWindow.min.x, dataWindow.min.x),
+                   (std::max)(displayWindow.min.y, dataWindow.min.y)),
+        Imath::V2i((std::min)(displayWindow.max.x, dataWindow.max.x),
+                   (std::min)(displayWindow.max.y, dataWindow.max.y)));
+    const bool overlaps = inter.min.x <= inter.max.x && inter.min.y <= inter.max.y;
+
+    // Padding outside the data window first; the reads below only touch the
+    // intersection, so the two never overlap (nothing to do when the windows match)
+    const int width = displayWindow.max.x - displayWindow.min.x + 1;
+    auto bytesOf = [pixelBytes](const EXRPlane& plane) { return plane.pixelBytes ? plane.pixelBytes : pixelBytes; };
+    if (displayWindow != dataWindow) {
+        for (const EXRPlane& plane : planes) {
+            const size_t pixelBytes = bytesOf(plane);
+            auto fillPadding = [&](uint8_t* p, int pixels) {
+                for (int i = 0; i < pixels; ++i) {
+                    std::memcpy(p + i * pixelBytes, plane.padPixel, pixelBytes);
+                }
+            };
+            for (int y = displayWindow.min.y; y <= displayWindow.max.y; ++y) {
+                uint8_t* row = plane.dest + static_cast<size_t>(y - displayWindow.min.y) * plane.stride;
+                if (!overlaps || y < inter.min.y || y > inter.max.y) {
+                    fillPadding(row, width);
+                    continue;
+                }
+                fillPadding(row, inter.min.x - displayWindow.min.x);
+                fillPadding(row + static_cast<size_t>(inter.max.x - displayWindow.min.x + 1) * pixelBytes,
+                            displayWindow.max.x - inter.max.x);
+            }
+        }
+    }
+    if (!overlaps) {
+        return !cancel.IsCancelled();
+    }
+
+    // Data window inside the display window horizontally: decode straight into
+    // the planes (origin at the display window min)
+    const bool direct = rangeLines == 0 &&
+                        dataWindow.min.x >= displayWindow.min.x && dataWindow.max.x <= displayWindow.max.x;
+    if (direct) {
+        Imf::FrameBuffer frameBuffer;
+        for (size_t p = 0; p < planes.size(); ++p) {
+            char* base = reinterpret_cast<char*>(planes[p].dest)
+                       - static_cast<ptrdiff_t>(displayWindow.min.x) * static_cast<ptrdiff_t>(bytesOf(planes[p]))
+                       - static_cast<ptrdiff_t>(displayWindow.min.y) * static_cast<ptrdiff_t>(planes[p].stride);
+            insertSlices(frameBuffer, p, base, planes[p].stride);
+        }
+        part.setFrameBuffer(frameBuffer);
+        return EXRReadRanges(part, frameBuffer, path, bytes, inter.min.y, inter.max.y,
+                             dataWindow.min.y, compression, cancel);
+    }
+
+    // Overscan: decode each range into a block buffer the width of the data
+    // window (one block per plane), then copy the visible span of its rows
+    const int lines = rangeLines > 0 ? rangeLines : EXRReadRangeLines(compression);
+    const auto ranges = EXRRanges(inter.min.y, inter.max.y, dataWindow.min.y, lines);
+
+    // Per-plane geometry (planes may differ in pixel size)
+    struct PlaneBlock {
+        size_t offset = 0;       // Into the block buffer
+        size_t rowBytes = 0;     // Data window row
+        size_t copyBytes = 0;
+        size_t srcOffset = 0;
+        size_t dstOffset = 0;
+    };
+    std::vector<PlaneBlock> planeBlocks(planes.size());
+    size_t blockBytes = 0;
+    for (size_t p = 0; p < planes.size(); ++p) {
+        const size_t planeBytes = bytesOf(planes[p]);
+        PlaneBlock& pb = planeBlocks[p];
+        pb.offset = blockBytes;
+        pb.rowBytes = static_cast<size_t>(dataWindow.max.x - dataWindow.min.x + 1) * planeBytes;
+        pb.copyBytes = static_cast<size_t>(inter.max.x - inter.min.x + 1) * planeBytes;
+        pb.srcOffset = static_cast<size_t>(inter.min.x - dataWindow.min.x) * planeBytes;
+        pb.dstOffset = static_cast<size_t>(inter.min.x - displayWindow.min.x) * planeBytes;
+        blockBytes += (pb.rowBytes * lines + 63) & ~size_t(63);  // Keep each plane 64-byte aligned
+    }
+
+    std::vector<std::vector<char, AlignedAllocator<char, 64>>> blocks(TaskScheduler::GetThreadHelperBudget() + 1);
+
+    return ForEachEXRRange(part, path, bytes, static_cast<int>(ranges.size()), cancel,
+        [](Imf::InputPart&) {},
+        [&](Imf::InputPart& target, size_t slot, int index) {
+            const int y0 = ranges[index].first;
+            const int y1 = ranges[index].second;
+            auto& block = blocks[slot];
+            block.resize(blockBytes);
+
+            Imf::FrameBuffer frameBuffer;
+            for (size_t p = 0; p < planes.size(); ++p) {
+                const PlaneBlock& pb = planeBlocks[p];
+                char* base = block.data() + pb.offset
+                           - static_cast<ptrdiff_t>(dataWindow.min.x) * static_cast<ptrdiff_t>(bytesOf(planes[p]))
+                           - static_cast<ptrdiff_t>(y0) * static_cast<ptrdiff_t>(pb.rowBytes);
+                insertSlices(frameBuffer, p, base, pb.rowBytes);
+            }
+            target.setFrameBuffer(frameBuffer);
+            target.readPixels(y0, y1);
+
+            for (size_t p = 0; p < planes.size(); ++p) {
+                const PlaneBlock& pb = planeBlocks[p];
+                const char* planeBlock = block.data() + pb.offset;
+                for (int y = y0; y <= y1; ++y) {
+                    std::memcpy(planes[p].dest + static_cast<size_t>(y - displayWindow.min.y) * planes[p].stride + pb.dstOffset,
+                                planeBlock + static_cast<size_t>(y - y0) * pb.rowBytes + pb.srcOffset,
+                                pb.copyBytes);
+                }
+            }
+        });
+}
+
 //=============================================================================
 // DirectEXRCache Implementation
 //=============================================================================
 
+namespace {
+    // Drop one frame's reference to a texture; identical frames share one,
+    // and the last reference queues the GL texture for release
+    void DropTextureRef(std::shared_ptr<EXRTexture>& texture, std::vector<GLuint>& released) {
+        if (texture && texture.use_count() == 1 && texture->texture_id != 0) {
+            released.push_back(texture->texture_id);
+        }
+        texture.reset();
+    }
+}
+
 DirectEXRCache::DirectEXRCache() {
     Debug::Log("DirectEXRCache: Constructor - starting permanent background threads");
 
@@ -120,6 +428,14 @@ DirectEXRCache::DirectEXRCache() {
     // This prevents thread over-subscription: 8 files * 1 thread = 8 threads total
     Imf::setGlobalThreadCount(0);
 
+    ApplyConcurrencyConfig();
+
+    // Budget evictions go to the compressed tier (no-op while it is off)
+    pixelCache_.SetEvictionCallback([this](const int& frame, const std::shared_ptr<PixelData>& pixels) {
+        ReleaseFrameBuffer(frame, pixels.get());
+        coldCache_.Store(frame, pixels);
+    });
+
     // The pixelCache_ just holds shared_ptrs to PixelData - automatic cleanup via shared_ptr
     // Threads wait idle until a sequence is loaded
     cacheRunning_ = true;
@@ -170,17 +486,32 @@ DirectEXRCache::~DirectEXRCache() {
         Debug::Log("DirectEXRCache: I/O worker thread was not running");
     }
 
-    // Clean up GL textures before clearing cache
-    Debug::Log("DirectEXRCache: Deleting GL textures...");
-    int texture_count = 0;
-    for (auto& pair : glTextureCache_) {
-        if (pair.second && pair.second->texture_id != 0) {
-            glDeleteTextures(1, &pair.second->texture_id);
-            texture_count++;
+    // Load tasks run on the shared scheduler and capture 'this' - wait for them
+    {
+        std::unique_lock<std::mutex> lock(ioTasksMutex_);
+        if (ioTasksInFlight_ > 0) {
+            Debug::Log("DirectEXRCache: Waiting for " + std::to_string(ioTasksInFlight_.load()) + " in-flight load tasks...");
         }
+        ioTasksCv_.wait(lock, [this] { return ioTasksInFlight_ == 0; });
+    }
+
+    // Clean up GL textures before clearing cache (uploader recycles/deletes them)
+    Debug::Log("DirectEXRCache: Releasing GL textures...");
+    std::vector<GLuint> released;
+    for (auto& pair : glTextureCache_) {
+        DropTextureRef(pair.second, released);
     }
+    const int texture_count = static_cast<int>(released.size());
+    for (GLuint texture : released) {
+        TextureUploader::Shared().ReleaseTexture(texture);
+    }
+    for (GLuint texture : texturesToDelete_) {
+        TextureUploader::Shared().ReleaseTexture(texture);
+    }
+    texturesToDelete_.clear();
     glTextureCache_.clear();
-    Debug::Log("DirectEXRCache: Deleted " + std::to_string(texture_count) + " GL textures");
+    stagedUploads_.clear();
+    Debug::Log("DirectEXRCache: Released " + std::to_string(texture_count) + " GL textures");
 
     Debug::Log("DirectEXRCache: Clearing pixel cache...");
     pixelCache_.Clear();
@@ -200,6 +531,12 @@ bool DirectEXRCache::Initialize(const std::vector<std::string>& files,
         return false;
     }
 
+    // Same sequence, another cached layer: swap the layer caches instead of reloading
+    if (initialized_ && config_.multiLayerCache && files == sequenceFiles_ &&
+        start_frame == startFrame_ && layer != layerName_ && SwitchLayer(layer, fps)) {
+        return true;
+    }
+
     Debug::Log("DirectEXRCache: [INIT] Loading new sequence (" + std::to_string(files.size()) + " frames, start frame: " + std::to_string(start_frame) + ")");
 
     auto clear_start = std::chrono::steady_clock::now();
@@ -207,20 +544,23 @@ bool DirectEXRCache::Initialize(const std::vector<std::string>& files,
     {
         std::lock_guard<std::mutex> lock(mutex_);
         videoRequests_.clear();
-        requestsInProgress_.clear();
+        CancelInProgressLocked();
+        seekPending_ = false;
     }
     {
         std::lock_guard<std::mutex> lock(textureMutex_);
-        texturesToDelete_.clear();
-        // Clean up GL textures
+        // Clean up GL textures (already-queued deletions stay queued)
         for (auto& pair : glTextureCache_) {
-            if (pair.second && pair.second->texture_id != 0) {
-                texturesToDelete_.push_back(pair.second->texture_id);
-            }
+            DropTextureRef(pair.second, texturesToDelete_);
         }
         glTextureCache_.clear();
+        stagedUploads_.clear();  // Load tasks were cancelled above - nothing re-stages
     }
     pixelCache_.Clear();
+    coldCache_.Clear();
+    dedupIndex_.Clear();
+    ClearFrameBuffers();
+    ClearLayerCaches();
     segmentsDirty_ = true;  // Segments invalid after clear
     auto clear_end = std::chrono::steady_clock::now();
     auto clear_ms = std::chrono::duration_cast<std::chrono::milliseconds>(clear_end - clear_start).count();
@@ -231,8 +571,27 @@ bool DirectEXRCache::Initialize(const std::vector<std::string>& files,
     fps_ = fps;
     startFrame_ = start_frame;
 
-    // Set cache size
-    pixelCache_.SetMaxSize(static_cast<size_t>(config_.cacheGB * 1024 * 1024 * 1024));
+    // Fresh measurements; seed the frame size from the first file's header
+    planner_.Reset(QueryFrameBytes(files[0]));
+    ioConcurrency_.Reset();  // New sequence may live on different storage
+    prefetcher_.Reset();
+
+    // Cached layers, then the cache size (split across them)
+    BuildLayerSet();
+
+    // Mipmapped sequences: level picked from the on-screen size (SetDisplaySize)
+    resolutionLevels_ = 1;
+    frameWidth_ = 0;
+    frameHeight_ = 0;
+    zoomLevel_ = 0;
+    if (loader_) {
+        FrameLayout layout;
+        if (loader_->QueryFrameLayout(files[0], layer, pipelineMode_, layout)) {
+            frameWidth_ = layout.width;
+            frameHeight_ = layout.height;
+            resolutionLevels_ = loader_->GetResolutionLevels(files[0]);
+        }
+    }
 
     initialized_ = true;
 
@@ -272,24 +631,24 @@ void DirectEXRCache::Shutdown() {
     {
         std::lock_guard<std::mutex> lock(mutex_);
         videoRequests_.clear();
-        requestsInProgress_.clear();
-    }
-    {
-        std::lock_guard<std::mutex> lock(textureMutex_);
-        texturesToDelete_.clear();
+        CancelInProgressLocked();
+        seekPending_ = false;
     }
     // Clean up GL texture cache
     {
         std::lock_guard<std::mutex> lock(textureMutex_);
         for (auto& pair : glTextureCache_) {
-            if (pair.second && pair.second->texture_id != 0) {
-                texturesToDelete_.push_back(pair.second->texture_id);
-            }
+            DropTextureRef(pair.second, texturesToDelete_);
         }
         glTextureCache_.clear();
+        stagedUploads_.clear();
     }
 
     pixelCache_.Clear();
+    coldCache_.Clear();
+    dedupIndex_.Clear();
+    ClearFrameBuffers();
+    ClearLayerCaches();
 
     initialized_ = false;
     sequenceFiles_.clear();
@@ -302,8 +661,8 @@ void DirectEXRCache::RequestFrame(int frame) {
 
     std::lock_guard<std::mutex> lock(mutex_);
 
-    // Already in cache?
-    if (pixelCache_.Contains(frame)) {
+    // Already in cache (at the current draft level or finer)?
+    if (IsCachedAtLevel(frame, GetLoadLevel())) {
         return;
     }
 
@@ -336,49 +695,98 @@ GLuint DirectEXRCache::GetTexture(int frame, int& width, int& height) {
     // Step 2: Check if we already have a GL texture for this frame
     {
         std::lock_guard<std::mutex> lock(textureMutex_);
+        // A draft texture whose pixels were since replaced gets uploaded again
         auto it = glTextureCache_.find(frame);
-        if (it != glTextureCache_.end() && it->second && it->second->texture_id != 0) {
-            width = it->second->width;
-            height = it->second->height;
+        if (it != glTextureCache_.end() && it->second && it->second->texture_id != 0 &&
+            it->second->width == pixels->width && it->second->height == pixels->height) {
+            width = pixels->DisplayWidth();
+            height = pixels->DisplayHeight();
             return it->second->texture_id;  // Return existing GL texture
         }
+
+        // Identical frame sharing these pixels already uploaded - share its texture
+        if (auto shared = FindTextureLocked(pixels)) {
+            InsertTextureLocked(frame, shared, frame);
+            width = pixels->DisplayWidth();
+            height = pixels->DisplayHeight();
+            return shared->texture_id;
+        }
     }
 
-    // Step 3: Create GL texture on-demand from pixel data
-    GLuint texId = CreateGLTexture(pixels);
+    // Step 3: Displayed frame can't wait for the budget - upload it now,
+    // from the PBO ring if its load task staged it, else from the pixel cache
+    std::shared_ptr<StagedUpload> staged;
+    {
+        std::lock_guard<std::mutex> lock(textureMutex_);
+        auto it = stagedUploads_.find(frame);
+        if (it != stagedUploads_.end()) {
+            staged = std::move(it->second);
+            stagedUploads_.erase(it);
+        }
+    }
+    if (staged && (staged->Format().width != pixels->width || staged->Format().height != pixels->height)) {
+        staged.reset();  // Staged at another draft level than the cached pixels
+    }
+
+    TextureUploader& uploader = TextureUploader::Shared();
+    GLuint texId = staged ? uploader.Upload(staged)
+                          : uploader.UploadNow(GetUploadFormat(*pixels), pixels->pixels.data());
     if (texId == 0) {
         width = 0;
         height = 0;
         return 0;
     }
 
-    // Step 4: Add to GL texture cache (with LRU eviction)
+    // Step 4: Add to GL texture cache (evicts the texture farthest from this frame)
     {
         std::lock_guard<std::mutex> lock(textureMutex_);
+        InsertTextureLocked(frame, texId, pixels, frame);
+        // Display size: a draft texture is stretched over the full frame
+        width = pixels->DisplayWidth();
+        height = pixels->DisplayHeight();
+    }
+
+    return texId;
+}
+
+void DirectEXRCache::InsertTextureLocked(int frame, GLuint texture, const std::shared_ptr<PixelData>& pixels, int anchor) {
+    auto tex = std::make_shared<EXRTexture>();
+    tex->texture_id = texture;
+    tex->width = pixels->width;
+    tex->height = pixels->height;
+    tex->byteCount = pixels->pixels.size();  // Already in bytes
+    tex->source = pixels;
+    InsertTextureLocked(frame, std::move(tex), anchor);
+}
+
+void DirectEXRCache::InsertTextureLocked(int frame, std::shared_ptr<EXRTexture> texture, int anchor) {
+    auto existing = glTextureCache_.find(frame);
+    if (existing != glTextureCache_.end()) {
+        DropTextureRef(existing->second, texturesToDelete_);
+        glTextureCache_.erase(existing);
+    }
 
-        // Evict oldest GL texture if cache is full
-        if (glTextureCache_.size() >= MAX_GL_TEXTURE_CACHE) {
-            // Find oldest (assuming map order, but we should really track access time)
-            auto oldest = glTextureCache_.begin();
-            if (oldest->second && oldest->second->texture_id != 0) {
-                texturesToDelete_.push_back(oldest->second->texture_id);
+    if (glTextureCache_.size() >= MAX_GL_TEXTURE_CACHE) {
+        auto farthest = glTextureCache_.begin();
+        for (auto it = glTextureCache_.begin(); it != glTextureCache_.end(); ++it) {
+            if (std::abs(it->first - anchor) > std::abs(farthest->first - anchor)) {
+                farthest = it;
             }
-            glTextureCache_.erase(oldest);
         }
+        DropTextureRef(farthest->second, texturesToDelete_);
+        glTextureCache_.erase(farthest);
+    }
 
-        // Add new texture to cache
-        auto tex = std::make_shared<EXRTexture>();
-        tex->texture_id = texId;
-        tex->width = pixels->width;
-        tex->height = pixels->height;
-        tex->byteCount = pixels->pixels.size();  // Already in bytes
-        glTextureCache_[frame] = tex;
+    glTextureCache_[frame] = std::move(texture);
+}
 
-        width = pixels->width;
-        height = pixels->height;
+std::shared_ptr<EXRTexture> DirectEXRCache::FindTextureLocked(const std::shared_ptr<PixelData>& pixels) const {
+    for (const auto& pair : glTextureCache_) {
+        if (pair.second && pair.second->texture_id != 0 && pair.second->source.lock() == pixels) {
+            return pair.second;
+        }
     }
-
-    return texId;
+    return nullptr;
 }
 
 bool DirectEXRCache::GetFrameOrLoad(int frame, GLuint& texture, int& width, int& height) {
@@ -416,6 +824,15 @@ void DirectEXRCache::UpdateCurrentPosition(double timestamp) {
     if (isSeek) {
         Debug::Log("DirectEXRCache: [SEEK DETECTED] Canceling all in-flight requests");
         ClearRequests();
+
+        // Start the time-to-first-frame clock for the new playhead
+        std::lock_guard<std::mutex> lock(mutex_);
+        seekPending_ = true;
+        seekTargetFrame_ = current_frame;
+        seekStartTime_ = std::chrono::steady_clock::now();
+        if (pixelCache_.Contains(current_frame)) {
+            RecordSeekFirstFrameLocked();  // Already cached - 0ms
+        }
     }
 
     // Wake up cache thread immediately (don't wait for next tick)
@@ -435,8 +852,8 @@ bool DirectEXRCache::GetFrameDimensions(int& width, int& height) const {
     if (!keys.empty()) {
         std::shared_ptr<PixelData> pixels;
         if (pixelCache_.Get(keys[0], pixels)) {
-            width = pixels->width;
-            height = pixels->height;
+            width = pixels->DisplayWidth();
+            height = pixels->DisplayHeight();
             return true;
         }
     }
@@ -449,11 +866,8 @@ bool DirectEXRCache::GetFrameDimensions(int& width, int& height) const {
 
 bool DirectEXRCache::GetFrameDimensions(const std::string& filePath, int& width, int& height) {
     try {
-        auto stream = std::make_unique<MemoryMappedIStream>(filePath);
-        Imf::MultiPartInputFile file(*stream);
-
-        const Imf::Header& header = file.header(0);
-        Imath::Box2i dw = header.dataWindow();
+        // Cached per sequence - only the first query parses a header
+        const Imath::Box2i dw = EXRLayoutCache::Shared().Get(filePath)->data_window;
 
         width = dw.max.x - dw.min.x + 1;
         height = dw.max.y - dw.min.y + 1;
@@ -465,35 +879,202 @@ bool DirectEXRCache::GetFrameDimensions(const std::string& filePath, int& width,
     }
 }
 
+//=============================================================================
+// Windowed-read benchmark
+//=============================================================================
+
+namespace {
+    // Decode time of the display window of 'bytes' in ranges of rangeLines
+    // (0 = chunk-aligned). Returns -1 for files without a data/display mismatch.
+    double TimeWindowRead(const std::string& path, const FileBytes& bytes, const std::string& layer,
+                          int rangeLines) {
+        MemoryIStream stream(path, bytes.data(), bytes.size());
+        Imf::MultiPartInputFile file(stream);
+        const Imf::Header& header = file.header(0);
+        const Imath::Box2i displayWindow = header.displayWindow();
+        const Imath::Box2i dataWindow = header.dataWindow();
+        if (displayWindow == dataWindow) {
+            return -1.0;
+        }
+
+        const std::string prefix = (!layer.empty() && header.channels().findChannel(layer + ".R")) ? layer + "." : "";
+        const char* names[4] = { "R", "G", "B", "A" };
+        const size_t cb = 4 * sizeof(half);
+        auto insertSlices = [&](Imf::FrameBuffer& fb, size_t, char* base, size_t yStride) {
+            for (int c = 0; c < 4; ++c) {
+                fb.insert((prefix + names[c]).c_str(),
+                          Imf::Slice(Imf::HALF, base + c * sizeof(half), cb, yStride, 1, 1, c == 3 ? 1.0 : 0.0));
+            }
+        };
+
+        const int width = displayWindow.max.x - displayWindow.min.x + 1;
+        const int height = displayWindow.max.y - displayWindow.min.y + 1;
+        std::vector<uint8_t> dest(static_cast<size_t>(width) * height * cb);
+        const uint8_t padPixel[4 * sizeof(half)] = {};
+
+        Imf::InputPart part(file, 0);
+        const auto start = std::chrono::steady_clock::now();
+        EXRReadWindow(part, insertSlices, cb, displayWindow, dataWindow, {{dest.data(), width * cb, padPixel}},
+                      path, bytes, header.compression(), CancelToken(), rangeLines);
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+}
+
+void DirectEXRCache::StartWindowReadBenchmark(int maxFiles) {
+    auto state = windowBenchmark_;
+    if (state->running.exchange(true)) {
+        return;
+    }
+
+    std::vector<std::string> files = sequenceFiles_;
+    files.resize((std::min)(files.size(), static_cast<size_t>((std::max)(maxFiles, 0))));
+    const std::string layer = layerName_;
+
+    TaskScheduler::Shared().Post(TaskPriority::Metadata, [state, files = std::move(files), layer]() {
+        WindowReadBenchmark result;
+        result.ok = true;
+        for (const std::string& path : files) {
+            try {
+                // Read once; both passes decode from the same bytes
+                FileBytes bytes;
+                if (!FrameFileReader::Shared().ReadFile(path, bytes, ReadBackend::PRead, false)) {
+                    result.ok = false;
+                    continue;
+                }
+                result.files++;
+                const double scanlineMs = TimeWindowRead(path, bytes, layer, 1);
+                if (scanlineMs < 0.0) {
+                    continue;
+                }
+                result.windowedFiles++;
+                result.scanlineMs += scanlineMs;
+                result.blockMs += TimeWindowRead(path, bytes, layer, 0);
+            } catch (const std::exception& e) {
+                Debug::Log("DirectEXRCache: Window read benchmark failed on " + path + " - " + e.what());
+                result.ok = false;
+            }
+        }
+
+        Debug::Log("DirectEXRCache: Window read benchmark - " + std::to_string(result.windowedFiles) + "/" +
+                   std::to_string(result.files) + " windowed files, per-scanline " +
+                   std::to_string(static_cast<int>(result.scanlineMs)) + "ms, blocks " +
+                   std::to_string(static_cast<int>(result.blockMs)) + "ms");
+        {
+            std::lock_guard<std::mutex> lock(state->mutex);
+            state->result = result;
+        }
+        state->running = false;
+    });
+}
+
+DirectEXRCache::WindowReadBenchmark DirectEXRCache::GetWindowReadBenchmark() const {
+    std::lock_guard<std::mutex> lock(windowBenchmark_->mutex);
+    return windowBenchmark_->result;
+}
+
+void DirectEXRCache::StartLRUBenchmark() {
+    auto state = lruBenchmark_;
+    if (state->running.exchange(true)) {
+        return;
+    }
+
+    // I/O thread, cache thread, main thread and one load worker
+    const int entries = (std::max)(static_cast<int>(pixelCache_.GetCount()), 1024);
+    TaskScheduler::Shared().Post(TaskPriority::Metadata, [state, entries]() {
+        const LRUBenchmarkResult result = RunLRUBenchmark(entries, 4, 20000);
+
+        Debug::Log("DirectEXRCache: LRU benchmark - " + std::to_string(result.operations) + " ops on " +
+                   std::to_string(result.entries) + " frames, map + list " +
+                   std::to_string(static_cast<int>(result.listMs)) + "ms, sharded " +
+                   std::to_string(static_cast<int>(result.shardedMs)) + "ms");
+        {
+            std::lock_guard<std::mutex> lock(state->mutex);
+            state->result = result;
+        }
+        state->running = false;
+    });
+}
+
+LRUBenchmarkResult DirectEXRCache::GetLRUBenchmark() const {
+    std::lock_guard<std::mutex> lock(lruBenchmark_->mutex);
+    return lruBenchmark_->result;
+}
+
 void DirectEXRCache::ProcessReadyTextures() {
-    // GL textures created on-demand in GetTexture()
-    // This function now ONLY handles deletion of queued GL textures
+    // Deletes queued GL textures and uploads frames staged by load tasks,
+    // within the uploader's per-frame budget (the displayed frame is still
+    // created on demand in GetTexture())
     // MUST be called from main thread with GL context. I keep forgetting this.
 
-    const int MAX_DELETES_PER_FRAME = 20;
+    TextureUploader& uploader = TextureUploader::Shared();
+
+    // Step 1: Hand queued textures back to the uploader (recycled or deleted next frame)
     std::vector<GLuint> toDelete;
     {
         std::lock_guard<std::mutex> lock(textureMutex_);
-        if (!texturesToDelete_.empty()) {
-            int count = std::min(MAX_DELETES_PER_FRAME, (int)texturesToDelete_.size());
-            toDelete.insert(toDelete.end(),
-                           texturesToDelete_.begin(),
-                           texturesToDelete_.begin() + count);
-            texturesToDelete_.erase(texturesToDelete_.begin(), texturesToDelete_.begin() + count);
-        }
+        toDelete.swap(texturesToDelete_);
+    }
+    for (GLuint texture : toDelete) {
+        uploader.ReleaseTexture(texture);
+    }
+
+    // Step 2: Upload staged frames nearest the playhead first
+    int current_frame;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        current_frame = lastCacheUpdateFrame_;
     }
 
-    if (!toDelete.empty()) {
-        glDeleteTextures(static_cast<GLsizei>(toDelete.size()), toDelete.data());
+    while (uploader.HasFrameBudget()) {
+        int frame = -1;
+        std::shared_ptr<StagedUpload> staged;
+        {
+            std::lock_guard<std::mutex> lock(textureMutex_);
+
+            // Drop frames the playhead has left behind (frees their ring space)
+            for (auto it = stagedUploads_.begin(); it != stagedUploads_.end(); ) {
+                if (std::abs(it->first - current_frame) > kUploadAheadFrames * 2 ||
+                    glTextureCache_.count(it->first) > 0) {
+                    it = stagedUploads_.erase(it);
+                } else {
+                    ++it;
+                }
+            }
+            if (stagedUploads_.empty()) break;
+
+            auto nearest = stagedUploads_.begin();
+            for (auto it = stagedUploads_.begin(); it != stagedUploads_.end(); ++it) {
+                if (std::abs(it->first - current_frame) < std::abs(nearest->first - current_frame)) {
+                    nearest = it;
+                }
+            }
+            frame = nearest->first;
+            staged = std::move(nearest->second);
+            stagedUploads_.erase(nearest);
+        }
+
+        // Evicted from the pixel cache while staged - nothing to show it from
+        // (or replaced at another draft level - GetTexture() uploads that one)
+        std::shared_ptr<PixelData> pixels;
+        if (!pixelCache_.Peek(frame, pixels) || !pixels ||
+            staged->Format().width != pixels->width || staged->Format().height != pixels->height) {
+            continue;
+        }
 
-        int remaining_deletes = 0;
         {
+            // Identical frame already uploaded - share its texture, drop the staged copy
             std::lock_guard<std::mutex> lock(textureMutex_);
-            remaining_deletes = (int)texturesToDelete_.size();
+            if (auto shared = FindTextureLocked(pixels)) {
+                InsertTextureLocked(frame, shared, current_frame);
+                continue;
+            }
         }
 
-        Debug::Log("DirectEXRCache: [TEX-DELETE] Deleted " + std::to_string(toDelete.size()) +
-                   " GL textures (" + std::to_string(remaining_deletes) + " queued)");
+        GLuint texId = uploader.Upload(staged);
+        if (texId == 0) break;
+
+        std::lock_guard<std::mutex> lock(textureMutex_);
+        InsertTextureLocked(frame, texId, pixels, current_frame);
     }
 }
 
@@ -508,16 +1089,163 @@ void DirectEXRCache::ClearRequests() {
 
         videoRequests_.clear();
 
-        // Clear the map and let the futures destruct naturally
-        requestsInProgress_.clear();
+        // Cancel in-flight loads: they stop at their next chunk and free the slot now
+        CancelInProgressLocked();
 
         // Set flag to reset fill counters on next cache update
         // This makes cache fill restart from new seek position
         needsFillReset_ = true;
     }
 
+    // Hints for the old position are useless now - re-hint from the new one
+    prefetcher_.Reset();
+
     Debug::Log("DirectEXRCache: Cleared " + std::to_string(pending) +
-               " pending + " + std::to_string(inProgress) + " in-progress (cache preserved)");
+               " pending + cancelled " + std::to_string(inProgress) + " in-progress (cache preserved)");
+}
+
+void DirectEXRCache::ApplyConcurrencyConfig() {
+    AdaptiveConcurrencyController::Config concurrency;
+    concurrency.enabled = config_.adaptiveConcurrency;
+    concurrency.min_limit = config_.minThreadCount;
+    concurrency.max_limit = config_.threadCount;
+    concurrency.initial_limit = std::min<size_t>(config_.threadCount, 8);
+    ioConcurrency_.SetConfig(concurrency);
+}
+
+size_t DirectEXRCache::QueryFrameBytes(const std::string& path) {
+    if (loader_) {
+        FrameLayout layout;
+        if (loader_->QueryFrameLayout(path, layerName_, pipelineMode_, layout)) {
+            return layout.ByteSize();
+        }
+        return 0;
+    }
+
+    // Legacy EXR path always produces RGBA half
+    int width = 0;
+    int height = 0;
+    if (GetFrameDimensions(path, width, height)) {
+        return static_cast<size_t>(width) * height * 4 * sizeof(half);
+    }
+    return 0;
+}
+
+void DirectEXRCache::ApplyCacheBudget() {
+    // The frame buffer pool's idle buffers come out of the same budget,
+    // so resident frames + recycled buffers never exceed cacheGB
+    const size_t budget = static_cast<size_t>(config_.cacheGB * 1024 * 1024 * 1024);
+    const size_t poolBytes = budget / 16;
+    FrameBufferPool::Shared().SetMaxPooledBytes(poolBytes);
+
+    // The compressed tier has a budget of its own, on top of cacheGB
+    coldCache_.SetMaxBytes(static_cast<size_t>(config_.compressedCacheGB * 1024 * 1024 * 1024));
+
+    // Cached layers share the rest evenly (the planner sizes read-ahead from one share)
+    std::lock_guard<std::mutex> lock(layerMutex_);
+    const size_t layerBytes = (budget - poolBytes) / std::max<size_t>(layerSet_.size(), 1);
+    pixelCache_.SetMaxSize(layerBytes);
+    for (auto& pair : layerCaches_) {
+        pair.second->SetMaxSize(layerBytes);
+    }
+}
+
+void DirectEXRCache::EvictFrame(int frame) {
+    // Atomic with SwitchLayer()'s swap: the frame reaches the compressed tier of its own layer
+    std::lock_guard<std::mutex> lock(layerMutex_);
+    std::shared_ptr<PixelData> pixels;
+    if (pixelCache_.RemoveAndGet(frame, pixels) && pixels) {
+        ReleaseFrameBuffer(frame, pixels.get());
+        coldCache_.Store(frame, std::move(pixels));
+    }
+    ApplyPendingCharges();
+}
+
+size_t DirectEXRCache::TrackFrameBuffer(int frame, const std::shared_ptr<PixelData>& pixels) {
+    std::lock_guard<std::mutex> lock(sharedMutex_);
+    std::vector<int>& frames = bufferFrames_[pixels.get()];
+    frames.push_back(frame);
+    if (frames.size() == 1) {
+        return pixels->pixels.size();
+    }
+    sharedFrames_++;
+    sharedBytes_ += pixels->pixels.size();
+    return sizeof(PixelData);
+}
+
+void DirectEXRCache::ReleaseFrameBuffer(int frame, const PixelData* pixels) {
+    std::lock_guard<std::mutex> lock(sharedMutex_);
+    auto it = bufferFrames_.find(pixels);
+    if (it == bufferFrames_.end()) {
+        return;
+    }
+    std::vector<int>& frames = it->second;
+    auto pos = std::find(frames.begin(), frames.end(), frame);
+    if (pos == frames.end()) {
+        return;
+    }
+    const bool charged = pos == frames.begin();
+    frames.erase(pos);
+    if (frames.empty()) {
+        bufferFrames_.erase(it);
+        return;
+    }
+    sharedFrames_--;
+    sharedBytes_ -= pixels->pixels.size();
+    if (charged) {
+        // Called under a pixelCache_ shard lock (eviction): re-charged by ApplyPendingCharges()
+        pendingCharges_.emplace_back(frames.front(), pixels);
+    }
+}
+
+void DirectEXRCache::ApplyPendingCharges() {
+    // Re-charging can evict, which can queue the next holder's charge
+    for (;;) {
+        std::vector<std::pair<int, const PixelData*>> charges;
+        {
+            std::lock_guard<std::mutex> lock(sharedMutex_);
+            charges.swap(pendingCharges_);
+        }
+        if (charges.empty()) {
+            return;
+        }
+        for (const auto& charge : charges) {
+            std::shared_ptr<PixelData> pixels;
+            if (pixelCache_.Peek(charge.first, pixels) && pixels.get() == charge.second) {
+                pixelCache_.SetBytes(charge.first, pixels->pixels.size());
+            }
+        }
+    }
+}
+
+void DirectEXRCache::ClearFrameBuffers() {
+    std::lock_guard<std::mutex> lock(sharedMutex_);
+    bufferFrames_.clear();
+    pendingCharges_.clear();
+    sharedFrames_ = 0;
+    sharedBytes_ = 0;
+}
+
+void DirectEXRCache::CancelInProgressLocked() {
+    // Futures don't block on destruction - the tasks see the flag and return nullptr
+    for (auto& pair : requestsInProgress_) {
+        pair.second.cancel.Cancel();
+    }
+    requestsInProgress_.clear();
+    seekEpoch_++;
+}
+
+void DirectEXRCache::RecordSeekFirstFrameLocked() {
+    const double ms = std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - seekStartTime_).count();
+
+    seekPending_ = false;
+    seekCount_++;
+    lastSeekFirstFrameMs_ = ms;
+    avgSeekFirstFrameMs_ = (seekCount_ == 1) ? ms : avgSeekFirstFrameMs_ + (ms - avgSeekFirstFrameMs_) * 0.1;
+
+    Debug::Log("DirectEXRCache: [SEEK] First frame " + std::to_string(seekTargetFrame_) +
+               " ready in " + std::to_string(static_cast<int>(ms)) + "ms");
 }
 
 void DirectEXRCache::ClearCache() {
@@ -525,20 +1253,22 @@ void DirectEXRCache::ClearCache() {
     ClearRequests();
 
     // Clear pixel cache
-    auto pixel_keys = pixelCache_.GetKeys();
-    size_t pixel_count = pixel_keys.size();
+    size_t pixel_count = pixelCache_.GetCount();
     pixelCache_.Clear();
+    coldCache_.Clear();
+    dedupIndex_.Clear();
+    ClearFrameBuffers();
+    ClearLayerCaches();
 
     // Clear GL texture cache and queue textures for deletion
     std::vector<GLuint> textures_to_delete;
     {
         std::lock_guard<std::mutex> lock(textureMutex_);
         for (auto& pair : glTextureCache_) {
-            if (pair.second && pair.second->texture_id != 0) {
-                textures_to_delete.push_back(pair.second->texture_id);
-            }
+            DropTextureRef(pair.second, textures_to_delete);
         }
         glTextureCache_.clear();
+        stagedUploads_.clear();
     }
 
     // Queue GL textures for deletion on main thread
@@ -554,6 +1284,226 @@ void DirectEXRCache::ClearCache() {
                " GL textures for deletion");
 }
 
+//=============================================================================
+// Draft playback
+//=============================================================================
+
+void DirectEXRCache::UpdateDraftLevel(const ReadAheadPlanner::Plan& plan, int currentFrame) {
+    bool playing = false;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        playing = isPlaying_;
+    }
+
+    const int level = draftLevel_.load();
+    const auto now = std::chrono::steady_clock::now();
+    int target = level;
+
+    if (!config_.draftPlayback || !playing) {
+        target = 0;  // Paused: every frame in the window gets full resolution
+    } else if (std::chrono::duration<double>(now - draftChangeTime_).count() >= kDraftHoldSeconds) {
+        if (plan.realtimeWarning && level < config_.maxDraftLevel) {
+            target = level + 1;
+        } else if (level > 0 && plan.realtime) {
+            // Caught up: the whole read-ahead window is cached
+            bool filled = true;
+            const int last = std::min(currentFrame + plan.readAheadFrames, static_cast<int>(sequenceFiles_.size()) - 1);
+            for (int frame = currentFrame + 1; frame <= last && filled; ++frame) {
+                filled = pixelCache_.Contains(frame);
+            }
+            if (filled) {
+                target = level - 1;
+            }
+        }
+    }
+
+    if (target != level) {
+        draftLevel_ = target;
+        draftChangeTime_ = now;
+        Debug::Log("DirectEXRCache: [DRAFT] Resolution 1/" + std::to_string(1 << target) +
+                   " (realtime " + std::to_string(plan.realtimeRatio) + "x, " +
+                   (playing ? "playing" : "paused") + ")");
+    }
+}
+
+void DirectEXRCache::SetDisplaySize(int width, int height) {
+    // Coarsest stored level still at least as large as the image on screen
+    int level = 0;
+    if (resolutionLevels_ > 1 && width > 0 && height > 0) {
+        while (level + 1 < resolutionLevels_ &&
+               (frameWidth_ >> (level + 1)) >= width && (frameHeight_ >> (level + 1)) >= height) {
+            level++;
+        }
+    }
+
+    if (zoomLevel_.exchange(level) != level) {
+        Debug::Log("DirectEXRCache: [MIP] Displaying " + std::to_string(width) + "x" + std::to_string(height) +
+                   " - loading mip level " + std::to_string(level));
+        cv_.notify_one();  // Finer frames needed now: refill without waiting for the tick
+    }
+}
+
+bool DirectEXRCache::IsCachedAtLevel(int frame, int level) const {
+    if (!pixelCache_.Contains(frame)) {
+        return false;
+    }
+    std::shared_ptr<PixelData> pixels;
+    return pixelCache_.Peek(frame, pixels) && pixels && pixels->draft_level <= level;
+}
+
+//=============================================================================
+// Multi-layer caching
+//=============================================================================
+
+void DirectEXRCache::BuildLayerSet() {
+    std::vector<std::string> layers;
+    if (config_.multiLayerCache && loader_ && !sequenceFiles_.empty()) {
+        layers = loader_->GetLayers(sequenceFiles_[0]);
+    }
+
+    // Active layer first; a single layer needs no layer caches
+    layers.erase(std::remove(layers.begin(), layers.end(), layerName_), layers.end());
+    layers.insert(layers.begin(), layerName_);
+    if (layers.size() > kMaxCachedLayers) {
+        layers.resize(kMaxCachedLayers);
+    }
+    if (layers.size() == 1) {
+        layers.clear();
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(layerMutex_);
+        layerSet_ = layers;
+        layerCaches_.clear();
+    }
+    ApplyCacheBudget();
+
+    if (!layers.empty()) {
+        Debug::Log("DirectEXRCache: Caching " + std::to_string(layers.size()) + " layers per frame");
+    }
+}
+
+bool DirectEXRCache::SwitchLayer(const std::string& layer, double fps) {
+    {
+        std::lock_guard<std::mutex> lock(layerMutex_);
+        if (std::find(layerSet_.begin(), layerSet_.end(), layer) == layerSet_.end()) {
+            return false;
+        }
+    }
+
+    // One critical section with the I/O worker: in-flight loads still decode for
+    // the old layer order, so they are cancelled (StoreInactiveLayers() can't add
+    // to the caches once they are swapped), and no request for the old layer can
+    // be submitted - or a new-layer result land in the outgoing cache - mid-swap
+    std::string previous;
+    size_t restored = 0;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        videoRequests_.clear();
+        CancelInProgressLocked();
+        seekPending_ = false;
+        needsFillReset_ = true;
+
+        previous = layerName_;
+        layerName_ = layer;
+        fps_ = fps;
+
+        std::lock_guard<std::mutex> layerLock(layerMutex_);
+
+        // Active frames become the old layer's cache, the new layer's cache becomes active
+        auto outgoing = std::make_unique<PixelCache>();
+        outgoing->SetMaxSize(pixelCache_.GetMaxSize());
+        for (int frame : pixelCache_.GetKeys()) {
+            std::shared_ptr<PixelData> pixels;
+            if (pixelCache_.Peek(frame, pixels) && pixels) {
+                outgoing->Add(frame, pixels, pixels->pixels.size());
+            }
+        }
+        pixelCache_.Clear();
+
+        auto incoming = layerCaches_.find(layer);
+        if (incoming != layerCaches_.end()) {
+            for (int frame : incoming->second->GetKeys()) {
+                std::shared_ptr<PixelData> pixels;
+                if (incoming->second->Peek(frame, pixels) && pixels) {
+                    pixelCache_.Add(frame, pixels, pixels->pixels.size());
+                    restored++;
+                }
+            }
+            layerCaches_.erase(incoming);
+        }
+        layerCaches_[previous] = std::move(outgoing);
+
+        layerSet_.erase(std::find(layerSet_.begin(), layerSet_.end(), layer));
+        layerSet_.insert(layerSet_.begin(), layer);
+
+        // The compressed tier and the dedup index hold the active layer only. Cleared
+        // after the swap: EvictFrame() moves a frame under layerMutex_, so no old-layer
+        // frame can be stored once this runs
+        coldCache_.Clear();
+        dedupIndex_.Clear();
+        ClearFrameBuffers();
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(textureMutex_);
+        for (auto& pair : glTextureCache_) {
+            DropTextureRef(pair.second, texturesToDelete_);
+        }
+        glTextureCache_.clear();
+        stagedUploads_.clear();
+    }
+
+    Debug::Log("DirectEXRCache: [INIT] Switched layer '" + previous + "' -> '" + layer + "' (" +
+               std::to_string(restored) + " frames already cached)");
+
+    segmentsDirty_ = true;
+    initialized_ = true;
+
+    // Keep the playhead - the restored frames are around it
+    UpdateCurrentPosition(lastCacheUpdateTime_);
+    return true;
+}
+
+void DirectEXRCache::StoreInactiveLayers(int frame, const std::vector<std::string>& layers,
+                                         const std::vector<std::shared_ptr<PixelData>>& pixels,
+                                         const CancelToken& cancel) {
+    std::lock_guard<std::mutex> lock(layerMutex_);
+    // Checked under layerMutex_: SwitchLayer() cancels, then swaps the caches
+    if (cancel.IsCancelled() || layerSet_.empty()) {
+        return;
+    }
+
+    for (size_t i = 0; i < layers.size() && i < pixels.size(); ++i) {
+        if (!pixels[i] || pixels[i]->pixels.empty() || layers[i] == layerSet_[0] ||
+            std::find(layerSet_.begin(), layerSet_.end(), layers[i]) == layerSet_.end()) {
+            continue;
+        }
+        auto& cache = layerCaches_[layers[i]];
+        if (!cache) {
+            cache = std::make_unique<PixelCache>();
+            cache->SetMaxSize(pixelCache_.GetMaxSize());
+        }
+        cache->Add(frame, pixels[i], pixels[i]->pixels.size());
+    }
+}
+
+void DirectEXRCache::EvictInactiveLayers(int minFrame, int maxFrame) {
+    std::lock_guard<std::mutex> lock(layerMutex_);
+    for (auto& pair : layerCaches_) {
+        for (int frame : pair.second->GetKeys()) {
+            if (frame < minFrame || frame > maxFrame) {
+                pair.second->Remove(frame);
+            }
+        }
+    }
+}
+
+void DirectEXRCache::ClearLayerCaches() {
+    std::lock_guard<std::mutex> lock(layerMutex_);
+    layerCaches_.clear();
+}
+
 void DirectEXRCache::SetConfig(const EXRCacheConfig& config) {
     if (!config.IsValid()) {
         Debug::Log("DirectEXRCache: WARNING - Invalid config");
@@ -562,9 +1512,16 @@ void DirectEXRCache::SetConfig(const EXRCacheConfig& config) {
 
     // Check if cache size changed - if so, clear cache 
     bool cacheSizeChanged = (config.cacheGB != config_.cacheGB);
+    bool multiLayerChanged = (config.multiLayerCache != config_.multiLayerCache);
 
     config_ = config;
-    pixelCache_.SetMaxSize(static_cast<size_t>(config_.cacheGB * 1024 * 1024 * 1024));
+    if (multiLayerChanged && initialized_) {
+        BuildLayerSet();  // Also applies the budget
+    }
+    ApplyCacheBudget();
+    ApplyConcurrencyConfig();
+    TextureUploader::Shared().SetFrameBudgetMs(config_.uploadBudgetMs);
+    FrameFileReader::Shared().SetBackend(config_.readBackend, config_.directIO);
 
     if (cacheSizeChanged) {
       /*  Debug::Log("DirectEXRCache: Cache size changed - clearing cache");
@@ -580,13 +1537,64 @@ void DirectEXRCache::SetConfig(const EXRCacheConfig& config) {
 DirectEXRCache::Stats DirectEXRCache::GetStats() const {
     Stats stats;
     stats.totalFrames = static_cast<int>(sequenceFiles_.size());
-    stats.cachedFrames = static_cast<int>(pixelCache_.GetKeys().size());
+    stats.cachedFrames = static_cast<int>(pixelCache_.GetCount());
     stats.cacheBytes = pixelCache_.GetSize();
 
     std::lock_guard<std::mutex> lock(const_cast<std::mutex&>(mutex_));
     stats.pendingRequests = static_cast<int>(videoRequests_.size());
     stats.inProgressRequests = static_cast<int>(requestsInProgress_.size());
 
+    stats.seekCount = seekCount_;
+    stats.lastSeekFirstFrameMs = lastSeekFirstFrameMs_;
+    stats.avgSeekFirstFrameMs = avgSeekFirstFrameMs_;
+    stats.cancelledLoads = cancelledLoads_.load();
+
+    stats.compressedTier = coldCache_.GetStats();
+    if (config_.dedupFrames) {
+        // Frames whose pixels another cached frame already holds
+        {
+            std::lock_guard<std::mutex> sharedLock(const_cast<std::mutex&>(sharedMutex_));
+            stats.dedupFrames = sharedFrames_;
+            stats.dedupBytes = sharedBytes_;
+        }
+        stats.dedup = dedupIndex_.GetStats();
+    }
+    stats.bufferPool = FrameBufferPool::Shared().GetStats();
+
+    stats.readAhead = planner_.GetPlan();
+    stats.ioConcurrency = ioConcurrency_.GetStats();
+    stats.pageCache = prefetcher_.GetStats();
+    stats.reader = FrameFileReader::Shared().GetStats();
+    stats.headerLayouts = EXRLayoutCache::Shared().GetStats();
+    stats.draftLevel = draftLevel_.load();
+    stats.zoomLevel = zoomLevel_.load();
+    stats.resolutionLevels = resolutionLevels_;
+    stats.draftLoads = draftLoads_.load();
+    stats.draftUpgrades = draftUpgrades_.load();
+    {
+        std::lock_guard<std::mutex> layerLock(layerMutex_);
+        stats.cachedLayers = static_cast<int>(layerSet_.size());
+        for (const auto& pair : layerCaches_) {
+            stats.layerFrames += static_cast<int>(pair.second->GetCount());
+            stats.layerBytes += pair.second->GetSize();
+        }
+    }
+    stats.average_load_time_ms = stats.readAhead.avgLoadMs;
+
+    stats.uploader = TextureUploader::Shared().GetStats();
+    {
+        std::lock_guard<std::mutex> textureLock(const_cast<std::mutex&>(textureMutex_));
+        stats.stagedFrames = static_cast<int>(stagedUploads_.size());
+        std::unordered_map<GLuint, int> textureUsers;
+        for (const auto& pair : glTextureCache_) {
+            if (pair.second && textureUsers[pair.second->texture_id]++ == 1) {
+                stats.sharedTextures++;
+            }
+        }
+    }
+
+    stats.scheduler = TaskScheduler::Shared().GetStats();
+
     return stats;
 }
 
@@ -706,10 +1714,10 @@ void DirectEXRCache::CacheThread() {
         if (iteration % 20 == 0) {
             size_t cached_bytes = pixelCache_.GetSize();
             size_t max_bytes = pixelCache_.GetMaxSize();
-            auto cached_frames = pixelCache_.GetKeys();
+            size_t cached_frames = pixelCache_.GetCount();
 
          /*   Debug::Log("DirectEXRCache: Cache status - Frame: " + std::to_string(current_frame) +
-                       ", Cached frames: " + std::to_string(cached_frames.size()) +
+                       ", Cached frames: " + std::to_string(cached_frames) +
                        ", Memory: " + std::to_string(cached_bytes / (1024*1024)) + "/" +
                        std::to_string(max_bytes / (1024*1024)) + " MB");*/
         }
@@ -718,6 +1726,17 @@ void DirectEXRCache::CacheThread() {
         if (current_frame >= 0) {
             auto iter_start = std::chrono::steady_clock::now();
 
+            // Re-plan from measured load cost (window sizes, frame size, realtime verdict)
+            ReadAheadPlanner::Inputs planInputs;
+            planInputs.fps = fps_;
+            planInputs.cacheBytes = pixelCache_.GetMaxSize();
+            planInputs.readBehindFrames = static_cast<int>(config_.readBehindSeconds * fps_);
+            planInputs.concurrency = static_cast<int>(std::min(
+                ioConcurrency_.GetLimit(), TaskScheduler::Shared().GetConcurrencyCap(TaskPriority::Prefetch)));
+            planInputs.totalFrames = static_cast<int>(sequenceFiles_.size());
+            const ReadAheadPlanner::Plan plan = planner_.Update(planInputs);
+            UpdateDraftLevel(plan, current_frame);
+
             // CRITICAL: Detect seeks BEFORE updating cacheIterationCount_
             // If position jumped >20 frames, reset iteration counter for post-seek boost
             bool isSeek = false;
@@ -731,7 +1750,7 @@ void DirectEXRCache::CacheThread() {
                 // Immediately evict stale frames on major seek
                 // This prevents memory tracking issues where old frames consume budget
                 int readBehindFrames = static_cast<int>(config_.readBehindSeconds * fps_);
-                int readAheadFrames = 72;  // Smaller immediate window ~3s @ 24fps
+                int readAheadFrames = plan.keepAheadFrames;
                 int eviction_threshold_behind = current_frame - readBehindFrames;
                 int eviction_threshold_ahead = current_frame + readAheadFrames;
 
@@ -740,14 +1759,16 @@ void DirectEXRCache::CacheThread() {
 
                 for (int frame : cached_frames_pre) {
                     if (frame < eviction_threshold_behind || frame > eviction_threshold_ahead) {
-                        pixelCache_.Remove(frame);
+                        EvictFrame(frame);
                         immediate_evicted++;
                     }
                 }
 
+                EvictInactiveLayers(eviction_threshold_behind, eviction_threshold_ahead);
+
                 if (immediate_evicted > 0) {
                     segmentsDirty_ = true;
-                    size_t freed_bytes = immediate_evicted * (hasActualFrameSize_ ? actualFrameSize_ : (3840 * 2160 * 4 * sizeof(half)));
+                    size_t freed_bytes = immediate_evicted * plan.bytesPerFrame;
                     Debug::Log("DirectEXRCache: [SEEK-EVICTION] Immediately evicted " + std::to_string(immediate_evicted) +
                                " stale frames (~" + std::to_string(freed_bytes / (1024*1024)) + "MB freed)");
                 }
@@ -762,7 +1783,8 @@ void DirectEXRCache::CacheThread() {
             int readBehindFrames = static_cast<int>(config_.readBehindSeconds * fps_);
             //  Also define a read-ahead window for eviction
             // After a major seek, frames FAR ahead of the playhead should be evicted too
-            int readAheadFrames = 180;  // Keep ~7.5 seconds ahead @ 24fps (was infinite before!)
+            // (planner keeps as much ahead as fits in the budget next to read-behind)
+            int readAheadFrames = plan.keepAheadFrames;
 
             auto cached_frames = pixelCache_.GetKeys();
 
@@ -776,11 +1798,13 @@ void DirectEXRCache::CacheThread() {
             for (int frame : cached_frames) {
                 // Evict frames both BEHIND and FAR AHEAD of playhead
                 if (frame < eviction_threshold_behind || frame > eviction_threshold_ahead) {
-                    pixelCache_.Remove(frame);
+                    EvictFrame(frame);
                     evicted_count++;
                 }
             }
 
+            EvictInactiveLayers(eviction_threshold_behind, eviction_threshold_ahead);
+
             if (evicted_count > 0) {
                 segmentsDirty_ = true;  // Mark segments dirty after eviction
                 Debug::Log("DirectEXRCache: Cache thread @ frame " + std::to_string(current_frame) +
@@ -788,6 +1812,16 @@ void DirectEXRCache::CacheThread() {
                            std::to_string(eviction_threshold_behind) + ", " + std::to_string(eviction_threshold_ahead) + "]");
             }
 
+            // Warm the OS page cache for the files just past the read-ahead
+            // window, so their loads don't wait on the disk when the fill gets there
+            // (pointless with O_DIRECT reads, which bypass the page cache)
+            if (config_.pageCachePrefetch && !config_.directIO && plan.pageCacheFrames > 0) {
+                const int prefetchStart = current_frame + plan.readAheadFrames + 1;
+                prefetcher_.Retain(current_frame + 1, prefetchStart + plan.pageCacheFrames - 1);
+                prefetcher_.Prefetch(sequenceFiles_, prefetchStart, plan.pageCacheFrames,
+                                     [this](int frame) { return pixelCache_.Contains(frame); });
+            }
+
             // Step 2: Fill cache with readahead frames
             size_t cached_bytes = pixelCache_.GetSize();
             size_t max_bytes = pixelCache_.GetMaxSize();
@@ -796,27 +1830,8 @@ void DirectEXRCache::CacheThread() {
                 // Calculate available space, accounting for in-progress AND ready-for-texture
                 std::lock_guard<std::mutex> lock(mutex_);
 
-                // Use pre-calculated actual frame size
-                int estimated_frame_size = 3840 * 2160 * 4 * sizeof(half); // Default estimate ~64MB
-
-                if (hasActualFrameSize_) {
-                    // Use cached actual size 
-                    estimated_frame_size = static_cast<int>(actualFrameSize_);
-                } else {
-                    // Try to get actual size from first cached frame
-                    auto cached_frames = pixelCache_.GetKeys();
-                    if (!cached_frames.empty()) {
-                        std::shared_ptr<PixelData> first_pixels;
-                        if (pixelCache_.Peek(cached_frames[0], first_pixels) && first_pixels) {
-                            actualFrameSize_ = first_pixels->pixels.size();
-                            hasActualFrameSize_ = true;
-                            estimated_frame_size = static_cast<int>(actualFrameSize_);
-
-                            //Debug::Log("DirectEXRCache: Detected actual frame size: " +
-                            //           std::to_string(actualFrameSize_ / (1024*1024)) + "MB ");
-                        }
-                    }
-                }
+                // Measured frame size (seeded from the first file's header)
+                size_t estimated_frame_size = plan.bytesPerFrame;
 
                 // Limit in-flight requests to prevent unbounded accumulation
                 // Count total requests pending: in queue + in progress
@@ -841,20 +1856,18 @@ void DirectEXRCache::CacheThread() {
 
                 size_t available = max_bytes - total_committed;
 
-                // Conservative batching - limit batch size
-                int batch_limit;
-                if (iteration == 1) {
-                    batch_limit = config_.threadCount * 4;  // Deep initial saturation
-                } else {
-                    batch_limit = 72;  // 3 seconds @ 24fps - need DEEP buffer since we're slow at GL texture creation
-                }
+                // Prefetch horizon from the planner: load latency + margin when
+                // realtime is sustainable, as deep as the budget allows when not
+                int batch_limit = plan.readAheadFrames;
 
                 // Use 80% of available space as safety margin
                 size_t safe_available = static_cast<size_t>(available * 0.80);
                 int max_to_request = std::min(batch_limit, (int)(safe_available / estimated_frame_size));
 
-                // Fill bi-directionally (read-behind + read-ahead)
+                // Fill bi-directionally (read-behind + read-ahead); frames cached
+                // coarser than the draft level are loaded again (replaced in place)
                 int requested_count = 0;
+                const int draftLevel = GetLoadLevel();
 
                 // Calculate frame ranges for both directions
                 int readAheadStart = current_frame + 1;
@@ -867,7 +1880,7 @@ void DirectEXRCache::CacheThread() {
                     int frame = current_frame + i;
 
                     // Skip if already cached
-                    if (pixelCache_.Contains(frame)) continue;
+                    if (IsCachedAtLevel(frame, draftLevel)) continue;
 
                     // Skip if already in progress
                     if (requestsInProgress_.find(frame) != requestsInProgress_.end()) continue;
@@ -894,7 +1907,7 @@ void DirectEXRCache::CacheThread() {
                     if (frame < 0) break;
 
                     // Skip if already cached
-                    if (pixelCache_.Contains(frame)) continue;
+                    if (IsCachedAtLevel(frame, draftLevel)) continue;
 
                     // Skip if already in progress
                     if (requestsInProgress_.find(frame) != requestsInProgress_.end()) continue;
@@ -917,8 +1930,7 @@ void DirectEXRCache::CacheThread() {
                 // Post-fill cache prioritization (reverse touch)
                 // Touch cached frames in REVERSE order so frames closest to current time
                 // are touched LAST and thus stay in cache longest (LRU keeps most recently touched)
-                auto cached_frame_list = pixelCache_.GetKeys();
-                if (!cached_frame_list.empty()) {
+                if (pixelCache_.GetCount() > 0) {
                     // Build list of frames within cache budget, sorted by distance from current frame
                     std::vector<int> frames_to_prioritize;
                     size_t priority_bytes = 0;
@@ -974,7 +1986,7 @@ void DirectEXRCache::CacheThread() {
 }
 
 //=============================================================================
-// I/O Worker Thread (spawns and manages async load tasks)
+// I/O Worker Thread (submits load tasks to the shared TaskScheduler)
 //=============================================================================
 
 void DirectEXRCache::IOWorkerThread() {
@@ -997,7 +2009,7 @@ void DirectEXRCache::IOWorkerThread() {
 
         if (!ioRunning_) break;
 
-        // Spawn async tasks (up to threadCount concurrent)
+        // Submit load tasks (up to threadCount in flight)
         {
             std::lock_guard<std::mutex> lock(mutex_);
 
@@ -1008,8 +2020,10 @@ void DirectEXRCache::IOWorkerThread() {
             }
 
             int spawned = 0;
+            const size_t ioLimit = ioConcurrency_.GetLimit();
             while (!videoRequests_.empty() &&
-                   requestsInProgress_.size() < config_.threadCount) {
+                   requestsInProgress_.size() < ioLimit &&
+                   static_cast<size_t>(ioTasksInFlight_.load()) < ioLimit) {
 
                 int frame = videoRequests_.front();
                 videoRequests_.pop_front();
@@ -1025,9 +2039,9 @@ void DirectEXRCache::IOWorkerThread() {
                 // Create request
                 EXRRequest request;
                 request.frame = frame;
-                request.byteCount = 3840 * 2160 * 4 * sizeof(half);  // Estimate
+                request.byteCount = planner_.GetBytesPerFrame();  // Measured estimate
 
-                // Spawn async task
+                // Submit load task
                 const std::string path = sequenceFiles_[frame];
                 const std::string layer = layerName_;
 
@@ -1038,25 +2052,136 @@ void DirectEXRCache::IOWorkerThread() {
                     continue;
                 }
 
-                request.future = std::async(std::launch::async, [this, path, frame]() {
+                // Frames the playhead reaches within ~1s are playback-critical,
+                // the rest of the fill is prefetch (yields to playback on the shared pool)
+                const int lead = std::abs(frame - lastCacheUpdateFrame_);
+                const TaskPriority priority = lead <= static_cast<int>(fps_ + 0.5)
+                    ? TaskPriority::PlaybackCritical
+                    : TaskPriority::Prefetch;
+
+                // Frames about to be displayed also get copied into the PBO ring
+                // here on the worker, so the main thread only issues the GPU copy
+                const bool stageUpload = lead <= kUploadAheadFrames;
+
+                // Task holds its own loader reference: the sequence may be replaced while it runs
+                auto loader = loader_;
+                const PipelineMode mode = pipelineMode_;
+                request.epoch = seekEpoch_;
+                request.cancel = CancelToken::Create();
+                const CancelToken cancel = request.cancel;
+                ioTasksInFlight_++;
+
+                const bool releasePages = config_.pageCachePrefetch && !config_.directIO;
+                const bool dedup = config_.dedupFrames;
+
+                const int draftLevel = GetLoadLevel();
+
+                // Multi-layer caching: decode every cached layer in this one read
+                // (draft loads decode the active layer only)
+                std::vector<std::string> layers;
+                {
+                    std::lock_guard<std::mutex> layerLock(layerMutex_);
+                    if (loader && draftLevel == 0 && !layerSet_.empty() && layerSet_[0] == layer) {
+                        layers = layerSet_;
+                    }
+                }
+
+                request.future = TaskScheduler::Shared().Submit(priority, [this, loader, path, layer, layers, draftLevel, mode, frame, cancel, stageUpload, releasePages, priority, dedup]() {
+                    std::shared_ptr<PixelData> result;
                     try {
-                        auto load_start = std::chrono::steady_clock::now();
-                        auto result = LoadPixels(path);
-                        auto load_end = std::chrono::steady_clock::now();
-                        auto load_ms = std::chrono::duration_cast<std::chrono::milliseconds>(load_end - load_start).count();
-
-                        if (result) {
-                           /* Debug::Log("DirectEXRCache: [IO-LOAD] Frame " + std::to_string(frame) +
-                                       " loaded in " + std::to_string(load_ms) + "ms (" +
-                                       std::to_string(result->pixels.size() / (1024*1024)) + "MB)");*/
-                        } else {
-                            //Debug::Log("DirectEXRCache: [IO-LOAD] Frame " + std::to_string(frame) + " returned null");
+                        // Still held compressed: decompress instead of reading the file
+                        // (not a storage load - the planner and I/O limit don't see it)
+                        if (!cancel.IsCancelled() && coldCache_.IsEnabled()) {
+                            TaskScheduler& scheduler = TaskScheduler::Shared();
+                            TaskScheduler::ScopedHelperBudget helperBudget(
+                                priority == TaskPriority::PlaybackCritical ? scheduler.GetWorkerCount() - 1 : 0);
+                            result = coldCache_.Load(frame, draftLevel);
+                        }
+
+                        // Identical file already decoded and cached: share its pixels
+                        // (multi-layer loads decode every layer - not deduplicated)
+                        uint64_t fingerprint = 0;
+                        if (!result && !cancel.IsCancelled() && dedup && layers.empty()) {
+                            result = dedupIndex_.Find(path, draftLevel, fingerprint);
+                        }
+
+                        // Cancelled while still queued - don't even open the file
+                        if (!result && !cancel.IsCancelled()) {
+                            // Playhead frames (e.g. right after a seek) may split their decode
+                            // across idle workers; streaming fill stays one frame per core
+                            TaskScheduler& scheduler = TaskScheduler::Shared();
+                            TaskScheduler::ScopedHelperBudget helperBudget(
+                                priority == TaskPriority::PlaybackCritical ? scheduler.GetWorkerCount() - 1 : 0);
+                            planner_.OnLoadStarted();
+                            ioConcurrency_.OnStart();
+                            auto load_start = std::chrono::steady_clock::now();
+                            std::error_code ec;
+                            const uintmax_t fileSize = std::filesystem::file_size(path, ec);
+                            const size_t fileBytes = ec ? 0 : static_cast<size_t>(fileSize);
+                            try {
+                                ThrottledStorageSimulator& storage = ThrottledStorageSimulator::Shared();
+                                if (storage.IsEnabled()) {
+                                    storage.SimulateRead(fileBytes);
+                                }
+                                if (layers.empty()) {
+                                    result = LoadPixels(loader.get(), path, layer, mode, draftLevel, cancel);
+                                    if (result && result->draft_level > 0) {
+                                        draftLoads_++;
+                                    }
+                                    if (result && fingerprint != 0 && !cancel.IsCancelled()) {
+                                        dedupIndex_.Remember(fingerprint, path, result);
+                                    }
+                                } else {
+                                    std::vector<std::shared_ptr<PixelData>> decoded;
+                                    if (loader->LoadFrameLayers(path, layers, mode, decoded, cancel) && !decoded.empty()) {
+                                        result = decoded[0];
+                                        StoreInactiveLayers(frame, layers, decoded, cancel);
+                                    }
+                                }
+                            } catch (...) {
+                                result = nullptr;
+                            }
+                            double load_ms = std::chrono::duration<double, std::milli>(
+                                std::chrono::steady_clock::now() - load_start).count();
+                            bool completed = result && !cancel.IsCancelled();
+                            const size_t bytes = completed ? result->pixels.size() : 0;
+                            planner_.OnLoadFinished(load_ms, bytes, completed, fileBytes);
+                            ioConcurrency_.OnComplete(load_ms, bytes, completed);
+
+                            // Pixels are about to live in the pixel cache - drop the file's pages
+                            if (completed && releasePages) {
+                                prefetcher_.Release(frame, path);
+                            }
                         }
-                        return result;
                     } catch (const std::exception& e) {
                         //Debug::Log("DirectEXRCache: [IO-LOAD] ERROR frame " + std::to_string(frame) + " - " + std::string(e.what()));
-                        return std::shared_ptr<PixelData>(nullptr);
+                        result = nullptr;
+                    }
+
+                    if (cancel.IsCancelled()) {
+                        cancelledLoads_++;
+                        result = nullptr;
+                    }
+
+                    if (result && stageUpload && !result->pixels.empty()) {
+                        auto staged = TextureUploader::Shared().Stage(GetUploadFormat(*result), result->pixels.data());
+                        if (staged) {
+                            // Checked under textureMutex_: Initialize() cancels, then clears stagedUploads_
+                            std::lock_guard<std::mutex> lock(textureMutex_);
+                            if (!cancel.IsCancelled()) {
+                                stagedUploads_[frame] = std::move(staged);
+                            }
+                        }
                     }
+
+                    {
+                        // Notify under the lock: once the destructor sees zero it
+                        // may free ioTasksCv_ (and this)
+                        std::lock_guard<std::mutex> lock(ioTasksMutex_);
+                        ioTasksInFlight_--;
+                        ioTasksCv_.notify_all();
+                    }
+                    return result;
                 });
 
                 requestsInProgress_[frame] = std::move(request);
@@ -1083,12 +2208,40 @@ void DirectEXRCache::IOWorkerThread() {
                     try {
                         auto pixelData = it->second.future.get();
 
+                        // Submitted before a seek or layer switch: not this epoch's pixels
+                        if (it->second.epoch != seekEpoch_) {
+                            pixelData.reset();
+                        }
+
+                        // A draft finishing after a finer load of the frame is dropped
+                        std::shared_ptr<PixelData> existing;
+                        if (pixelData && pixelCache_.Peek(it->first, existing) && existing &&
+                            existing->draft_level < pixelData->draft_level) {
+                            pixelData.reset();
+                        }
+
                         if (pixelData && !pixelData->pixels.empty()) {
-                            // Add directly to pixel cache (no intermediate queue!)
+                            if (existing && existing->draft_level > pixelData->draft_level) {
+                                draftUpgrades_++;
+                            }
+
+                            // Add directly to pixel cache (no intermediate queue!) - replaces a draft in place
+                            // With dedup, one of the frames sharing a buffer is charged its bytes
                             size_t byteCount = pixelData->pixels.size();  // Already in bytes (uint8_t vector)
+                            if (existing) {
+                                ReleaseFrameBuffer(it->first, existing.get());
+                            }
+                            if (config_.dedupFrames) {
+                                byteCount = TrackFrameBuffer(it->first, pixelData);
+                            }
                             pixelCache_.Add(it->first, pixelData, byteCount);
+                            ApplyPendingCharges();
                             segmentsDirty_ = true;  // Mark segments dirty for UI update
                             completed++;
+
+                            if (seekPending_ && it->first == seekTargetFrame_) {
+                                RecordSeekFirstFrameLocked();
+                            }
                           /*  Debug::Log("DirectEXRCache: [IO-COMPLETE] Frame " + std::to_string(it->first) +
                                        " added to pixel cache (" + std::to_string(byteCount / (1024*1024)) + "MB)");*/
                         }
@@ -1112,14 +2265,20 @@ void DirectEXRCache::IOWorkerThread() {
 // Universal Image Loading (wraps EXR or IImageLoader)
 //=============================================================================
 
-std::shared_ptr<PixelData> DirectEXRCache::LoadPixels(const std::string& path) {
+std::shared_ptr<PixelData> DirectEXRCache::LoadPixels(IImageLoader* loader,
+                                                     const std::string& path,
+                                                     const std::string& layer,
+                                                     PipelineMode mode,
+                                                     int draftLevel,
+                                                     const CancelToken& cancel) {
     // If custom loader is provided, use it
-    if (loader_) {
-        return loader_->LoadFrame(path, layerName_, pipelineMode_);
+    if (loader) {
+        return draftLevel > 0 ? loader->LoadFrameDraft(path, layer, mode, draftLevel, cancel)
+                              : loader->LoadFrame(path, layer, mode, cancel);
     }
 
     // Otherwise, fall back to legacy EXR loading and convert
-    auto exr_pixels = LoadEXRPixels(path, layerName_);
+    auto exr_pixels = LoadEXRPixels(path, layer, cancel);
     if (!exr_pixels) {
         return nullptr;
     }
@@ -1132,11 +2291,24 @@ std::shared_ptr<PixelData> DirectEXRCache::LoadPixels(const std::string& path) {
     pixels->gl_type = GL_HALF_FLOAT;
     pixels->pipeline_mode = PipelineMode::HDR_RES;  // EXR is always HDR
 
+    if (exr_pixels->full_width > 0) {
+        pixels->region_x = exr_pixels->region_x;
+        pixels->region_y = exr_pixels->region_y;
+        pixels->region_width = exr_pixels->width;
+        pixels->region_height = exr_pixels->height;
+        pixels->full_width = exr_pixels->full_width;
+        pixels->full_height = exr_pixels->full_height;
+        pixels->opaque = exr_pixels->opaque;
+    }
+
     // Convert half vector to uint8_t vector (reinterpret bytes)
     size_t byte_count = exr_pixels->pixels.size() * sizeof(half);
     pixels->pixels.resize(byte_count);
     std::memcpy(pixels->pixels.data(), exr_pixels->pixels.data(), byte_count);
 
+    if (draftLevel > 0) {
+        return DownsampleFrame(*pixels, draftLevel);
+    }
     return pixels;
 }
 
@@ -1145,25 +2317,26 @@ std::shared_ptr<PixelData> DirectEXRCache::LoadPixels(const std::string& path) {
 //=============================================================================
 
 std::shared_ptr<EXRPixelData> DirectEXRCache::LoadEXRPixels(const std::string& path,
-                                                             const std::string& layer) {
-    // Memory-mapped stream 
-    auto stream = std::make_unique<MemoryMappedIStream>(path);
+                                                             const std::string& layer,
+                                                             const CancelToken& cancel) {
+    // Memory-mapped, or read whole by the selected backend
+    FileBytes bytes;
+    auto stream = OpenFrameStream(path, bytes, cancel);
     Imf::MultiPartInputFile file(*stream);
 
-    // Get header and dimensions (check both windows)
-    const Imf::Header& header = file.header(0);
-    const Imath::Box2i displayWindow = header.displayWindow();
-    const Imath::Box2i dataWindow = header.dataWindow();
+    // Sequence layout: windows, compression and the layer's channels, checked
+    // against this header and resolved once per sequence
+    const auto headerLayout = EXRLayoutCache::Shared().Get(path, file);
+    const Imath::Box2i displayWindow = headerLayout->display_window;
+    const Imath::Box2i dataWindow = headerLayout->data_window;
+    const Imf::Compression compression = headerLayout->compression;
 
     //Detect fast path when windows match
-    const bool fastPath = (displayWindow == dataWindow);
+    const bool fastPath = headerLayout->FastPath();
 
     // Use display window for output dimensions 
-    int width = displayWindow.max.x - displayWindow.min.x + 1;
-    int height = displayWindow.max.y - displayWindow.min.y + 1;
-
-    // Setup frame buffer
-    const Imf::ChannelList& channels = header.channels();
+    int width = headerLayout->Width();
+    int height = headerLayout->Height();
 
     // Debug logging 
     static bool loggedFileInfo = false;
@@ -1172,15 +2345,12 @@ std::shared_ptr<EXRPixelData> DirectEXRCache::LoadEXRPixels(const std::string& p
             "NO_COMPRESSION", "RLE", "ZIPS", "ZIP", "PIZ", "PXR24",
             "B44", "B44A", "DWAA", "DWAB"
         };
-        int compressionType = static_cast<int>(header.compression());
+        int compressionType = static_cast<int>(compression);
         const char* compressionName = (compressionType >= 0 && compressionType < 10)
             ? compressionNames[compressionType] : "UNKNOWN";
 
         // Count total channels in file
-        int totalChannels = 0;
-        for (auto it = channels.begin(); it != channels.end(); ++it) {
-            totalChannels++;
-        }
+        int totalChannels = static_cast<int>(headerLayout->channels.size());
 
        /* Debug::Log("DirectEXRCache: EXR file info - " +
                    std::to_string(width) + "x" + std::to_string(height) +
@@ -1192,76 +2362,58 @@ std::shared_ptr<EXRPixelData> DirectEXRCache::LoadEXRPixels(const std::string& p
         loggedFileInfo = true;
     }
 
-    // Allocate pixel buffer with optimizations
-    auto data = std::make_shared<EXRPixelData>();
-    data->width = width;
-    data->height = height;
-
-    // Optimization: Reserve capacity first to avoid reallocation during resize
-    // With aligned allocator, this ensures single allocation at proper alignment
-    const size_t pixelCount = static_cast<size_t>(width) * static_cast<size_t>(height) * 4;
-    data->pixels.reserve(pixelCount);
-    data->pixels.resize(pixelCount);  // RGBA
-    Imf::FrameBuffer frameBuffer;
-
-    // Try with layer prefix first, then without (for single-layer EXRs)
-    std::string layerPrefix = layer.empty() ? "" : (layer + ".");
-
-    // Find RGBA channels with layer prefix
-    std::string channelR = layerPrefix + "R";
-    std::string channelG = layerPrefix + "G";
-    std::string channelB = layerPrefix + "B";
-    std::string channelA = layerPrefix + "A";
-
-    const Imf::Channel* chR = channels.findChannel(channelR.c_str());
-    const Imf::Channel* chG = channels.findChannel(channelG.c_str());
-    const Imf::Channel* chB = channels.findChannel(channelB.c_str());
-    const Imf::Channel* chA = channels.findChannel(channelA.c_str());
-
-    // If not found with layer prefix, try root-level channels (single-layer EXR)
-    if (!chR && !layer.empty()) {
-        channelR = "R";
-        channelG = "G";
-        channelB = "B";
-        channelA = "A";
-        layerPrefix = "";
-
-        chR = channels.findChannel("R");
-        chG = channels.findChannel("G");
-        chB = channels.findChannel("B");
-        chA = channels.findChannel("A");
+    // Layer prefix first, then root-level channels (single-layer EXRs)
+    const EXRLayerMapping& mapping = headerLayout->Resolve(layer);
+    if (!mapping.valid) {
+        Debug::Log("DirectEXRCache: ERROR - Missing RGB channels for layer '" + layer + "' in " + path);
+        return nullptr;
     }
 
-    if (!chR || !chG || !chB) {
-        Debug::Log("DirectEXRCache: ERROR - Missing RGB channels for layer '" + layer + "' in " + path);
+    if (!mapping.IsRGB()) {
+        Debug::Log("DirectEXRCache: ERROR - AOV layer '" + layer + "' needs an image loader in " + path);
         return nullptr;
     }
 
     // Check pixel type consistency across channels
-    const Imf::PixelType pixelType = chR->type;
-    if (pixelType != chG->type || pixelType != chB->type || (chA && pixelType != chA->type)) {
+    if (!mapping.uniform_type) {
         Debug::Log("DirectEXRCache: ERROR - Inconsistent pixel types across RGBA channels in " + path);
         return nullptr;
     }
 
     // Check sampling rates (must be 1,1 for non-subsampled)
-    if (chR->xSampling != 1 || chR->ySampling != 1 ||
-        chG->xSampling != 1 || chG->ySampling != 1 ||
-        chB->xSampling != 1 || chB->ySampling != 1 ||
-        (chA && (chA->xSampling != 1 || chA->ySampling != 1))) {
+    if (!mapping.full_sampling) {
         Debug::Log("DirectEXRCache: ERROR - Subsampled channels not supported (sampling must be 1,1) in " + path);
         return nullptr;
     }
 
-    bool hasAlpha = (chA != nullptr);
+    // Allocate pixel buffer with optimizations
+    auto data = std::make_shared<EXRPixelData>();
+
+    // Overscan / cropped renders: store only the visible part of the data window
+    Imath::Box2i readWindow = displayWindow;
+    Imath::Box2i region;
+    if (!fastPath && EXRStoredRegion(displayWindow, dataWindow, region)) {
+        readWindow = region;
+        data->region_x = region.min.x - displayWindow.min.x;
+        data->region_y = region.min.y - displayWindow.min.y;
+        data->full_width = width;
+        data->full_height = height;
+        data->opaque = !mapping.has_alpha;
+        width = region.max.x - region.min.x + 1;
+        height = region.max.y - region.min.y + 1;
+    }
+    data->width = width;
+    data->height = height;
 
-    // (layerPrefix might have changed during fallback logic)
-    std::string fullChannelNames[4] = {
-        channelR,
-        channelG,
-        channelB,
-        channelA
-    };
+    // Optimization: Reserve capacity first to avoid reallocation during resize
+    // With aligned allocator, this ensures single allocation at proper alignment
+    const size_t pixelCount = static_cast<size_t>(width) * static_cast<size_t>(height) * 4;
+    data->pixels.reserve(pixelCount);
+    data->pixels.resize(pixelCount);  // RGBA
+    Imf::FrameBuffer frameBuffer;
+
+    bool hasAlpha = mapping.has_alpha;
+    const std::string* fullChannelNames = mapping.names;
     int numChannels = hasAlpha ? 4 : 3;
 
     // Read pixels using using the dual-path approach
@@ -1301,7 +2453,10 @@ std::shared_ptr<EXRPixelData> DirectEXRCache::LoadEXRPixels(const std::string& p
 
         // PROFILING: Time the actual decompression
         auto read_start = std::chrono::steady_clock::now();
-        part.readPixels(displayWindow.min.y, displayWindow.max.y);
+        if (!EXRReadRanges(part, frameBuffer, path, bytes, displayWindow.min.y, displayWindow.max.y,
+                           dataWindow.min.y, compression, cancel)) {
+            return nullptr;
+        }
         auto read_end = std::chrono::steady_clock::now();
         auto read_ms = std::chrono::duration_cast<std::chrono::milliseconds>(read_end - read_start).count();
 
@@ -1311,66 +2466,33 @@ std::shared_ptr<EXRPixelData> DirectEXRCache::LoadEXRPixels(const std::string& p
         }
 
     } else {
-        // SLOW PATH: Handle mismatched windows with intermediate buffer
-        // This handles edge cases where display != data window
-        const Imath::Box2i intersectedWindow = Imath::Box2i(
-            Imath::V2i(std::max(displayWindow.min.x, dataWindow.min.x),
-                      std::max(displayWindow.min.y, dataWindow.min.y)),
-            Imath::V2i(std::min(displayWindow.max.x, dataWindow.max.x),
-                      std::min(displayWindow.max.y, dataWindow.max.y))
-        );
-
-        const int dataWidth = dataWindow.max.x - dataWindow.min.x + 1;
+        // SLOW PATH: Display != data window (overscan / cropped renders).
+        // Whole chunk-aligned ranges of the stored region; padding (windows
+        // that don't overlap) is black
         const size_t channelByteCount = sizeof(half);
         const size_t cb = 4 * channelByteCount;
-
-        // Optimization: Use aligned buffer for scanline reads
-        const size_t bufSize = dataWidth * cb;
-        std::vector<char, AlignedAllocator<char, 64>> buf;
-        buf.reserve(bufSize);
-        buf.resize(bufSize);
-
-        for (int c = 0; c < numChannels; ++c) {
-            frameBuffer.insert(
-                fullChannelNames[c].c_str(),
-                Imf::Slice(
-                    Imf::HALF,  // CRITICAL: Buffer type, not file's pixelType! OpenEXR converts automatically
-                    buf.data() - (dataWindow.min.x * cb) + (c * channelByteCount),
-                    cb,
-                    0,  // yStride = 0 for single scanline buffer
-                    1, 1,
-                    0.0f
-                )
-            );
-        }
-
-        part.setFrameBuffer(frameBuffer);
-
-        // Read scanline by scanline and copy to output
-        const size_t scb = width * 4 * channelByteCount;
-        for (int y = displayWindow.min.y; y <= displayWindow.max.y; ++y) {
-            uint8_t* p = reinterpret_cast<uint8_t*>(data->pixels.data()) +
-                        ((y - displayWindow.min.y) * scb);
-            uint8_t* end = p + scb;
-
-            if (y >= intersectedWindow.min.y && y <= intersectedWindow.max.y) {
-                // Fill left padding
-                size_t size = (intersectedWindow.min.x - displayWindow.min.x) * cb;
-                std::memset(p, 0, size);
-                p += size;
-
-                // Read and copy actual data
-                size = (intersectedWindow.max.x - intersectedWindow.min.x + 1) * cb;
-                part.readPixels(y, y);
-                std::memcpy(
-                    p,
-                    buf.data() + std::max(displayWindow.min.x - dataWindow.min.x, 0) * cb,
-                    size);
-                p += size;
+        const uint8_t padPixel[4 * sizeof(half)] = {};
+
+        auto insertSlices = [&](Imf::FrameBuffer& fb, size_t, char* base, size_t yStride) {
+            for (int c = 0; c < numChannels; ++c) {
+                fb.insert(
+                    fullChannelNames[c].c_str(),
+                    Imf::Slice(
+                        Imf::HALF,  // CRITICAL: Buffer type, not file's pixelType! OpenEXR converts automatically
+                        base + (c * channelByteCount),
+                        cb,
+                        yStride,
+                        1, 1,
+                        0.0f
+                    )
+                );
             }
+        };
 
-            // Fill remaining with zeros
-            std::memset(p, 0, end - p);
+        if (!EXRReadWindow(part, insertSlices, cb, readWindow, dataWindow,
+                           {{reinterpret_cast<uint8_t*>(data->pixels.data()), width * cb, padPixel}},
+                           path, bytes, compression, cancel)) {
+            return nullptr;
         }
 
         // Fill alpha with 1.0 if no alpha channel
@@ -1384,37 +2506,28 @@ std::shared_ptr<EXRPixelData> DirectEXRCache::LoadEXRPixels(const std::string& p
     return data;
 }
 
-GLuint DirectEXRCache::CreateGLTexture(const std::shared_ptr<PixelData>& pixels) {
-    if (!pixels || pixels->pixels.empty()) {
-        return 0;
-    }
-
-    GLuint texId = 0;
-    glGenTextures(1, &texId);
-    glBindTexture(GL_TEXTURE_2D, texId);
-
-    // Determine internal format based on GL type
-    GLint internalFormat = GL_RGBA16F;  // Default for HDR
-    if (pixels->gl_type == GL_UNSIGNED_BYTE) {
-        internalFormat = GL_RGBA8;
-    } else if (pixels->gl_type == GL_UNSIGNED_SHORT) {
-        internalFormat = GL_RGBA16;
+UploadFormat DirectEXRCache::GetUploadFormat(const PixelData& pixels) {
+    UploadFormat format;
+    format.width = pixels.width;
+    format.height = pixels.height;
+    format.format = pixels.gl_format;
+    format.type = pixels.gl_type;
+
+    // Data window storage: the region goes at its offset in a frame-sized
+    // texture (both scaled down with draft frames), so display is unchanged
+    if (pixels.HasRegion()) {
+        const int level = pixels.draft_level;
+        const int factor = 1 << level;
+        format.texture_width = (pixels.DisplayWidth() + factor - 1) / factor;
+        format.texture_height = (pixels.DisplayHeight() + factor - 1) / factor;
+        format.x_offset = pixels.region_x / factor;
+        format.y_offset = pixels.region_y / factor;
+        format.pad_alpha = pixels.opaque ? 1.0f : 0.0f;
     }
 
-    // Upload pixel data with appropriate format/type
-    glTexImage2D(GL_TEXTURE_2D, 0, internalFormat,
-                 pixels->width, pixels->height, 0,
-                 pixels->gl_format, pixels->gl_type, pixels->pixels.data());
-
-    // Set filtering
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-
-    glBindTexture(GL_TEXTURE_2D, 0);
-
-    return texId;
+    // Stored as loaded: RGBA8/16/16F, or RGB16F/RG16F/R16F for compact EXR frames
+    format.internal_format = StorageInternalFormat(pixels.gl_format, pixels.gl_type);
+    return format;
 }
 
 } // namespace ump
@@ -8,16 +8,33 @@
 #include <condition_variable>
 #include <future>
 #include <map>
+#include <unordered_map>
 #include <deque>
 #include <functional>
+#include <atomic>
+#include <chrono>
 
 #include <glad/gl.h>
 #include <half.h>
 
 #include <OpenEXR/ImfIO.h>
+#include <OpenEXR/ImfCompression.h>
+#include <OpenEXR/ImfForward.h>
+#include <Imath/ImathBox.h>
 
 #include "image_loader_interface.h"
 #include "pipeline_mode.h"
+#include "sharded_lru.h"
+#include "lru_benchmark.h"
+#include "compressed_frame_cache.h"
+#include "frame_dedup_index.h"
+#include "read_ahead_planner.h"
+#include "file_prefetcher.h"
+#include "frame_file_reader.h"
+#include "../gpu/texture_uploader.h"
+#include "../utils/adaptive_concurrency.h"
+#include "../utils/exr_layout_cache.h"
+#include "../utils/task_scheduler.h"
 
 #ifdef _WIN32
     #include <windows.h>
@@ -54,6 +71,89 @@ private:
 #endif
 };
 
+//=============================================================================
+// In-memory IStream - decodes a frame file FrameFileReader already read
+//=============================================================================
+
+class MemoryIStream : public Imf::IStream {
+public:
+    MemoryIStream(const std::string& fileName, const uint8_t* data, size_t size);
+
+    bool isMemoryMapped() const override { return true; }
+    char* readMemoryMapped(int n) override;
+    bool read(char c[], int n) override;
+    uint64_t tellg() override;
+    void seekg(uint64_t pos) override;
+
+private:
+    char* data_ = nullptr;  // Read-only despite the IStream signature
+    uint64_t size_ = 0;
+    uint64_t currentPos_ = 0;
+};
+
+// Stream for a full frame decode: whole file read by the selected backend
+// (kept alive in 'bytes'), or memory-mapped for ReadBackend::Mapped.
+// Throws std::runtime_error like the stream constructors.
+std::unique_ptr<Imf::IStream> OpenFrameStream(const std::string& path, FileBytes& bytes,
+                                              const CancelToken& cancel);
+
+//=============================================================================
+// Chunk-aligned scanline ranges - Shared utility
+// readPixels() decompresses whole chunks, so ranges that split a chunk decode
+// it twice. Loaders read one range at a time and poll for cancellation between.
+//=============================================================================
+
+// Lines per readPixels() call: whole chunks, at least 64 lines
+int EXRReadRangeLines(Imf::Compression compression);
+
+// Last line of the range starting at y (ranges are aligned to dataWindowMinY)
+inline int EXRAlignedRangeEnd(int y, int dataWindowMinY, int rangeLines) {
+    return dataWindowMinY + ((y - dataWindowMinY) / rangeLines + 1) * rangeLines - 1;
+}
+
+// Read lines [yMin, yMax] of 'part' (frame buffer already set) in aligned ranges.
+// With a helper budget on this thread (TaskScheduler::ScopedHelperBudget) the
+// ranges are spread over idle workers: OpenEXR serializes readPixels() per file,
+// so each helper opens its own part - over 'bytes' when the file was read into
+// memory, else mapped from 'path' - with the same frame buffer. Ranges are
+// disjoint so they write disjoint destination rows.
+// Returns false when cancelled; throws like readPixels().
+bool EXRReadRanges(Imf::InputPart& part, const Imf::FrameBuffer& frameBuffer,
+                   const std::string& path, const FileBytes& bytes,
+                   int yMin, int yMax, int dataWindowMinY, Imf::Compression compression,
+                   const CancelToken& cancel);
+
+// One destination image of a windowed read (e.g. one layer of the file)
+struct EXRPlane {
+    uint8_t* dest = nullptr;            // Display window origin
+    size_t stride = 0;                  // Row stride in bytes
+    const uint8_t* padPixel = nullptr;  // Written outside the data window
+    size_t pixelBytes = 0;              // 0 = the read's pixelBytes (planes may store fewer channels)
+};
+
+// Adds a plane's slices to a frame buffer: pixel (x, y) lives at
+// base + x * pixelBytes + y * yStride
+using EXRSliceInserter = std::function<void(Imf::FrameBuffer& frameBuffer, size_t plane, char* base, size_t yStride)>;
+
+// Read the display window of 'part' into each plane (pixelBytes, unless the
+// plane sets its own), padding whatever lies outside the data window. One decode fills every
+// plane, since a chunk holds all of the file's channels.
+// Whole chunk-aligned ranges are decoded once each: straight into the planes
+// when the data window fits horizontally, else through a block buffer (overscan).
+// rangeLines > 0 forces the block buffer with that many lines per read
+// (1 = the old per-scanline read, for benchmarks).
+// Returns false when cancelled; throws like readPixels().
+bool EXRReadWindow(Imf::InputPart& part, const EXRSliceInserter& insertSlices, size_t pixelBytes,
+                   const Imath::Box2i& displayWindow, const Imath::Box2i& dataWindow,
+                   const std::vector<EXRPlane>& planes,
+                   const std::string& path, const FileBytes& bytes, Imf::Compression compression,
+                   const CancelToken& cancel, int rangeLines = 0);
+
+// Data window storage: the part of the data window inside the display window
+// (file coordinates), read with EXRReadWindow() as its display window so no
+// padding is written. False when the windows don't overlap.
+bool EXRStoredRegion(const Imath::Box2i& displayWindow, const Imath::Box2i& dataWindow, Imath::Box2i& region);
+
 //=============================================================================
 // Clean DirectEXRCache - Pure tlRender Architecture
 // Zero legacy code. Minimal state. Fast.
@@ -63,12 +163,48 @@ private:
 struct EXRCacheConfig {
     // tlRender default: 16 I/O threads for sequences (SequenceOptions.threadCount = 16)
     // This helps with slow multilayer EXRs (31 channels, DWAB compression ~900ms/frame)
-    size_t threadCount = 16;            // Parallel EXR loads (matches tlRender)
+    size_t threadCount = 16;            // Max parallel EXR loads (matches tlRender)
+
+    // Adaptive I/O concurrency: AIMD between minThreadCount and threadCount
+    // from measured read latency/throughput (false = always threadCount)
+    bool adaptiveConcurrency = true;
+    size_t minThreadCount = 2;
     double cacheGB = 18.0;             // LRU cache size
 
+    // Compressed second tier below cacheGB: evicted frames are kept deflated
+    // in RAM and decompressed when the fill reaches them again (0 = off)
+    double compressedCacheGB = 0.0;
+
     // tlRender pattern: Read-behind for instant backward scrubbing
     double readBehindSeconds = 0.5;    // Keep frames BEHIND playhead (0.5s default like tlRender)
 
+    // Hint the files past the read-ahead window to the OS page cache and
+    // drop each file's pages once decoded (Linux; no-op elsewhere, off with directIO)
+    bool pageCachePrefetch = true;
+
+    // Frame file reads: mmap (format library maps the file) or pread/io_uring of
+    // the whole file into memory; directIO bypasses the page cache (O_DIRECT)
+    ReadBackend readBackend = ReadBackend::Mapped;
+    bool directIO = false;
+
+    // Multi-layer EXR: each load decodes every layer of the file (one read) and
+    // keeps the inactive layers cached too, so switching layers needs no I/O.
+    // The cache budget is split evenly across the cached layers.
+    bool multiLayerCache = false;
+
+    // Identical files (held frames, slates) share one decoded buffer and one
+    // texture: sampled fingerprint per load, confirmed by a full-file hash
+    bool dedupFrames = false;
+
+    // Draft playback: while playing and decode can't sustain the fps, new
+    // loads decode at 1/2, then 1/4 resolution. Back to full resolution when
+    // paused or once the read-ahead has caught up (drafts replaced in place).
+    bool draftPlayback = true;
+    int maxDraftLevel = 2;              // 1 = 1/2, 2 = 1/4 resolution
+
+    // Main-thread texture upload time per UI frame (shared with thumbnails/video cache)
+    double uploadBudgetMs = TextureUploader::kDefaultBudgetMs;
+
     // Compatibility fields (unused in clean version)
     double video_cache_gb = 18.0;      // Alias for cacheGB
     double read_behind_seconds = 0.5;  // Alias for readBehindSeconds
@@ -78,8 +214,12 @@ struct EXRCacheConfig {
 
     bool IsValid() const {
         return threadCount >= 1 && threadCount <= 32 &&
+               minThreadCount >= 1 && minThreadCount <= threadCount &&
                cacheGB >= 1.0 && cacheGB <= 128.0 &&
-               readBehindSeconds >= 0.0 && readBehindSeconds <= 5.0;
+               compressedCacheGB >= 0.0 && compressedCacheGB <= 128.0 &&
+               readBehindSeconds >= 0.0 && readBehindSeconds <= 5.0 &&
+               maxDraftLevel >= 1 && maxDraftLevel <= 2 &&
+               uploadBudgetMs >= 0.5 && uploadBudgetMs <= 100.0;
     }
 };
 
@@ -153,11 +293,18 @@ public:
 };
 
 // Pixel data loaded from EXR (CPU-side, background thread safe)
-// Using 64-byte aligned allocation for SIMD/cache line optimization
+// Pooled 64-byte aligned allocation (uninitialized on resize, recycled on free)
 struct EXRPixelData {
-    std::vector<half, AlignedAllocator<half, 64>> pixels;  // RGBA half-float (64-byte aligned)
+    std::vector<half, PooledFrameAllocator<half>> pixels;  // RGBA half-float (64-byte aligned)
     int width = 0;
     int height = 0;
+
+    // Data window storage: width x height at (region_x, region_y) of the display window
+    int region_x = 0;
+    int region_y = 0;
+    int full_width = 0;                 // 0 = whole display window stored
+    int full_height = 0;
+    bool opaque = false;                // No alpha channel
 };
 
 // GL texture (GPU-side, main thread only)
@@ -166,154 +313,13 @@ struct EXRTexture {
     int width = 0;
     int height = 0;
     size_t byteCount = 0;
+    std::weak_ptr<PixelData> source;    // Pixels uploaded (frames sharing them share the texture)
 
     // NOTE: GL textures are NOT deleted in destructor because this can be called
     // from any thread. Instead, DirectEXRCache queues textures for deletion
     // and ProcessReadyTextures() deletes them on the main thread.
 };
 
-// Simple LRU cache
-template<typename K, typename V>
-class SimpleLRU {
-public:
-    using EvictionCallback = std::function<void(const K& key, const V& value)>;
-
-    void SetMaxSize(size_t bytes) { maxBytes_ = bytes; }
-    size_t GetMaxSize() const { return maxBytes_; }
-    size_t GetSize() const { return currentBytes_; }
-    void SetEvictionCallback(EvictionCallback callback) { evictionCallback_ = callback; }
-
-    bool Contains(const K& key) const {
-        std::lock_guard<std::mutex> lock(mutex_);
-        return cache_.find(key) != cache_.end();
-    }
-
-    bool Get(const K& key, V& value) {
-        std::lock_guard<std::mutex> lock(mutex_);
-        auto it = cache_.find(key);
-        if (it != cache_.end()) {
-            value = it->second;
-            Touch(key);
-            return true;
-        }
-        return false;
-    }
-
-    bool Get(const K& key, V& value) const {
-        std::lock_guard<std::mutex> lock(mutex_);
-        auto it = cache_.find(key);
-        if (it != cache_.end()) {
-            value = it->second;
-            // Don't touch in const version
-            return true;
-        }
-        return false;
-    }
-
-    // Peek without updating LRU (for playback - don't keep old frames fresh)
-    bool Peek(const K& key, V& value) const {
-        std::lock_guard<std::mutex> lock(mutex_);
-        auto it = cache_.find(key);
-        if (it != cache_.end()) {
-            value = it->second;
-            return true;
-        }
-        return false;
-    }
-
-    void Add(const K& key, const V& value, size_t bytes) {
-        std::lock_guard<std::mutex> lock(mutex_);
-
-        // Remove old entry
-        auto it = cache_.find(key);
-        if (it != cache_.end()) {
-            currentBytes_ -= sizes_[key];
-            cache_.erase(it);
-            sizes_.erase(key);
-        }
-
-        // Add new
-        cache_[key] = value;
-        sizes_[key] = bytes;
-        currentBytes_ += bytes;
-        Touch(key);
-
-        // Evict if needed
-        while (currentBytes_ > maxBytes_ && !lruList_.empty()) {
-            K oldest = lruList_.front();
-            lruList_.pop_front();
-
-            // Call eviction callback BEFORE erasing (so callback can access the value)
-            if (evictionCallback_) {
-                auto it = cache_.find(oldest);
-                if (it != cache_.end()) {
-                    evictionCallback_(oldest, it->second);
-                }
-            }
-
-            currentBytes_ -= sizes_[oldest];
-            cache_.erase(oldest);
-            sizes_.erase(oldest);
-        }
-    }
-
-    void Clear() {
-        std::lock_guard<std::mutex> lock(mutex_);
-        cache_.clear();
-        sizes_.clear();
-        lruList_.clear();
-        currentBytes_ = 0;
-    }
-
-    // Remove without returning the value (for eviction without texture deletion callback)
-    void Remove(const K& key) {
-        std::lock_guard<std::mutex> lock(mutex_);
-        auto it = cache_.find(key);
-        if (it != cache_.end()) {
-            currentBytes_ -= sizes_[key];
-            cache_.erase(it);
-            sizes_.erase(key);
-            lruList_.remove(key);
-        }
-    }
-
-    // Remove and return the value (so caller can extract GL texture ID for deletion)
-    bool RemoveAndGet(const K& key, V& value) {
-        std::lock_guard<std::mutex> lock(mutex_);
-        auto it = cache_.find(key);
-        if (it != cache_.end()) {
-            value = it->second;
-            currentBytes_ -= sizes_[key];
-            cache_.erase(it);
-            sizes_.erase(key);
-            lruList_.remove(key);
-            return true;
-        }
-        return false;
-    }
-
-    std::vector<K> GetKeys() const {
-        std::lock_guard<std::mutex> lock(mutex_);
-        std::vector<K> keys;
-        for (const auto& p : cache_) keys.push_back(p.first);
-        return keys;
-    }
-
-private:
-    void Touch(const K& key) {
-        lruList_.remove(key);
-        lruList_.push_back(key);
-    }
-
-    mutable std::mutex mutex_;
-    std::map<K, V> cache_;
-    std::map<K, size_t> sizes_;
-    std::list<K> lruList_;
-    size_t maxBytes_ = 0;
-    size_t currentBytes_ = 0;
-    EvictionCallback evictionCallback_;
-};
-
 //=============================================================================
 // DirectEXRCache - Clean Implementation
 //=============================================================================
@@ -369,6 +375,7 @@ public:
     void SetConfig(const EXRCacheConfig& config);
     EXRCacheConfig GetConfig() const { return config_; }
     int GetStartFrame() const { return startFrame_; }
+    std::vector<std::string> GetSequenceFiles() const { return sequenceFiles_; }
 
     // Stats
     struct Stats {
@@ -386,6 +393,58 @@ public:
         bool background_thread_active = true;
         double average_load_time_ms = 0.0;
 
+        // Seek responsiveness (time from seek to the target frame being cached)
+        uint64_t seekCount = 0;
+        double lastSeekFirstFrameMs = 0.0;
+        double avgSeekFirstFrameMs = 0.0;
+        uint64_t cancelledLoads = 0;        // Loads abandoned mid-decode after a seek
+
+        // Adaptive I/O concurrency (current in-flight limit and its inputs)
+        AdaptiveConcurrencyController::Stats ioConcurrency;
+
+        // Read-ahead plan: measured load cost, window sizes, realtime verdict
+        ReadAheadPlanner::Plan readAhead;
+
+        // OS page-cache warming past the read-ahead window
+        FilePrefetcher::Stats pageCache;
+
+        // Frame file read backend (mmap / pread / io_uring) and per-backend totals
+        FrameFileReader::Stats reader;
+
+        // Per-sequence EXR header layouts (frames matching the cached layout)
+        EXRLayoutCache::Stats headerLayouts;
+
+        // Multi-layer caching: layers decoded per load, inactive layers' frames
+        int cachedLayers = 0;
+        int layerFrames = 0;
+        size_t layerBytes = 0;
+
+        // Draft playback: resolution level of new loads (0 = full)
+        int draftLevel = 0;
+        int zoomLevel = 0;                  // Mip level matching the on-screen size
+        int resolutionLevels = 1;           // Mip levels stored in the sequence (1 = none)
+        uint64_t draftLoads = 0;            // Frames loaded below full resolution
+        uint64_t draftUpgrades = 0;         // Draft entries replaced by finer ones
+
+        // Deduplication: cached frames sharing another frame's pixels/texture
+        int dedupFrames = 0;
+        size_t dedupBytes = 0;              // Pixel bytes not stored thanks to sharing
+        int sharedTextures = 0;             // Resident textures serving more than one frame
+        FrameDedupIndex::Stats dedup;
+
+        // Compressed tier: frames, ratio, hits and decompress time (separate from cacheBytes)
+        CompressedFrameCache::Stats compressedTier;
+
+        // Recycled frame buffers (idle bytes count against the cache budget)
+        FrameBufferPool::Stats bufferPool;
+
+        // Texture uploads (PBO ring + per-frame budget)
+        TextureUploader::Stats uploader;
+        int stagedFrames = 0;               // Frames waiting in the PBO ring for upload
+
+        // Shared TaskScheduler (queue depth/latency per priority class)
+        std::vector<TaskClassStats> scheduler;
+
         // Aliases for old field names
         int& total_frames_in_sequence = totalFrames;
         int& frames_cached = cachedFrames;
@@ -406,6 +465,32 @@ public:
 
     bool IsInitialized() const { return initialized_; }
 
+    // Size of the image on screen in pixels (main thread, every frame).
+    // Mipmapped sequences load the coarsest level at least this large;
+    // frames cached coarser are reloaded when the image grows.
+    void SetDisplaySize(int width, int height);
+
+    // Windowed-read benchmark: decodes the sequence's frames whose data window
+    // differs from the display window (overscan) once per scanline, as the
+    // loaders used to, and once in chunk-aligned blocks. Decode time only.
+    struct WindowReadBenchmark {
+        bool ok = false;
+        int files = 0;                  // Files examined
+        int windowedFiles = 0;          // Of those, display != data window (timed)
+        double scanlineMs = 0.0;        // Total per-scanline decode time
+        double blockMs = 0.0;           // Total chunk-aligned decode time
+    };
+
+    void StartWindowReadBenchmark(int maxFiles);
+    bool IsWindowReadBenchmarkRunning() const { return windowBenchmark_->running.load(); }
+    WindowReadBenchmark GetWindowReadBenchmark() const;
+
+    // Pixel cache benchmark: ShardedLRU against the single-mutex LRU it
+    // replaced, at this cache's frame count (see lru_benchmark.h)
+    void StartLRUBenchmark();
+    bool IsLRUBenchmarkRunning() const { return lruBenchmark_->running.load(); }
+    LRUBenchmarkResult GetLRUBenchmark() const;
+
 private:
     //=========================================================================
     // tlRender-style Request Management
@@ -415,6 +500,8 @@ private:
         int frame;
         std::future<std::shared_ptr<PixelData>> future;  // Changed from EXRPixelData
         size_t byteCount;
+        uint64_t epoch = 0;       // seekEpoch_ when submitted
+        CancelToken cancel;       // Set by ClearRequests() - loader stops at next chunk
     };
 
     //=========================================================================
@@ -427,11 +514,21 @@ private:
     std::atomic<bool> cacheRunning_{false};
 
     //=========================================================================
-    // I/O Worker Thread (spawns and manages async load tasks)
+    // I/O Worker Thread (submits load tasks to the shared TaskScheduler)
     //=========================================================================
 
     void IOWorkerThread();
 
+    // Load tasks still running on the scheduler (destructor waits for zero)
+    // Cancelled loads count until they return - they still occupy the storage
+    std::atomic<int> ioTasksInFlight_{0};
+
+    // In-flight load limit, adapted to the storage (NAS collapses at 16, NVMe wants more)
+    AdaptiveConcurrencyController ioConcurrency_{"exr-io"};
+    void ApplyConcurrencyConfig();
+    std::mutex ioTasksMutex_;
+    std::condition_variable ioTasksCv_;
+
     std::thread ioWorkerThread_;
     std::atomic<bool> ioRunning_{false};
     std::mutex mutex_;
@@ -441,6 +538,23 @@ private:
     std::map<int, EXRRequest> requestsInProgress_;     // Currently loading
     bool needsFillReset_ = false;                      // Flag to reset fill counters on next cache update
 
+    // Seek epoch: bumped when in-flight loads are cancelled; results from older epochs are dropped
+    uint64_t seekEpoch_ = 0;                           // Guarded by mutex_
+    std::atomic<uint64_t> cancelledLoads_{0};
+
+    // Post-seek time-to-first-frame (guarded by mutex_)
+    bool seekPending_ = false;
+    int seekTargetFrame_ = -1;
+    std::chrono::steady_clock::time_point seekStartTime_;
+    uint64_t seekCount_ = 0;
+    double lastSeekFirstFrameMs_ = 0.0;
+    double avgSeekFirstFrameMs_ = 0.0;
+
+    void ApplyCacheBudget();
+    size_t QueryFrameBytes(const std::string& path);  // Header-only size of one decoded frame
+    void CancelInProgressLocked();
+    void RecordSeekFirstFrameLocked();
+
     //=========================================================================
     // GL Texture Management (main thread only)
     //=========================================================================
@@ -448,19 +562,39 @@ private:
     std::vector<GLuint> texturesToDelete_;  // GL textures marked for deletion (deleted on main thread)
     std::mutex textureMutex_;
 
+    // Frames near the playhead are staged into the uploader's PBO ring by their
+    // load task; ProcessReadyTextures() turns them into textures within the frame budget
+    std::map<int, std::shared_ptr<StagedUpload>> stagedUploads_;  // Guarded by textureMutex_
+    static constexpr int kUploadAheadFrames = 6;
+
+    // Add a texture, evicting the resident texture farthest from 'anchor' (textureMutex_ held)
+    void InsertTextureLocked(int frame, GLuint texture, const std::shared_ptr<PixelData>& pixels, int anchor);
+    void InsertTextureLocked(int frame, std::shared_ptr<EXRTexture> texture, int anchor);
+
+    // Resident texture uploaded from these pixels (deduplicated frames), or nullptr
+    std::shared_ptr<EXRTexture> FindTextureLocked(const std::shared_ptr<PixelData>& pixels) const;
+
     //=========================================================================
     // Universal Image Loading (replaces EXR-only loading)
     //=========================================================================
 
     // NEW: Universal loader (runtime polymorphism)
-    std::shared_ptr<PixelData> LoadPixels(const std::string& path);
+    // Runs on scheduler workers - takes everything it needs by argument
+    // draftLevel > 0: 1/2^draftLevel resolution (LoadFrameDraft)
+    std::shared_ptr<PixelData> LoadPixels(IImageLoader* loader,
+                                          const std::string& path,
+                                          const std::string& layer,
+                                          PipelineMode mode,
+                                          int draftLevel,
+                                          const CancelToken& cancel);
 
     // LEGACY: EXR-specific loading (preserved for backward compatibility)
     std::shared_ptr<EXRPixelData> LoadEXRPixels(const std::string& path,
-                                                 const std::string& layer);
+                                                 const std::string& layer,
+                                                 const CancelToken& cancel);
 
-    // GL texture creation (now handles multiple formats via PixelData)
-    GLuint CreateGLTexture(const std::shared_ptr<PixelData>& pixels);
+    // Texture storage for a frame (float data is stored as RGBA16F like half)
+    static UploadFormat GetUploadFormat(const PixelData& pixels);
 
     //=========================================================================
     // State
@@ -475,14 +609,91 @@ private:
     EXRCacheConfig config_;
 
     // NEW: Runtime-swappable image loader (nullptr = use EXR legacy path)
-    std::unique_ptr<IImageLoader> loader_;
+    // Shared so in-flight load tasks keep it alive across Initialize()
+    std::shared_ptr<IImageLoader> loader_;
 
     // NEW: Pipeline mode for current sequence
     PipelineMode pipelineMode_ = PipelineMode::NORMAL;
 
     // tlRender pattern: LRU cache for CPU pixel data (NOT GL textures!)
-    // Changed from EXRPixelData to PixelData for universal support
-    SimpleLRU<int, std::shared_ptr<PixelData>> pixelCache_;
+    // Sharded O(1) LRU - touched by the I/O, cache and main threads concurrently
+    ShardedLRU<int, std::shared_ptr<PixelData>> pixelCache_;
+
+    // Frames leaving pixelCache_ (budget eviction or the cache window), kept
+    // compressed; load tasks take a frame from here before reading its file
+    CompressedFrameCache coldCache_;
+
+    // Window eviction: drop from pixelCache_, keep compressed when the tier is on
+    void EvictFrame(int frame);
+
+    // Identical files share one decode (config_.dedupFrames)
+    FrameDedupIndex dedupIndex_;
+
+    // Frames holding each buffer while dedup is on. The first one listed is
+    // charged the buffer's bytes, the others only their PixelData; when it
+    // leaves pixelCache_ the next one is charged in full instead
+    std::mutex sharedMutex_;
+    std::unordered_map<const PixelData*, std::vector<int>> bufferFrames_;
+    std::vector<std::pair<int, const PixelData*>> pendingCharges_;  // Applied outside pixelCache_ locks
+    int sharedFrames_ = 0;                  // Holders past the first, for GetStats()
+    size_t sharedBytes_ = 0;
+
+    size_t TrackFrameBuffer(int frame, const std::shared_ptr<PixelData>& pixels);  // Bytes to charge
+    void ReleaseFrameBuffer(int frame, const PixelData* pixels);  // Also from the eviction callback
+    void ApplyPendingCharges();
+    void ClearFrameBuffers();
+
+    //=========================================================================
+    // Draft playback (config_.draftPlayback)
+    //=========================================================================
+
+    // Cache thread: step the level down (coarser) on a sustained realtime
+    // deficit, up once the read-ahead is full; 0 when paused
+    void UpdateDraftLevel(const ReadAheadPlanner::Plan& plan, int currentFrame);
+
+    // Cached at this resolution level or finer (coarser entries get reloaded)
+    bool IsCachedAtLevel(int frame, int level) const;
+
+    // Level new loads decode at: draft playback or the on-screen mip level
+    int GetLoadLevel() const { return std::max(draftLevel_.load(), zoomLevel_.load()); }
+
+    static constexpr double kDraftHoldSeconds = 3.0;   // Minimum time between level steps
+
+    std::atomic<int> draftLevel_{0};                    // Draft playback level
+    std::atomic<int> zoomLevel_{0};                     // Mip level for the on-screen size
+    int resolutionLevels_ = 1;                          // Mip levels of the sequence (Initialize)
+    int frameWidth_ = 0;                                // Full-resolution frame size (Initialize)
+    int frameHeight_ = 0;
+    std::chrono::steady_clock::time_point draftChangeTime_;  // Cache thread only
+    std::atomic<uint64_t> draftLoads_{0};
+    std::atomic<uint64_t> draftUpgrades_{0};
+
+    //=========================================================================
+    // Multi-layer caching (config_.multiLayerCache)
+    //=========================================================================
+
+    using PixelCache = ShardedLRU<int, std::shared_ptr<PixelData>>;
+    static constexpr size_t kMaxCachedLayers = 8;
+
+    // Layers of the sequence (active first) from the loader, or none
+    void BuildLayerSet();
+
+    // Initialize() for another cached layer of the same sequence: swaps the
+    // layer caches instead of clearing, keeps the planner's measurements
+    bool SwitchLayer(const std::string& layer, double fps);
+
+    // Load task: the other layers' frames, unless the load was cancelled
+    void StoreInactiveLayers(int frame, const std::vector<std::string>& layers,
+                             const std::vector<std::shared_ptr<PixelData>>& pixels,
+                             const CancelToken& cancel);
+
+    // Mirrors the cache window eviction of pixelCache_
+    void EvictInactiveLayers(int minFrame, int maxFrame);
+    void ClearLayerCaches();
+
+    mutable std::mutex layerMutex_;
+    std::vector<std::string> layerSet_;                          // Active layer first; empty = single layer
+    std::map<std::string, std::unique_ptr<PixelCache>> layerCaches_;  // Inactive layers
 
     // Small GL texture cache for recently used frames (created on-demand during GetTexture)
     // Keep this small (8-16 textures) to prevent GPU memory bloat
@@ -496,9 +707,11 @@ private:
     CacheDirection cacheDirection_ = CacheDirection::Forward;
     bool isPlaying_ = false;
 
-    // tlRender pattern: Pre-calculated frame size (from actual file, not estimated)
-    size_t actualFrameSize_ = 0;  // Calculated from first loaded frame
-    bool hasActualFrameSize_ = false;
+    // Read-ahead window and frame size from measured load cost (replaces fixed 72/180/4K estimates)
+    ReadAheadPlanner planner_;
+
+    // Page-cache hints for the files just past the read-ahead window
+    FilePrefetcher prefetcher_;
 
     // tlRender pattern: Fill frame counter (reset on seek for correct fill start)
     int cacheFillFrame_ = 0;
@@ -508,6 +721,21 @@ private:
     std::atomic<int> cacheIterationCount_{0};  // Track cache thread iterations
     int lastSeekFrame_{-1};  // Detect seeks to reset ramp-up
 
+    // Windowed-read benchmark, shared with its task (may outlive the cache)
+    struct WindowBenchmarkState {
+        std::atomic<bool> running{false};
+        std::mutex mutex;
+        WindowReadBenchmark result;     // Guarded by mutex
+    };
+    std::shared_ptr<WindowBenchmarkState> windowBenchmark_ = std::make_shared<WindowBenchmarkState>();
+
+    struct LRUBenchmarkState {
+        std::atomic<bool> running{false};
+        std::mutex mutex;
+        LRUBenchmarkResult result;      // Guarded by mutex
+    };
+    std::shared_ptr<LRUBenchmarkState> lruBenchmark_ = std::make_shared<LRUBenchmarkState>();
+
     // Cached segments (optimization - avoid rebuilding every UI frame)
     mutable std::mutex segmentMutex_;
     mutable std::vector<CacheSegment> cachedSegments_;
@@ -1,5 +1,6 @@
 #include "exr_transcoder.h"
 #include "../utils/debug_utils.h"
+#include "../utils/task_scheduler.h"
 #include "image_loaders.h"  // For TIFFLoader and PNGLoader
 
 #include <OpenEXR/ImfMultiPartInputFile.h>
@@ -8,7 +9,7 @@
 #include <OpenEXR/ImfFrameBuffer.h>
 #include <OpenEXR/ImfChannelList.h>
 
-#include "direct_exr_cache.h"  // For MemoryMappedIStream
+#include "direct_exr_cache.h"  // For MemoryMappedIStream / OpenFrameStream
 
 #include <filesystem>
 #include <sstream>
@@ -504,8 +505,17 @@ void EXRTranscoder::TranscodeWorker(
         return;
     }
 
-    // Parallel transcoding using async (similar to DirectEXRCache pattern)
-    Debug::Log("EXRTranscoder: Using " + std::to_string(config.threadCount) + " parallel threads");
+    // Parallel transcoding on the shared TaskScheduler (transcode class - yields to playback)
+    // The number of frames in flight adapts to the storage between min/max threadCount
+    AdaptiveConcurrencyController::Config concurrency;
+    concurrency.enabled = config.adaptiveConcurrency;
+    concurrency.min_limit = config.minThreadCount;
+    concurrency.max_limit = config.threadCount;
+    concurrency.initial_limit = std::min<size_t>(config.threadCount, 4);
+    concurrency_.SetConfig(concurrency);
+    concurrency_.Reset();
+    Debug::Log("EXRTranscoder: Using up to " + std::to_string(config.threadCount) + " parallel tasks" +
+               (config.adaptiveConcurrency ? " (adaptive, starting at " + std::to_string(concurrency_.GetLimit()) + ")" : ""));
 
     completed_count_ = 0;
     failed_count_ = 0;
@@ -518,7 +528,7 @@ void EXRTranscoder::TranscodeWorker(
     auto launch_task = [&](size_t frame_idx) -> bool {
         if (frame_idx >= source_files.size()) return false;
 
-        // Create copies of strings BEFORE async lambda (critical for parallel execution)
+        // Create copies of strings BEFORE task lambda (critical for parallel execution)
         std::string source_file = source_files[frame_idx];  // COPY, not reference
         std::filesystem::path source_path(source_file);
 
@@ -533,13 +543,20 @@ void EXRTranscoder::TranscodeWorker(
 
         std::string dest_file = (std::filesystem::path(transcode_dir) / output_filename).string();
 
-        // Launch async task - capture by VALUE to ensure each thread gets unique work
-        auto future = std::async(std::launch::async, [this, source_file, dest_file, layer,
+        // Submit task - capture by VALUE to ensure each task gets unique work
+        auto future = TaskScheduler::Shared().Submit(TaskPriority::Transcode, [this, source_file, dest_file, layer,
                                                        target_width, target_height,
                                                        compression = config.compression, is_exr]() -> bool {
             std::string error_message;
             bool success = false;
 
+            concurrency_.OnStart();
+            auto start = std::chrono::steady_clock::now();
+            std::error_code ec;
+            size_t bytes = static_cast<size_t>(std::filesystem::file_size(source_file, ec));
+            if (ec) bytes = 0;
+            ThrottledStorageSimulator::Shared().SimulateRead(bytes);
+
             // Call appropriate transcode method based on format
             if (is_exr) {
                 success = TranscodeFrame(source_file, dest_file, layer,
@@ -552,6 +569,14 @@ void EXRTranscoder::TranscodeWorker(
                                              compression, error_message);
             }
 
+            // Read + write volume drives the controller
+            if (success) {
+                size_t written = static_cast<size_t>(std::filesystem::file_size(dest_file, ec));
+                if (!ec) bytes += written;
+            }
+            double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+            concurrency_.OnComplete(ms, bytes, success);
+
             if (success) {
                 completed_count_.fetch_add(1);
             } else {
@@ -567,10 +592,15 @@ void EXRTranscoder::TranscodeWorker(
         return true;
     };
 
-    // Launch initial batch (up to threadCount tasks)
-    for (size_t i = 0; i < config.threadCount && next_frame_index < source_files.size(); i++) {
-        launch_task(next_frame_index++);
-    }
+    // Keep as many frames in flight as the controller currently allows
+    auto top_up = [&]() {
+        while (active_tasks.size() < concurrency_.GetLimit() && next_frame_index < source_files.size()) {
+            launch_task(next_frame_index++);
+        }
+    };
+
+    // Launch initial batch
+    top_up();
 
     // Main loop: wait for task completion and launch new ones
     while (!active_tasks.empty()) {
@@ -617,22 +647,21 @@ void EXRTranscoder::TranscodeWorker(
                 active_tasks.erase(active_tasks.begin() + i);
                 active_indices.erase(active_indices.begin() + i);
                 any_completed = true;
-
-                // Launch next frame if available
-                if (next_frame_index < source_files.size()) {
-                    launch_task(next_frame_index++);
-                }
             } else {
                 i++;
             }
         }
 
+        // Launch next frames (limit may have grown or shrunk)
+        top_up();
+
         // Update progress (thread-safe)
         int completed = completed_count_.load();
         int total = static_cast<int>(source_files.size());
         if (progress_callback && (any_completed || completed % 10 == 0)) {
             std::string message = "Transcoding frame " + std::to_string(completed) + "/" + std::to_string(total) +
-                                " (" + std::to_string(active_tasks.size()) + " active threads)";
+                                " (" + std::to_string(active_tasks.size()) + " active tasks, limit " +
+                                std::to_string(concurrency_.GetLimit()) + ")";
             progress_callback(completed, total, message);
         }
 
@@ -669,8 +698,9 @@ bool EXRTranscoder::TranscodeFrame(const std::string& source_path,
                                    Imf::Compression compression,
                                    std::string& error_message) {
     try {
-        // Read source EXR
-        auto stream = std::make_unique<MemoryMappedIStream>(source_path);
+        // Read source EXR (mapped, or read whole by the selected backend)
+        FileBytes bytes;
+        auto stream = OpenFrameStream(source_path, bytes, CancelToken());
         Imf::MultiPartInputFile file(*stream);
 
         const Imf::Header& header = file.header(0);
@@ -813,7 +843,7 @@ bool EXRTranscoder::TranscodeImageToEXR(const std::string& source_path,
         }
 
         // Load source image using appropriate loader
-        std::vector<uint8_t> pixel_data;
+        PixelBuffer pixel_data;
         int source_width = 0;
         int source_height = 0;
         PipelineMode mode = PipelineMode::NORMAL;
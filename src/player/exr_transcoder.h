@@ -13,6 +13,8 @@
 #include <OpenEXR/ImfHeader.h>
 #include <OpenEXR/ImfCompression.h>
 
+#include "../utils/adaptive_concurrency.h"
+
 extern "C" {
 #include <libswscale/swscale.h>
 #include <libavutil/pixfmt.h>
@@ -30,7 +32,9 @@ struct EXRTranscodeConfig {
     Imf::Compression compression = Imf::B44A_COMPRESSION;  // B44A default (lossy, 32:1 ratio, fast)
 
     // Parallel transcoding (similar to DirectEXRCache threadCount)
-    size_t threadCount = 8;        // Conservative default (write-heavy operation)
+    size_t threadCount = 8;        // Max parallel frames (write-heavy operation)
+    bool adaptiveConcurrency = true;  // AIMD between minThreadCount and threadCount
+    size_t minThreadCount = 1;
 
     // Future settings
     bool auto_transcode = false;   // Auto-suggest for multilayer
@@ -39,7 +43,8 @@ struct EXRTranscodeConfig {
 
     bool IsValid() const {
         return max_width >= 0 &&
-               threadCount >= 1 && threadCount <= 16;
+               threadCount >= 1 && threadCount <= 16 &&
+               minThreadCount >= 1 && minThreadCount <= threadCount;
     }
 };
 
@@ -90,6 +95,9 @@ public:
     // Check if transcode is running
     bool IsTranscoding() const { return is_transcoding_.load(); }
 
+    // Current parallel frame limit and the read/write throughput driving it
+    AdaptiveConcurrencyController::Stats GetConcurrencyStats() const { return concurrency_.GetStats(); }
+
     // Get/set cache directory
     void SetCacheDirectory(const std::string& path);
     std::string GetCacheDirectory() const { return cache_dir_; }
@@ -165,6 +173,9 @@ private:
     // Progress tracking for parallel transcoding
     std::atomic<int> completed_count_{0};
     std::atomic<int> failed_count_{0};
+
+    // Parallel frame limit (adapts to source/destination storage)
+    AdaptiveConcurrencyController concurrency_{"transcode"};
 };
 
 } // namespace ump
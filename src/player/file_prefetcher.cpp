@@ -0,0 +1,130 @@
+#include "file_prefetcher.h"
+#include "../utils/task_scheduler.h"
+
+#include <algorithm>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace ump {
+
+namespace {
+#if !defined(_WIN32) && defined(POSIX_FADV_WILLNEED)
+    // Returns the file size on success, 0 when the file couldn't be advised
+    uint64_t AdviseFile(const std::string& path, int advice) {
+        const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0) {
+            return 0;
+        }
+        struct stat st;
+        uint64_t size = 0;
+        if (::fstat(fd, &st) == 0 && st.st_size > 0 &&
+            ::posix_fadvise(fd, 0, 0, advice) == 0) {
+            size = static_cast<uint64_t>(st.st_size);
+        }
+        ::close(fd);
+        return size;
+    }
+#define UMP_HAS_FADVISE 1
+#endif
+}
+
+FilePrefetcher::FilePrefetcher()
+    : state_(std::make_shared<State>()) {
+}
+
+bool FilePrefetcher::IsSupported() {
+#ifdef UMP_HAS_FADVISE
+    return true;
+#else
+    return false;
+#endif
+}
+
+void FilePrefetcher::Prefetch(const std::vector<std::string>& files, int first, int count,
+                              const std::function<bool(int)>& skip) {
+    std::vector<std::string> batch;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        window_ = count;
+        if (!IsSupported()) {
+            return;
+        }
+        const int last = std::min(first + count, static_cast<int>(files.size()));
+        for (int frame = std::max(first, 0); frame < last; frame++) {
+            if (hinted_.count(frame) || (skip && skip(frame))) {
+                continue;
+            }
+            hinted_.insert(frame);
+            batch.push_back(files[frame]);
+        }
+    }
+    if (batch.empty()) {
+        return;
+    }
+
+#ifdef UMP_HAS_FADVISE
+    // WILLNEED only queues the reads, so one task covers the whole batch.
+    // A seek in the meantime bumps the epoch and the rest is skipped.
+    auto state = state_;
+    const uint64_t epoch = state->epoch.load();
+    TaskScheduler::Shared().Post(TaskPriority::Prefetch, [state, epoch, batch = std::move(batch)]() {
+        for (const std::string& path : batch) {
+            if (state->epoch.load() != epoch) {
+                return;
+            }
+            const uint64_t bytes = AdviseFile(path, POSIX_FADV_WILLNEED);
+            if (bytes > 0) {
+                state->hintedFiles++;
+                state->hintedBytes += bytes;
+            }
+        }
+    });
+#endif
+}
+
+void FilePrefetcher::Retain(int minFrame, int maxFrame) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    hinted_.erase(hinted_.begin(), hinted_.lower_bound(minFrame));
+    hinted_.erase(hinted_.upper_bound(maxFrame), hinted_.end());
+}
+
+void FilePrefetcher::Reset() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    state_->epoch++;
+    hinted_.clear();
+    window_ = 0;
+}
+
+void FilePrefetcher::Release(int frame, const std::string& path) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        hinted_.erase(frame);
+    }
+#ifdef UMP_HAS_FADVISE
+    if (AdviseFile(path, POSIX_FADV_DONTNEED) > 0) {
+        state_->releasedFiles++;
+    }
+#else
+    (void)path;
+#endif
+}
+
+FilePrefetcher::Stats FilePrefetcher::GetStats() const {
+    Stats stats;
+    stats.supported = IsSupported();
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stats.window = window_;
+        stats.outstanding = static_cast<int>(hinted_.size());
+    }
+    stats.hintedFiles = state_->hintedFiles.load();
+    stats.hintedBytes = state_->hintedBytes.load();
+    stats.releasedFiles = state_->releasedFiles.load();
+    return stats;
+}
+
+} // namespace ump
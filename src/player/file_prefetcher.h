@@ -0,0 +1,76 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace ump {
+
+//=============================================================================
+// FilePrefetcher - warms the OS page cache for files beyond the decode window
+//
+// On a cold cache every load waits for the disk before it can decode. The
+// prefetcher hints the files just past the read-ahead window to the kernel
+// (posix_fadvise WILLNEED), so they are read in the background while the
+// workers decode the current window. Once a frame is decoded into the pixel
+// cache its file pages are dropped again (Release), so the page cache never
+// holds a second copy of what the pixel cache already has.
+// - Hints run as Prefetch tasks on the shared TaskScheduler, one per batch
+// - A frame is hinted once until it is decoded, leaves the window or Reset()
+// - No-op where unsupported (Windows prefetches mapped views on open instead)
+//=============================================================================
+
+class FilePrefetcher {
+public:
+    struct Stats {
+        bool supported = false;
+        int window = 0;               // Files requested past the read-ahead window
+        int outstanding = 0;          // Hinted frames not decoded yet
+        uint64_t hintedFiles = 0;
+        uint64_t hintedBytes = 0;
+        uint64_t releasedFiles = 0;   // Decoded files dropped from the page cache
+    };
+
+    FilePrefetcher();
+
+    static bool IsSupported();
+
+    // Hint files[first, first + count) in order; frames already hinted or
+    // skipped by the predicate (e.g. already decoded) are left out
+    void Prefetch(const std::vector<std::string>& files, int first, int count,
+                  const std::function<bool(int)>& skip);
+
+    // Forget hints outside [minFrame, maxFrame] (playhead moved, queued batches stay)
+    void Retain(int minFrame, int maxFrame);
+
+    // Seek / new sequence: forget all hints and drop batches not yet run
+    void Reset();
+
+    // Frame decoded into the pixel cache: drop its pages (any thread)
+    void Release(int frame, const std::string& path);
+
+    Stats GetStats() const;
+
+private:
+    // Shared with queued tasks, which may outlive the owning cache
+    struct State {
+        std::atomic<uint64_t> epoch{0};
+        std::atomic<uint64_t> hintedFiles{0};
+        std::atomic<uint64_t> hintedBytes{0};
+        std::atomic<uint64_t> releasedFiles{0};
+    };
+
+    std::shared_ptr<State> state_;
+
+    mutable std::mutex mutex_;
+    std::set<int> hinted_;            // Guarded by mutex_
+    int window_ = 0;
+};
+
+} // namespace ump
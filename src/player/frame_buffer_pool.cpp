@@ -0,0 +1,133 @@
+#include "frame_buffer_pool.h"
+
+#include <algorithm>
+#include <cstdlib>
+
+#ifdef _WIN32
+    #include <malloc.h>
+#endif
+
+namespace ump {
+
+FrameBufferPool& FrameBufferPool::Shared() {
+    static FrameBufferPool* pool = new FrameBufferPool();
+    return *pool;
+}
+
+FrameBufferPool::~FrameBufferPool() {
+    Trim();
+}
+
+void* FrameBufferPool::AllocateAligned(size_t bytes) {
+    if (bytes == 0) bytes = kAlignment;
+#ifdef _WIN32
+    void* p = _aligned_malloc(bytes, kAlignment);
+    if (!p) throw std::bad_alloc();
+    return p;
+#else
+    void* p = nullptr;
+    if (posix_memalign(&p, kAlignment, bytes) != 0) throw std::bad_alloc();
+    return p;
+#endif
+}
+
+void FrameBufferPool::FreeAligned(void* ptr) {
+#ifdef _WIN32
+    _aligned_free(ptr);
+#else
+    free(ptr);
+#endif
+}
+
+void* FrameBufferPool::Acquire(size_t bytes) {
+    if (bytes >= kMinPooledBytes) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = free_.find(bytes);
+        if (it != free_.end() && !it->second.empty()) {
+            void* p = it->second.back();
+            it->second.pop_back();
+            pooledBytes_ -= bytes;
+            pooledBuffers_--;
+            hits_++;
+            return p;
+        }
+        misses_++;
+    }
+    return AllocateAligned(bytes);
+}
+
+void FrameBufferPool::Release(void* ptr, size_t bytes) {
+    if (!ptr) return;
+
+    if (bytes >= kMinPooledBytes) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (pooledBytes_ + bytes > maxPooledBytes_) {
+            MakeRoomLocked(bytes, bytes);
+        }
+        if (pooledBytes_ + bytes <= maxPooledBytes_) {
+            free_[bytes].push_back(ptr);
+            pooledBytes_ += bytes;
+            pooledBuffers_++;
+            return;
+        }
+        dropped_++;
+    }
+    FreeAligned(ptr);
+}
+
+void FrameBufferPool::MakeRoomLocked(size_t incoming, size_t keep_size) {
+    // Other size classes go first: a resolution change leaves stale classes behind
+    for (int pass = 0; pass < 2 && pooledBytes_ + incoming > maxPooledBytes_; ++pass) {
+        for (auto it = free_.begin(); it != free_.end() && pooledBytes_ + incoming > maxPooledBytes_; ) {
+            if (pass == 0 && it->first == keep_size) {
+                ++it;
+                continue;
+            }
+            auto& buffers = it->second;
+            while (!buffers.empty() && pooledBytes_ + incoming > maxPooledBytes_) {
+                FreeAligned(buffers.back());
+                buffers.pop_back();
+                pooledBytes_ -= it->first;
+                pooledBuffers_--;
+            }
+            it = buffers.empty() ? free_.erase(it) : std::next(it);
+        }
+    }
+}
+
+void FrameBufferPool::SetMaxPooledBytes(size_t bytes) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    maxPooledBytes_ = bytes;
+    MakeRoomLocked(0, 0);
+}
+
+size_t FrameBufferPool::GetMaxPooledBytes() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return maxPooledBytes_;
+}
+
+void FrameBufferPool::Trim() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto& pair : free_) {
+        for (void* p : pair.second) {
+            FreeAligned(p);
+        }
+    }
+    free_.clear();
+    pooledBytes_ = 0;
+    pooledBuffers_ = 0;
+}
+
+FrameBufferPool::Stats FrameBufferPool::GetStats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    Stats stats;
+    stats.pooled_bytes = pooledBytes_;
+    stats.pooled_buffers = pooledBuffers_;
+    stats.max_pooled_bytes = maxPooledBytes_;
+    stats.hits = hits_;
+    stats.misses = misses_;
+    stats.dropped = dropped_;
+    return stats;
+}
+
+} // namespace ump
@@ -0,0 +1,128 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <new>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace ump {
+
+//=============================================================================
+// FrameBufferPool - recycles frame-sized pixel buffers
+//
+// Every frame load used to allocate a fresh vector and zero-fill it (~66 MB
+// for 4K RGBA half) just before the decoder overwrote it, while evicted frames
+// of the exact same size were being freed. The pool keeps released buffers in
+// size classes (exact byte size = width x height x pixel type) and hands them
+// back out already faulted in.
+// - Buffers are 64-byte aligned and never zero-filled (see PooledFrameAllocator)
+// - Idle pooled bytes are capped; DirectEXRCache carves the cap out of its own
+//   budget so cache + pool stays within the configured cache size
+// - Small buffers (< kMinPooledBytes) bypass the pool
+//=============================================================================
+
+class FrameBufferPool {
+public:
+    struct Stats {
+        size_t pooled_bytes = 0;     // Idle bytes held for reuse
+        size_t pooled_buffers = 0;
+        size_t max_pooled_bytes = 0;
+        uint64_t hits = 0;           // Acquires served from the pool
+        uint64_t misses = 0;         // Acquires that hit the system allocator
+        uint64_t dropped = 0;        // Releases freed because the pool was full
+    };
+
+    static constexpr size_t kAlignment = 64;
+    static constexpr size_t kMinPooledBytes = 64 * 1024;
+
+    // Process-wide pool (never destroyed - buffers may be released during static teardown)
+    static FrameBufferPool& Shared();
+
+    FrameBufferPool() = default;
+    ~FrameBufferPool();
+
+    FrameBufferPool(const FrameBufferPool&) = delete;
+    FrameBufferPool& operator=(const FrameBufferPool&) = delete;
+
+    // Uninitialized, kAlignment-aligned buffer of exactly 'bytes'
+    void* Acquire(size_t bytes);
+    void Release(void* ptr, size_t bytes);
+
+    // Cap on idle pooled bytes (shrinks immediately if lowered)
+    void SetMaxPooledBytes(size_t bytes);
+    size_t GetMaxPooledBytes() const;
+
+    // Free every idle buffer (sequence change, memory pressure)
+    void Trim();
+
+    Stats GetStats() const;
+
+private:
+    static void* AllocateAligned(size_t bytes);
+    static void FreeAligned(void* ptr);
+
+    // Frees idle buffers of other sizes until 'incoming' more bytes fit (mutex_ held)
+    void MakeRoomLocked(size_t incoming, size_t keep_size);
+
+    mutable std::mutex mutex_;
+    std::unordered_map<size_t, std::vector<void*>> free_;  // byte size -> idle buffers
+    size_t pooledBytes_ = 0;
+    size_t pooledBuffers_ = 0;
+    size_t maxPooledBytes_ = size_t(1) << 30;  // 1 GB until a cache sets its budget
+    uint64_t hits_ = 0;
+    uint64_t misses_ = 0;
+    uint64_t dropped_ = 0;
+};
+
+//=============================================================================
+// PooledFrameAllocator - std::allocator replacement backed by FrameBufferPool
+// Default-initializes on resize(), so resizing a pixel buffer doesn't memset it.
+//=============================================================================
+
+template<typename T>
+class PooledFrameAllocator {
+public:
+    using value_type = T;
+
+    template<typename U>
+    struct rebind {
+        using other = PooledFrameAllocator<U>;
+    };
+
+    PooledFrameAllocator() = default;
+    template<typename U>
+    PooledFrameAllocator(const PooledFrameAllocator<U>&) {}
+
+    T* allocate(size_t n) {
+        return static_cast<T*>(FrameBufferPool::Shared().Acquire(n * sizeof(T)));
+    }
+
+    void deallocate(T* p, size_t n) {
+        FrameBufferPool::Shared().Release(p, n * sizeof(T));
+    }
+
+    // resize(n) calls construct(p) - default-init leaves the bytes alone
+    template<typename U>
+    void construct(U* p) noexcept {
+        ::new (static_cast<void*>(p)) U;
+    }
+
+    template<typename U, typename... Args>
+    void construct(U* p, Args&&... args) {
+        ::new (static_cast<void*>(p)) U(std::forward<Args>(args)...);
+    }
+
+    template<typename U>
+    bool operator==(const PooledFrameAllocator<U>&) const { return true; }
+
+    template<typename U>
+    bool operator!=(const PooledFrameAllocator<U>&) const { return false; }
+};
+
+// Frame pixel storage: resize() leaves contents uninitialized - loaders must write every byte
+using PixelBuffer = std::vector<uint8_t, PooledFrameAllocator<uint8_t>>;
+
+} // namespace ump
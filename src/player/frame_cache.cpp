@@ -2,6 +2,7 @@
 #include "media_background_extractor.h"
 #include "video_player.h"
 #include "../metadata/video_metadata.h"
+#include "../gpu/texture_uploader.h"
 #include "../utils/debug_utils.h"
 #include <algorithm>
 #include <thread>
@@ -40,6 +41,9 @@ CachedFrame::CachedFrame(CachedFrame&& other) noexcept
     , pixel_data(std::move(other.pixel_data))
     , texture_created(other.texture_created)
     , pipeline_mode(other.pipeline_mode)
+    , shared_texture(std::move(other.shared_texture))
+    , fingerprint(other.fingerprint)
+    , content_bytes(other.content_bytes)
 {
     other.texture_id = 0;
     other.width = 0;
@@ -63,6 +67,9 @@ CachedFrame& CachedFrame::operator=(CachedFrame&& other) noexcept {
         pixel_data = std::move(other.pixel_data);
         texture_created = other.texture_created;
         pipeline_mode = other.pipeline_mode;
+        shared_texture = std::move(other.shared_texture);
+        fingerprint = other.fingerprint;
+        content_bytes = other.content_bytes;
 
         other.texture_id = 0;
         other.width = 0;
@@ -86,17 +93,14 @@ void CachedFrame::CreateTexture(int w, int h, const void* data, PipelineMode pip
 
     const PipelineConfig& config = it->second;
 
-    glGenTextures(1, &texture_id);
-    glBindTexture(GL_TEXTURE_2D, texture_id);
-
-    // Use pipeline-appropriate texture format
-    glTexImage2D(GL_TEXTURE_2D, 0, config.internal_format, w, h, 0, GL_RGBA, config.data_type, data);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-    
-    glBindTexture(GL_TEXTURE_2D, 0);
+    // Use pipeline-appropriate texture format (recycled immutable texture from the shared uploader)
+    ump::UploadFormat format;
+    format.width = w;
+    format.height = h;
+    format.internal_format = config.internal_format;
+    format.format = GL_RGBA;
+    format.type = config.data_type;
+    texture_id = ump::TextureUploader::Shared().UploadNow(format, data);
     
     width = w;
     height = h;
@@ -145,8 +149,11 @@ bool CachedFrame::EnsureTextureCreated() {
 }
 
 void CachedFrame::ReleaseTexture() {
-    if (texture_id != 0) {
-        glDeleteTextures(1, &texture_id);
+    if (shared_texture) {
+        shared_texture.reset();  // Last frame sharing it releases the texture
+        texture_id = 0;
+    } else if (texture_id != 0) {
+        ump::TextureUploader::Shared().ReleaseTexture(texture_id);
         texture_id = 0;
     }
     width = 0;
@@ -170,9 +177,11 @@ FrameCache::FrameCache(const CacheConfig& cfg) : config(cfg) {
     extractor_config.max_batch_size = config.max_batch_size;
     extractor_config.max_concurrent_batches = config.max_concurrent_batches;
     extractor_config.pause_during_playback = config.pause_during_playback;
+    extractor_config.reverse_read_ahead_seconds = config.reverse_read_ahead_seconds;
     extractor_config.hw_config.mode = config.enable_nvidia_decode ? HardwareDecodeMode::NVDEC : HardwareDecodeMode::D3D11VA;
 
     background_extractor = std::make_unique<MediaBackgroundExtractor>(this, extractor_config);
+    background_extractor->SetContentHashing(config.dedup_identical_frames);
     Debug::Log("FrameCache: Created MediaBackgroundExtractor");
 
     // Removed: Disk cache initialization (simplified to RAM-only cache)
@@ -322,6 +331,39 @@ void FrameCache::BackgroundCacheWorker() {
             continue;
         }
 
+        // The packet index replaces frame-rate numbering (VFR, odd start times):
+        // frames cached and queued under the old numbers are keyed wrong
+        if (background_extractor->TakePacketIndexArrival()) {
+            Debug::Log("FrameCache: Packet index arrived - dropping frames numbered by frame rate");
+            ClearCachedFrames();
+        }
+
+        // Reverse playback: re-request the window once the playhead has moved back
+        // a quarter of it (per-UI-frame steps are far below any per-call threshold),
+        // and keep the reverse read-ahead inside the eviction window
+        if (reverse_playback.load()) {
+            double position = current_scrub_position.load();
+            double requested = reverse_window_position.load();
+            if (requested - position >= config.reverse_read_ahead_seconds / 4.0 || position > requested) {
+                background_extractor->RequestReverseWindow(position);
+                reverse_window_position = position;
+            }
+
+            static int reverse_eviction_counter = 0;
+            if (++reverse_eviction_counter % 10 == 0) {
+                double behind = (std::max)(0.0, config.reverse_read_ahead_seconds - config.max_cache_seconds / 2.0);
+                EvictFramesBeyondSeconds(current_scrub_position.load() - behind, config.max_cache_seconds);
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            continue;
+        }
+
+        // Trick play: only the shuttle's keyframes are decoded
+        if (trick_play.load()) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(50));
+            continue;
+        }
+
         // Much more aggressive throttling during playback to prevent stutter
         bool is_playing = main_player_is_playing.load();
 
@@ -710,7 +752,8 @@ void FrameCache::AddExtractedFrame(int frame_number, double timestamp, GLuint te
     //           " (" + std::to_string(timestamp) + "s) to cache");
 }
 
-void FrameCache::AddExtractedFrame(int frame_number, double timestamp, const std::vector<uint8_t>& pixel_data, int width, int height, bool from_native_image) {
+void FrameCache::AddExtractedFrame(int frame_number, double timestamp, const std::vector<uint8_t>& pixel_data, int width, int height, bool from_native_image, bool packed_10bit,
+                                   const ump::ContentFingerprint& fingerprint) {
     std::lock_guard<std::mutex> lock(cache_mutex);
 
     // Check if frame already exists
@@ -718,13 +761,30 @@ void FrameCache::AddExtractedFrame(int frame_number, double timestamp, const std
         return;
     }
 
-    // Create texture from pixel data on main thread (correct OpenGL context)
-    GLuint texture_id = 0;
-    glGenTextures(1, &texture_id);
-
-    if (texture_id == 0) {
-        Debug::Log("FrameCache: Failed to create texture for extracted frame " + std::to_string(frame_number));
-        return;
+    // Identical content already cached (held frames, slates): share its texture
+    const bool dedup = config.dedup_identical_frames && fingerprint.IsValid();
+    if (dedup) {
+        auto indexed = content_index.find(fingerprint.sample);
+        auto source = indexed != content_index.end() ? scrub_cache.find(indexed->second) : scrub_cache.end();
+        if (source != scrub_cache.end() && source->second->shared_texture &&
+            source->second->fingerprint == fingerprint &&
+            source->second->width == width && source->second->height == height) {
+            const CachedFrame& original = *source->second;
+            auto cached_frame = std::make_unique<CachedFrame>();
+            cached_frame->timestamp = timestamp;
+            cached_frame->width = width;
+            cached_frame->height = height;
+            cached_frame->is_valid = true;
+            cached_frame->last_accessed = std::chrono::steady_clock::now();
+            cached_frame->texture_id = original.texture_id;
+            cached_frame->texture_created = true;
+            cached_frame->pipeline_mode = original.pipeline_mode;
+            cached_frame->shared_texture = original.shared_texture;
+            cached_frame->fingerprint = fingerprint;
+            cached_frame->content_bytes = original.content_bytes;
+            scrub_cache[frame_number] = std::move(cached_frame);
+            return;
+        }
     }
 
     // Get pipeline-specific format configuration
@@ -734,14 +794,8 @@ void FrameCache::AddExtractedFrame(int frame_number, double timestamp, const std
     }
     const PipelineConfig& pipeline_config = it->second;
 
-    glBindTexture(GL_TEXTURE_2D, texture_id);
-
-    // Ensure proper alignment for texture upload
-    // RGBA data (4 channels) is naturally 4-byte aligned, so use default alignment
-    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
-
     // DIAGNOSTIC: Log first non-zero pixel for texture upload verification
-    if (config.pipeline_mode == PipelineMode::HIGH_RES && pixel_data.size() >= 16) {
+    if (config.pipeline_mode == PipelineMode::HIGH_RES && !packed_10bit && pixel_data.size() >= 16) {
         const uint16_t* pixels16 = reinterpret_cast<const uint16_t*>(pixel_data.data());
         // Find first non-zero pixel
         bool found_nonzero = false;
@@ -763,15 +817,23 @@ void FrameCache::AddExtractedFrame(int frame_number, double timestamp, const std
         }
     }
 
-    glTexImage2D(GL_TEXTURE_2D, 0, pipeline_config.internal_format, width, height, 0,
-                 GL_RGBA, pipeline_config.data_type, pixel_data.data());
-
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    // Create texture from pixel data on main thread (correct OpenGL context)
+    ump::UploadFormat format;
+    format.width = width;
+    format.height = height;
+    format.internal_format = pipeline_config.internal_format;
+    format.format = GL_RGBA;
+    format.type = pipeline_config.data_type;
+    if (packed_10bit) {
+        format.type = GL_UNSIGNED_INT_2_10_10_10_REV;
+        format.internal_format = ump::StorageInternalFormat(format.format, format.type);  // RGB10_A2
+    }
+    GLuint texture_id = ump::TextureUploader::Shared().UploadNow(format, pixel_data.data());
 
-    glBindTexture(GL_TEXTURE_2D, 0);
+    if (texture_id == 0) {
+        Debug::Log("FrameCache: Failed to create texture for extracted frame " + std::to_string(frame_number));
+        return;
+    }
 
     // Create cached frame entry
     auto cached_frame = std::make_unique<CachedFrame>();
@@ -785,6 +847,21 @@ void FrameCache::AddExtractedFrame(int frame_number, double timestamp, const std
     cached_frame->texture_created = true;
     cached_frame->pipeline_mode = config.pipeline_mode;  // Store pipeline mode for consistency
 
+    if (dedup) {
+        cached_frame->shared_texture = std::shared_ptr<GLuint>(new GLuint(texture_id), [](GLuint* texture) {
+            ump::TextureUploader::Shared().ReleaseTexture(*texture);
+            delete texture;
+        });
+        cached_frame->fingerprint = fingerprint;
+        cached_frame->content_bytes = pixel_data.size();
+        if (content_index.size() > scrub_cache.size() * 2 + 256) {
+            for (auto it = content_index.begin(); it != content_index.end(); ) {
+                it = scrub_cache.count(it->second) ? std::next(it) : content_index.erase(it);
+            }
+        }
+        content_index[fingerprint.sample] = frame_number;  // Replaces an evicted frame's entry
+    }
+
     // Removed: memory usage tracking (memory-based eviction removed)
 
     // Add to cache
@@ -799,12 +876,26 @@ bool FrameCache::IsFrameCached(int frame_number) const {
     return scrub_cache.find(frame_number) != scrub_cache.end();
 }
 
+bool FrameCache::HasFrameAt(double timestamp) const {
+    std::lock_guard<std::mutex> lock(cache_mutex);
+    if (cached_video_player == nullptr) {
+        return false;
+    }
+    int frame_number = TimestampToFrameNumber(timestamp, cached_video_player->GetFrameRate());
+    return scrub_cache.find(frame_number) != scrub_cache.end();
+}
+
 int FrameCache::TimestampToFrameNumber(double timestamp, double fps) const {
     // ACCURACY FIX: Use consistent frame rate source and account for start time offset
     if (!background_extractor || !background_extractor->IsInitialized()) {
         return static_cast<int>(std::round(timestamp * fps));
     }
 
+    // Packet index built: exact frame for the timestamp (VFR safe)
+    if (auto index = background_extractor->GetPacketIndex()) {
+        return index->FrameAtTime(timestamp);
+    }
+
     // For videos: Use FFmpeg's detected frame rate for consistency with frame extraction
     double effective_fps = background_extractor->GetFrameRate();
     if (effective_fps <= 0) {
@@ -846,6 +937,10 @@ double FrameCache::FrameNumberToTimestamp(int frame_number, double fps) const {
         return frame_number / fps;
     }
 
+    if (auto index = background_extractor->GetPacketIndex()) {
+        return index->FrameTime(frame_number);
+    }
+
     // For videos: Use FFmpeg's detected frame rate for consistency
     double effective_fps = background_extractor->GetFrameRate();
     if (effective_fps <= 0) {
@@ -981,9 +1076,16 @@ void FrameCache::EvictFramesBeyondSeconds(double center_timestamp, int max_secon
 
 
 FrameCache::CacheStats FrameCache::GetStats() const {
-    std::lock_guard<std::mutex> lock(cache_mutex);
-    
     CacheStats stats;
+
+    // Before cache_mutex: extractor tasks hold their queue lock while checking the cache
+    if (background_extractor) {
+        auto extractor_stats = background_extractor->GetStats();
+        stats.frames_decoded = extractor_stats.total_frames_decoded;
+        stats.frames_delivered = extractor_stats.total_frames_extracted;
+    }
+
+    std::lock_guard<std::mutex> lock(cache_mutex);
     stats.total_frames_cached = scrub_cache.size() + keyframe_cache.size();
     // Removed: memory_used_mb (memory-based eviction removed)
     stats.cache_hits = cache_hits.load();
@@ -991,6 +1093,16 @@ FrameCache::CacheStats FrameCache::GetStats() const {
     
     size_t total_requests = stats.cache_hits + stats.cache_misses;
     stats.hit_ratio = total_requests > 0 ? (float)stats.cache_hits / total_requests : 0.0f;
+
+    // Frames sharing a texture beyond the first
+    std::unordered_map<GLuint, int> texture_users;
+    for (const auto& pair : scrub_cache) {
+        const CachedFrame& frame = *pair.second;
+        if (frame.shared_texture && texture_users[frame.texture_id]++ > 0) {
+            stats.dedup_frames++;
+            stats.dedup_bytes += frame.content_bytes;
+        }
+    }
     
     // Calculate coverage range
     if (!scrub_cache.empty() && cached_video_player) {
@@ -1004,6 +1116,31 @@ FrameCache::CacheStats FrameCache::GetStats() const {
     return stats;
 }
 
+void FrameCache::SetReversePlayback(bool reverse, double playhead_timestamp) {
+    if (reverse) {
+        current_scrub_position = playhead_timestamp;
+        reverse_window_position = playhead_timestamp;
+    }
+    reverse_playback = reverse;
+    if (background_extractor) {
+        background_extractor->SetReversePlayback(reverse, playhead_timestamp);
+    }
+}
+
+void FrameCache::SetTrickPlay(bool enabled) {
+    trick_play = enabled;
+    if (background_extractor) {
+        background_extractor->SetTrickPlay(enabled);
+    }
+}
+
+bool FrameCache::RequestTrickPlayKeyframe(double timestamp, bool forward, double& keyframe_timestamp) {
+    if (!background_extractor || !background_extractor->IsInitialized()) {
+        return false;
+    }
+    return background_extractor->RequestKeyframe(timestamp, forward, keyframe_timestamp);
+}
+
 void FrameCache::NotifyPlaybackState(bool is_playing) {
     main_player_is_playing = is_playing;
 
@@ -1112,6 +1249,7 @@ void FrameCache::InvalidateCache() {
 
     scrub_cache.clear();
     keyframe_cache.clear();
+    content_index.clear();
     // Removed: current_cache_size reset (memory-based eviction removed)
     // Debug::Log("FrameCache: Cache invalidated");
 }
@@ -1128,6 +1266,11 @@ void FrameCache::SetCacheConfig(const CacheConfig& new_config) {
 
     config = new_config;
 
+    if (background_extractor) {
+        background_extractor->SetContentHashing(config.dedup_identical_frames);
+        background_extractor->SetReverseReadAhead(config.reverse_read_ahead_seconds);
+    }
+
     // If mode changed, clear existing cache and reset state
     if (mode_changed) {
         InvalidateCache();
@@ -1161,6 +1304,7 @@ void FrameCache::ClearCachedFrames() {
     // Clear all cached frames but keep the cache structure
     scrub_cache.clear();     // Main RAM cache
     keyframe_cache.clear();  // Keyframe cache
+    content_index.clear();
 
     Debug::Log("FrameCache: Cleared all cached frames (kept cache structure)");
 
@@ -18,6 +18,7 @@ class GPUFrameCache;
 class MediaBackgroundExtractor;
 struct VideoMetadata;
 #include "pipeline_mode.h"
+#include "../utils/content_hash.h"
 
 // Forward declaration - defined in mpv_extractor.h
 struct MPVConversionStrategy;
@@ -38,7 +39,12 @@ struct CachedFrame {
     std::vector<uint8_t> pixel_data;
     bool texture_created = false;
     PipelineMode pipeline_mode = PipelineMode::NORMAL;  // Store pipeline mode for texture creation
-    
+
+    // Deduplication: identical frames share one texture, released with the last of them
+    std::shared_ptr<GLuint> shared_texture;
+    ump::ContentFingerprint fingerprint;
+    size_t content_bytes = 0;
+
     CachedFrame() = default;
     ~CachedFrame();
     
@@ -59,6 +65,7 @@ public:
     struct CacheConfig {
         // RAM Cache settings
         int max_cache_seconds = 20;             // Maximum seconds of video to cache (NEW: replaces memory limit)
+        int reverse_read_ahead_seconds = 4;     // Decoded behind the playhead in reverse playback
         bool use_centered_caching = true;       // true = center around seekbar, false = sequential full video
         int cache_width = 1920;                 // Fixed width for consistent quality
         int cache_height = -1;                  // Calculate from video aspect ratio
@@ -79,6 +86,9 @@ public:
         // Pipeline format settings
         PipelineMode pipeline_mode = PipelineMode::NORMAL;  // Current pipeline mode for texture format
 
+        // Identical frames (held frames, slates) share one texture
+        bool dedup_identical_frames = false;
+
         // Removed: Disk cache settings (simplified to RAM-only cache)
     };
 
@@ -89,6 +99,15 @@ public:
     bool GetCachedFrame(double timestamp, GLuint& texture_id, int& width, int& height);
     void UpdateScrubPosition(double timestamp, VideoPlayer* video_player);
     void NotifyPlaybackState(bool is_playing); // Inform cache about playback state
+    void SetReversePlayback(bool reverse, double playhead_timestamp = 0.0);  // Decode GOPs behind the playhead instead of around it
+    bool IsReversePlayback() const { return reverse_playback.load(); }
+    bool HasFrameAt(double timestamp) const;   // Exact frame cached (no nearby-frame tolerance)
+
+    // Trick play: keyframes only while shuttling fast. RequestTrickPlayKeyframe
+    // returns the timestamp of the keyframe to show (false while keyframes are unknown).
+    void SetTrickPlay(bool enabled);
+    bool IsTrickPlay() const { return trick_play.load(); }
+    bool RequestTrickPlayKeyframe(double timestamp, bool forward, double& keyframe_timestamp);
     void SetVideoFile(const std::string& video_path, const VideoMetadata* metadata = nullptr);
     void UpdateVideoMetadata(const std::string& video_path, const VideoMetadata& metadata);
     void InvalidateCache();
@@ -103,6 +122,10 @@ public:
         float hit_ratio = 0.0f;
         double coverage_start = 0.0;
         double coverage_end = 0.0;
+        size_t dedup_frames = 0;    // Frames sharing another frame's texture
+        size_t dedup_bytes = 0;     // Pixel bytes not uploaded thanks to sharing
+        size_t frames_decoded = 0;  // Background extractor, including GOP pre-roll
+        size_t frames_delivered = 0;
     };
     CacheStats GetStats() const;
     
@@ -135,7 +158,8 @@ public:
 
     // Background extractor integration
     void AddExtractedFrame(int frame_number, double timestamp, GLuint texture_id, int width, int height); // Called by background extractor
-    void AddExtractedFrame(int frame_number, double timestamp, const std::vector<uint8_t>& pixel_data, int width, int height, bool from_native_image = false); // Called by background extractor with pixel data
+    void AddExtractedFrame(int frame_number, double timestamp, const std::vector<uint8_t>& pixel_data, int width, int height, bool from_native_image = false, bool packed_10bit = false,
+                           const ump::ContentFingerprint& fingerprint = {}); // Called by background extractor with pixel data
     bool IsFrameCached(int frame_number) const; // Check if frame is already cached
 
     // Removed: Disk cache interface (simplified to RAM-only cache)
@@ -147,6 +171,9 @@ private:
     std::unordered_map<int, std::unique_ptr<CachedFrame>> scrub_cache;    // Frame number -> cached frame
     std::unordered_map<int, std::unique_ptr<CachedFrame>> keyframe_cache; // Keyframe cache for long seeks
     mutable std::mutex cache_mutex;
+
+    // Deduplication: sampled fingerprint -> a cached frame with that content (cache_mutex)
+    std::unordered_map<uint64_t, int> content_index;
     
     // Removed: Memory management tracking (memory-based eviction removed)
     std::atomic<size_t> cache_hits{0};
@@ -159,6 +186,9 @@ private:
     std::atomic<bool> caching_enabled{true};
     std::atomic<double> current_scrub_position{0.0};
     std::atomic<bool> main_player_is_playing{false};
+    std::atomic<bool> reverse_playback{false};
+    std::atomic<double> reverse_window_position{0.0};  // Playhead the reverse window was last requested for
+    std::atomic<bool> trick_play{false};
     VideoPlayer* cached_video_player = nullptr;
     
     // Rate limiting removed - only RAM limit constrains caching
@@ -0,0 +1,86 @@
+#include "frame_dedup_index.h"
+#include "../utils/content_hash.h"
+
+#include <iterator>
+
+namespace ump {
+
+uint64_t FrameDedupIndex::Key(uint64_t sample, int level) {
+    return sample ^ (static_cast<uint64_t>(level) * 0x9E3779B97F4A7C15ull);
+}
+
+std::shared_ptr<PixelData> FrameDedupIndex::Find(const std::string& path, int level, uint64_t& sample) {
+    sample = SampleHashFile(path);
+    if (sample == 0) {
+        return nullptr;
+    }
+
+    Record candidate;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = records_.find(Key(sample, level));
+        if (it == records_.end()) {
+            return nullptr;
+        }
+        candidate = it->second;
+    }
+
+    // Same file loading again (e.g. a draft replaced at full resolution) isn't a duplicate
+    std::shared_ptr<PixelData> pixels = candidate.pixels.lock();
+    if (!pixels || pixels->draft_level != level || candidate.path == path) {
+        return nullptr;
+    }
+
+    // Confirm outside the lock: both files read in full
+    const uint64_t candidateHash = candidate.fullHash ? candidate.fullHash : HashFile(candidate.path);
+    const uint64_t hash = HashFile(path);
+    const bool match = hash != 0 && hash == candidateHash;
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = records_.find(Key(sample, level));
+    if (it != records_.end() && it->second.path == candidate.path) {
+        it->second.fullHash = candidateHash;
+    }
+    stats_.sampleMatches++;
+    (match ? stats_.confirmed : stats_.rejected)++;
+    return match ? pixels : nullptr;
+}
+
+void FrameDedupIndex::Remember(uint64_t sample, const std::string& path, const std::shared_ptr<PixelData>& pixels) {
+    if (sample == 0 || !pixels) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    const uint64_t key = Key(sample, pixels->draft_level);
+    auto it = records_.find(key);
+    if (it != records_.end() && !it->second.pixels.expired()) {
+        return;  // Earlier copy still cached - keep sharing that one
+    }
+
+    if (it == records_.end() && records_.size() >= kMaxRecords) {
+        for (auto r = records_.begin(); r != records_.end(); ) {
+            r = r->second.pixels.expired() ? records_.erase(r) : std::next(r);
+        }
+        if (records_.size() >= kMaxRecords) {
+            records_.clear();
+        }
+    }
+
+    Record& record = records_[key];
+    record.path = path;
+    record.fullHash = 0;
+    record.pixels = pixels;
+}
+
+void FrameDedupIndex::Clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    records_.clear();
+}
+
+FrameDedupIndex::Stats FrameDedupIndex::GetStats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return stats_;
+}
+
+} // namespace ump
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "image_loader_interface.h"
+
+namespace ump {
+
+//=============================================================================
+// FrameDedupIndex - identical sequence frames share one decode
+//
+// Renders with held frames, static slates or frames copied to fill gaps repeat
+// the same file content under different frame numbers. Before a load decodes
+// a file, the index looks up the file's sampled fingerprint (size, header and
+// a few blocks); when frames with that fingerprint are still cached, both
+// files are hashed in full to confirm, and the load returns the cached pixels
+// instead of decoding - the caches then hold one buffer (and one texture) for
+// all the copies.
+// - Records hold weak references: the index never keeps pixels alive
+// - A first decode's full hash is taken only once something matches it
+// - One index per cache; Clear() on a new sequence or layer
+//=============================================================================
+
+class FrameDedupIndex {
+public:
+    struct Stats {
+        uint64_t sampleMatches = 0;     // Sampled fingerprint matched a cached frame
+        uint64_t confirmed = 0;         // Full hashes equal - pixels shared
+        uint64_t rejected = 0;          // Full hashes differ (fingerprint collision)
+    };
+
+    // Pixels decoded at 'level' from another file with this file's content,
+    // or nullptr. 'sample' returns the file's fingerprint for Remember() (0 = unreadable).
+    std::shared_ptr<PixelData> Find(const std::string& path, int level, uint64_t& sample);
+
+    // First decode of this content: later identical files share 'pixels' while it lives
+    void Remember(uint64_t sample, const std::string& path, const std::shared_ptr<PixelData>& pixels);
+
+    void Clear();
+    Stats GetStats() const;
+
+private:
+    struct Record {
+        std::string path;
+        uint64_t fullHash = 0;          // 0 = not hashed yet
+        std::weak_ptr<PixelData> pixels;
+    };
+
+    static uint64_t Key(uint64_t sample, int level);
+
+    static constexpr size_t kMaxRecords = 4096;
+
+    mutable std::mutex mutex_;
+    std::unordered_map<uint64_t, Record> records_;
+    Stats stats_;
+};
+
+} // namespace ump
@@ -0,0 +1,699 @@
+#include "frame_file_reader.h"
+#include "../utils/debug_utils.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+
+#ifdef _WIN32
+#include <windows.h>
+#undef min
+#undef max
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#if defined(__linux__) && defined(__has_include)
+#if __has_include(<linux/io_uring.h>)
+#include <linux/io_uring.h>
+#include <sys/syscall.h>
+#define UMP_HAS_IO_URING 1
+#endif
+#endif
+
+namespace ump {
+
+namespace {
+    constexpr size_t kSizeClassBytes = 1024 * 1024;  // Buffer sizes round up to this (pool reuse)
+    constexpr size_t kMaxRegisteredBytes = size_t(256) << 20;  // Larger files use unregistered reads
+    constexpr unsigned kRingEntries = 64;             // SQEs in flight per file
+
+    size_t RoundUp(size_t value, size_t multiple) {
+        return (value + multiple - 1) / multiple * multiple;
+    }
+
+    uint8_t* AlignPointer(void* ptr) {
+        const uintptr_t p = reinterpret_cast<uintptr_t>(ptr);
+        return reinterpret_cast<uint8_t*>(RoundUp(p, FrameFileReader::kAlignment));
+    }
+
+    // Storage for 'size' file bytes, aligned and padded to whole O_DIRECT blocks
+    uint8_t* PrepareStorage(PixelBuffer& storage, size_t size) {
+        const size_t bytes = RoundUp(std::max<size_t>(size, 1), kSizeClassBytes) + FrameFileReader::kAlignment;
+        if (storage.size() < bytes) {
+            storage.resize(bytes);  // Pooled, uninitialized
+        }
+        return AlignPointer(storage.data());
+    }
+
+#ifndef _WIN32
+    // O_DIRECT where the filesystem supports it, buffered otherwise
+    int OpenForRead(const std::string& path, bool& directIO) {
+#ifdef O_DIRECT
+        if (directIO) {
+            const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC | O_DIRECT);
+            if (fd >= 0) {
+                return fd;
+            }
+        }
+#endif
+        directIO = false;
+        return ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    }
+#endif
+
+#ifdef UMP_HAS_IO_URING
+    //=========================================================================
+    // Minimal io_uring (raw syscalls - no liburing dependency)
+    // One ring per loader thread; reads one file at a time as a batch of
+    // chunk-sized SQEs. The thread's staging buffer is registered once and
+    // only re-registered when a larger file needs it to grow.
+    //=========================================================================
+
+    class IoUringFileReader {
+    public:
+        ~IoUringFileReader() {
+            ReleaseBuffer();
+            if (sqes_) ::munmap(sqes_, sqesBytes_);
+            if (cqRing_ && cqRing_ != sqRing_) ::munmap(cqRing_, cqRingBytes_);
+            if (sqRing_) ::munmap(sqRing_, sqRingBytes_);
+            if (ringFd_ >= 0) ::close(ringFd_);
+        }
+
+        bool Init() {
+            io_uring_params params;
+            std::memset(&params, 0, sizeof(params));
+            ringFd_ = static_cast<int>(::syscall(__NR_io_uring_setup, kRingEntries, &params));
+            if (ringFd_ < 0) {
+                return false;
+            }
+
+            sqRingBytes_ = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+            cqRingBytes_ = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+            const bool singleMmap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+            if (singleMmap) {
+                sqRingBytes_ = cqRingBytes_ = std::max(sqRingBytes_, cqRingBytes_);
+            }
+
+            sqRing_ = ::mmap(nullptr, sqRingBytes_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                             ringFd_, IORING_OFF_SQ_RING);
+            if (sqRing_ == MAP_FAILED) {
+                sqRing_ = nullptr;
+                return false;
+            }
+            if (singleMmap) {
+                cqRing_ = sqRing_;
+            } else {
+                cqRing_ = ::mmap(nullptr, cqRingBytes_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                                 ringFd_, IORING_OFF_CQ_RING);
+                if (cqRing_ == MAP_FAILED) {
+                    cqRing_ = nullptr;
+                    return false;
+                }
+            }
+            sqesBytes_ = params.sq_entries * sizeof(io_uring_sqe);
+            void* sqes = ::mmap(nullptr, sqesBytes_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                                ringFd_, IORING_OFF_SQES);
+            if (sqes == MAP_FAILED) {
+                return false;
+            }
+            sqes_ = static_cast<io_uring_sqe*>(sqes);
+
+            char* sq = static_cast<char*>(sqRing_);
+            sqTail_ = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+            sqMask_ = *reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+            sqArray_ = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+            sqEntries_ = params.sq_entries;
+
+            char* cq = static_cast<char*>(cqRing_);
+            cqHead_ = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+            cqTail_ = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+            cqMask_ = *reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+            cqes_ = reinterpret_cast<io_uring_cqe*>(cq + params.cq_off.cqes);
+            return true;
+        }
+
+        // Staging buffer for 'bytes' (registered when small enough); nullptr = use caller storage
+        uint8_t* Buffer(size_t bytes) {
+            if (bytes > kMaxRegisteredBytes) {
+                return nullptr;
+            }
+            if (bytes > bufferBytes_) {
+                ReleaseBuffer();
+                bufferBytes_ = RoundUp(bytes, kSizeClassBytes);
+                bufferBase_ = FrameBufferPool::Shared().Acquire(bufferBytes_ + FrameFileReader::kAlignment);
+                buffer_ = AlignPointer(bufferBase_);
+
+                iovec iov;
+                iov.iov_base = buffer_;
+                iov.iov_len = bufferBytes_;
+                // May fail (RLIMIT_MEMLOCK on older kernels) - plain READ still works
+                registered_ = ::syscall(__NR_io_uring_register, ringFd_, IORING_REGISTER_BUFFERS, &iov, 1) == 0;
+            }
+            return buffer_;
+        }
+
+        bool IsBroken() const { return broken_; }
+
+        bool IsRegistered(const uint8_t* dst) const {
+            return registered_ && dst == buffer_;
+        }
+
+        // Read 'readBytes' (block-rounded for O_DIRECT) from offset 0 into dst
+        // in chunk SQEs. Returns bytes read (short at EOF), or -1 on error/cancel.
+        int64_t Read(int fd, uint8_t* dst, size_t readBytes, const CancelToken& cancel) {
+            struct Chunk { uint64_t offset; unsigned length; };
+            std::vector<Chunk> queue;
+            for (uint64_t offset = 0; offset < readBytes; offset += FrameFileReader::kChunkBytes) {
+                queue.push_back({offset, static_cast<unsigned>(
+                    std::min<uint64_t>(FrameFileReader::kChunkBytes, readBytes - offset))});
+            }
+            std::reverse(queue.begin(), queue.end());  // pop_back() in file order
+
+            const bool fixed = IsRegistered(dst);
+            uint64_t end = 0;          // Furthest byte read
+            bool eof = false;
+            bool failed = false;
+            unsigned inFlight = 0;     // Consumed by the kernel, not completed
+            unsigned unsubmitted = 0;  // In the SQ, not consumed yet
+            std::vector<Chunk> slots(sqEntries_);  // user_data -> chunk (completions arrive out of order)
+            std::vector<unsigned> freeSlots;
+            for (unsigned slot = 0; slot < sqEntries_; slot++) {
+                freeSlots.push_back(slot);
+            }
+
+            for (;;) {
+                // Stop feeding once cancelled/failed, but always reap what the
+                // kernel owns - it is still writing into dst
+                if (cancel.IsCancelled()) {
+                    failed = true;
+                }
+                unsigned tail = *sqTail_;
+                while (!failed && !eof && !queue.empty() && !freeSlots.empty()) {
+                    const Chunk chunk = queue.back();
+                    queue.pop_back();
+                    const unsigned slot = freeSlots.back();
+                    freeSlots.pop_back();
+                    const unsigned index = tail & sqMask_;
+                    io_uring_sqe* sqe = &sqes_[index];
+                    std::memset(sqe, 0, sizeof(*sqe));
+                    sqe->opcode = fixed ? IORING_OP_READ_FIXED : IORING_OP_READ;
+                    sqe->fd = fd;
+                    sqe->off = chunk.offset;
+                    sqe->addr = reinterpret_cast<uint64_t>(dst + chunk.offset);
+                    sqe->len = chunk.length;
+                    sqe->buf_index = 0;
+                    sqe->user_data = slot;
+                    slots[slot] = chunk;
+                    sqArray_[index] = index;
+                    tail++;
+                    unsubmitted++;
+                }
+                __atomic_store_n(sqTail_, tail, __ATOMIC_RELEASE);
+
+                if (inFlight == 0 && unsubmitted == 0) {
+                    break;
+                }
+
+                const int consumed = static_cast<int>(::syscall(__NR_io_uring_enter, ringFd_, unsubmitted, 1,
+                                                                IORING_ENTER_GETEVENTS, nullptr, 0));
+                if (consumed >= 0) {
+                    unsubmitted -= static_cast<unsigned>(consumed);
+                    inFlight += static_cast<unsigned>(consumed);
+                } else if (errno != EINTR && errno != EAGAIN && errno != EBUSY) {
+                    // Ring unusable: SQEs left in it would run on the next file
+                    broken_ = true;
+                    return -1;
+                }
+
+                // Reap completions
+                unsigned head = *cqHead_;
+                const unsigned cqTail = __atomic_load_n(cqTail_, __ATOMIC_ACQUIRE);
+                while (head != cqTail) {
+                    const io_uring_cqe& cqe = cqes_[head & cqMask_];
+                    const unsigned slot = static_cast<unsigned>(cqe.user_data);
+                    const Chunk chunk = slots[slot];
+                    freeSlots.push_back(slot);
+                    inFlight--;
+                    if (cqe.res < 0) {
+                        failed = true;
+                    } else if (cqe.res == 0) {
+                        eof = true;
+                    } else {
+                        end = std::max<uint64_t>(end, chunk.offset + cqe.res);
+                        if (static_cast<unsigned>(cqe.res) < chunk.length) {
+                            // Short read: the rest of this chunk goes back in the queue
+                            queue.push_back({chunk.offset + cqe.res, chunk.length - cqe.res});
+                        }
+                    }
+                    head++;
+                }
+                __atomic_store_n(cqHead_, head, __ATOMIC_RELEASE);
+            }
+
+            return failed ? -1 : static_cast<int64_t>(end);
+        }
+
+    private:
+        void ReleaseBuffer() {
+            if (registered_) {
+                ::syscall(__NR_io_uring_register, ringFd_, IORING_UNREGISTER_BUFFERS, nullptr, 0);
+                registered_ = false;
+            }
+            if (bufferBase_) {
+                FrameBufferPool::Shared().Release(bufferBase_, bufferBytes_ + FrameFileReader::kAlignment);
+                bufferBase_ = nullptr;
+                buffer_ = nullptr;
+            }
+            bufferBytes_ = 0;
+        }
+
+        int ringFd_ = -1;
+        void* sqRing_ = nullptr;
+        void* cqRing_ = nullptr;
+        size_t sqRingBytes_ = 0;
+        size_t cqRingBytes_ = 0;
+        io_uring_sqe* sqes_ = nullptr;
+        size_t sqesBytes_ = 0;
+
+        unsigned* sqTail_ = nullptr;
+        unsigned* sqArray_ = nullptr;
+        unsigned sqMask_ = 0;
+        unsigned sqEntries_ = 0;
+        unsigned* cqHead_ = nullptr;
+        unsigned* cqTail_ = nullptr;
+        unsigned cqMask_ = 0;
+        io_uring_cqe* cqes_ = nullptr;
+
+        void* bufferBase_ = nullptr;   // From FrameBufferPool
+        uint8_t* buffer_ = nullptr;    // 4KB-aligned inside bufferBase_
+        size_t bufferBytes_ = 0;
+        bool registered_ = false;
+        bool broken_ = false;
+    };
+
+    // Per loader thread; nullptr when the kernel has no io_uring (or it is disabled)
+    IoUringFileReader* ThreadRing() {
+        thread_local std::unique_ptr<IoUringFileReader> ring;
+        thread_local bool tried = false;
+        if (!tried) {
+            tried = true;
+            auto candidate = std::make_unique<IoUringFileReader>();
+            if (candidate->Init()) {
+                ring = std::move(candidate);
+            }
+        }
+        if (ring && ring->IsBroken()) {
+            ring.reset();  // Closing the fd tears the ring down; the next read builds a new one
+            tried = false;
+        }
+        return ring.get();
+    }
+#endif
+}
+
+const char* ReadBackendName(ReadBackend backend) {
+    switch (backend) {
+        case ReadBackend::Mapped:  return "mmap";
+        case ReadBackend::PRead:   return "pread";
+        case ReadBackend::IoUring: return "io_uring";
+        default:                   return "unknown";
+    }
+}
+
+FrameFileReader& FrameFileReader::Shared() {
+    static FrameFileReader reader;
+    return reader;
+}
+
+FrameFileReader::~FrameFileReader() {
+    if (benchmarkThread_.joinable()) {
+        benchmarkThread_.join();
+    }
+}
+
+bool FrameFileReader::IsAvailable(ReadBackend backend) {
+    switch (backend) {
+        case ReadBackend::Mapped:
+        case ReadBackend::PRead:
+            return true;
+        case ReadBackend::IoUring:
+#ifdef UMP_HAS_IO_URING
+        {
+            static const bool available = [] {
+                IoUringFileReader probe;
+                return probe.Init();
+            }();
+            return available;
+        }
+#else
+            return false;
+#endif
+        default:
+            return false;
+    }
+}
+
+void FrameFileReader::SetBackend(ReadBackend backend, bool directIO) {
+    if (!IsAvailable(backend)) {
+        Debug::Log(std::string("FrameFileReader: ") + ReadBackendName(backend) +
+                   " not available on this system - using pread");
+        backend = ReadBackend::PRead;
+    }
+    if (backend_.exchange(backend) != backend || directIO_.exchange(directIO) != directIO) {
+        Debug::Log(std::string("FrameFileReader: Frame reads via ") + ReadBackendName(backend) +
+                   (directIO ? " (O_DIRECT)" : ""));
+    }
+}
+
+bool FrameFileReader::ReadFile(const std::string& path, FileBytes& out, const CancelToken& cancel) {
+    return ReadFile(path, out, GetBackend(), GetDirectIO(), cancel);
+}
+
+bool FrameFileReader::ReadFile(const std::string& path, FileBytes& out, ReadBackend backend, bool directIO,
+                               const CancelToken& cancel) {
+    out.data_ = nullptr;
+    out.size_ = 0;
+
+    const auto start = std::chrono::steady_clock::now();
+    bool ok = false;
+    if (backend == ReadBackend::IoUring) {
+        ok = ReadIoUring(path, out, directIO, cancel);
+    } else {
+        backend = ReadBackend::PRead;
+        ok = ReadPRead(path, out, directIO, cancel);
+    }
+
+    if (ok) {
+        RecordRead(backend, out.size_,
+                   std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+    }
+    return ok;
+}
+
+bool FrameFileReader::ReadPRead(const std::string& path, FileBytes& out, bool directIO, const CancelToken& cancel) {
+#ifdef _WIN32
+    // Buffered read (no O_DIRECT equivalent wired up on Windows)
+    (void)directIO;
+    FILE* fp = _wfopen(std::wstring(path.begin(), path.end()).c_str(), L"rb");
+    if (!fp) return false;
+    _fseeki64(fp, 0, SEEK_END);
+    const int64_t fileSize = _ftelli64(fp);
+    _fseeki64(fp, 0, SEEK_SET);
+    if (fileSize < 0) {
+        fclose(fp);
+        return false;
+    }
+    uint8_t* dst = PrepareStorage(out.storage_, static_cast<size_t>(fileSize));
+    size_t done = 0;
+    while (done < static_cast<size_t>(fileSize)) {
+        if (cancel.IsCancelled()) {
+            fclose(fp);
+            return false;
+        }
+        const size_t want = std::min(kChunkBytes, static_cast<size_t>(fileSize) - done);
+        const size_t got = fread(dst + done, 1, want, fp);
+        if (got == 0) break;
+        done += got;
+    }
+    fclose(fp);
+    out.data_ = dst;
+    out.size_ = done;
+    return done == static_cast<size_t>(fileSize);
+#else
+    bool direct = directIO;
+    const int fd = OpenForRead(path, direct);
+    if (fd < 0) {
+        return false;
+    }
+    if (directIO && !direct) {
+        directFallbacks_++;
+    }
+
+    struct stat st;
+    if (::fstat(fd, &st) != 0) {
+        ::close(fd);
+        return false;
+    }
+    const size_t fileSize = static_cast<size_t>(st.st_size);
+    uint8_t* dst = PrepareStorage(out.storage_, fileSize);
+    const size_t readBytes = direct ? RoundUp(fileSize, kAlignment) : fileSize;
+
+    size_t done = 0;
+    while (done < readBytes) {
+        if (cancel.IsCancelled()) {
+            ::close(fd);
+            return false;
+        }
+        const size_t want = std::min(kChunkBytes, readBytes - done);
+        const ssize_t got = ::pread(fd, dst + done, want, static_cast<off_t>(done));
+        if (got < 0) {
+            if (errno == EINTR) continue;
+            ::close(fd);
+            return false;
+        }
+        if (got == 0) break;  // EOF (O_DIRECT reads stop short of the rounded length)
+        done += static_cast<size_t>(got);
+    }
+    ::close(fd);
+
+    out.data_ = dst;
+    out.size_ = std::min(done, fileSize);
+    return out.size_ == fileSize;
+#endif
+}
+
+bool FrameFileReader::ReadIoUring(const std::string& path, FileBytes& out, bool directIO, const CancelToken& cancel) {
+#ifdef UMP_HAS_IO_URING
+    IoUringFileReader* ring = ThreadRing();
+    if (!ring) {
+        ringFallbacks_++;
+        return ReadPRead(path, out, directIO, cancel);
+    }
+
+    bool direct = directIO;
+    const int fd = OpenForRead(path, direct);
+    if (fd < 0) {
+        return false;
+    }
+    if (directIO && !direct) {
+        directFallbacks_++;
+    }
+
+    struct stat st;
+    if (::fstat(fd, &st) != 0) {
+        ::close(fd);
+        return false;
+    }
+    const size_t fileSize = static_cast<size_t>(st.st_size);
+    const size_t readBytes = direct ? RoundUp(fileSize, kAlignment) : fileSize;
+
+    // Thread's registered buffer when the file fits, else the caller's storage
+    uint8_t* dst = ring->Buffer(readBytes);
+    if (!dst) {
+        dst = PrepareStorage(out.storage_, fileSize);
+    }
+
+    const int64_t got = fileSize > 0 ? ring->Read(fd, dst, readBytes, cancel) : 0;
+    ::close(fd);
+    if (got < 0) {
+        return false;
+    }
+
+    out.data_ = dst;
+    out.size_ = std::min(static_cast<size_t>(got), fileSize);
+    return out.size_ == fileSize;
+#else
+    ringFallbacks_++;
+    return ReadPRead(path, out, directIO, cancel);
+#endif
+}
+
+bool FrameFileReader::TouchMapped(const std::string& path, size_t& bytes) {
+    bytes = 0;
+    volatile uint8_t sink = 0;
+#ifdef _WIN32
+    const int wlen = MultiByteToWideChar(CP_UTF8, 0, path.c_str(), -1, nullptr, 0);
+    std::vector<wchar_t> wpath(wlen);
+    MultiByteToWideChar(CP_UTF8, 0, path.c_str(), -1, wpath.data(), wlen);
+    HANDLE file = CreateFileW(wpath.data(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                              FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (file == INVALID_HANDLE_VALUE) return false;
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size) || size.QuadPart == 0) {
+        CloseHandle(file);
+        return size.QuadPart == 0;
+    }
+    HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    const uint8_t* data = mapping ? static_cast<const uint8_t*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0)) : nullptr;
+    if (data) {
+        bytes = static_cast<size_t>(size.QuadPart);
+        for (size_t i = 0; i < bytes; i += 4096) sink += data[i];
+        UnmapViewOfFile(data);
+    }
+    if (mapping) CloseHandle(mapping);
+    CloseHandle(file);
+    return data != nullptr;
+#else
+    const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) return false;
+    struct stat st;
+    if (::fstat(fd, &st) != 0) {
+        ::close(fd);
+        return false;
+    }
+    bytes = static_cast<size_t>(st.st_size);
+    if (bytes == 0) {
+        ::close(fd);
+        return true;
+    }
+    // Same access pattern as MemoryMappedIStream: sequential, one fault per page
+    void* mapped = ::mmap(nullptr, bytes, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (mapped == MAP_FAILED) return false;
+    ::madvise(mapped, bytes, MADV_SEQUENTIAL);
+    const uint8_t* data = static_cast<const uint8_t*>(mapped);
+    for (size_t i = 0; i < bytes; i += 4096) sink += data[i];
+    ::munmap(mapped, bytes);
+    return true;
+#endif
+}
+
+void FrameFileReader::RecordRead(ReadBackend backend, size_t bytes, double ms) {
+    std::lock_guard<std::mutex> lock(statsMutex_);
+    BackendStats& stats = reads_[static_cast<int>(backend)];
+    stats.files++;
+    stats.bytes += bytes;
+    stats.totalMs += ms;
+}
+
+FrameFileReader::Stats FrameFileReader::GetStats() const {
+    Stats stats;
+    stats.backend = GetBackend();
+    stats.directIO = GetDirectIO();
+    stats.ioUringAvailable = IsAvailable(ReadBackend::IoUring);
+    {
+        std::lock_guard<std::mutex> lock(statsMutex_);
+        std::copy(std::begin(reads_), std::end(reads_), std::begin(stats.reads));
+    }
+    stats.directFallbacks = directFallbacks_.load();
+    stats.ringFallbacks = ringFallbacks_.load();
+    return stats;
+}
+
+//=============================================================================
+// Benchmark
+//=============================================================================
+
+void FrameFileReader::StartBenchmark(std::vector<std::string> files, int threads) {
+    if (files.empty() || benchmarkRunning_.exchange(true)) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(benchmarkMutex_);
+    if (benchmarkThread_.joinable()) {
+        benchmarkThread_.join();
+    }
+    benchmarkResults_.clear();
+
+    benchmarkThread_ = std::thread([this, files = std::move(files), threads]() {
+        struct Variant { ReadBackend backend; bool directIO; };
+        const Variant variants[] = {
+            {ReadBackend::Mapped, false},
+            {ReadBackend::PRead, false},
+            {ReadBackend::PRead, true},
+            {ReadBackend::IoUring, false},
+            {ReadBackend::IoUring, true},
+        };
+
+        Debug::Log("FrameFileReader: Benchmarking " + std::to_string(files.size()) + " files x " +
+                   std::to_string(threads) + " threads");
+        for (const Variant& variant : variants) {
+            if (!IsAvailable(variant.backend)) {
+                continue;
+            }
+            BenchmarkResult result = RunBenchmark(files, threads, variant.backend, variant.directIO);
+
+            char line[256];
+            std::snprintf(line, sizeof(line), "FrameFileReader: [BENCH] %-8s%s %.0f MB/s, %.1f files/s (%d files, %.2fs)%s",
+                          ReadBackendName(result.backend), result.directIO ? " O_DIRECT" : "",
+                          result.mbps, result.filesPerSec, result.files, result.seconds,
+                          result.ok ? "" : " - read errors");
+            Debug::Log(line);
+
+            std::lock_guard<std::mutex> resultsLock(benchmarkMutex_);
+            benchmarkResults_.push_back(result);
+        }
+        benchmarkRunning_ = false;
+    });
+}
+
+std::vector<FrameFileReader::BenchmarkResult> FrameFileReader::GetBenchmarkResults() const {
+    std::lock_guard<std::mutex> lock(benchmarkMutex_);
+    return benchmarkResults_;
+}
+
+FrameFileReader::BenchmarkResult FrameFileReader::RunBenchmark(const std::vector<std::string>& files, int threads,
+                                                               ReadBackend backend, bool directIO) {
+    // Start every variant cold: drop the files from the page cache first
+    // (best effort - pages still mapped elsewhere stay resident)
+#if !defined(_WIN32) && defined(POSIX_FADV_DONTNEED)
+    for (const std::string& path : files) {
+        const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd >= 0) {
+            ::posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+            ::close(fd);
+        }
+    }
+#endif
+
+    BenchmarkResult result;
+    result.backend = backend;
+    result.directIO = directIO;
+
+    std::atomic<size_t> next{0};
+    std::atomic<uint64_t> bytes{0};
+    std::atomic<int> failures{0};
+
+    const auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> workers;
+    for (int t = 0; t < std::max(1, threads); t++) {
+        workers.emplace_back([&]() {
+            FileBytes data;
+            for (size_t i = next++; i < files.size(); i = next++) {
+                size_t size = 0;
+                bool ok = false;
+                if (backend == ReadBackend::Mapped) {
+                    ok = TouchMapped(files[i], size);
+                } else {
+                    ok = ReadFile(files[i], data, backend, directIO);
+                    size = data.size();
+                }
+                if (ok) {
+                    bytes += size;
+                } else {
+                    failures++;
+                }
+            }
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+
+    result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    result.files = static_cast<int>(files.size()) - failures.load();
+    result.bytes = bytes.load();
+    result.ok = failures.load() == 0;
+    if (result.seconds > 0.0) {
+        result.mbps = result.bytes / (1024.0 * 1024.0) / result.seconds;
+        result.filesPerSec = result.files / result.seconds;
+    }
+    return result;
+}
+
+} // namespace ump
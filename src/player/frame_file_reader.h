@@ -0,0 +1,141 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "frame_buffer_pool.h"
+#include "image_loader_interface.h"
+
+namespace ump {
+
+//=============================================================================
+// FrameFileReader - selectable read backend for image sequence frame loads
+//
+// Mapping every frame file (MemoryMappedIStream, libtiff's own mmap) makes the
+// decoder take a page fault per 4KB, and on Linux those faults serialize on the
+// process VM lock - past ~8 loader threads on large DWAA files the mapping,
+// not the disk, is the bottleneck. The alternatives read the whole file into
+// memory first and the loaders decode from that buffer:
+// - Mapped:  format library maps/streams the file itself (previous behavior)
+// - PRead:   pread() in large chunks into a pooled buffer
+// - IoUring: the chunks are submitted as one io_uring batch per file, into a
+//            per-thread buffer from the FrameBufferPool registered with the
+//            ring (no per-read page pinning); Linux only, raw syscalls
+// Direct I/O (O_DIRECT) bypasses the page cache for sequences larger than RAM.
+// Buffers are 4KB aligned and padded so O_DIRECT reads can use them as-is.
+//
+// The backend is a process-wide runtime switch (Performance settings).
+// Benchmark() reads the same files with every backend for comparison.
+//=============================================================================
+
+enum class ReadBackend : int {
+    Mapped = 0,
+    PRead,
+    IoUring,
+    Count
+};
+
+const char* ReadBackendName(ReadBackend backend);
+
+// A whole frame file in memory
+class FileBytes {
+public:
+    const uint8_t* data() const { return data_; }
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+
+private:
+    friend class FrameFileReader;
+
+    PixelBuffer storage_;              // Owned bytes (pooled, padded for alignment)
+    const uint8_t* data_ = nullptr;    // Into storage_, or the thread's registered io_uring
+    size_t size_ = 0;                  // buffer (valid until this thread's next read)
+};
+
+class FrameFileReader {
+public:
+    struct BackendStats {
+        uint64_t files = 0;
+        uint64_t bytes = 0;
+        double totalMs = 0.0;
+    };
+
+    struct Stats {
+        ReadBackend backend = ReadBackend::Mapped;
+        bool directIO = false;
+        bool ioUringAvailable = false;
+        BackendStats reads[static_cast<int>(ReadBackend::Count)];
+        uint64_t directFallbacks = 0;  // O_DIRECT refused by the filesystem - read buffered
+        uint64_t ringFallbacks = 0;    // io_uring unavailable on a thread - read with pread
+    };
+
+    struct BenchmarkResult {
+        ReadBackend backend = ReadBackend::Mapped;
+        bool directIO = false;
+        bool ok = false;
+        int files = 0;
+        uint64_t bytes = 0;
+        double seconds = 0.0;
+        double mbps = 0.0;
+        double filesPerSec = 0.0;
+    };
+
+    static constexpr size_t kAlignment = 4096;          // O_DIRECT buffer/offset/length alignment
+    static constexpr size_t kChunkBytes = 1024 * 1024;  // One pread / io_uring SQE
+
+    static FrameFileReader& Shared();
+    ~FrameFileReader();
+
+    static bool IsAvailable(ReadBackend backend);
+
+    void SetBackend(ReadBackend backend, bool directIO);
+    ReadBackend GetBackend() const { return backend_.load(); }
+    bool GetDirectIO() const { return directIO_.load(); }
+
+    // Frame loads decode from ReadFile() rather than mapping/streaming the file
+    bool ReadsIntoMemory() const { return GetBackend() != ReadBackend::Mapped; }
+
+    // Whole file with the current backend (Mapped reads with pread). Any thread.
+    bool ReadFile(const std::string& path, FileBytes& out, const CancelToken& cancel = CancelToken());
+    bool ReadFile(const std::string& path, FileBytes& out, ReadBackend backend, bool directIO,
+                  const CancelToken& cancel = CancelToken());
+
+    // Read 'files' with each backend (cold page cache where it can be dropped),
+    // 'threads' reads in parallel. Runs on its own thread; results replace the last run.
+    void StartBenchmark(std::vector<std::string> files, int threads);
+    bool IsBenchmarkRunning() const { return benchmarkRunning_.load(); }
+    std::vector<BenchmarkResult> GetBenchmarkResults() const;
+
+    Stats GetStats() const;
+
+private:
+    FrameFileReader() = default;
+
+    bool ReadPRead(const std::string& path, FileBytes& out, bool directIO, const CancelToken& cancel);
+    bool ReadIoUring(const std::string& path, FileBytes& out, bool directIO, const CancelToken& cancel);
+    bool TouchMapped(const std::string& path, size_t& bytes);  // Benchmark: map + fault every page
+    void RecordRead(ReadBackend backend, size_t bytes, double ms);
+
+    BenchmarkResult RunBenchmark(const std::vector<std::string>& files, int threads,
+                                 ReadBackend backend, bool directIO);
+
+    std::atomic<ReadBackend> backend_{ReadBackend::Mapped};
+    std::atomic<bool> directIO_{false};
+
+    mutable std::mutex statsMutex_;
+    BackendStats reads_[static_cast<int>(ReadBackend::Count)];
+    std::atomic<uint64_t> directFallbacks_{0};
+    std::atomic<uint64_t> ringFallbacks_{0};
+
+    mutable std::mutex benchmarkMutex_;
+    std::thread benchmarkThread_;
+    std::atomic<bool> benchmarkRunning_{false};
+    std::vector<BenchmarkResult> benchmarkResults_;
+};
+
+} // namespace ump
@@ -3,8 +3,11 @@
 #include <string>
 #include <vector>
 #include <memory>
+#include <atomic>
+#include <cstring>
 #include <glad/gl.h>
 #include "pipeline_mode.h"
+#include "frame_buffer_pool.h"
 
 namespace ump {
 
@@ -13,16 +16,135 @@ namespace ump {
 //=============================================================================
 
 // Supports all pipeline modes: RGBA8, RGBA16, RGBA16F
-// Raw bytes stored in uint8_t vector, interpreted based on gl_type
+// Raw bytes stored in a pooled uint8_t buffer, interpreted based on gl_format/gl_type
+// (uninitialized after resize(), returned to FrameBufferPool when the frame is freed)
+// Compact EXR storage drops channels the source doesn't have: RGB without
+// alpha (sampled with alpha 1), RG/RED for one or two channel AOVs (depth, masks)
 struct PixelData {
-    std::vector<uint8_t> pixels;        // Raw bytes (RGBA8: 4 bytes/px, RGBA16/16F: 8 bytes/px)
+    PixelBuffer pixels;                 // Raw bytes (RGBA8: 4 bytes/px, RGBA16/16F: 8 bytes/px)
     int width = 0;
     int height = 0;
-    GLenum gl_format = GL_RGBA;          // Always GL_RGBA (4 channels)
+    GLenum gl_format = GL_RGBA;          // GL_RGBA, or GL_RGB/GL_RG/GL_RED (compact EXR storage)
     GLenum gl_type = GL_UNSIGNED_BYTE;   // GL_UNSIGNED_BYTE, GL_UNSIGNED_SHORT, or GL_HALF_FLOAT
     PipelineMode pipeline_mode = PipelineMode::NORMAL;
 
+    // Draft playback: stored at 1/2^draft_level of the full frame size
+    int draft_level = 0;                 // 0 = full resolution
+    int full_width = 0;                  // 0 = same as width
+    int full_height = 0;
+
+    // Data window storage (EXR): only region_width x region_height at
+    // (region_x, region_y) of the full frame is stored (full-resolution
+    // coordinates; full_width/full_height give the frame). The rest is black,
+    // opaque when the source has no alpha.
+    int region_x = 0;
+    int region_y = 0;
+    int region_width = 0;                // 0 = whole frame stored
+    int region_height = 0;
+    bool opaque = false;
+
     size_t ByteSize() const { return pixels.size(); }
+    bool HasRegion() const { return region_width > 0; }
+    int DisplayWidth() const { return full_width ? full_width : width; }
+    int DisplayHeight() const { return full_height ? full_height : height; }
+};
+
+// Channels per pixel of a GL pixel format (GL_RGBA = 4 ... GL_RED = 1)
+inline int FormatComponents(GLenum format) {
+    switch (format) {
+        case GL_RED: return 1;
+        case GL_RG:  return 2;
+        case GL_RGB: return 3;
+        default:     return 4;
+    }
+}
+
+// Box-filtered copy at 1/2^level resolution (draft playback), any gl_format/gl_type
+std::shared_ptr<PixelData> DownsampleFrame(const PixelData& frame, int level);
+
+//=============================================================================
+// Caller-Provided Destinations (decode straight into a cache slot or PBO)
+//=============================================================================
+
+// Shape of a decoded frame - RGBA, except compact EXR storage (LoadFrame()
+// only; LoadFrameInto() destinations are always RGBA)
+struct FrameLayout {
+    int width = 0;
+    int height = 0;
+    GLenum gl_format = GL_RGBA;
+    GLenum gl_type = GL_UNSIGNED_BYTE;   // GL_UNSIGNED_BYTE, GL_UNSIGNED_SHORT, GL_HALF_FLOAT or GL_FLOAT
+    PipelineMode pipeline_mode = PipelineMode::NORMAL;
+
+    // Data window storage: width x height is the stored region at
+    // (region_x, region_y) of a full_width x full_height frame
+    int region_x = 0;
+    int region_y = 0;
+    int full_width = 0;                  // 0 = the whole frame is stored
+    int full_height = 0;
+    bool opaque = false;                 // No alpha: black outside the region is opaque
+
+    bool HasRegion() const { return full_width > 0; }
+
+    size_t BytesPerPixel() const {
+        const size_t components = FormatComponents(gl_format);
+        switch (gl_type) {
+            case GL_UNSIGNED_SHORT:
+            case GL_HALF_FLOAT: return components * 2;
+            case GL_FLOAT:      return components * 4;
+            default:            return components;
+        }
+    }
+    size_t RowBytes() const { return static_cast<size_t>(width) * BytesPerPixel(); }
+    size_t ByteSize() const { return RowBytes() * static_cast<size_t>(height); }
+};
+
+// Where a loader writes pixels: row y starts at data + y * row_stride
+struct FrameDestination {
+    uint8_t* data = nullptr;
+    size_t row_stride = 0;               // Bytes between rows (0 = tightly packed)
+    size_t capacity = 0;                 // Bytes writable from data
+    GLenum gl_type = GL_UNSIGNED_BYTE;   // Must be the layout's type (EXR also converts to GL_FLOAT)
+
+    size_t Stride(const FrameLayout& layout) const { return row_stride ? row_stride : layout.RowBytes(); }
+    uint8_t* Row(const FrameLayout& layout, int y) const { return data + static_cast<size_t>(y) * Stride(layout); }
+
+    // True when a frame of 'layout' converted to gl_type fits
+    bool Fits(FrameLayout layout) const {
+        layout.gl_type = gl_type;
+        if (!data || layout.width <= 0 || layout.height <= 0) return false;
+        if (row_stride != 0 && row_stride < layout.RowBytes()) return false;
+        return capacity >= Stride(layout) * static_cast<size_t>(layout.height - 1) + layout.RowBytes();
+    }
+};
+
+//=============================================================================
+// Cooperative Cancellation
+//=============================================================================
+
+// Shared cancel flag for one load request (copies observe the same flag)
+// Loaders poll IsCancelled() between chunk/scanline reads and return nullptr
+// once set, so a stale load gives its worker back as soon as possible.
+// A default-constructed token is never cancelled.
+class CancelToken {
+public:
+    CancelToken() = default;
+
+    static CancelToken Create() {
+        CancelToken token;
+        token.flag_ = std::make_shared<std::atomic<bool>>(false);
+        return token;
+    }
+
+    void Cancel() const {
+        if (flag_) flag_->store(true, std::memory_order_relaxed);
+    }
+
+    bool IsCancelled() const {
+        return flag_ && flag_->load(std::memory_order_relaxed);
+    }
+
+private:
+    std::shared_ptr<std::atomic<bool>> flag_;
 };
 
 //=============================================================================
@@ -43,6 +165,107 @@ public:
         PipelineMode pipeline_mode       // Determines output format (RGBA8/16/16F)
     ) = 0;
 
+    // Cancellable load - returns nullptr once 'cancel' is set
+    // Default ignores the token; loaders override to poll it between reads
+    virtual std::shared_ptr<PixelData> LoadFrame(
+        const std::string& path,
+        const std::string& layer,
+        PipelineMode pipeline_mode,
+        const CancelToken& cancel
+    ) {
+        if (cancel.IsCancelled()) return nullptr;
+        return LoadFrame(path, layer, pipeline_mode);
+    }
+
+    // Frame shape without decoding pixels (header read) - lets the caller
+    // reserve a cache slot or map an upload buffer before LoadFrameInto()
+    // Default decodes the whole frame; loaders override with a header read
+    virtual bool QueryFrameLayout(
+        const std::string& path,
+        const std::string& layer,
+        PipelineMode pipeline_mode,
+        FrameLayout& layout
+    ) {
+        auto frame = LoadFrame(path, layer, pipeline_mode);
+        if (!frame) return false;
+        layout.width = frame->width;
+        layout.height = frame->height;
+        layout.gl_format = frame->gl_format;
+        layout.gl_type = frame->gl_type;
+        layout.pipeline_mode = frame->pipeline_mode;
+        return true;
+    }
+
+    // Draft playback: frame at 1/2^level resolution (0 = LoadFrame)
+    // Default decodes full resolution and box-filters on the calling worker;
+    // loaders override when the format has a cheaper route
+    virtual std::shared_ptr<PixelData> LoadFrameDraft(
+        const std::string& path,
+        const std::string& layer,
+        PipelineMode pipeline_mode,
+        int level,
+        const CancelToken& cancel = CancelToken{}
+    ) {
+        auto frame = LoadFrame(path, layer, pipeline_mode, cancel);
+        if (!frame || level <= 0) return frame;
+        return DownsampleFrame(*frame, level);
+    }
+
+    // Reduced-resolution levels stored in the file (EXR mipmaps) - LoadFrameDraft()
+    // reads levels below this without decoding full resolution. 1 = none.
+    virtual int GetResolutionLevels(const std::string& /*path*/) {
+        return 1;
+    }
+
+    // Decode directly into caller memory (no intermediate PixelData)
+    // Fails without writing if 'dest' can't hold the frame or has the wrong type
+    // Default decodes into a temporary frame and copies rows; loaders override
+    virtual bool LoadFrameInto(
+        const std::string& path,
+        const std::string& layer,
+        PipelineMode pipeline_mode,
+        const FrameDestination& dest,
+        const CancelToken& cancel = CancelToken{}
+    ) {
+        auto frame = LoadFrame(path, layer, pipeline_mode, cancel);
+        if (!frame) return false;
+
+        FrameLayout layout;
+        layout.width = frame->width;
+        layout.height = frame->height;
+        layout.gl_type = frame->gl_type;
+        if (dest.gl_type != layout.gl_type || !dest.Fits(layout)) return false;
+
+        const size_t rowBytes = layout.RowBytes();
+        for (int y = 0; y < layout.height; ++y) {
+            std::memcpy(dest.Row(layout, y), frame->pixels.data() + y * rowBytes, rowBytes);
+        }
+        return true;
+    }
+
+    // Layers a frame can be decoded as (EXR multi-layer); empty = one image per file
+    virtual std::vector<std::string> GetLayers(const std::string& /*path*/) {
+        return {};
+    }
+
+    // Several layers of one frame: out[i] is layers[i] (nullptr when missing)
+    // Default loads each layer on its own; loaders override to decode once
+    virtual bool LoadFrameLayers(
+        const std::string& path,
+        const std::vector<std::string>& layers,
+        PipelineMode pipeline_mode,
+        std::vector<std::shared_ptr<PixelData>>& out,
+        const CancelToken& cancel = CancelToken{}
+    ) {
+        out.clear();
+        bool any = false;
+        for (const auto& layer : layers) {
+            out.push_back(LoadFrame(path, layer, pipeline_mode, cancel));
+            any = any || out.back() != nullptr;
+        }
+        return any;
+    }
+
     // Load thumbnail (optimized low-resolution decode)
     // Bypasses expensive color management and uses format-specific optimizations
     // For JPEG: Uses libjpeg DCT scaling (1/2, 1/4, 1/8 resolution)
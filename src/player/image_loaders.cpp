@@ -1,7 +1,10 @@
 #include "image_loaders.h"
 #include "video_player.h"  // For PipelineModeToString
 #include "direct_exr_cache.h"  // For MemoryMappedIStream
+#include "video_packet_index.h"
 #include "../utils/debug_utils.h"
+#include "../utils/exr_layer_detector.h"
+#include "../utils/exr_layout_cache.h"
 
 #include <tiffio.h>
 #include <png.h>
@@ -13,6 +16,7 @@
 #include <OpenEXR/ImfFrameBuffer.h>
 #include <OpenEXR/ImfInputPart.h>
 #include <OpenEXR/ImfMultiPartInputFile.h>
+#include <OpenEXR/ImfTiledInputPart.h>
 #include <Imath/ImathBox.h>
 #include <Imath/half.h>
 
@@ -54,6 +58,223 @@ bool GetImageInfo(const std::string& path, ImageInfo& info) {
     }
 }
 
+FrameDestinationProvider AllocateInto(PixelBuffer& buffer) {
+    return [&buffer](const FrameLayout& layout, FrameDestination& dest) {
+        buffer.resize(layout.ByteSize());  // Pooled, uninitialized
+        dest.data = buffer.data();
+        dest.row_stride = layout.RowBytes();
+        dest.capacity = buffer.size();
+        dest.gl_type = layout.gl_type;
+        return true;
+    };
+}
+
+FrameDestinationProvider UseDestination(const FrameDestination& dest) {
+    return [dest](const FrameLayout& layout, FrameDestination& out) {
+        if (dest.gl_type != layout.gl_type || !dest.Fits(layout)) {
+            Debug::Log("LoadFrameInto: Destination does not fit " + std::to_string(layout.width) + "x" +
+                       std::to_string(layout.height) + " frame (type/stride/capacity mismatch)");
+            return false;
+        }
+        out = dest;
+        return true;
+    };
+}
+
+// ============================================================================
+// Draft resolution (box filter)
+// ============================================================================
+
+namespace {
+
+template <typename T>
+T FromAverage(float value) { return static_cast<T>(value + 0.5f); }  // Integer: round
+template <>
+float FromAverage<float>(float value) { return value; }
+template <>
+Imath::half FromAverage<Imath::half>(float value) { return Imath::half(value); }
+
+// Each output pixel averages its factor x factor block (clipped at the edges)
+template <typename T>
+void BoxDownsample(const T* src, int width, int height, T* dst, int outWidth, int outHeight, int factor,
+                   int components) {
+    for (int oy = 0; oy < outHeight; ++oy) {
+        const int y0 = oy * factor;
+        const int y1 = std::min(height, y0 + factor);
+        for (int ox = 0; ox < outWidth; ++ox) {
+            const int x0 = ox * factor;
+            const int x1 = std::min(width, x0 + factor);
+            float sum[4] = {};
+            for (int y = y0; y < y1; ++y) {
+                const T* row = src + (static_cast<size_t>(y) * width + x0) * components;
+                for (int x = x0; x < x1; ++x, row += components) {
+                    for (int c = 0; c < components; ++c) {
+                        sum[c] += static_cast<float>(row[c]);
+                    }
+                }
+            }
+            const float scale = 1.0f / static_cast<float>((y1 - y0) * (x1 - x0));
+            T* out = dst + (static_cast<size_t>(oy) * outWidth + ox) * components;
+            for (int c = 0; c < components; ++c) {
+                out[c] = FromAverage<T>(sum[c] * scale);
+            }
+        }
+    }
+}
+
+// Region fields of a data-window-only decode
+void ApplyRegion(PixelData& pixels, const FrameLayout& layout) {
+    if (!layout.HasRegion()) {
+        return;
+    }
+    pixels.region_x = layout.region_x;
+    pixels.region_y = layout.region_y;
+    pixels.region_width = layout.width;
+    pixels.region_height = layout.height;
+    pixels.full_width = layout.full_width;
+    pixels.full_height = layout.full_height;
+    pixels.opaque = layout.opaque;
+}
+
+} // namespace
+
+std::shared_ptr<PixelData> DownsampleFrame(const PixelData& frame, int level) {
+    const int steps = std::clamp(level, 0, 4);
+    const int factor = 1 << steps;
+    auto result = std::make_shared<PixelData>();
+    result->width = (frame.width + factor - 1) / factor;
+    result->height = (frame.height + factor - 1) / factor;
+    result->gl_format = frame.gl_format;
+    result->gl_type = frame.gl_type;
+    result->pipeline_mode = frame.pipeline_mode;
+    result->draft_level = frame.draft_level + steps;
+    result->full_width = frame.DisplayWidth();
+    result->full_height = frame.DisplayHeight();
+    result->region_x = frame.region_x;
+    result->region_y = frame.region_y;
+    result->region_width = frame.region_width;
+    result->region_height = frame.region_height;
+    result->opaque = frame.opaque;
+
+    FrameLayout layout;
+    layout.width = result->width;
+    layout.height = result->height;
+    layout.gl_format = frame.gl_format;
+    layout.gl_type = frame.gl_type;
+    result->pixels.resize(layout.ByteSize());
+
+    const uint8_t* src = frame.pixels.data();
+    uint8_t* dst = result->pixels.data();
+    const int components = FormatComponents(frame.gl_format);
+    switch (frame.gl_type) {
+        case GL_UNSIGNED_BYTE:
+            BoxDownsample(src, frame.width, frame.height, dst, result->width, result->height, factor, components);
+            break;
+        case GL_UNSIGNED_SHORT:
+            BoxDownsample(reinterpret_cast<const uint16_t*>(src), frame.width, frame.height,
+                          reinterpret_cast<uint16_t*>(dst), result->width, result->height, factor, components);
+            break;
+        case GL_HALF_FLOAT:
+            BoxDownsample(reinterpret_cast<const Imath::half*>(src), frame.width, frame.height,
+                          reinterpret_cast<Imath::half*>(dst), result->width, result->height, factor, components);
+            break;
+        case GL_FLOAT:
+            BoxDownsample(reinterpret_cast<const float*>(src), frame.width, frame.height,
+                          reinterpret_cast<float*>(dst), result->width, result->height, factor, components);
+            break;
+        default:
+            return nullptr;
+    }
+    return result;
+}
+
+// ============================================================================
+// In-memory decode sources (frame reads through FrameFileReader)
+// ============================================================================
+
+namespace {
+
+// Read position over a file FrameFileReader loaded
+struct MemorySource {
+    const uint8_t* data = nullptr;
+    size_t size = 0;
+    size_t pos = 0;
+};
+
+tmsize_t TIFFMemoryRead(thandle_t handle, void* buffer, tmsize_t size) {
+    auto* source = static_cast<MemorySource*>(handle);
+    const size_t count = std::min(static_cast<size_t>(size), source->size - source->pos);
+    std::memcpy(buffer, source->data + source->pos, count);
+    source->pos += count;
+    return static_cast<tmsize_t>(count);
+}
+
+tmsize_t TIFFMemoryWrite(thandle_t, void*, tmsize_t) {
+    return 0;
+}
+
+toff_t TIFFMemorySeek(thandle_t handle, toff_t offset, int whence) {
+    auto* source = static_cast<MemorySource*>(handle);
+    uint64_t base = 0;
+    if (whence == SEEK_CUR) base = source->pos;
+    if (whence == SEEK_END) base = source->size;
+    source->pos = static_cast<size_t>(std::min<uint64_t>(base + offset, source->size));
+    return source->pos;
+}
+
+int TIFFMemoryClose(thandle_t) {
+    return 0;
+}
+
+toff_t TIFFMemorySize(thandle_t handle) {
+    return static_cast<MemorySource*>(handle)->size;
+}
+
+// libtiff reads strips/tiles straight out of a "mapped" file - no copy
+int TIFFMemoryMap(thandle_t handle, void** base, toff_t* size) {
+    auto* source = static_cast<MemorySource*>(handle);
+    *base = const_cast<uint8_t*>(source->data);
+    *size = source->size;
+    return 1;
+}
+
+void TIFFMemoryUnmap(thandle_t, void*, toff_t) {
+}
+
+// Frame loads: libtiff's own (mapped) file access, or decode from the whole
+// file read by the selected FrameFileReader backend ('bytes'/'source' outlive the TIFF*)
+TIFF* OpenTIFFFrame(const std::string& path, FileBytes& bytes, MemorySource& source, const CancelToken& cancel) {
+    FrameFileReader& reader = FrameFileReader::Shared();
+    if (reader.ReadsIntoMemory()) {
+        if (!reader.ReadFile(path, bytes, cancel)) {
+            return nullptr;
+        }
+        source.data = bytes.data();
+        source.size = bytes.size();
+        source.pos = 0;
+        return TIFFClientOpen(path.c_str(), "r", static_cast<thandle_t>(&source),
+                              TIFFMemoryRead, TIFFMemoryWrite, TIFFMemorySeek, TIFFMemoryClose,
+                              TIFFMemorySize, TIFFMemoryMap, TIFFMemoryUnmap);
+    }
+#ifdef _WIN32
+    std::wstring wpath(path.begin(), path.end());
+    return TIFFOpenW(wpath.c_str(), "r");
+#else
+    return TIFFOpen(path.c_str(), "r");
+#endif
+}
+
+void PNGMemoryRead(png_structp png, png_bytep out, png_size_t length) {
+    auto* source = static_cast<MemorySource*>(png_get_io_ptr(png));
+    if (source->size - source->pos < length) {
+        png_error(png, "Read past end of file");
+    }
+    std::memcpy(out, source->data + source->pos, length);
+    source->pos += length;
+}
+
+} // namespace
+
 // ============================================================================
 // TIFF Loader (libtiff)
 // ============================================================================
@@ -112,16 +333,49 @@ bool GetInfo(const std::string& path, ImageInfo& info) {
     return true;
 }
 
-bool Load(const std::string& path, std::vector<uint8_t>& pixel_data,
-          int& width, int& height, PipelineMode& mode) {
+bool GetLayout(const std::string& path, FrameLayout& layout) {
+    ImageInfo info;
+    if (!GetInfo(path, info)) {
+        return false;
+    }
+
+    layout.width = info.width;
+    layout.height = info.height;
+    layout.gl_format = GL_RGBA;
+    layout.pipeline_mode = info.recommended_pipeline;
+    if (info.bit_depth <= 8) {
+        layout.gl_type = GL_UNSIGNED_BYTE;
+        layout.pipeline_mode = PipelineMode::NORMAL;
+    } else if (info.is_float) {
+        layout.gl_type = (info.bit_depth == 32) ? GL_FLOAT : GL_HALF_FLOAT;
+    } else if (info.bit_depth == 16) {
+        layout.gl_type = GL_UNSIGNED_SHORT;
+    } else {
+        return false;  // Same samples LoadInto() rejects
+    }
+    return true;
+}
+
+bool Load(const std::string& path, PixelBuffer& pixel_data,
+          int& width, int& height, PipelineMode& mode,
+          const CancelToken& cancel) {
+    FrameLayout layout;
+    if (!LoadInto(path, AllocateInto(pixel_data), layout, cancel)) {
+        return false;
+    }
+    width = layout.width;
+    height = layout.height;
+    mode = layout.pipeline_mode;
+    return true;
+}
+
+bool LoadInto(const std::string& path, const FrameDestinationProvider& provide,
+              FrameLayout& layout, const CancelToken& cancel) {
     Debug::Log("TIFFLoader::Load: Attempting to load " + path);
 
-#ifdef _WIN32
-    std::wstring wpath(path.begin(), path.end());
-    TIFF* tif = TIFFOpenW(wpath.c_str(), "r");
-#else
-    TIFF* tif = TIFFOpen(path.c_str(), "r");
-#endif
+    FileBytes bytes;
+    MemorySource source;
+    TIFF* tif = OpenTIFFFrame(path, bytes, source, cancel);
 
     if (!tif) {
         Debug::Log("TIFFLoader::Load: Failed to open " + path);
@@ -166,10 +420,12 @@ bool Load(const std::string& path, std::vector<uint8_t>& pixel_data,
                ", extraSamples=" + std::to_string(extraSamplesCount) +
                " type=" + extraSampleType);
 
-    width = tiffWidth;
-    height = tiffHeight;
+    layout.width = tiffWidth;
+    layout.height = tiffHeight;
+    layout.gl_format = GL_RGBA;
 
     // Set pipeline mode based on bit depth
+    PipelineMode& mode = layout.pipeline_mode;
     if (bitDepth == 8) {
         mode = PipelineMode::NORMAL;
     } else if (bitDepth == 16) {
@@ -180,33 +436,121 @@ bool Load(const std::string& path, std::vector<uint8_t>& pixel_data,
     } else {
         mode = PipelineMode::NORMAL;  // Fallback
     }
+    // <= 8-bit goes through libtiff's RGBA8 conversion; wider samples are copied as-is
+    const bool rgba8 = (bitDepth <= 8);
+    if (rgba8) {
+        layout.gl_type = GL_UNSIGNED_BYTE;
+    } else if (sampleFormat == SAMPLEFORMAT_IEEEFP) {
+        layout.gl_type = (bitDepth == 32) ? GL_FLOAT : GL_HALF_FLOAT;
+    } else if (bitDepth == 16) {
+        layout.gl_type = GL_UNSIGNED_SHORT;
+    } else {
+        Debug::Log("TIFFLoader::Load: Unsupported " + std::to_string(bitDepth) + "-bit integer samples in " + path);
+        TIFFClose(tif);
+        return false;
+    }
+
+    FrameDestination dest;
+    if (!provide(layout, dest)) {
+        Debug::Log("TIFFLoader::Load: No destination for " + std::to_string(tiffWidth) + "x" + std::to_string(tiffHeight) + " frame");
+        TIFFClose(tif);
+        return false;
+    }
 
     // Use TIFFReadRGBAImageOriented for automatic format conversion
     // This handles all TIFF formats and converts to ABGR uint32
-    if (bitDepth == 8) {
-        // 8-bit: Use RGBA conversion
-        std::vector<uint32_t> temp_buffer(tiffWidth * tiffHeight);
-        if (!TIFFReadRGBAImageOriented(tif, tiffWidth, tiffHeight, temp_buffer.data(), ORIENTATION_TOPLEFT, 0)) {
-            Debug::Log("TIFFLoader::Load: Failed to read RGBA image data");
-            TIFFClose(tif);
-            return false;
-        }
+    if (rgba8) {
+        // 8-bit: libtiff's packed ABGR uint32 is R,G,B,A in memory on little-endian hosts,
+        // so a tightly packed, 4-byte aligned destination is decoded into directly
+        const size_t stride = dest.Stride(layout);
+        const bool direct = (stride == static_cast<size_t>(tiffWidth) * 4) &&
+                            (reinterpret_cast<uintptr_t>(dest.data) % alignof(uint32_t) == 0);
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+        constexpr bool hostIsRGBA = false;
+#else
+        constexpr bool hostIsRGBA = true;
+#endif
+
+        uint16_t orientation = ORIENTATION_TOPLEFT;
+        TIFFGetFieldDefaulted(tif, TIFFTAG_ORIENTATION, &orientation);
+
+        // Convert ABGR (uint32) rows to RGBA (4x uint8) at the destination
+        auto storeRows = [&](const uint32_t* raster, uint32_t firstRow, uint32_t rows) {
+            for (uint32_t r = 0; r < rows; ++r) {
+                const uint32_t* src = raster + static_cast<size_t>(r) * tiffWidth;
+                uint8_t* dst = dest.Row(layout, firstRow + r);
+                if (hostIsRGBA) {
+                    std::memcpy(dst, src, static_cast<size_t>(tiffWidth) * 4);
+                    continue;
+                }
+                for (uint32_t x = 0; x < tiffWidth; ++x) {
+                    uint32_t abgr = src[x];
+                    dst[x * 4 + 0] = TIFFGetR(abgr);  // R
+                    dst[x * 4 + 1] = TIFFGetG(abgr);  // G
+                    dst[x * 4 + 2] = TIFFGetB(abgr);  // B
+                    dst[x * 4 + 3] = TIFFGetA(abgr);  // A
+                }
+            }
+        };
+
+        if (orientation == ORIENTATION_TOPLEFT) {
+            // Decode in row bands so a cancelled load stops early
+            // (same TIFFRGBAImage calls TIFFReadRGBAImageOriented makes, split by row_offset)
+            const uint32_t bandRows = 64;
+            std::vector<uint32_t> band;
+            if (!direct || !hostIsRGBA) {
+                band.resize(static_cast<size_t>(tiffWidth) * bandRows);
+            }
 
-        // Convert ABGR (uint32) to RGBA (4x uint8)
-        pixel_data.resize(tiffWidth * tiffHeight * 4);
-        for (size_t i = 0; i < tiffWidth * tiffHeight; ++i) {
-            uint32_t abgr = temp_buffer[i];
-            pixel_data[i * 4 + 0] = TIFFGetR(abgr);  // R
-            pixel_data[i * 4 + 1] = TIFFGetG(abgr);  // G
-            pixel_data[i * 4 + 2] = TIFFGetB(abgr);  // B
-            pixel_data[i * 4 + 3] = TIFFGetA(abgr);  // A
+            char emsg[1024] = {};
+            TIFFRGBAImage img;
+            if (!TIFFRGBAImageOK(tif, emsg) || !TIFFRGBAImageBegin(&img, tif, 0, emsg)) {
+                Debug::Log("TIFFLoader::Load: Failed to read RGBA image data - " + std::string(emsg));
+                TIFFClose(tif);
+                return false;
+            }
+            img.req_orientation = ORIENTATION_TOPLEFT;
+
+            for (uint32_t row = 0; row < tiffHeight; row += bandRows) {
+                if (cancel.IsCancelled()) {
+                    TIFFRGBAImageEnd(&img);
+                    TIFFClose(tif);
+                    return false;
+                }
+
+                const uint32_t rows = (std::min)(bandRows, tiffHeight - row);
+                uint32_t* raster = band.empty()
+                    ? reinterpret_cast<uint32_t*>(dest.Row(layout, row))
+                    : band.data();
+                img.row_offset = static_cast<int>(row);
+                img.col_offset = 0;
+                if (!TIFFRGBAImageGet(&img, raster, tiffWidth, rows)) {
+                    Debug::Log("TIFFLoader::Load: Failed to read RGBA image data");
+                    TIFFRGBAImageEnd(&img);
+                    TIFFClose(tif);
+                    return false;
+                }
+                if (!band.empty()) {
+                    storeRows(band.data(), row, rows);
+                }
+            }
+            TIFFRGBAImageEnd(&img);
+        } else {
+            // Reoriented files can't be split into bands - single read
+            std::vector<uint32_t> temp_buffer(static_cast<size_t>(tiffWidth) * tiffHeight);
+            if (cancel.IsCancelled() ||
+                !TIFFReadRGBAImageOriented(tif, tiffWidth, tiffHeight, temp_buffer.data(), ORIENTATION_TOPLEFT, 0)) {
+                Debug::Log("TIFFLoader::Load: Failed to read RGBA image data");
+                TIFFClose(tif);
+                return false;
+            }
+            storeRows(temp_buffer.data(), 0, tiffHeight);
         }
     } else {
         // 16-bit: Read scanlines directly and convert to RGBA16
         size_t bytes_per_sample = (bitDepth + 7) / 8;
         size_t scanlineSize = TIFFScanlineSize(tif);
         std::vector<uint8_t> temp_scanline(scanlineSize);
-        pixel_data.resize(tiffHeight * tiffWidth * 4 * bytes_per_sample);
 
         // Check TIFF byte order - TIFFIsByteSwapped() returns true if libtiff is already handling byte swapping
         bool isByteSwapped = TIFFIsByteSwapped(tif) != 0;
@@ -215,6 +559,11 @@ bool Load(const std::string& path, std::vector<uint8_t>& pixel_data,
         }
 
         for (uint32_t row = 0; row < tiffHeight; row++) {
+            if (cancel.IsCancelled()) {
+                TIFFClose(tif);
+                return false;
+            }
+
             if (TIFFReadScanline(tif, temp_scanline.data(), row) < 0) {
                 Debug::Log("TIFFLoader::Load: Failed to read scanline " + std::to_string(row));
                 TIFFClose(tif);
@@ -225,7 +574,7 @@ bool Load(const std::string& path, std::vector<uint8_t>& pixel_data,
             // So we do NOT need to manually swap - the data is already in host byte order
 
             // Convert to RGBA (add alpha channel if needed)
-            uint8_t* dest = pixel_data.data() + row * tiffWidth * 4 * bytes_per_sample;
+            uint8_t* dest_row = dest.Row(layout, row);
             if (samplesPerPixel == 4) {
                 // 4 channels - need to check if it's RGBA or needs reordering
                 // TIFF with photometric=RGB and 4 channels is typically RGBA, but may need verification
@@ -237,7 +586,7 @@ bool Load(const std::string& path, std::vector<uint8_t>& pixel_data,
                 // Try swapping to see if it's ABGR instead of RGBA
                 if (bitDepth == 16) {
                     uint16_t* src = reinterpret_cast<uint16_t*>(temp_scanline.data());
-                    uint16_t* dst = reinterpret_cast<uint16_t*>(dest);
+                    uint16_t* dst = reinterpret_cast<uint16_t*>(dest_row);
 
                     if (row == 0) {
                         Debug::Log("TIFFLoader::Load: 16-bit RGBA direct copy (no channel swap)");
@@ -253,45 +602,46 @@ bool Load(const std::string& path, std::vector<uint8_t>& pixel_data,
                     // Direct copy - assume TIFF is already in RGBA order
                     memcpy(dst, src, tiffWidth * 4 * bytes_per_sample);
                 } else {
-                    memcpy(dest, temp_scanline.data(), tiffWidth * 4 * bytes_per_sample);
+                    memcpy(dest_row, temp_scanline.data(), tiffWidth * 4 * bytes_per_sample);
                 }
             } else if (samplesPerPixel == 3) {
                 // RGB → RGBA, add alpha channel
                 if (row == 0) {
                     Debug::Log("TIFFLoader::Load: 16-bit RGB (3 channels) - converting to RGBA, scanlineSize=" + std::to_string(scanlineSize));
                 }
-                if (bitDepth == 16) {
+                if (layout.gl_type == GL_UNSIGNED_SHORT || layout.gl_type == GL_HALF_FLOAT) {
+                    const uint16_t alphaMax = (layout.gl_type == GL_HALF_FLOAT) ? 0x3C00 : 65535;  // half 1.0 / max
                     uint16_t* src = reinterpret_cast<uint16_t*>(temp_scanline.data());
-                    uint16_t* dst = reinterpret_cast<uint16_t*>(dest);
+                    uint16_t* dst = reinterpret_cast<uint16_t*>(dest_row);
                     for (uint32_t x = 0; x < tiffWidth; ++x) {
                         dst[x * 4 + 0] = src[x * 3 + 0];  // R
                         dst[x * 4 + 1] = src[x * 3 + 1];  // G
                         dst[x * 4 + 2] = src[x * 3 + 2];  // B
-                        dst[x * 4 + 3] = 65535;           // A = max
+                        dst[x * 4 + 3] = alphaMax;        // A = max
                     }
                 } else {
-                    uint8_t* src = temp_scanline.data();
+                    float* src = reinterpret_cast<float*>(temp_scanline.data());
+                    float* dst = reinterpret_cast<float*>(dest_row);
                     for (uint32_t x = 0; x < tiffWidth; ++x) {
-                        dest[x * 4 + 0] = src[x * 3 + 0];  // R
-                        dest[x * 4 + 1] = src[x * 3 + 1];  // G
-                        dest[x * 4 + 2] = src[x * 3 + 2];  // B
-                        dest[x * 4 + 3] = 255;             // A = max
+                        dst[x * 4 + 0] = src[x * 3 + 0];  // R
+                        dst[x * 4 + 1] = src[x * 3 + 1];  // G
+                        dst[x * 4 + 2] = src[x * 3 + 2];  // B
+                        dst[x * 4 + 3] = 1.0f;            // A = opaque
                     }
                 }
             } else {
                 if (row == 0) {
                     Debug::Log("TIFFLoader::Load: WARNING - Unexpected samplesPerPixel=" + std::to_string(samplesPerPixel));
                 }
+                std::memset(dest_row, 0, layout.RowBytes());  // Destination is uninitialized
             }
         }
     }
 
     TIFFClose(tif);
 
-    size_t expected_size = tiffWidth * tiffHeight * 4 * ((bitDepth == 8) ? 1 : 2);
     Debug::Log("TIFFLoader::Load: Successfully loaded " + path + " -> " +
-               PipelineModeToString(mode) + ", pixel_data size: " + std::to_string(pixel_data.size()) +
-               " (expected: " + std::to_string(expected_size) + ")");
+               PipelineModeToString(mode) + ", " + std::to_string(layout.ByteSize()) + " bytes");
 
     return true;
 }
@@ -360,45 +710,90 @@ bool GetInfo(const std::string& path, ImageInfo& info) {
     return true;
 }
 
-bool Load(const std::string& path, std::vector<uint8_t>& pixel_data,
-          int& width, int& height, PipelineMode& mode) {
+bool GetLayout(const std::string& path, FrameLayout& layout) {
+    ImageInfo info;
+    if (!GetInfo(path, info)) {
+        return false;
+    }
+
+    // Load() always expands to RGBA at the source bit depth
+    layout.width = info.width;
+    layout.height = info.height;
+    layout.gl_format = GL_RGBA;
+    layout.gl_type = (info.bit_depth > 8) ? GL_UNSIGNED_SHORT : GL_UNSIGNED_BYTE;
+    layout.pipeline_mode = info.recommended_pipeline;
+    return true;
+}
+
+bool Load(const std::string& path, PixelBuffer& pixel_data,
+          int& width, int& height, PipelineMode& mode,
+          const CancelToken& cancel) {
+    FrameLayout layout;
+    if (!LoadInto(path, AllocateInto(pixel_data), layout, cancel)) {
+        return false;
+    }
+    width = layout.width;
+    height = layout.height;
+    mode = layout.pipeline_mode;
+    return true;
+}
+
+bool LoadInto(const std::string& path, const FrameDestinationProvider& provide,
+              FrameLayout& layout, const CancelToken& cancel) {
+    // Decode from the whole file when the read backend isn't mmap
+    FileBytes bytes;
+    MemorySource source;
+    FILE* fp = nullptr;
+    if (FrameFileReader::Shared().ReadsIntoMemory()) {
+        if (!FrameFileReader::Shared().ReadFile(path, bytes, cancel)) {
+            Debug::Log("PNGLoader::Load: Failed to read " + path);
+            return false;
+        }
+        source.data = bytes.data();
+        source.size = bytes.size();
+    } else {
 #ifdef _WIN32
-    FILE* fp = _wfopen(std::wstring(path.begin(), path.end()).c_str(), L"rb");
+        fp = _wfopen(std::wstring(path.begin(), path.end()).c_str(), L"rb");
 #else
-    FILE* fp = fopen(path.c_str(), "rb");
+        fp = fopen(path.c_str(), "rb");
 #endif
-
-    if (!fp) {
-        Debug::Log("PNGLoader::Load: Failed to open " + path);
-        return false;
+        if (!fp) {
+            Debug::Log("PNGLoader::Load: Failed to open " + path);
+            return false;
+        }
     }
 
     png_structp png = png_create_read_struct(PNG_LIBPNG_VER_STRING, nullptr, nullptr, nullptr);
     if (!png) {
-        fclose(fp);
+        if (fp) fclose(fp);
         return false;
     }
 
     png_infop info_png = png_create_info_struct(png);
     if (!info_png) {
         png_destroy_read_struct(&png, nullptr, nullptr);
-        fclose(fp);
+        if (fp) fclose(fp);
         return false;
     }
 
     if (setjmp(png_jmpbuf(png))) {
         png_destroy_read_struct(&png, &info_png, nullptr);
-        fclose(fp);
+        if (fp) fclose(fp);
         return false;
     }
 
-    png_init_io(png, fp);
+    if (fp) {
+        png_init_io(png, fp);
+    } else {
+        png_set_read_fn(png, &source, PNGMemoryRead);
+    }
     png_read_info(png, info_png);
 
-    width = png_get_image_width(png, info_png);
-    height = png_get_image_height(png, info_png);
-    int channels = png_get_channels(png, info_png);
+    const int width = png_get_image_width(png, info_png);
+    const int height = png_get_image_height(png, info_png);
     int bitDepth = png_get_bit_depth(png, info_png);
+    int sourceColorType = png_get_color_type(png, info_png);
+    bool hasTRNS = png_get_valid(png, info_png, PNG_INFO_tRNS) != 0;
 
     // Auto-expand formats and ensure RGBA output
     png_set_expand(png);              // Expand palette/grayscale
@@ -406,8 +801,8 @@ bool Load(const std::string& path, std::vector<uint8_t>& pixel_data,
     png_set_tRNS_to_alpha(png);       // tRNS → alpha channel
     png_set_gray_to_rgb(png);         // Grayscale → RGB
 
-    // Add alpha channel if missing (RGB → RGBA)
-    if (channels == 3 || (channels == 1 && bitDepth == 8)) {
+    // Add alpha channel if missing (RGB/gray/palette without tRNS → RGBA)
+    if (!(sourceColorType & PNG_COLOR_MASK_ALPHA) && !hasTRNS) {
         png_set_add_alpha(png, (bitDepth == 16) ? 0xFFFF : 0xFF, PNG_FILLER_AFTER);
     }
 
@@ -422,6 +817,9 @@ bool Load(const std::string& path, std::vector<uint8_t>& pixel_data,
 #endif
     }
 
+    // Row-by-row reads below need libpng to run the interlace passes
+    const int passes = png_set_interlace_handling(png);
+
     // Update info after transformations
     png_read_update_info(png, info_png);
 
@@ -433,22 +831,40 @@ bool Load(const std::string& path, std::vector<uint8_t>& pixel_data,
                ", bit_depth=" + std::to_string(final_bit_depth) +
                ", color_type=" + std::to_string(color_type));
 
-    // Allocate buffer for RGBA output
+    layout.width = width;
+    layout.height = height;
+    layout.gl_format = GL_RGBA;
+    layout.gl_type = (final_bit_depth > 8) ? GL_UNSIGNED_SHORT : GL_UNSIGNED_BYTE;
+    layout.pipeline_mode = (bitDepth > 8) ? PipelineMode::HIGH_RES : PipelineMode::NORMAL;
+
+    // Transformed rows must be exactly RGBA at the layout's depth
     size_t rowBytes = png_get_rowbytes(png, info_png);
-    pixel_data.resize(height * rowBytes);
+    FrameDestination dest;
+    if (final_channels != 4 || rowBytes != layout.RowBytes() || !provide(layout, dest)) {
+        Debug::Log("PNGLoader::Load: No destination for " + std::to_string(width) + "x" + std::to_string(height) +
+                   " frame (" + std::to_string(final_channels) + " channels)");
+        png_destroy_read_struct(&png, &info_png, nullptr);
+        if (fp) fclose(fp);
+        return false;
+    }
 
-    // Read scanlines
-    std::vector<png_bytep> rows(height);
-    for (int y = 0; y < height; y++) {
-        rows[y] = pixel_data.data() + y * rowBytes;
+    // Read scanlines (row by row so a cancelled load stops early)
+    for (int pass = 0; pass < passes; pass++) {
+        for (int y = 0; y < height; y++) {
+            if (cancel.IsCancelled()) {
+                png_destroy_read_struct(&png, &info_png, nullptr);
+                if (fp) fclose(fp);
+                return false;
+            }
+            png_read_row(png, dest.Row(layout, y), nullptr);
+        }
     }
-    png_read_image(png, rows.data());
 
     // Log first non-zero pixel for channel order verification
-    if (bitDepth == 16 && pixel_data.size() >= 8) {
-        const uint16_t* pixels16 = reinterpret_cast<const uint16_t*>(pixel_data.data());
+    if (bitDepth == 16 && width > 0) {
+        const uint16_t* pixels16 = reinterpret_cast<const uint16_t*>(dest.Row(layout, 0));
         bool found_nonzero = false;
-        for (size_t i = 0; i < std::min(pixel_data.size() / 8, size_t(100)); i++) {
+        for (int i = 0; i < (std::min)(width, 100); i++) {
             if (pixels16[i*4] != 0 || pixels16[i*4+1] != 0 || pixels16[i*4+2] != 0) {
                 Debug::Log("PNGLoader::Load: First non-zero pixel at offset " + std::to_string(i) +
                            ": R=" + std::to_string(pixels16[i*4]) +
@@ -464,16 +880,11 @@ bool Load(const std::string& path, std::vector<uint8_t>& pixel_data,
         }
     }
 
-    // Set pipeline mode
-    mode = (bitDepth > 8) ? PipelineMode::HIGH_RES : PipelineMode::NORMAL;
-
     png_destroy_read_struct(&png, &info_png, nullptr);
-    fclose(fp);
+    if (fp) fclose(fp);
 
-    size_t expected_size = width * height * 4 * ((bitDepth > 8) ? 2 : 1);
     Debug::Log("PNGLoader::Load: Successfully loaded " + path + " -> " +
-               PipelineModeToString(mode) + ", pixel_data size: " + std::to_string(pixel_data.size()) +
-               " (expected: " + std::to_string(expected_size) + ")");
+               PipelineModeToString(layout.pipeline_mode) + ", " + std::to_string(layout.ByteSize()) + " bytes");
 
     return true;
 }
@@ -528,17 +939,53 @@ bool GetInfo(const std::string& path, ImageInfo& info) {
     return true;
 }
 
-bool Load(const std::string& path, std::vector<uint8_t>& pixel_data,
-          int& width, int& height, PipelineMode& mode) {
+bool GetLayout(const std::string& path, FrameLayout& layout) {
+    ImageInfo info;
+    if (!GetInfo(path, info)) {
+        return false;
+    }
+
+    layout.width = info.width;
+    layout.height = info.height;
+    layout.gl_format = GL_RGBA;
+    layout.gl_type = GL_UNSIGNED_BYTE;  // JPEG is always 8-bit
+    layout.pipeline_mode = PipelineMode::NORMAL;
+    return true;
+}
+
+bool Load(const std::string& path, PixelBuffer& pixel_data,
+          int& width, int& height, PipelineMode& mode,
+          const CancelToken& cancel) {
+    FrameLayout layout;
+    if (!LoadInto(path, AllocateInto(pixel_data), layout, cancel)) {
+        return false;
+    }
+    width = layout.width;
+    height = layout.height;
+    mode = layout.pipeline_mode;
+    return true;
+}
+
+bool LoadInto(const std::string& path, const FrameDestinationProvider& provide,
+              FrameLayout& layout, const CancelToken& cancel) {
+    // Decode from the whole file when the read backend isn't mmap
+    FileBytes bytes;
+    FILE* fp = nullptr;
+    if (FrameFileReader::Shared().ReadsIntoMemory()) {
+        if (!FrameFileReader::Shared().ReadFile(path, bytes, cancel)) {
+            Debug::Log("JPEGLoader::Load: Failed to read " + path);
+            return false;
+        }
+    } else {
 #ifdef _WIN32
-    FILE* fp = _wfopen(std::wstring(path.begin(), path.end()).c_str(), L"rb");
+        fp = _wfopen(std::wstring(path.begin(), path.end()).c_str(), L"rb");
 #else
-    FILE* fp = fopen(path.c_str(), "rb");
+        fp = fopen(path.c_str(), "rb");
 #endif
-
-    if (!fp) {
-        Debug::Log("JPEGLoader::Load: Failed to open " + path);
-        return false;
+        if (!fp) {
+            Debug::Log("JPEGLoader::Load: Failed to open " + path);
+            return false;
+        }
     }
 
     struct jpeg_decompress_struct cinfo;
@@ -546,65 +993,99 @@ bool Load(const std::string& path, std::vector<uint8_t>& pixel_data,
 
     cinfo.err = jpeg_std_error(&jerr);
     jpeg_create_decompress(&cinfo);
-    jpeg_stdio_src(&cinfo, fp);
+    if (fp) {
+        jpeg_stdio_src(&cinfo, fp);
+    } else {
+        jpeg_mem_src(&cinfo, const_cast<unsigned char*>(bytes.data()), static_cast<unsigned long>(bytes.size()));
+    }
 
     if (jpeg_read_header(&cinfo, TRUE) != JPEG_HEADER_OK) {
         jpeg_destroy_decompress(&cinfo);
-        fclose(fp);
+        if (fp) fclose(fp);
         return false;
     }
 
+#ifdef JCS_EXTENSIONS
+    // libjpeg-turbo converts RGB/grayscale straight to RGBA - scanlines land in the destination
+    const bool directRGBA = (cinfo.jpeg_color_space == JCS_YCbCr ||
+                             cinfo.jpeg_color_space == JCS_RGB ||
+                             cinfo.jpeg_color_space == JCS_GRAYSCALE);
+    if (directRGBA) {
+        cinfo.out_color_space = JCS_EXT_RGBA;
+    }
+#else
+    const bool directRGBA = false;
+#endif
+
     jpeg_start_decompress(&cinfo);
 
-    width = cinfo.output_width;
-    height = cinfo.output_height;
+    const int width = cinfo.output_width;
+    const int height = cinfo.output_height;
     int channels = cinfo.output_components;
 
     Debug::Log("JPEGLoader::Load: Image dimensions " + std::to_string(width) + "x" + std::to_string(height) +
                ", channels=" + std::to_string(channels));
 
-    // Read JPEG scanlines into temporary RGB buffer
-    size_t rowStride = width * channels;
-    std::vector<uint8_t> temp_rgb(height * rowStride);
+    layout.width = width;
+    layout.height = height;
+    layout.gl_format = GL_RGBA;
+    layout.gl_type = GL_UNSIGNED_BYTE;          // JPEG is always 8-bit
+    layout.pipeline_mode = PipelineMode::NORMAL;
 
-    while (cinfo.output_scanline < cinfo.output_height) {
-        uint8_t* rowPtr = temp_rgb.data() + cinfo.output_scanline * rowStride;
-        jpeg_read_scanlines(&cinfo, &rowPtr, 1);
+    FrameDestination dest;
+    if ((!directRGBA && channels != 3 && channels != 1) || !provide(layout, dest)) {
+        Debug::Log("JPEGLoader::Load: WARNING - Unexpected channel count or no destination: " + std::to_string(channels));
+        jpeg_abort_decompress(&cinfo);
+        jpeg_destroy_decompress(&cinfo);
+        if (fp) fclose(fp);
+        return false;
     }
 
-    jpeg_finish_decompress(&cinfo);
-    jpeg_destroy_decompress(&cinfo);
-    fclose(fp);
+    // Non-RGBA output: one scanline of RGB/gray, expanded to RGBA at the destination
+    std::vector<uint8_t> temp_row(directRGBA ? 0 : static_cast<size_t>(width) * channels);
 
-    // Convert RGB to RGBA (add alpha channel for OpenGL compatibility)
-    pixel_data.resize(width * height * 4);
-    if (channels == 3) {
-        // RGB → RGBA
-        for (int i = 0; i < width * height; ++i) {
-            pixel_data[i * 4 + 0] = temp_rgb[i * 3 + 0];  // R
-            pixel_data[i * 4 + 1] = temp_rgb[i * 3 + 1];  // G
-            pixel_data[i * 4 + 2] = temp_rgb[i * 3 + 2];  // B
-            pixel_data[i * 4 + 3] = 255;                  // A = opaque
+    while (cinfo.output_scanline < cinfo.output_height) {
+        if (cancel.IsCancelled()) {
+            jpeg_abort_decompress(&cinfo);
+            jpeg_destroy_decompress(&cinfo);
+            if (fp) fclose(fp);
+            return false;
         }
-        Debug::Log("JPEGLoader::Load: Converted RGB to RGBA (" + std::to_string(pixel_data.size()) + " bytes)");
-    } else if (channels == 1) {
-        // Grayscale → RGBA
-        for (int i = 0; i < width * height; ++i) {
-            uint8_t gray = temp_rgb[i];
-            pixel_data[i * 4 + 0] = gray;  // R
-            pixel_data[i * 4 + 1] = gray;  // G
-            pixel_data[i * 4 + 2] = gray;  // B
-            pixel_data[i * 4 + 3] = 255;   // A = opaque
+
+        const int y = cinfo.output_scanline;
+        uint8_t* dst = dest.Row(layout, y);
+        uint8_t* rowPtr = directRGBA ? dst : temp_row.data();
+        jpeg_read_scanlines(&cinfo, &rowPtr, 1);
+
+        if (directRGBA) continue;
+
+        // Convert RGB to RGBA (add alpha channel for OpenGL compatibility)
+        if (channels == 3) {
+            // RGB → RGBA
+            for (int x = 0; x < width; ++x) {
+                dst[x * 4 + 0] = temp_row[x * 3 + 0];  // R
+                dst[x * 4 + 1] = temp_row[x * 3 + 1];  // G
+                dst[x * 4 + 2] = temp_row[x * 3 + 2];  // B
+                dst[x * 4 + 3] = 255;                  // A = opaque
+            }
+        } else {
+            // Grayscale → RGBA
+            for (int x = 0; x < width; ++x) {
+                uint8_t gray = temp_row[x];
+                dst[x * 4 + 0] = gray;  // R
+                dst[x * 4 + 1] = gray;  // G
+                dst[x * 4 + 2] = gray;  // B
+                dst[x * 4 + 3] = 255;   // A = opaque
+            }
         }
-        Debug::Log("JPEGLoader::Load: Converted grayscale to RGBA (" + std::to_string(pixel_data.size()) + " bytes)");
-    } else {
-        Debug::Log("JPEGLoader::Load: WARNING - Unexpected channel count: " + std::to_string(channels));
-        return false;
     }
 
-    mode = PipelineMode::NORMAL;  // JPEG is always 8-bit
+    jpeg_finish_decompress(&cinfo);
+    jpeg_destroy_decompress(&cinfo);
+    if (fp) fclose(fp);
 
-    Debug::Log("JPEGLoader::Load: Successfully loaded " + path + " -> NORMAL, RGBA output");
+    Debug::Log("JPEGLoader::Load: Successfully loaded " + path + " -> NORMAL, RGBA output" +
+               (directRGBA ? " (direct)" : " (expanded)"));
 
     return true;
 }
@@ -618,32 +1099,52 @@ bool Load(const std::string& path, std::vector<uint8_t>& pixel_data,
 // TIFF Image Loader (wraps TIFFLoader namespace)
 std::shared_ptr<PixelData> TIFFImageLoader::LoadFrame(
     const std::string& path,
-    const std::string& layer,  // Ignored
+    const std::string& layer,
     PipelineMode pipeline_mode) {
+    return LoadFrame(path, layer, pipeline_mode, CancelToken{});
+}
+
+std::shared_ptr<PixelData> TIFFImageLoader::LoadFrame(
+    const std::string& path,
+    const std::string& layer,  // Ignored
+    PipelineMode pipeline_mode,
+    const CancelToken& cancel) {
 
     auto result = std::make_shared<PixelData>();
 
-    // Use existing TIFFLoader::Load
-    PipelineMode detected_mode = pipeline_mode;
-    if (!TIFFLoader::Load(path, result->pixels, result->width, result->height, detected_mode)) {
+    // Use existing TIFFLoader::LoadInto, decoding into the frame's pooled buffer
+    FrameLayout layout;
+    if (!TIFFLoader::LoadInto(path, AllocateInto(result->pixels), layout, cancel)) {
         return nullptr;
     }
 
-    result->gl_format = GL_RGBA;
-    result->pipeline_mode = detected_mode;
-
-    // Set GL type based on detected pipeline mode
-    if (detected_mode == PipelineMode::NORMAL) {
-        result->gl_type = GL_UNSIGNED_BYTE;  // RGBA8
-    } else if (detected_mode == PipelineMode::HIGH_RES) {
-        result->gl_type = GL_UNSIGNED_SHORT;  // RGBA16
-    } else {
-        result->gl_type = GL_HALF_FLOAT;  // RGBA16F
-    }
+    result->width = layout.width;
+    result->height = layout.height;
+    result->gl_format = layout.gl_format;
+    result->gl_type = layout.gl_type;
+    result->pipeline_mode = layout.pipeline_mode;
 
     return result;
 }
 
+bool TIFFImageLoader::QueryFrameLayout(
+    const std::string& path,
+    const std::string& /*layer*/,
+    PipelineMode /*pipeline_mode*/,
+    FrameLayout& layout) {
+    return TIFFLoader::GetLayout(path, layout);
+}
+
+bool TIFFImageLoader::LoadFrameInto(
+    const std::string& path,
+    const std::string& /*layer*/,
+    PipelineMode /*pipeline_mode*/,
+    const FrameDestination& dest,
+    const CancelToken& cancel) {
+    FrameLayout layout;
+    return TIFFLoader::LoadInto(path, UseDestination(dest), layout, cancel);
+}
+
 std::shared_ptr<PixelData> TIFFImageLoader::LoadThumbnail(const std::string& path, int max_size) {
     // FAST thumbnail loading for TIFF - skip every Nth scanline for speed
     // Trade quality for performance
@@ -732,30 +1233,52 @@ bool TIFFImageLoader::GetDimensions(const std::string& path, int& width, int& he
 // PNG Image Loader (wraps PNGLoader namespace)
 std::shared_ptr<PixelData> PNGImageLoader::LoadFrame(
     const std::string& path,
-    const std::string& layer,  // Ignored
+    const std::string& layer,
     PipelineMode pipeline_mode) {
+    return LoadFrame(path, layer, pipeline_mode, CancelToken{});
+}
+
+std::shared_ptr<PixelData> PNGImageLoader::LoadFrame(
+    const std::string& path,
+    const std::string& layer,  // Ignored
+    PipelineMode pipeline_mode,
+    const CancelToken& cancel) {
 
     auto result = std::make_shared<PixelData>();
 
-    // Use existing PNGLoader::Load
-    PipelineMode detected_mode = pipeline_mode;
-    if (!PNGLoader::Load(path, result->pixels, result->width, result->height, detected_mode)) {
+    // Use existing PNGLoader::LoadInto, decoding into the frame's pooled buffer
+    FrameLayout layout;
+    if (!PNGLoader::LoadInto(path, AllocateInto(result->pixels), layout, cancel)) {
         return nullptr;
     }
 
-    result->gl_format = GL_RGBA;
-    result->pipeline_mode = detected_mode;
-
-    // Set GL type based on detected pipeline mode
-    if (detected_mode == PipelineMode::NORMAL) {
-        result->gl_type = GL_UNSIGNED_BYTE;  // RGBA8
-    } else {
-        result->gl_type = GL_UNSIGNED_SHORT;  // RGBA16 (PNG can be 16-bit)
-    }
+    result->width = layout.width;
+    result->height = layout.height;
+    result->gl_format = layout.gl_format;
+    result->gl_type = layout.gl_type;
+    result->pipeline_mode = layout.pipeline_mode;
 
     return result;
 }
 
+bool PNGImageLoader::QueryFrameLayout(
+    const std::string& path,
+    const std::string& /*layer*/,
+    PipelineMode /*pipeline_mode*/,
+    FrameLayout& layout) {
+    return PNGLoader::GetLayout(path, layout);
+}
+
+bool PNGImageLoader::LoadFrameInto(
+    const std::string& path,
+    const std::string& /*layer*/,
+    PipelineMode /*pipeline_mode*/,
+    const FrameDestination& dest,
+    const CancelToken& cancel) {
+    FrameLayout layout;
+    return PNGLoader::LoadInto(path, UseDestination(dest), layout, cancel);
+}
+
 std::shared_ptr<PixelData> PNGImageLoader::LoadThumbnail(const std::string& path, int max_size) {
     // FAST thumbnail loading for PNG - read every Nth row and skip expensive transforms
 
@@ -895,24 +1418,52 @@ bool PNGImageLoader::GetDimensions(const std::string& path, int& width, int& hei
 // JPEG Image Loader (wraps JPEGLoader namespace)
 std::shared_ptr<PixelData> JPEGImageLoader::LoadFrame(
     const std::string& path,
-    const std::string& layer,  // Ignored
+    const std::string& layer,
     PipelineMode pipeline_mode) {
+    return LoadFrame(path, layer, pipeline_mode, CancelToken{});
+}
+
+std::shared_ptr<PixelData> JPEGImageLoader::LoadFrame(
+    const std::string& path,
+    const std::string& layer,  // Ignored
+    PipelineMode pipeline_mode,
+    const CancelToken& cancel) {
 
     auto result = std::make_shared<PixelData>();
 
-    // Use existing JPEGLoader::Load
-    PipelineMode detected_mode = pipeline_mode;
-    if (!JPEGLoader::Load(path, result->pixels, result->width, result->height, detected_mode)) {
+    // Use existing JPEGLoader::LoadInto, decoding into the frame's pooled buffer
+    FrameLayout layout;
+    if (!JPEGLoader::LoadInto(path, AllocateInto(result->pixels), layout, cancel)) {
         return nullptr;
     }
 
-    result->gl_format = GL_RGBA;
-    result->gl_type = GL_UNSIGNED_BYTE;  // JPEG is always 8-bit
-    result->pipeline_mode = PipelineMode::NORMAL;  // JPEG is always NORMAL mode
+    result->width = layout.width;
+    result->height = layout.height;
+    result->gl_format = layout.gl_format;
+    result->gl_type = layout.gl_type;
+    result->pipeline_mode = layout.pipeline_mode;
 
     return result;
 }
 
+bool JPEGImageLoader::QueryFrameLayout(
+    const std::string& path,
+    const std::string& /*layer*/,
+    PipelineMode /*pipeline_mode*/,
+    FrameLayout& layout) {
+    return JPEGLoader::GetLayout(path, layout);
+}
+
+bool JPEGImageLoader::LoadFrameInto(
+    const std::string& path,
+    const std::string& /*layer*/,
+    PipelineMode /*pipeline_mode*/,
+    const FrameDestination& dest,
+    const CancelToken& cancel) {
+    FrameLayout layout;
+    return JPEGLoader::LoadInto(path, UseDestination(dest), layout, cancel);
+}
+
 std::shared_ptr<PixelData> JPEGImageLoader::LoadThumbnail(const std::string& path, int max_size) {
     // Optimized JPEG thumbnail loading using libjpeg's built-in DCT scaling
     // This is MUCH faster than loading full-res and downsampling with stb_image_resize
@@ -1034,160 +1585,478 @@ std::shared_ptr<PixelData> EXRImageLoader::LoadFrame(
     const std::string& path,
     const std::string& layer,
     PipelineMode pipeline_mode) {
+    return LoadFrame(path, layer, pipeline_mode, CancelToken{});
+}
 
-    // DirectEXRCache::LoadEXRPixels is private, so we inline the EXR loading here
-    // This uses the same memory-mapped, optimized loading path
+std::shared_ptr<PixelData> EXRImageLoader::LoadFrame(
+    const std::string& path,
+    const std::string& layer,
+    PipelineMode pipeline_mode,
+    const CancelToken& cancel) {
 
-    try {
-        auto stream = std::make_unique<MemoryMappedIStream>(path);
-        Imf::MultiPartInputFile file(*stream);
+    auto result = std::make_shared<PixelData>();
 
-        const Imf::Header& header = file.header(0);
-        const Imath::Box2i displayWindow = header.displayWindow();
-        const Imath::Box2i dataWindow = header.dataWindow();
+    FrameLayout layout;
+    if (!DecodeInto(path, layer, AllocateInto(result->pixels), layout, cancel, true)) {
+        return nullptr;
+    }
 
-        const bool fastPath = (displayWindow == dataWindow);
+    result->width = layout.width;
+    result->height = layout.height;
+    result->gl_format = layout.gl_format;
+    result->gl_type = GL_HALF_FLOAT;
+    result->pipeline_mode = PipelineMode::HDR_RES;  // EXR is always HDR
+    ApplyRegion(*result, layout);
 
-        int width = displayWindow.max.x - displayWindow.min.x + 1;
-        int height = displayWindow.max.y - displayWindow.min.y + 1;
+    return result;
+}
 
-        // Allocate pixel buffer
-        auto result = std::make_shared<PixelData>();
-        result->width = width;
-        result->height = height;
-        result->gl_format = GL_RGBA;
-        result->gl_type = GL_HALF_FLOAT;
-        result->pipeline_mode = PipelineMode::HDR_RES;  // EXR is always HDR
+bool EXRImageLoader::QueryFrameLayout(
+    const std::string& path,
+    const std::string& /*layer*/,
+    PipelineMode /*pipeline_mode*/,
+    FrameLayout& layout) {
+    try {
+        // Cached per file once checked against its sequence's layout
+        const auto headerLayout = EXRLayoutCache::Shared().Get(path);
+        layout.width = headerLayout->Width();
+        layout.height = headerLayout->Height();
+        layout.gl_format = GL_RGBA;
+        layout.gl_type = GL_HALF_FLOAT;
+        layout.pipeline_mode = PipelineMode::HDR_RES;
+        return true;
+    } catch (const std::exception& e) {
+        Debug::Log("EXRImageLoader::QueryFrameLayout: Exception - " + std::string(e.what()));
+        return false;
+    }
+}
 
-        const size_t pixelCount = static_cast<size_t>(width) * static_cast<size_t>(height) * 4;
-        result->pixels.resize(pixelCount * sizeof(Imath::half));
-        Imath::half* pixel_half = reinterpret_cast<Imath::half*>(result->pixels.data());
+bool EXRImageLoader::LoadFrameInto(
+    const std::string& path,
+    const std::string& layer,
+    PipelineMode /*pipeline_mode*/,
+    const FrameDestination& dest,
+    const CancelToken& cancel) {
+    // OpenEXR converts to the slice type for free, so half or float destinations both work
+    auto provide = [&dest](const FrameLayout& layout, FrameDestination& out) {
+        if ((dest.gl_type != GL_HALF_FLOAT && dest.gl_type != GL_FLOAT) || !dest.Fits(layout)) {
+            Debug::Log("EXRImageLoader::LoadFrameInto: Destination does not fit " + std::to_string(layout.width) +
+                       "x" + std::to_string(layout.height) + " frame");
+            return false;
+        }
+        out = dest;
+        return true;
+    };
 
-        Imf::FrameBuffer frameBuffer;
-        const Imf::ChannelList& channels = header.channels();
+    FrameLayout layout;
+    return DecodeInto(path, layer, provide, layout, cancel);
+}
 
-        // Find RGBA channels with layer prefix
-        std::string layerPrefix = layer.empty() ? "" : (layer + ".");
-        std::string channelR = layerPrefix + "R";
-        std::string channelG = layerPrefix + "G";
-        std::string channelB = layerPrefix + "B";
-        std::string channelA = layerPrefix + "A";
+bool EXRImageLoader::DecodeInto(const std::string& path, const std::string& layer,
+                                const FrameDestinationProvider& provide, FrameLayout& layout,
+                                const CancelToken& cancel, bool compact) {
+    std::vector<int> planeOf;
+    auto providePlane = [&provide](size_t, const FrameLayout& planeLayout, FrameDestination& dest) {
+        return provide(planeLayout, dest);
+    };
+    return DecodeLayers(path, { layer }, providePlane, layout, planeOf, cancel, compact) &&
+           planeOf[0] >= 0;
+}
 
-        const Imf::Channel* chR = channels.findChannel(channelR.c_str());
-        const Imf::Channel* chG = channels.findChannel(channelG.c_str());
-        const Imf::Channel* chB = channels.findChannel(channelB.c_str());
-        const Imf::Channel* chA = channels.findChannel(channelA.c_str());
+bool EXRImageLoader::DecodeLayers(const std::string& path, const std::vector<std::string>& layers,
+                                  const PlaneProvider& provide, FrameLayout& layout,
+                                  std::vector<int>& planeOf, const CancelToken& cancel,
+                                  bool compact) {
+    // DirectEXRCache::LoadEXRPixels is private, so we inline the EXR loading here
+    // This uses the same stream selection (mapped or read by FrameFileReader)
 
-        // Fallback to root-level channels
-        if (!chR && !layer.empty()) {
-            channelR = "R";
-            channelG = "G";
-            channelB = "B";
-            channelA = "A";
-            chR = channels.findChannel("R");
-            chG = channels.findChannel("G");
-            chB = channels.findChannel("B");
-            chA = channels.findChannel("A");
-        }
+    try {
+        FileBytes bytes;
+        auto stream = OpenFrameStream(path, bytes, cancel);
+        Imf::MultiPartInputFile file(*stream);
 
-        if (!chR || !chG || !chB) {
-            Debug::Log("EXRImageLoader::LoadFrame: Missing RGB channels for layer '" + layer + "'");
-            return nullptr;
+        // Sequence layout: checked against this header, layer channels resolved once
+        const auto headerLayout = EXRLayoutCache::Shared().Get(path, file);
+        const Imath::Box2i displayWindow = headerLayout->display_window;
+        const Imath::Box2i dataWindow = headerLayout->data_window;
+        const Imf::Compression compression = headerLayout->compression;
+
+        // One plane per distinct channel set - layers falling back to the
+        // root R/G/B/A share a plane (a frame buffer takes each channel once)
+        std::vector<const EXRLayerMapping*> mappings;
+        planeOf.assign(layers.size(), -1);
+        for (size_t i = 0; i < layers.size(); ++i) {
+            const EXRLayerMapping& mapping = headerLayout->Resolve(layers[i]);
+            if (!mapping.valid) {
+                Debug::Log("EXRImageLoader::LoadFrame: Missing RGB channels for layer '" + layers[i] + "'");
+                continue;
+            }
+            for (size_t p = 0; p < mappings.size() && planeOf[i] < 0; ++p) {
+                if (mappings[p]->names[0] == mapping.names[0]) {
+                    planeOf[i] = static_cast<int>(p);
+                }
+            }
+            if (planeOf[i] < 0) {
+                planeOf[i] = static_cast<int>(mappings.size());
+                mappings.push_back(&mapping);
+            }
+        }
+        if (mappings.empty()) {
+            return false;
         }
 
-        bool hasAlpha = (chA != nullptr);
-        std::string fullChannelNames[4] = { channelR, channelG, channelB, channelA };
-        int numChannels = hasAlpha ? 4 : 3;
+        if (!compact) {
+            for (const EXRLayerMapping* mapping : mappings) {
+                if (!mapping->IsRGB()) {
+                    Debug::Log("EXRImageLoader::LoadFrame: AOV layers decode through LoadFrame() only");
+                    return false;
+                }
+            }
+        }
 
-        Imf::InputPart part(file, 0);
+        layout.width = headerLayout->Width();
+        layout.height = headerLayout->Height();
+        layout.gl_format = GL_RGBA;
+        layout.gl_type = GL_HALF_FLOAT;
+        layout.pipeline_mode = PipelineMode::HDR_RES;  // EXR is always HDR
+
+        // Compact storage, data window: read just the visible part of the
+        // data window (nothing to pad, so nothing outside it is written)
+        Imath::Box2i readWindow = displayWindow;
+        Imath::Box2i region;
+        if (compact && !headerLayout->FastPath() &&
+            EXRStoredRegion(displayWindow, dataWindow, region)) {
+            readWindow = region;
+            layout.width = region.max.x - region.min.x + 1;
+            layout.height = region.max.y - region.min.y + 1;
+            layout.region_x = region.min.x - displayWindow.min.x;
+            layout.region_y = region.min.y - displayWindow.min.y;
+            layout.full_width = headerLayout->Width();
+            layout.full_height = headerLayout->Height();
+        }
 
-        if (fastPath) {
-            // FAST PATH: Direct read
-            const size_t channelByteCount = sizeof(Imath::half);
-            const size_t cb = 4 * channelByteCount;
-            const size_t scb = width * 4 * channelByteCount;
-
-            for (int c = 0; c < numChannels; ++c) {
-                frameBuffer.insert(
-                    fullChannelNames[c].c_str(),
-                    Imf::Slice(
-                        Imf::HALF,
-                        (char*)(pixel_half) + (c * channelByteCount),
-                        cb, scb, 1, 1, 0.0f
-                    )
-                );
+        // Compact storage, channels: only those the layer has - RGB without
+        // alpha, RG/RED for AOVs (else RGBA, a missing alpha filled with 1.0)
+        static const GLenum kFormats[5] = { GL_RGBA, GL_RED, GL_RG, GL_RGB, GL_RGBA };
+        std::vector<FrameLayout> planeLayouts(mappings.size(), layout);
+        for (size_t p = 0; p < mappings.size(); ++p) {
+            planeLayouts[p].gl_format = compact ? kFormats[mappings[p]->components] : GL_RGBA;
+            planeLayouts[p].opaque = !mappings[p]->has_alpha;
+        }
+        layout.gl_format = planeLayouts[0].gl_format;
+        layout.opaque = planeLayouts[0].opaque;
+
+        // Destination may ask for float - OpenEXR converts while decoding.
+        // Every plane takes the first plane's type (one channel type per read).
+        std::vector<FrameDestination> dests(mappings.size());
+        for (size_t p = 0; p < mappings.size(); ++p) {
+            if (!provide(p, planeLayouts[p], dests[p])) {
+                return false;
             }
+            if (dests[p].gl_type != dests[0].gl_type) {
+                Debug::Log("EXRImageLoader::LoadFrame: Layer destinations differ in pixel type");
+                return false;
+            }
+        }
 
-            if (!hasAlpha) {
-                for (int i = 0; i < width * height; ++i) {
-                    pixel_half[i * 4 + 3] = 1.0f;
+        const Imf::PixelType sliceType = (dests[0].gl_type == GL_FLOAT) ? Imf::FLOAT : Imf::HALF;
+        const size_t channelByteCount = (dests[0].gl_type == GL_FLOAT) ? sizeof(float) : sizeof(Imath::half);
+
+        // Padding outside the data window is black, opaque when an RGBA plane has no alpha
+        std::vector<std::vector<uint8_t>> padPixels(mappings.size());
+        std::vector<EXRPlane> planes(mappings.size());
+        std::vector<int> planeComponents(mappings.size());
+        for (size_t p = 0; p < mappings.size(); ++p) {
+            planeComponents[p] = FormatComponents(planeLayouts[p].gl_format);
+            const size_t pixelBytes = planeComponents[p] * channelByteCount;
+            padPixels[p].assign(pixelBytes, 0);
+            if (planeComponents[p] == 4 && !mappings[p]->has_alpha) {
+                if (sliceType == Imf::FLOAT) {
+                    const float one = 1.0f;
+                    std::memcpy(padPixels[p].data() + 3 * channelByteCount, &one, sizeof(one));
+                } else {
+                    const Imath::half one(1.0f);
+                    std::memcpy(padPixels[p].data() + 3 * channelByteCount, &one, sizeof(one));
                 }
             }
+            FrameLayout destLayout = planeLayouts[p];
+            destLayout.gl_type = dests[p].gl_type;
+            planes[p].dest = dests[p].data;
+            planes[p].stride = dests[p].Stride(destLayout);
+            planes[p].padPixel = padPixels[p].data();
+            planes[p].pixelBytes = pixelBytes;
+        }
 
-            part.setFrameBuffer(frameBuffer);
-            part.readPixels(displayWindow.min.y, displayWindow.max.y);
-        } else {
-            // SLOW PATH: Handle mismatched windows
-            const Imath::Box2i intersectedWindow = Imath::Box2i(
-                Imath::V2i((std::max)(displayWindow.min.x, dataWindow.min.x),
-                          (std::max)(displayWindow.min.y, dataWindow.min.y)),
-                Imath::V2i((std::min)(displayWindow.max.x, dataWindow.max.x),
-                          (std::min)(displayWindow.max.y, dataWindow.max.y))
-            );
-
-            const int dataWidth = dataWindow.max.x - dataWindow.min.x + 1;
-            const size_t channelByteCount = sizeof(Imath::half);
-            const size_t cb = 4 * channelByteCount;
-            const size_t bufSize = dataWidth * cb;
-            std::vector<char> buf(bufSize);
-
-            for (int c = 0; c < numChannels; ++c) {
-                frameBuffer.insert(
-                    fullChannelNames[c].c_str(),
-                    Imf::Slice(
-                        Imf::HALF,
-                        buf.data() - (dataWindow.min.x * cb) + (c * channelByteCount),
-                        cb, 0, 1, 1, 0.0f
-                    )
-                );
+        // A missing alpha channel is filled with 1.0 by OpenEXR (slice fill value)
+        auto insertSlices = [&](Imf::FrameBuffer& fb, size_t plane, char* base, size_t yStride) {
+            const std::string* names = mappings[plane]->names;
+            const int components = planeComponents[plane];
+            const size_t pixelBytes = components * channelByteCount;
+            for (int c = 0; c < components; ++c) {
+                fb.insert(
+                    names[c].c_str(),
+                    Imf::Slice(sliceType, base + (c * channelByteCount), pixelBytes, yStride, 1, 1,
+                               c == 3 ? 1.0 : 0.0));
             }
+        };
+
+        // Whole chunk-aligned ranges decoded once for every plane (straight into
+        // the destinations unless the data window overhangs the display window),
+        // split across idle workers when the calling task has a helper budget
+        Imf::InputPart part(file, 0);
+        return EXRReadWindow(part, insertSlices, 4 * channelByteCount, readWindow, dataWindow, planes,
+                             path, bytes, compression, cancel);
+
+    } catch (const std::exception& e) {
+        Debug::Log("EXRImageLoader::LoadFrame: Exception - " + std::string(e.what()));
+        return false;
+    }
+}
 
-            part.setFrameBuffer(frameBuffer);
+std::shared_ptr<PixelData> EXRImageLoader::LoadFrameDraft(
+    const std::string& path,
+    const std::string& layer,
+    PipelineMode pipeline_mode,
+    int level,
+    const CancelToken& cancel) {
+    if (level <= 0) {
+        return LoadFrame(path, layer, pipeline_mode, cancel);
+    }
 
-            const size_t scb = width * 4 * channelByteCount;
-            for (int y = displayWindow.min.y; y <= displayWindow.max.y; ++y) {
-                uint8_t* p = result->pixels.data() + ((y - displayWindow.min.y) * scb);
-                uint8_t* end = p + scb;
+    try {
+        // Mipmapped: the level is stored, read it (overscan files keep the
+        // generic route - mip levels cover the data window only)
+        const auto cachedLayout = EXRLayoutCache::Shared().Get(path);
+        if (!cachedLayout->Resolve(layer).IsRGB()) {
+            return IImageLoader::LoadFrameDraft(path, layer, pipeline_mode, level, cancel);  // AOV: RED/RG storage
+        }
+        const int levels = cachedLayout->ResolutionLevels();
+        if (levels > 1 && cachedLayout->FastPath()) {
+            return LoadMipLevel(path, layer, std::min(level, levels - 1), level, cancel);
+        }
 
-                if (y >= intersectedWindow.min.y && y <= intersectedWindow.max.y) {
-                    size_t size = (intersectedWindow.min.x - displayWindow.min.x) * cb;
-                    std::memset(p, 0, size);
-                    p += size;
+        // Multi-line chunks (ZIP, PIZ, DWAA/DWAB...) decode whole, so skipping
+        // lines saves nothing there: decode full resolution and box-filter
+        if (cachedLayout->tiled || Imf::getCompressionNumScanlines(cachedLayout->compression) != 1) {
+            return IImageLoader::LoadFrameDraft(path, layer, pipeline_mode, level, cancel);
+        }
 
-                    size = (intersectedWindow.max.x - intersectedWindow.min.x + 1) * cb;
-                    part.readPixels(y, y);
-                    std::memcpy(p, buf.data() + (std::max)(displayWindow.min.x - dataWindow.min.x, 0) * cb, size);
-                    p += size;
-                }
+        FileBytes bytes;
+        auto stream = OpenFrameStream(path, bytes, cancel);
+        Imf::MultiPartInputFile file(*stream);
+        const auto headerLayout = EXRLayoutCache::Shared().Get(path, file);
+        const EXRLayerMapping& mapping = headerLayout->Resolve(layer);
+        if (!mapping.valid) {
+            Debug::Log("EXRImageLoader::LoadFrameDraft: Missing RGB channels for layer '" + layer + "'");
+            return nullptr;
+        }
+
+        const Imath::Box2i displayWindow = headerLayout->display_window;
+        const Imath::Box2i dataWindow = headerLayout->data_window;
+        const int width = headerLayout->Width();
+        const int height = headerLayout->Height();
+        level = std::clamp(level, 0, 4);
+        const int factor = 1 << level;
+        const size_t cb = 4 * sizeof(Imath::half);
 
-                std::memset(p, 0, end - p);
+        auto result = std::make_shared<PixelData>();
+        result->width = (width + factor - 1) / factor;
+        result->height = (height + factor - 1) / factor;
+        result->gl_format = GL_RGBA;
+        result->gl_type = GL_HALF_FLOAT;
+        result->pipeline_mode = PipelineMode::HDR_RES;
+        result->draft_level = level;
+        result->full_width = width;
+        result->full_height = height;
+        result->pixels.resize(static_cast<size_t>(result->width) * result->height * cb);
+
+        // One line spanning display and data window, padded black (opaque
+        // without alpha); every sampled scanline decodes into it (yStride 0)
+        // and its display part is box-filtered across. Reads only overwrite
+        // the data columns, so the padding around them stays.
+        const int lineMinX = std::min(displayWindow.min.x, dataWindow.min.x);
+        const int lineMaxX = std::max(displayWindow.max.x, dataWindow.max.x);
+        const Imath::half zero(0.0f);
+        const Imath::half padAlpha(mapping.has_alpha ? 0.0f : 1.0f);
+        std::vector<Imath::half> line(static_cast<size_t>(lineMaxX - lineMinX + 1) * 4);
+        auto padLine = [&]() {
+            for (size_t i = 0; i < line.size(); i += 4) {
+                line[i] = line[i + 1] = line[i + 2] = zero;
+                line[i + 3] = padAlpha;
+            }
+        };
+        padLine();
+
+        Imf::FrameBuffer frameBuffer;
+        char* base = reinterpret_cast<char*>(line.data())
+                   - static_cast<ptrdiff_t>(lineMinX) * static_cast<ptrdiff_t>(cb);
+        const Imath::half* displayLine = line.data() + static_cast<size_t>(displayWindow.min.x - lineMinX) * 4;
+        for (int c = 0; c < 4; ++c) {
+            frameBuffer.insert(
+                mapping.names[c].c_str(),
+                Imf::Slice(Imf::HALF, base + c * sizeof(Imath::half), cb, 0, 1, 1, c == 3 ? 1.0 : 0.0));
+        }
+        Imf::InputPart part(file, 0);
+        part.setFrameBuffer(frameBuffer);
+
+        bool linePadded = true;
+
+        Imath::half* out = reinterpret_cast<Imath::half*>(result->pixels.data());
+        for (int oy = 0; oy < result->height; ++oy) {
+            if (cancel.IsCancelled()) {
+                return nullptr;
             }
 
-            if (!hasAlpha) {
-                for (int i = 0; i < width * height; ++i) {
-                    pixel_half[i * 4 + 3] = 1.0f;
+            // Vertical: nearest sampled line (draft quality)
+            const int y = displayWindow.min.y + oy * factor;
+            if (y >= dataWindow.min.y && y <= dataWindow.max.y) {
+                part.readPixels(y, y);
+                linePadded = false;
+            } else if (!linePadded) {
+                padLine();
+                linePadded = true;
+            }
+
+            // Horizontal: box filter over 'factor' pixels
+            for (int ox = 0; ox < result->width; ++ox) {
+                const int x0 = ox * factor;
+                const int x1 = std::min(width, x0 + factor);
+                float sum[4] = {};
+                for (int x = x0; x < x1; ++x) {
+                    const Imath::half* px = displayLine + static_cast<size_t>(x) * 4;
+                    for (int c = 0; c < 4; ++c) {
+                        sum[c] += static_cast<float>(px[c]);
+                    }
+                }
+                const float scale = 1.0f / static_cast<float>(x1 - x0);
+                for (int c = 0; c < 4; ++c) {
+                    *out++ = Imath::half(sum[c] * scale);
                 }
             }
         }
-
         return result;
 
     } catch (const std::exception& e) {
-        Debug::Log("EXRImageLoader::LoadFrame: Exception - " + std::string(e.what()));
+        Debug::Log("EXRImageLoader::LoadFrameDraft: Exception - " + std::string(e.what()));
         return nullptr;
     }
 }
 
+std::shared_ptr<PixelData> EXRImageLoader::LoadMipLevel(const std::string& path, const std::string& layer,
+                                                        int mipLevel, int level, const CancelToken& cancel) {
+    FileBytes bytes;
+    auto stream = OpenFrameStream(path, bytes, cancel);
+    Imf::MultiPartInputFile file(*stream);
+    const auto headerLayout = EXRLayoutCache::Shared().Get(path, file);
+    const EXRLayerMapping& mapping = headerLayout->Resolve(layer);
+    if (!mapping.valid) {
+        Debug::Log("EXRImageLoader::LoadMipLevel: Missing RGB channels for layer '" + layer + "'");
+        return nullptr;
+    }
+
+    // MIPMAP level l is (l, l); RIPMAP files read their square levels
+    Imf::TiledInputPart part(file, 0);
+    const Imath::Box2i levelWindow = part.dataWindowForLevel(mipLevel, mipLevel);
+    const size_t cb = 4 * sizeof(Imath::half);
+
+    auto result = std::make_shared<PixelData>();
+    result->width = levelWindow.max.x - levelWindow.min.x + 1;
+    result->height = levelWindow.max.y - levelWindow.min.y + 1;
+    result->gl_format = GL_RGBA;
+    result->gl_type = GL_HALF_FLOAT;
+    result->pipeline_mode = PipelineMode::HDR_RES;
+    result->draft_level = mipLevel;
+    result->full_width = headerLayout->Width();
+    result->full_height = headerLayout->Height();
+    const size_t stride = static_cast<size_t>(result->width) * cb;
+    result->pixels.resize(stride * result->height);
+
+    Imf::FrameBuffer frameBuffer;
+    char* base = reinterpret_cast<char*>(result->pixels.data())
+               - static_cast<ptrdiff_t>(levelWindow.min.x) * static_cast<ptrdiff_t>(cb)
+               - static_cast<ptrdiff_t>(levelWindow.min.y) * static_cast<ptrdiff_t>(stride);
+    for (int c = 0; c < 4; ++c) {
+        frameBuffer.insert(
+            mapping.names[c].c_str(),
+            Imf::Slice(Imf::HALF, base + c * sizeof(Imath::half), cb, stride, 1, 1, c == 3 ? 1.0 : 0.0));
+    }
+    part.setFrameBuffer(frameBuffer);
+
+    const int lastTileX = part.numXTiles(mipLevel) - 1;
+    for (int ty = 0; ty < part.numYTiles(mipLevel); ++ty) {
+        if (cancel.IsCancelled()) {
+            return nullptr;
+        }
+        part.readTiles(0, lastTileX, ty, ty, mipLevel, mipLevel);
+    }
+
+    // Asked for coarser than the smallest stored level
+    if (level > mipLevel) {
+        return DownsampleFrame(*result, level - mipLevel);
+    }
+    return result;
+}
+
+int EXRImageLoader::GetResolutionLevels(const std::string& path) {
+    try {
+        return EXRLayoutCache::Shared().Get(path)->ResolutionLevels();
+    } catch (const std::exception& e) {
+        Debug::Log("EXRImageLoader::GetResolutionLevels: Exception - " + std::string(e.what()));
+        return 1;
+    }
+}
+
+bool EXRImageLoader::LoadFrameLayers(
+    const std::string& path,
+    const std::vector<std::string>& layers,
+    PipelineMode pipeline_mode,
+    std::vector<std::shared_ptr<PixelData>>& out,
+    const CancelToken& cancel) {
+
+    std::vector<std::shared_ptr<PixelData>> planes;
+    auto provide = [&planes](size_t plane, const FrameLayout& layout, FrameDestination& dest) {
+        planes.push_back(std::make_shared<PixelData>());
+        planes[plane]->gl_format = layout.gl_format;
+        ApplyRegion(*planes[plane], layout);
+        return AllocateInto(planes[plane]->pixels)(layout, dest);
+    };
+
+    FrameLayout layout;
+    std::vector<int> planeOf;
+    if (!DecodeLayers(path, layers, provide, layout, planeOf, cancel, true)) {
+        return false;
+    }
+
+    for (auto& pixels : planes) {
+        pixels->width = layout.width;
+        pixels->height = layout.height;
+        pixels->gl_type = GL_HALF_FLOAT;
+        pixels->pipeline_mode = PipelineMode::HDR_RES;
+    }
+
+    out.assign(layers.size(), nullptr);
+    for (size_t i = 0; i < layers.size(); ++i) {
+        if (planeOf[i] >= 0) {
+            out[i] = planes[planeOf[i]];
+        }
+    }
+    return true;
+}
+
+std::vector<std::string> EXRImageLoader::GetLayers(const std::string& path) {
+    EXRLayerDetector detector;
+    std::vector<EXRLayer> detected;
+    std::vector<std::string> layers;
+    if (detector.DetectLayers(path, detected)) {
+        for (const auto& info : detected) {
+            if (info.has_rgba || info.channels.size() <= 2) {  // RGB layers and R/RG AOVs
+                layers.push_back(info.name);
+            }
+        }
+    }
+    return layers;
+}
+
 std::shared_ptr<PixelData> EXRImageLoader::LoadThumbnail(const std::string& path, int max_size) {
     // FAST EXR thumbnail loading with compression-aware strategy:
     // - DWAB (256-line blocks): Load full image and downsample (same decompression cost)
@@ -1251,6 +2120,7 @@ std::shared_ptr<PixelData> EXRImageLoader::LoadThumbnail(const std::string& path
         result->gl_type = GL_HALF_FLOAT;  // Keep as half-float for HDR thumbnails
         result->pipeline_mode = PipelineMode::HDR_RES;
         result->pixels.resize(thumb_width * thumb_height * 4 * sizeof(Imath::half));
+        std::memset(result->pixels.data(), 0, result->pixels.size());  // Pooled buffer - edges past the source stay black
 
         Imath::half* thumb_pixels = reinterpret_cast<Imath::half*>(result->pixels.data());
 
@@ -1380,6 +2250,9 @@ VideoImageLoader::VideoImageLoader(const std::string& video_path, double fps, do
     } else {
         Debug::Log("VideoImageLoader: Successfully initialized " + std::to_string(width_) + "x" +
                    std::to_string(height_) + ", " + std::to_string(GetFrameCount()) + " frames");
+
+        // Exact frame pts and keyframe seeks once the packet index is ready
+        ump::VideoIndexStore::Shared().Request(video_path_);
     }
 }
 
@@ -1476,6 +2349,40 @@ std::shared_ptr<PixelData> VideoImageLoader::LoadFrame(
     return ExtractFrame(frame_number, pipeline_mode, 0);
 }
 
+bool VideoImageLoader::QueryFrameLayout(
+    const std::string& /*path*/,
+    const std::string& /*layer*/,
+    PipelineMode /*pipeline_mode*/,
+    FrameLayout& layout) {
+    if (!initialized_) {
+        return false;
+    }
+    layout.width = width_;
+    layout.height = height_;
+    layout.gl_format = GL_RGBA;
+    layout.gl_type = GL_UNSIGNED_BYTE;
+    layout.pipeline_mode = PipelineMode::NORMAL;
+    return true;
+}
+
+bool VideoImageLoader::LoadFrameInto(
+    const std::string& path,
+    const std::string& /*layer*/,
+    PipelineMode /*pipeline_mode*/,
+    const FrameDestination& dest,
+    const CancelToken& cancel) {
+    int frame_number = 0;
+    try {
+        frame_number = std::stoi(path);
+    } catch (...) {
+        Debug::Log("VideoImageLoader::LoadFrameInto: Invalid frame number: " + path);
+        return false;
+    }
+
+    FrameLayout layout;
+    return ExtractFrameInto(frame_number, 0, UseDestination(dest), layout, cancel);
+}
+
 std::shared_ptr<PixelData> VideoImageLoader::LoadThumbnail(const std::string& path, int max_size) {
     // Parse frame number from path
     int frame_number = 0;
@@ -1494,13 +2401,41 @@ std::shared_ptr<PixelData> VideoImageLoader::LoadThumbnail(const std::string& pa
 }
 
 std::shared_ptr<PixelData> VideoImageLoader::ExtractFrame(int frame_number, PipelineMode pipeline_mode, int max_size) {
+    // Convert to pixel buffer
+    auto result = std::make_shared<PixelData>();
+
+    FrameLayout layout;
+    if (!ExtractFrameInto(frame_number, max_size, AllocateInto(result->pixels), layout, CancelToken{})) {
+        return nullptr;
+    }
+
+    result->width = layout.width;
+    result->height = layout.height;
+    result->gl_format = GL_RGBA;
+    result->gl_type = GL_UNSIGNED_BYTE;  // Thumbnails are always 8-bit for now
+    result->pipeline_mode = PipelineMode::NORMAL;
+
+    /*Debug::Log("VideoImageLoader::ExtractFrame: Successfully extracted frame " + std::to_string(frame_number) +
+               " -> " + std::to_string(result->width) + "x" + std::to_string(result->height) +
+               ", " + std::to_string(result->pixels.size()) + " bytes");*/
+
+    return result;
+}
+
+bool VideoImageLoader::ExtractFrameInto(int frame_number, int max_size, const FrameDestinationProvider& provide,
+                                        FrameLayout& layout, const CancelToken& cancel) {
     if (!initialized_) {
         Debug::Log("VideoImageLoader::ExtractFrame: Not initialized");
-        return nullptr;
+        return false;
     }
 
     std::lock_guard<std::mutex> lock(ffmpeg_mutex_);
 
+    // Cancelled while waiting for the decoder - skip the seek
+    if (cancel.IsCancelled()) {
+        return false;
+    }
+
     // Calculate timestamp
     double timestamp = frame_number / fps_;
 
@@ -1508,46 +2443,46 @@ std::shared_ptr<PixelData> VideoImageLoader::ExtractFrame(int frame_number, Pipe
     AVFrame* frame = av_frame_alloc();
     if (!frame) {
         Debug::Log("VideoImageLoader::ExtractFrame: Failed to allocate frame");
-        return nullptr;
+        return false;
     }
 
     // Seek and decode
-    bool success = SeekAndDecodeFrame(timestamp, frame);
+    bool success = SeekAndDecodeFrame(frame_number, timestamp, frame);
     if (!success) {
         Debug::Log("VideoImageLoader::ExtractFrame: Seek/decode failed for frame " + std::to_string(frame_number) +
                    " (timestamp=" + std::to_string(timestamp) + "s)");
         av_frame_free(&frame);
-        return nullptr;
+        return false;
     }
 
-    // Convert to pixel buffer
-    auto result = std::make_shared<PixelData>();
-    result->gl_format = GL_RGBA;
-    result->gl_type = GL_UNSIGNED_BYTE;  // Thumbnails are always 8-bit for now
-    result->pipeline_mode = PipelineMode::NORMAL;
-
-    if (!ConvertFrameToPixels(frame, result->pixels, result->width, result->height, pipeline_mode, max_size)) {
+    if (!ConvertFrameToPixels(frame, provide, layout, max_size)) {
         Debug::Log("VideoImageLoader::ExtractFrame: Failed to convert frame to pixels");
         av_frame_free(&frame);
-        return nullptr;
+        return false;
     }
 
-    /*Debug::Log("VideoImageLoader::ExtractFrame: Successfully extracted frame " + std::to_string(frame_number) +
-               " -> " + std::to_string(result->width) + "x" + std::to_string(result->height) +
-               ", " + std::to_string(result->pixels.size()) + " bytes");*/
-
     av_frame_free(&frame);
-    return result;
+    return true;
 }
 
-bool VideoImageLoader::SeekAndDecodeFrame(double timestamp, AVFrame* output_frame) {
+bool VideoImageLoader::SeekAndDecodeFrame(int frame_number, double timestamp, AVFrame* output_frame) {
     AVStream* stream = format_context_->streams[video_stream_index_];
 
     // Convert timestamp to stream timebase
     int64_t target_pts = av_rescale_q(timestamp * AV_TIME_BASE, AV_TIME_BASE_Q, stream->time_base);
+    int64_t seek_pts = target_pts;
+
+    // With the packet index: the frame's exact pts, and a seek straight to its keyframe
+    auto index = ump::VideoIndexStore::Shared().Get(video_path_);
+    if (index && frame_number < index->FrameCount()) {
+        target_pts = index->FramePts(frame_number);
+        seek_pts = index->SeekTimestamp(frame_number);
+    } else {
+        index.reset();
+    }
 
     // Seek to target timestamp
-    if (av_seek_frame(format_context_, video_stream_index_, target_pts, AVSEEK_FLAG_BACKWARD) < 0) {
+    if (av_seek_frame(format_context_, video_stream_index_, seek_pts, AVSEEK_FLAG_BACKWARD) < 0) {
         Debug::Log("VideoImageLoader: Seek failed for timestamp " + std::to_string(timestamp));
         return false;
     }
@@ -1560,13 +2495,27 @@ bool VideoImageLoader::SeekAndDecodeFrame(double timestamp, AVFrame* output_fram
     }
 
     bool found_frame = false;
+    bool passed_target = false;
 
     // Read packets until we find our target frame
     while (av_read_frame(format_context_, packet) >= 0) {
         if (packet->stream_index == video_stream_index_) {
             if (avcodec_send_packet(codec_context_, packet) >= 0) {
                 while (avcodec_receive_frame(codec_context_, output_frame) >= 0) {
-                    // Check if this is close to our target timestamp
+                    // Check if this is our target frame (exact pts when indexed)
+                    if (index) {
+                        if (output_frame->best_effort_timestamp == target_pts) {
+                            found_frame = true;
+                            break;
+                        }
+                        if (output_frame->best_effort_timestamp > target_pts) {
+                            av_frame_unref(output_frame);
+                            passed_target = true;  // No frame with this pts
+                            break;
+                        }
+                        av_frame_unref(output_frame);
+                        continue;
+                    }
                     double frame_timestamp = output_frame->pts * av_q2d(stream->time_base);
                     if (std::abs(frame_timestamp - timestamp) < (1.0 / fps_)) {
                         found_frame = true;
@@ -1575,7 +2524,7 @@ bool VideoImageLoader::SeekAndDecodeFrame(double timestamp, AVFrame* output_fram
                     av_frame_unref(output_frame);
                 }
             }
-            if (found_frame) break;
+            if (found_frame || passed_target) break;
         }
         av_packet_unref(packet);
     }
@@ -1584,13 +2533,15 @@ bool VideoImageLoader::SeekAndDecodeFrame(double timestamp, AVFrame* output_fram
     return found_frame;
 }
 
-bool VideoImageLoader::ConvertFrameToPixels(AVFrame* frame, std::vector<uint8_t>& pixels,
-                                            int& width, int& height, PipelineMode pipeline_mode, int max_size) {
+bool VideoImageLoader::ConvertFrameToPixels(AVFrame* frame, const FrameDestinationProvider& provide,
+                                            FrameLayout& layout, int max_size) {
     if (!frame || frame->width <= 0 || frame->height <= 0) {
         return false;
     }
 
     // Calculate output dimensions
+    int width = frame->width;
+    int height = frame->height;
     if (max_size > 0) {
         // Scale to fit within max_size
         int max_dim = (std::max)(frame->width, frame->height);
@@ -1598,27 +2549,19 @@ bool VideoImageLoader::ConvertFrameToPixels(AVFrame* frame, std::vector<uint8_t>
             float scale = static_cast<float>(max_size) / max_dim;
             width = static_cast<int>(frame->width * scale);
             height = static_cast<int>(frame->height * scale);
-        } else {
-            width = frame->width;
-            height = frame->height;
         }
-    } else {
-        width = frame->width;
-        height = frame->height;
     }
 
-    // Target format (RGBA8 for thumbnails)
+    // Target format (RGBA8)
     AVPixelFormat target_format = AV_PIX_FMT_RGBA;
-    size_t bytes_per_pixel = 4;
-
-    // Allocate target frame
-    AVFrame* target_frame = av_frame_alloc();
-    target_frame->format = target_format;
-    target_frame->width = width;
-    target_frame->height = height;
-
-    if (av_frame_get_buffer(target_frame, 32) < 0) {
-        av_frame_free(&target_frame);
+    layout.width = width;
+    layout.height = height;
+    layout.gl_format = GL_RGBA;
+    layout.gl_type = GL_UNSIGNED_BYTE;
+    layout.pipeline_mode = PipelineMode::NORMAL;
+
+    FrameDestination dest;
+    if (!provide(layout, dest)) {
         return false;
     }
 
@@ -1630,21 +2573,16 @@ bool VideoImageLoader::ConvertFrameToPixels(AVFrame* frame, std::vector<uint8_t>
         nullptr, nullptr, nullptr);
 
     if (!sws_ctx) {
-        av_frame_free(&target_frame);
         return false;
     }
 
-    // Convert
+    // Convert straight into the destination rows (no intermediate AVFrame + copy)
+    uint8_t* dst_data[4] = { dest.data, nullptr, nullptr, nullptr };
+    int dst_linesize[4] = { static_cast<int>(dest.Stride(layout)), 0, 0, 0 };
     sws_scale(sws_ctx, frame->data, frame->linesize, 0, frame->height,
-              target_frame->data, target_frame->linesize);
-
-    // Copy to output buffer
-    size_t data_size = width * height * bytes_per_pixel;
-    pixels.resize(data_size);
-    std::memcpy(pixels.data(), target_frame->data[0], data_size);
+              dst_data, dst_linesize);
 
     sws_freeContext(sws_ctx);
-    av_frame_free(&target_frame);
 
     return true;
 }
@@ -4,6 +4,7 @@
 #include <vector>
 #include <cstdint>
 #include <mutex>
+#include <functional>
 #include "pipeline_mode.h"
 #include "image_loader_interface.h"
 
@@ -35,24 +36,46 @@ struct ImageInfo {
 ImageFormat DetectImageFormat(const std::string& path);
 bool GetImageInfo(const std::string& path, ImageInfo& info);
 
+// Called by LoadInto() once the header is parsed: fill 'dest' for 'layout'
+// (false = abort without decoding)
+using FrameDestinationProvider = std::function<bool(const FrameLayout& layout, FrameDestination& dest)>;
+
+// Provider that sizes 'buffer' for the frame (what Load() uses)
+FrameDestinationProvider AllocateInto(PixelBuffer& buffer);
+
+// Provider that hands out a fixed caller destination (what LoadFrameInto() uses)
+FrameDestinationProvider UseDestination(const FrameDestination& dest);
+
 // TIFF Loader (using libtiff)
 namespace TIFFLoader {
-    bool Load(const std::string& path, std::vector<uint8_t>& pixel_data,
-              int& width, int& height, PipelineMode& mode);
+    bool Load(const std::string& path, PixelBuffer& pixel_data,
+              int& width, int& height, PipelineMode& mode,
+              const CancelToken& cancel = CancelToken{});
+    bool LoadInto(const std::string& path, const FrameDestinationProvider& provide,
+                  FrameLayout& layout, const CancelToken& cancel = CancelToken{});
+    bool GetLayout(const std::string& path, FrameLayout& layout);
     bool GetInfo(const std::string& path, ImageInfo& info);
 }
 
 // PNG Loader (using libpng)
 namespace PNGLoader {
-    bool Load(const std::string& path, std::vector<uint8_t>& pixel_data,
-              int& width, int& height, PipelineMode& mode);
+    bool Load(const std::string& path, PixelBuffer& pixel_data,
+              int& width, int& height, PipelineMode& mode,
+              const CancelToken& cancel = CancelToken{});
+    bool LoadInto(const std::string& path, const FrameDestinationProvider& provide,
+                  FrameLayout& layout, const CancelToken& cancel = CancelToken{});
+    bool GetLayout(const std::string& path, FrameLayout& layout);
     bool GetInfo(const std::string& path, ImageInfo& info);
 }
 
 // JPEG Loader (using libjpeg-turbo)
 namespace JPEGLoader {
-    bool Load(const std::string& path, std::vector<uint8_t>& pixel_data,
-              int& width, int& height, PipelineMode& mode);
+    bool Load(const std::string& path, PixelBuffer& pixel_data,
+              int& width, int& height, PipelineMode& mode,
+              const CancelToken& cancel = CancelToken{});
+    bool LoadInto(const std::string& path, const FrameDestinationProvider& provide,
+                  FrameLayout& layout, const CancelToken& cancel = CancelToken{});
+    bool GetLayout(const std::string& path, FrameLayout& layout);
     bool GetInfo(const std::string& path, ImageInfo& info);
 }
 
@@ -74,16 +97,91 @@ public:
         PipelineMode pipeline_mode
     ) override;
 
+    // Polls 'cancel' between compression chunks (scanlines on the slow path).
+    // Stores only the data window (PixelData::HasRegion()) when it is smaller,
+    // and only the layer's channels: RGB without alpha, RED/RG for AOVs.
+    std::shared_ptr<PixelData> LoadFrame(
+        const std::string& path,
+        const std::string& layer,
+        PipelineMode pipeline_mode,
+        const CancelToken& cancel
+    ) override;
+
+    bool QueryFrameLayout(
+        const std::string& path,
+        const std::string& layer,
+        PipelineMode pipeline_mode,
+        FrameLayout& layout
+    ) override;
+
+    // Decodes straight into dest via OpenEXR slices (GL_HALF_FLOAT or GL_FLOAT)
+    bool LoadFrameInto(
+        const std::string& path,
+        const std::string& layer,
+        PipelineMode pipeline_mode,
+        const FrameDestination& dest,
+        const CancelToken& cancel = CancelToken{}
+    ) override;
+
     // EXR thumbnail loading - optimized scanline-based loading, keeps HDR data
     std::shared_ptr<PixelData> LoadThumbnail(
         const std::string& path,
         int max_size = 320
     ) override;
 
+    // Mipmapped tiled files read the stored level; scanline-per-chunk files
+    // (NONE/RLE/ZIPS) read only every 2^level-th line; others decode full
+    // resolution and box-filter
+    std::shared_ptr<PixelData> LoadFrameDraft(
+        const std::string& path,
+        const std::string& layer,
+        PipelineMode pipeline_mode,
+        int level,
+        const CancelToken& cancel = CancelToken{}
+    ) override;
+
+    // One decode for every requested layer (a chunk holds all of the file's channels)
+    bool LoadFrameLayers(
+        const std::string& path,
+        const std::vector<std::string>& layers,
+        PipelineMode pipeline_mode,
+        std::vector<std::shared_ptr<PixelData>>& out,
+        const CancelToken& cancel = CancelToken{}
+    ) override;
+
+    // Layers with RGB channels and one/two channel AOVs (EXRLayerDetector)
+    std::vector<std::string> GetLayers(const std::string& path) override;
+
+    // Mip levels of tiled files (sequence header layout)
+    int GetResolutionLevels(const std::string& path) override;
+
     bool GetDimensions(const std::string& path, int& width, int& height) override;
     std::string GetLoaderName() const override { return "EXR"; }
 
 private:
+    // Destination for plane 'plane' of a multi-layer decode
+    using PlaneProvider = std::function<bool(size_t plane, const FrameLayout& layout, FrameDestination& dest)>;
+
+    // LoadFrameDraft() of a mipmapped file: whole mip level 'mipLevel' (tile
+    // rows, cancel polled between them), box-filtered down to 'level' if coarser
+    std::shared_ptr<PixelData> LoadMipLevel(const std::string& path, const std::string& layer,
+                                            int mipLevel, int level, const CancelToken& cancel);
+
+    // Shared by LoadFrame() and LoadFrameInto()
+    bool DecodeInto(const std::string& path, const std::string& layer,
+                    const FrameDestinationProvider& provide, FrameLayout& layout,
+                    const CancelToken& cancel, bool compact = false);
+
+    // Decodes 'layers' in one read. Layers resolving to the same channels
+    // share a plane; planeOf[i] is the plane of layers[i] (-1 = missing).
+    // compact: cache storage - just the data window's part of the display
+    // window (layout.HasRegion()) instead of padding it to the display
+    // window, and only the channels each layer has (plane layout gl_format)
+    bool DecodeLayers(const std::string& path, const std::vector<std::string>& layers,
+                      const PlaneProvider& provide, FrameLayout& layout,
+                      std::vector<int>& planeOf, const CancelToken& cancel,
+                      bool compact = false);
+
     std::string layer_name_;  // Layer name for multi-layer EXR (empty = default layer)
 };
 
@@ -96,6 +194,30 @@ public:
         PipelineMode pipeline_mode
     ) override;
 
+    // Polls 'cancel' between scanlines
+    std::shared_ptr<PixelData> LoadFrame(
+        const std::string& path,
+        const std::string& layer,
+        PipelineMode pipeline_mode,
+        const CancelToken& cancel
+    ) override;
+
+    bool QueryFrameLayout(
+        const std::string& path,
+        const std::string& layer,
+        PipelineMode pipeline_mode,
+        FrameLayout& layout
+    ) override;
+
+    // Decodes scanlines / RGBA bands straight into dest
+    bool LoadFrameInto(
+        const std::string& path,
+        const std::string& layer,
+        PipelineMode pipeline_mode,
+        const FrameDestination& dest,
+        const CancelToken& cancel = CancelToken{}
+    ) override;
+
     // Fast thumbnail loading - reads every Nth scanline for speed
     std::shared_ptr<PixelData> LoadThumbnail(
         const std::string& path,
@@ -115,6 +237,30 @@ public:
         PipelineMode pipeline_mode
     ) override;
 
+    // Polls 'cancel' between rows
+    std::shared_ptr<PixelData> LoadFrame(
+        const std::string& path,
+        const std::string& layer,
+        PipelineMode pipeline_mode,
+        const CancelToken& cancel
+    ) override;
+
+    bool QueryFrameLayout(
+        const std::string& path,
+        const std::string& layer,
+        PipelineMode pipeline_mode,
+        FrameLayout& layout
+    ) override;
+
+    // Decodes rows straight into dest
+    bool LoadFrameInto(
+        const std::string& path,
+        const std::string& layer,
+        PipelineMode pipeline_mode,
+        const FrameDestination& dest,
+        const CancelToken& cancel = CancelToken{}
+    ) override;
+
     // Fast thumbnail loading - minimal transformations
     std::shared_ptr<PixelData> LoadThumbnail(
         const std::string& path,
@@ -134,6 +280,30 @@ public:
         PipelineMode pipeline_mode
     ) override;
 
+    // Polls 'cancel' between scanlines
+    std::shared_ptr<PixelData> LoadFrame(
+        const std::string& path,
+        const std::string& layer,
+        PipelineMode pipeline_mode,
+        const CancelToken& cancel
+    ) override;
+
+    bool QueryFrameLayout(
+        const std::string& path,
+        const std::string& layer,
+        PipelineMode pipeline_mode,
+        FrameLayout& layout
+    ) override;
+
+    // Decodes scanlines straight into dest (RGBA via libjpeg-turbo)
+    bool LoadFrameInto(
+        const std::string& path,
+        const std::string& layer,
+        PipelineMode pipeline_mode,
+        const FrameDestination& dest,
+        const CancelToken& cancel = CancelToken{}
+    ) override;
+
     // Optimized thumbnail loading using libjpeg DCT scaling (1/2, 1/4, 1/8)
     std::shared_ptr<PixelData> LoadThumbnail(
         const std::string& path,
@@ -168,6 +338,23 @@ public:
         int max_size = 320
     ) override;
 
+    // RGBA8 at the stream's coded size
+    bool QueryFrameLayout(
+        const std::string& path,
+        const std::string& layer,
+        PipelineMode pipeline_mode,
+        FrameLayout& layout
+    ) override;
+
+    // sws_scale writes straight into dest
+    bool LoadFrameInto(
+        const std::string& path,
+        const std::string& layer,
+        PipelineMode pipeline_mode,
+        const FrameDestination& dest,
+        const CancelToken& cancel = CancelToken{}
+    ) override;
+
     bool GetDimensions(const std::string& path, int& width, int& height) override;
     std::string GetLoaderName() const override { return "Video"; }
 
@@ -179,6 +366,8 @@ public:
 private:
     // Internal frame extraction with optional scaling
     std::shared_ptr<PixelData> ExtractFrame(int frame_number, PipelineMode pipeline_mode, int max_size = 0);
+    bool ExtractFrameInto(int frame_number, int max_size, const FrameDestinationProvider& provide,
+                          FrameLayout& layout, const CancelToken& cancel);
 
     // Initialize FFmpeg context (called in constructor)
     bool InitializeFFmpeg();
@@ -186,12 +375,12 @@ private:
     // Clean up FFmpeg resources
     void CleanupFFmpeg();
 
-    // Seek to and decode specific frame
-    bool SeekAndDecodeFrame(double timestamp, ::AVFrame* output_frame);
+    // Seek to and decode specific frame (exact pts and keyframe from the packet index once built)
+    bool SeekAndDecodeFrame(int frame_number, double timestamp, ::AVFrame* output_frame);
 
-    // Convert AVFrame to pixel buffer
-    bool ConvertFrameToPixels(::AVFrame* frame, std::vector<uint8_t>& pixels,
-                              int& width, int& height, PipelineMode pipeline_mode, int max_size);
+    // Convert AVFrame to RGBA8 at the provided destination
+    bool ConvertFrameToPixels(::AVFrame* frame, const FrameDestinationProvider& provide,
+                              FrameLayout& layout, int max_size);
 
     // Video metadata
     std::string video_path_;
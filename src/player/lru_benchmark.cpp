@@ -0,0 +1,149 @@
+#include "lru_benchmark.h"
+#include "sharded_lru.h"
+#include "image_loader_interface.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace ump {
+
+namespace {
+    // The pixel cache before ShardedLRU: one mutex, O(n) touch
+    template<typename K, typename V>
+    class ListLRU {
+    public:
+        explicit ListLRU(size_t maxBytes) : maxBytes_(maxBytes) {}
+
+        bool Contains(const K& key) const {
+            std::lock_guard<std::mutex> lock(mutex_);
+            return cache_.find(key) != cache_.end();
+        }
+
+        bool Get(const K& key, V& value) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            auto it = cache_.find(key);
+            if (it == cache_.end()) return false;
+            value = it->second;
+            Touch(key);
+            return true;
+        }
+
+        void Add(const K& key, const V& value, size_t bytes) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            auto it = cache_.find(key);
+            if (it != cache_.end()) {
+                currentBytes_ -= sizes_[key];
+                cache_.erase(it);
+                sizes_.erase(key);
+            }
+            cache_[key] = value;
+            sizes_[key] = bytes;
+            currentBytes_ += bytes;
+            Touch(key);
+
+            while (currentBytes_ > maxBytes_ && !lruList_.empty()) {
+                K oldest = lruList_.front();
+                lruList_.pop_front();
+                currentBytes_ -= sizes_[oldest];
+                cache_.erase(oldest);
+                sizes_.erase(oldest);
+            }
+        }
+
+    private:
+        void Touch(const K& key) {
+            lruList_.remove(key);
+            lruList_.push_back(key);
+        }
+
+        mutable std::mutex mutex_;
+        std::map<K, V> cache_;
+        std::map<K, size_t> sizes_;
+        std::list<K> lruList_;
+        size_t maxBytes_ = 0;
+        size_t currentBytes_ = 0;
+    };
+
+    // Deterministic per thread, so both caches see the same operations
+    struct XorShift {
+        uint64_t state;
+        uint32_t Next() {
+            state ^= state << 13;
+            state ^= state >> 7;
+            state ^= state << 17;
+            return static_cast<uint32_t>(state);
+        }
+    };
+
+    template<typename Cache>
+    double TimeWorkload(Cache& cache, int entries, int threads, int operationsPerThread) {
+        auto pixels = std::make_shared<PixelData>();
+        for (int frame = 0; frame < entries; ++frame) {
+            cache.Add(frame, pixels, 1);
+        }
+
+        std::atomic<bool> go{false};
+        std::vector<std::thread> workers;
+        workers.reserve(threads);
+        for (int t = 0; t < threads; ++t) {
+            workers.emplace_back([&, t]() {
+                XorShift rng{0x9E3779B97F4A7C15ull * (t + 1)};
+                std::shared_ptr<PixelData> value;
+                while (!go.load(std::memory_order_acquire)) {
+                    std::this_thread::yield();
+                }
+                for (int i = 0; i < operationsPerThread; ++i) {
+                    // Frames around a playhead advancing through the sequence
+                    const int playhead = i / 8;
+                    const int frame = (std::max)(0, playhead + static_cast<int>(rng.Next() % entries) - entries / 2);
+                    const uint32_t op = rng.Next() % 100;
+                    if (op < 60) {
+                        (void)cache.Contains(frame);
+                    } else if (op < 85) {
+                        cache.Get(frame, value);
+                    } else {
+                        cache.Add(frame + entries / 2, pixels, 1);
+                    }
+                }
+            });
+        }
+
+        const auto start = std::chrono::steady_clock::now();
+        go.store(true, std::memory_order_release);
+        for (auto& worker : workers) {
+            worker.join();
+        }
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+}
+
+LRUBenchmarkResult RunLRUBenchmark(int entries, int threads, int operationsPerThread) {
+    LRUBenchmarkResult result;
+    result.entries = (std::max)(entries, 1);
+    result.threads = (std::max)(threads, 1);
+    operationsPerThread = (std::max)(operationsPerThread, 1);
+    result.operations = static_cast<uint64_t>(result.threads) * operationsPerThread;
+
+    // Budget = frame count: every insert past it evicts one frame
+    {
+        ListLRU<int, std::shared_ptr<PixelData>> cache(result.entries);
+        result.listMs = TimeWorkload(cache, result.entries, result.threads, operationsPerThread);
+    }
+    {
+        ShardedLRU<int, std::shared_ptr<PixelData>> cache;
+        cache.SetMaxSize(result.entries);
+        result.shardedMs = TimeWorkload(cache, result.entries, result.threads, operationsPerThread);
+    }
+
+    result.ok = true;
+    return result;
+}
+
+} // namespace ump
@@ -0,0 +1,29 @@
+#pragma once
+
+#include <cstdint>
+
+namespace ump {
+
+//=============================================================================
+// LRU microbenchmark - the pixel cache's access mix, timed on ShardedLRU and
+// on the single-mutex LRU it replaced (std::map index, std::list recency,
+// list::remove on every touch)
+//
+// Each thread plays one of the cache's users around a moving playhead:
+// presence checks (segments, fill scans), touching lookups (upload, playback)
+// and inserts that evict at the byte budget (completed loads). Both caches
+// start full with 'entries' frames and run the same sequence of operations.
+//=============================================================================
+
+struct LRUBenchmarkResult {
+    bool ok = false;
+    int threads = 0;
+    int entries = 0;                // Frames resident (also the budget)
+    uint64_t operations = 0;        // Per cache, all threads
+    double listMs = 0.0;            // Wall time, single-mutex map + list LRU
+    double shardedMs = 0.0;         // Wall time, ShardedLRU
+};
+
+LRUBenchmarkResult RunLRUBenchmark(int entries, int threads, int operationsPerThread);
+
+} // namespace ump
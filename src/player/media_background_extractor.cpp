@@ -13,10 +13,12 @@
 #include "video_player.h"  // For PIPELINE_CONFIGS
 #include "../metadata/video_metadata.h"
 #include "../utils/debug_utils.h"
+#include "../utils/task_scheduler.h"
 #include <algorithm>
 #include <cmath>
 #include <mutex>
 #include <cstdlib>
+#include <cstring>
 
 // Windows-specific includes for hardware decode (BEFORE extern "C")
 #ifdef _WIN32
@@ -30,9 +32,29 @@ extern "C" {
 #include <libavformat/avformat.h>
 #include <libavutil/imgutils.h>
 #include <libavutil/hwcontext.h>
+#include <libavutil/pixdesc.h>
 #include <libswscale/swscale.h>
 }
 
+namespace {
+    constexpr size_t kMaxRunFrames = 256;       // Frames delivered by one run (very long GOPs split)
+    constexpr int kUnknownGopSpan = 32;         // Run length when the next keyframe isn't known yet
+    constexpr double kOvershootBackoff = 1.0;   // Seconds to back off when a seek lands past the run
+    constexpr int kMaxIntraScanPackets = 64;    // Packets read after an intra-only seek before giving up
+    constexpr int kReversePriority = 2000;      // Above the forward window (1000 at the playhead)
+    constexpr int kTrickPlayPriority = 3000;    // Above the reverse window
+
+    ExtractionResult FailedResult(const FrameExtractionRequest& request, const std::string& error) {
+        ExtractionResult result;
+        result.frame_number = request.frame_number;
+        result.timestamp = request.timestamp;
+        result.numbering = request.numbering;
+        result.completed_at = std::chrono::steady_clock::now();
+        result.error_message = error;
+        return result;
+    }
+}
+
 MediaBackgroundExtractor::MediaBackgroundExtractor(FrameCache* parent_cache, const ExtractorConfig& cfg)
     : config(cfg), parent_cache(parent_cache) {
     Debug::Log("MediaBackgroundExtractor: Initializing with " + std::to_string(config.max_batch_size) + " batch size");
@@ -58,6 +80,11 @@ bool MediaBackgroundExtractor::Initialize(const std::string& video_path, const V
     }
 
     this->video_path = video_path;
+    {
+        std::lock_guard<std::mutex> lock(index_mutex);
+        packet_index.reset();
+    }
+    ump::VideoIndexStore::Shared().Request(video_path);
 
     // Note: Sequential caching state removed
 
@@ -97,6 +124,17 @@ bool MediaBackgroundExtractor::Initialize(const std::string& video_path, const V
     video_width = video_stream->codecpar->width;
     video_height = video_stream->codecpar->height;
 
+    SeedKeyframeIndex();
+
+    // Intra-only codecs: every frame decodes on its own, on any worker
+    const AVCodecDescriptor* descriptor = avcodec_descriptor_get(video_stream->codecpar->codec_id);
+    intra_only = descriptor && (descriptor->props & AV_CODEC_PROP_INTRA_ONLY);
+    addressable_packets = std::strstr(format_context->iformat->name, "mov") != nullptr;
+    if (intra_only.load()) {
+        Debug::Log("MediaBackgroundExtractor: Intra-only codec (" + std::string(descriptor->name) +
+                   ") - frames decode independently in parallel");
+    }
+
     // Validate duration and calculate max frames
     double dur = duration.load();
     double fps = frame_rate.load();
@@ -228,18 +266,12 @@ void MediaBackgroundExtractor::StartBackgroundExtraction() {
         return;
     }
 
-    Debug::Log("MediaBackgroundExtractor: Starting background extraction with " +
-               std::to_string(config.max_concurrent_batches) + " worker threads");
+    Debug::Log("MediaBackgroundExtractor: Starting background extraction with up to " +
+               std::to_string(config.max_concurrent_batches) + " concurrent batch tasks");
 
     shutdown_requested = false;
     SetState(ExtractorState::EXTRACTING);
 
-    // Start worker threads with thread-safe contexts
-    worker_threads.clear();
-    for (int i = 0; i < config.max_concurrent_batches; ++i) {
-        worker_threads.emplace_back(&MediaBackgroundExtractor::WorkerThread, this);
-    }
-
     // Start with window-based caching around current position
     double initial_timestamp = current_playhead_position.load();
     RequestWindowAroundPlayhead(initial_timestamp);
@@ -255,17 +287,12 @@ void MediaBackgroundExtractor::StopBackgroundExtraction() {
     shutdown_requested = true;
     SetState(ExtractorState::STOPPED);
 
-    // Wake up all worker threads
-    queue_cv.notify_all();
-    worker_cv.notify_all();
-
-    // Wait for threads to finish
-    for (auto& thread : worker_threads) {
-        if (thread.joinable()) {
-            thread.join();
-        }
+    // Wait for in-flight batch tasks (they finish their current frame and exit)
+    {
+        std::unique_lock<std::mutex> lock(queue_mutex);
+        queue_cv.wait(lock, [this] { return active_batch_tasks == 0; });
+        idle_worker_contexts.clear();  // Release per-task FFmpeg contexts
     }
-    worker_threads.clear();
 
     // Clear pending work
     ClearPendingRequests();
@@ -273,94 +300,209 @@ void MediaBackgroundExtractor::StopBackgroundExtraction() {
     //Debug::Log("MediaBackgroundExtractor: Background extraction stopped");
 }
 
-void MediaBackgroundExtractor::WorkerThread() {
-    //Debug::Log("MediaBackgroundExtractor: Worker thread started");
-
-    // Wait for initialization to complete
-    while (!initialized.load() && !shutdown_requested.load()) {
-        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+void MediaBackgroundExtractor::ScheduleBatchTasksLocked() {
+    if (shutdown_requested.load() || !initialized.load() || !ShouldExtract()) {
+        return;
     }
 
-    if (shutdown_requested.load()) {
-        //Debug::Log("MediaBackgroundExtractor: Worker thread shutting down before initialization");
-        return;
+    // One task per run, up to max_concurrent_batches in flight (tasks finding
+    // only GOPs already being decoded exit straight away); intra-only batches
+    // are independent, so they spread over every worker
+    size_t queued = request_queue.size();
+    const int max_tasks = static_cast<int>(MaxBatchTasks());
+    while (active_batch_tasks < max_tasks && queued > 0) {
+        active_batch_tasks++;
+        queued -= (std::min)(queued, static_cast<size_t>(config.max_batch_size));
+        ump::TaskScheduler::Shared().Post(ump::TaskPriority::Prefetch, [this]() { RunBatchTask(); });
     }
+}
 
-    // Create thread-local FFmpeg context for video files
-    WorkerContext worker_ctx;
-    if (!worker_ctx.Initialize(video_path, config.hw_config)) {
-        Debug::Log("MediaBackgroundExtractor: Failed to initialize worker context");
-        return;
+void MediaBackgroundExtractor::RunBatchTask() {
+    // Check out a decoder context (thread-safe FFmpeg context, reused across tasks)
+    std::unique_ptr<WorkerContext> worker_ctx;
+    {
+        std::lock_guard<std::mutex> lock(queue_mutex);
+        if (!idle_worker_contexts.empty()) {
+            worker_ctx = std::move(idle_worker_contexts.back());
+            idle_worker_contexts.pop_back();
+        }
     }
 
-    AVFrame* frame = av_frame_alloc();
-    if (!frame) {
-        Debug::Log("MediaBackgroundExtractor: Failed to allocate AVFrame");
-        return;
+    bool ok = !shutdown_requested.load() && ShouldExtract();
+    if (ok && !worker_ctx) {
+        worker_ctx = std::make_unique<WorkerContext>();
+        if (!worker_ctx->Initialize(video_path, config.hw_config)) {
+            Debug::Log("MediaBackgroundExtractor: Failed to initialize worker context");
+            worker_ctx.reset();
+            ok = false;
+        }
     }
 
-    while (!shutdown_requested.load()) {
-        // Event-driven state check - no polling
-        if (!ShouldExtract()) {
-            std::unique_lock<std::mutex> lock(queue_mutex);
-            worker_cv.wait(lock);  // Pure event-driven - wait until state changes
-            continue;
+    // Next GOP run (empty when the queue is drained or every queued GOP is being decoded)
+    ExtractionBatch batch;
+    if (ok) {
+        batch = BuildNextBatch();
+        if (!batch.frames.empty() && IsIntraOnlyStream()) {
+            ProcessIntraBatch(batch, *worker_ctx);
+        } else if (!batch.frames.empty()) {
+            ProcessBatch(batch, *worker_ctx);  // Queues results as frames are decoded
         }
+    }
 
-        // Get next batch of work
-        ExtractionBatch batch = BuildNextBatch();
-        if (batch.frames.empty()) {
-            // No more work available - window-based caching is demand-driven
-            // Worker will wait for new requests from window updates
+    std::lock_guard<std::mutex> lock(queue_mutex);
+    if (worker_ctx) {
+        idle_worker_contexts.push_back(std::move(worker_ctx));
+    }
+    if (batch.gop_start_frame >= 0) {
+        active_gops.erase(batch.gop_start_frame);
+    }
+    active_batch_tasks--;
 
-            std::unique_lock<std::mutex> lock(queue_mutex);
-            queue_cv.wait(lock);  // Pure event-driven - wait until work is available
-            continue;
+    // Continue while work remains (re-posting lets playback tasks run in between);
+    // requests waiting on a busy GOP are picked up when its run finishes here
+    if (ok && !batch.frames.empty()) {
+        ScheduleBatchTasksLocked();
+    }
+    if (active_batch_tasks == 0) {
+        queue_cv.notify_all();
+    }
+}
+
+// ============================================================================
+// GOP Run Planning
+// ============================================================================
+
+std::shared_ptr<const ump::VideoPacketIndex> MediaBackgroundExtractor::GetPacketIndex() const {
+    std::lock_guard<std::mutex> lock(index_mutex);
+    if (!packet_index && !video_path.empty()) {
+        packet_index = ump::VideoIndexStore::Shared().Get(video_path);
+        if (packet_index) {
+            index_numbering.fetch_add(1);
+            packet_index_arrived = true;
         }
+    }
+    return packet_index;
+}
 
-        // Process the batch with worker context
-        std::vector<ExtractionResult> results = ProcessBatch(batch, worker_ctx);
+int MediaBackgroundExtractor::FrameAtTimestamp(double timestamp) const {
+    if (auto index = GetPacketIndex()) {
+        return index->FrameAtTime(timestamp);
+    }
+    return static_cast<int>(std::llround(timestamp * frame_rate.load()));
+}
 
-        // Note: Memory enforcement now handled by global checks in main loop
+double MediaBackgroundExtractor::FrameTimestamp(int frame_number) const {
+    if (auto index = GetPacketIndex()) {
+        return index->FrameTime(frame_number);
+    }
+    return frame_number / frame_rate.load();
+}
 
-        // Queue results for main thread processing
-        {
-            std::lock_guard<std::mutex> lock(results_mutex);
-            for (const auto& result : results) {
-                completed_results.push(result);
-                UpdateStats(result);
-            }
+void MediaBackgroundExtractor::SeedKeyframeIndex() {
+    // Containers with a seek index (MP4/MOV sample tables, MKV cues) list their
+    // keyframes up front; keyframes seen while decoding are added as runs go
+    AVStream* stream = format_context->streams[video_stream_index];
+    const double time_base = av_q2d(stream->time_base);
+
+    std::set<int> keyframes;
+    const int count = avformat_index_get_entries_count(stream);
+    for (int i = 0; i < count; ++i) {
+        const AVIndexEntry* entry = avformat_index_get_entry(stream, i);
+        if (entry && (entry->flags & AVINDEX_KEYFRAME)) {
+            keyframes.insert(static_cast<int>(std::llround(entry->timestamp * time_base * frame_rate.load())));
         }
     }
 
-    if (frame) {
-        av_frame_free(&frame);
+    Debug::Log("MediaBackgroundExtractor: " + std::to_string(keyframes.size()) +
+               " keyframes from container index");
+
+    std::lock_guard<std::mutex> lock(queue_mutex);
+    keyframe_frames = std::move(keyframes);
+    active_gops.clear();
+}
+
+void MediaBackgroundExtractor::FindGopLocked(int frame_number, int& gop_start, int& gop_end) const {
+    if (auto index = GetPacketIndex()) {
+        gop_start = index->GopStart(frame_number);
+        gop_end = index->GopEnd(frame_number);
+        if (gop_end < 0) {
+            gop_end = index->FrameCount();
+        }
+        return;
     }
-    //Debug::Log("MediaBackgroundExtractor: Worker thread finished");
+
+    auto next = keyframe_frames.upper_bound(frame_number);
+    gop_end = next != keyframe_frames.end() ? *next : -1;
+    gop_start = next != keyframe_frames.begin() ? *std::prev(next) : frame_number;
 }
 
 ExtractionBatch MediaBackgroundExtractor::BuildNextBatch() {
     std::lock_guard<std::mutex> lock(queue_mutex);
 
-    std::vector<FrameExtractionRequest> batch_frames;
-    batch_frames.reserve(config.max_batch_size);
-
-    // Extract up to max_batch_size requests
-    while (!request_queue.empty() && batch_frames.size() < config.max_batch_size) {
-        FrameExtractionRequest request = request_queue.top();
+    // In priority order: the most urgent request not in a GOP being decoded
+    // picks the GOP, and every queued frame in that GOP joins its run
+    std::vector<FrameExtractionRequest> pending;
+    pending.reserve(request_queue.size());
+    while (!request_queue.empty()) {
+        pending.push_back(request_queue.top());
         request_queue.pop();
+    }
+
+    std::vector<FrameExtractionRequest> batch_frames;
+    int gop_start = -1;
+    int gop_end = -1;
+
+    // Intra-only: no GOPs - the most urgent frames, split evenly over the workers
+    if (IsIntraOnlyStream()) {
+        const size_t workers = (std::max)(static_cast<size_t>(1), MaxBatchTasks());
+        const size_t batch_size = (std::min)(static_cast<size_t>((std::max)(1, config.max_batch_size)),
+                                             (std::max)(static_cast<size_t>(1), pending.size() / workers));
+        for (const auto& request : pending) {
+            if (IsFrameAlreadyCached(request.frame_number)) {
+                requested_frames.erase(request.frame_number);
+            } else if (batch_frames.size() < batch_size) {
+                batch_frames.push_back(request);
+            } else {
+                request_queue.push(request);
+            }
+        }
+        if (batch_frames.empty()) {
+            return ExtractionBatch();
+        }
+        return ExtractionBatch(std::move(batch_frames), false);
+    }
 
+    for (const auto& request : pending) {
         // Skip if frame is already cached
-        if (!IsFrameAlreadyCached(request.frame_number)) {
+        if (IsFrameAlreadyCached(request.frame_number)) {
+            requested_frames.erase(request.frame_number);
+            continue;
+        }
+
+        if (batch_frames.empty()) {
+            int start = 0;
+            int end = 0;
+            FindGopLocked(request.frame_number, start, end);
+            if (active_gops.count(start) == 0) {
+                gop_start = start;
+                gop_end = end >= 0 ? end : request.frame_number + kUnknownGopSpan;
+                batch_frames.push_back(request);
+                continue;
+            }
+        } else if (request.frame_number >= gop_start && request.frame_number < gop_end &&
+                   batch_frames.size() < kMaxRunFrames) {
             batch_frames.push_back(request);
+            continue;
         }
+        request_queue.push(request);
     }
 
     if (batch_frames.empty()) {
         return ExtractionBatch();
     }
+    active_gops.insert(gop_start);
 
-    // Sort batch by timestamp for sequential access optimization
+    // Sort batch by timestamp: the run decodes forward once
     std::sort(batch_frames.begin(), batch_frames.end(),
         [](const FrameExtractionRequest& a, const FrameExtractionRequest& b) {
             return a.timestamp < b.timestamp;
@@ -378,62 +520,287 @@ ExtractionBatch MediaBackgroundExtractor::BuildNextBatch() {
         }
     }
 
-    return ExtractionBatch(std::move(batch_frames), is_sequential);
+    const bool keyframes_only = std::all_of(batch_frames.begin(), batch_frames.end(),
+        [](const FrameExtractionRequest& request) { return request.keyframe_only; });
+
+    ExtractionBatch batch(std::move(batch_frames), is_sequential);
+    batch.gop_start_frame = gop_start;
+    batch.keyframes_only = keyframes_only;
+    return batch;
 }
 
-std::vector<ExtractionResult> MediaBackgroundExtractor::ProcessBatch(const ExtractionBatch& batch, WorkerContext& worker_ctx) {
-    std::vector<ExtractionResult> results;
-    results.reserve(batch.frames.size());
+void MediaBackgroundExtractor::DeliverResult(ExtractionResult&& result) {
+    std::lock_guard<std::mutex> lock(results_mutex);
+    UpdateStats(result);
+    completed_results.push(std::move(result));
+}
+
+void MediaBackgroundExtractor::ProcessBatch(const ExtractionBatch& batch, WorkerContext& worker_ctx) {
+    if (!worker_ctx.format_context || !worker_ctx.codec_context) {
+        return;
+    }
 
     AVFrame* frame = av_frame_alloc();
-    if (!frame) {
+    AVPacket* packet = av_packet_alloc();
+    if (!frame || !packet) {
         Debug::Log("MediaBackgroundExtractor: Failed to allocate frame for batch processing");
-        return results;
+        av_frame_free(&frame);
+        av_packet_free(&packet);
+        return;
     }
 
-    auto batch_start = std::chrono::steady_clock::now();
+    AVStream* stream = worker_ctx.format_context->streams[worker_ctx.video_stream_index];
+    const double time_base = av_q2d(stream->time_base);
+    const double fps = frame_rate.load();
+
+    // Positions in frames: exact from the packet index, else timestamp x frame rate
+    const std::shared_ptr<const ump::VideoPacketIndex> index = GetPacketIndex();
+    auto frame_position = [&](int64_t pts) -> double {
+        if (index) {
+            const int exact = index->FrameAtPts(pts);
+            return exact >= 0 ? exact : index->FrameAtTime(pts * time_base);
+        }
+        return pts * time_base * fps;
+    };
+    auto request_position = [&](const FrameExtractionRequest& request) -> double {
+        return index ? request.frame_number : request.timestamp * fps;
+    };
+
+    size_t next = 0;        // First request not delivered yet
+    size_t decoded = 0;
+    std::vector<int> keyframes_seen;
+
+    // Each decoded frame serves every pending request it matches; frames before
+    // the next request are GOP pre-roll. Returns true when the run is complete.
+    bool overshoot = false;
+    bool first_frame = true;
+    auto consume = [&](bool allow_overshoot) {
+        decoded++;
+        const int64_t pts = frame->best_effort_timestamp != AV_NOPTS_VALUE ? frame->best_effort_timestamp : frame->pts;
+        const double position = frame_position(pts);
+        if (frame->flags & AV_FRAME_FLAG_KEY) {
+            keyframes_seen.push_back(static_cast<int>(std::llround(position)));
+        }
 
-    for (const auto& request : batch.frames) {
-        ExtractionResult result = ExtractSingleFrame(request, frame, worker_ctx);
-        results.push_back(result);
+        // Seek landed past the run's first frame (index of decode timestamps): back off once
+        if (first_frame && allow_overshoot && position - request_position(batch.frames[next]) >= 1.0) {
+            overshoot = true;
+            return true;
+        }
+        first_frame = false;
 
-        // Early exit if shutdown requested
-        if (shutdown_requested.load()) {
+        while (next < batch.frames.size()) {
+            const FrameExtractionRequest& request = batch.frames[next];
+            if (position < request_position(request) - 0.5) {
+                break;
+            }
+            if (position - request_position(request) < 1.0) {
+                DeliverResult(ExtractDecodedFrame(request, frame));
+            } else {
+                DeliverResult(FailedResult(request, "No frame at timestamp " + std::to_string(request.timestamp)));
+            }
+            next++;
+        }
+        av_frame_unref(frame);
+        return next >= batch.frames.size() || shutdown_requested.load();
+    };
+
+    // One seek for the whole run: lands on the GOP's keyframe (the index knows where it is)
+    for (int attempt = 0; attempt < 2 && next < batch.frames.size() && !shutdown_requested.load(); ++attempt) {
+        const double seek_timestamp = (std::max)(0.0, batch.start_timestamp - attempt * kOvershootBackoff);
+        const int64_t target_pts = index ? index->SeekTimestamp(batch.frames.front().frame_number) :
+            av_rescale_q(static_cast<int64_t>(seek_timestamp * AV_TIME_BASE), AV_TIME_BASE_Q, stream->time_base);
+        if (av_seek_frame(worker_ctx.format_context, worker_ctx.video_stream_index, target_pts, AVSEEK_FLAG_BACKWARD) < 0) {
+            Debug::Log("MediaBackgroundExtractor: Seek failed for timestamp " + std::to_string(seek_timestamp));
             break;
         }
+        avcodec_flush_buffers(worker_ctx.codec_context);
+        worker_ctx.codec_context->skip_frame = batch.keyframes_only ? AVDISCARD_NONKEY : AVDISCARD_DEFAULT;
+
+        overshoot = false;
+        first_frame = true;
+        const bool allow_overshoot = !index && attempt == 0 && seek_timestamp > 0.0;
+        bool done = false;
+        while (!done && av_read_frame(worker_ctx.format_context, packet) >= 0) {
+            if (packet->stream_index == worker_ctx.video_stream_index &&
+                avcodec_send_packet(worker_ctx.codec_context, packet) >= 0) {
+                while (!done && avcodec_receive_frame(worker_ctx.codec_context, frame) >= 0) {
+                    done = consume(allow_overshoot);
+                }
+            }
+            av_packet_unref(packet);
+        }
+
+        // End of stream: drain the frames the decoder holds for reordering
+        if (!done) {
+            avcodec_send_packet(worker_ctx.codec_context, nullptr);
+            while (!done && avcodec_receive_frame(worker_ctx.codec_context, frame) >= 0) {
+                done = consume(allow_overshoot);
+            }
+        }
+        if (!overshoot) {
+            break;
+        }
+    }
+
+    // Requests the run never reached (shutdown clears the request tracking instead)
+    if (!shutdown_requested.load()) {
+        for (; next < batch.frames.size(); ++next) {
+            const FrameExtractionRequest& request = batch.frames[next];
+            DeliverResult(FailedResult(request, "Failed to decode frame at timestamp " + std::to_string(request.timestamp)));
+        }
+    }
+
+    av_packet_free(&packet);
+    av_frame_free(&frame);
+
+    {
+        std::lock_guard<std::mutex> lock(stats_mutex);
+        stats.total_batches_processed++;
+        stats.total_frames_decoded += decoded;
+    }
+
+    if (!keyframes_seen.empty()) {
+        std::lock_guard<std::mutex> lock(queue_mutex);
+        keyframe_frames.insert(keyframes_seen.begin(), keyframes_seen.end());
+    }
+}
+
+// ============================================================================
+// Intra-only Fast Path
+// ============================================================================
+
+bool MediaBackgroundExtractor::IsIntraOnlyStream() const {
+    if (intra_only.load()) {
+        return true;
+    }
+    auto index = GetPacketIndex();
+    return index && index->IsIntraOnly();   // e.g. all-I H.264
+}
+
+size_t MediaBackgroundExtractor::MaxBatchTasks() const {
+    const size_t configured = static_cast<size_t>((std::max)(1, config.max_concurrent_batches));
+    if (!IsIntraOnlyStream()) {
+        return configured;
+    }
+    return (std::max)(configured, ump::TaskScheduler::Shared().GetWorkerCount());
+}
+
+bool MediaBackgroundExtractor::ReadFramePacket(const FrameExtractionRequest& request, const ump::VideoPacketIndex* index,
+                                               AVPacket* packet, WorkerContext& worker_ctx) {
+    AVFormatContext* input = worker_ctx.format_context;
+    AVStream* stream = input->streams[worker_ctx.video_stream_index];
+    const bool indexed = index && request.frame_number < index->FrameCount();
+
+    // Indexed MOV/MP4: the sample's bytes straight from its offset - no demuxer seek
+    const ump::VideoPacketIndex::Packet* entry = indexed ? index->FramePacket(request.frame_number) : nullptr;
+    if (entry && addressable_packets.load() && entry->pos >= 0 && entry->size > 0 && input->pb) {
+        if (av_new_packet(packet, entry->size) == 0) {
+            if (avio_seek(input->pb, entry->pos, SEEK_SET) == entry->pos &&
+                avio_read(input->pb, packet->data, entry->size) == entry->size) {
+                packet->pts = entry->pts;
+                packet->dts = entry->dts;
+                packet->flags |= AV_PKT_FLAG_KEY;
+                packet->stream_index = worker_ctx.video_stream_index;
+
+                std::lock_guard<std::mutex> lock(stats_mutex);
+                stats.direct_packet_reads++;
+                return true;
+            }
+            av_packet_unref(packet);
+        }
+    }
+
+    // Other containers: every frame is a keyframe, so the seek lands on the frame itself
+    const int64_t target_pts = indexed ? index->FramePts(request.frame_number) :
+        av_rescale_q(static_cast<int64_t>(request.timestamp * AV_TIME_BASE), AV_TIME_BASE_Q, stream->time_base);
+    if (av_seek_frame(input, worker_ctx.video_stream_index, target_pts, AVSEEK_FLAG_BACKWARD) < 0) {
+        return false;
     }
 
-    if (frame) {
+    const double time_base = av_q2d(stream->time_base);
+    const double frame_duration = 1.0 / frame_rate.load();
+    for (int video_packets = 0; video_packets < kMaxIntraScanPackets && av_read_frame(input, packet) >= 0; ) {
+        if (packet->stream_index != worker_ctx.video_stream_index) {
+            av_packet_unref(packet);
+            continue;
+        }
+        video_packets++;
+
+        const int64_t pts = packet->pts != AV_NOPTS_VALUE ? packet->pts : packet->dts;
+        const double offset = indexed ? static_cast<double>(pts - target_pts) : pts * time_base - request.timestamp;
+        const double tolerance = indexed ? 0.0 : 0.5 * frame_duration;
+        if (offset >= -tolerance && offset <= tolerance) {
+            return true;
+        }
+        av_packet_unref(packet);
+        if (offset > tolerance) {
+            break;  // Passed it: no packet for this frame
+        }
+    }
+    return false;
+}
+
+void MediaBackgroundExtractor::ProcessIntraBatch(const ExtractionBatch& batch, WorkerContext& worker_ctx) {
+    if (!worker_ctx.format_context || !worker_ctx.codec_context) {
+        return;
+    }
+
+    AVFrame* frame = av_frame_alloc();
+    AVPacket* packet = av_packet_alloc();
+    if (!frame || !packet) {
+        Debug::Log("MediaBackgroundExtractor: Failed to allocate frame for batch processing");
         av_frame_free(&frame);
+        av_packet_free(&packet);
+        return;
     }
 
-    auto batch_end = std::chrono::steady_clock::now();
-    double batch_time = std::chrono::duration<double, std::milli>(batch_end - batch_start).count();
+    // Each frame is one packet in, one frame out: no flush between frames,
+    // and only the requested packets are decoded
+    const std::shared_ptr<const ump::VideoPacketIndex> index = GetPacketIndex();
+    size_t decoded = 0;
+    for (const auto& request : batch.frames) {
+        if (shutdown_requested.load()) {
+            break;
+        }
+
+        bool ok = ReadFramePacket(request, index.get(), packet, worker_ctx) &&
+                  avcodec_send_packet(worker_ctx.codec_context, packet) >= 0 &&
+                  avcodec_receive_frame(worker_ctx.codec_context, frame) >= 0;
+        av_packet_unref(packet);
+
+        if (ok) {
+            decoded++;
+            DeliverResult(ExtractDecodedFrame(request, frame));
+            av_frame_unref(frame);
+        } else {
+            avcodec_flush_buffers(worker_ctx.codec_context);  // Nothing carried into the next frame
+            DeliverResult(FailedResult(request, "Failed to decode frame at timestamp " + std::to_string(request.timestamp)));
+        }
+    }
 
-    //Debug::Log("MediaBackgroundExtractor: Processed batch of " + std::to_string(batch.frames.size()) +
-    //           " frames in " + std::to_string(batch_time) + "ms");
+    av_packet_free(&packet);
+    av_frame_free(&frame);
 
-    return results;
+    std::lock_guard<std::mutex> lock(stats_mutex);
+    stats.total_batches_processed++;
+    stats.total_frames_decoded += decoded;
 }
 
-ExtractionResult MediaBackgroundExtractor::ExtractSingleFrame(const FrameExtractionRequest& request, AVFrame* frame, WorkerContext& worker_ctx) {
+ExtractionResult MediaBackgroundExtractor::ExtractDecodedFrame(const FrameExtractionRequest& request, AVFrame* frame) {
     ExtractionResult result;
     result.frame_number = request.frame_number;
     result.timestamp = request.timestamp;
+    result.numbering = request.numbering;
     result.completed_at = std::chrono::steady_clock::now();
 
-    // Decode frame at timestamp
-    if (!DecodeFrameAtTimestamp(request.timestamp, frame, worker_ctx)) {
-        result.error_message = "Failed to decode frame at timestamp " + std::to_string(request.timestamp);
-        return result;
-    }
-
     // Extract to pixel buffer instead of texture (texture creation happens on main thread)
     std::vector<uint8_t> pixel_data;
     int width = frame->width;
     int height = frame->height;
 
-    if (!ConvertFrameToPixelBuffer(frame, pixel_data, width, height)) {
+    bool packed_10bit = false;
+    if (!ConvertFrameToPixelBuffer(frame, pixel_data, width, height, packed_10bit)) {
         result.error_message = "Failed to convert frame to pixel buffer";
         return result;
     }
@@ -442,76 +809,17 @@ ExtractionResult MediaBackgroundExtractor::ExtractSingleFrame(const FrameExtract
     result.texture_id = 0;  // Will be created on main thread
     result.width = width;
     result.height = height;
-    // Calculate memory bytes based on pipeline mode
-    size_t bytes_per_pixel;
-    switch (config.pipeline_mode) {
-        case PipelineMode::HIGH_RES:
-            bytes_per_pixel = 8;  // 16-bit RGBA (4 channels * 2 bytes)
-            break;
-        case PipelineMode::ULTRA_HIGH_RES:
-            bytes_per_pixel = 16; // 32-bit float RGBA (4 channels * 4 bytes) - EXR only
-            break;
-        case PipelineMode::HDR_RES:
-            bytes_per_pixel = 8;  // 16-bit RGBA (4 channels * 2 bytes) - half-float equivalent
-            break;
-        default:  // PipelineMode::NORMAL
-            bytes_per_pixel = 4;  // 8-bit RGBA (4 channels * 1 byte)
-            break;
+    result.packed_10bit = packed_10bit;
+    result.memory_bytes = pixel_data.size();  // Actual storage (packed 10-bit is half of RGBA16)
+    if (content_hashing.load()) {
+        result.fingerprint = ump::FingerprintBytes(pixel_data.data(), pixel_data.size());
     }
-    result.memory_bytes = width * height * bytes_per_pixel;
     result.pixel_data = std::move(pixel_data);  // Store pixel data for texture creation
 
     return result;
 }
 
-bool MediaBackgroundExtractor::DecodeFrameAtTimestamp(double timestamp, AVFrame* output_frame, WorkerContext& worker_ctx) {
-    if (!worker_ctx.format_context || !worker_ctx.codec_context) {
-        return false;
-    }
-
-    // Convert timestamp to stream timebase
-    AVStream* stream = worker_ctx.format_context->streams[worker_ctx.video_stream_index];
-    int64_t target_pts = av_rescale_q(timestamp * AV_TIME_BASE, AV_TIME_BASE_Q, stream->time_base);
-
-    // Seek to target timestamp
-    if (av_seek_frame(worker_ctx.format_context, worker_ctx.video_stream_index, target_pts, AVSEEK_FLAG_BACKWARD) < 0) {
-        Debug::Log("MediaBackgroundExtractor: Seek failed for timestamp " + std::to_string(timestamp));
-        return false;
-    }
-
-    avcodec_flush_buffers(worker_ctx.codec_context);
-
-    AVPacket* packet = av_packet_alloc();
-    if (!packet) {
-        return false;
-    }
-
-    bool found_frame = false;
-
-    // Read packets until we find our target frame
-    while (av_read_frame(worker_ctx.format_context, packet) >= 0) {
-        if (packet->stream_index == worker_ctx.video_stream_index) {
-            if (avcodec_send_packet(worker_ctx.codec_context, packet) >= 0) {
-                while (avcodec_receive_frame(worker_ctx.codec_context, output_frame) >= 0) {
-                    // Check if this is close to our target timestamp
-                    double frame_timestamp = output_frame->pts * av_q2d(stream->time_base);
-                    if (std::abs(frame_timestamp - timestamp) < (1.0 / frame_rate.load())) {
-                        found_frame = true;
-                        break;
-                    }
-                    av_frame_unref(output_frame);
-                }
-            }
-            if (found_frame) break;
-        }
-        av_packet_unref(packet);
-    }
-
-    av_packet_free(&packet);
-    return found_frame;
-}
-
-bool MediaBackgroundExtractor::ConvertFrameToPixelBuffer(AVFrame* frame, std::vector<uint8_t>& pixel_data, int& width, int& height) {
+bool MediaBackgroundExtractor::ConvertFrameToPixelBuffer(AVFrame* frame, std::vector<uint8_t>& pixel_data, int& width, int& height, bool& packed_10bit) {
     if (!frame || frame->width <= 0 || frame->height <= 0) {
         return false;
     }
@@ -544,11 +852,23 @@ bool MediaBackgroundExtractor::ConvertFrameToPixelBuffer(AVFrame* frame, std::ve
     AVPixelFormat target_format;
     size_t bytes_per_pixel;
 
+    packed_10bit = false;
     switch (config.pipeline_mode) {
-        case PipelineMode::HIGH_RES:
+        case PipelineMode::HIGH_RES: {
+            // Sources of 10 bits or less without alpha fit RGB10_A2 - half the
+            // memory of 16-bit RGBA with no precision lost
+            const AVPixFmtDescriptor* desc = av_pix_fmt_desc_get((AVPixelFormat)frame->format);
+            if (desc && desc->comp[0].depth <= 10 && !(desc->flags & AV_PIX_FMT_FLAG_ALPHA) &&
+                sws_isSupportedOutput(AV_PIX_FMT_X2BGR10LE)) {
+                target_format = AV_PIX_FMT_X2BGR10LE;  // R in the low bits, as GL_UNSIGNED_INT_2_10_10_10_REV
+                bytes_per_pixel = 4;
+                packed_10bit = true;
+                break;
+            }
             target_format = AV_PIX_FMT_RGBA64LE;  // 16-bit RGBA
             bytes_per_pixel = 8;
             break;
+        }
         case PipelineMode::ULTRA_HIGH_RES:
             target_format = AV_PIX_FMT_RGBAF32LE;  // 32-bit float RGBA (EXR only)
             bytes_per_pixel = 16;
@@ -702,14 +1022,19 @@ GLuint MediaBackgroundExtractor::CreateTextureFromPixels(const std::vector<uint8
 
 // Note: RequestSequentialFrames() removed - using window-around-playhead only
 
-void MediaBackgroundExtractor::RequestFrame(int frame_number, double timestamp, int priority) {
+void MediaBackgroundExtractor::RequestFrame(int frame_number, double timestamp, int priority, bool keyframe_only) {
     // Validate frame bounds
     if (frame_number < 0) return;
 
-    // For videos, use duration-based calculation
+    // Read before GetPacketIndex: the caller counted frame_number without it
+    uint32_t numbering = index_numbering.load();
+
+    // For videos, use duration-based calculation (exact frame count once indexed)
     double dur = duration.load();
     double fps = frame_rate.load();
-    if (dur > 0 && fps > 0) {
+    if (auto index = GetPacketIndex()) {
+        if (frame_number >= index->FrameCount()) return;
+    } else if (dur > 0 && fps > 0) {
         int max_frame = static_cast<int>(dur * fps) - 1;
         if (frame_number > max_frame) return;
     }
@@ -739,9 +1064,11 @@ void MediaBackgroundExtractor::RequestFrame(int frame_number, double timestamp,
     request.timestamp = timestamp;
     request.priority = priority;
     request.requested_at = std::chrono::steady_clock::now();
+    request.keyframe_only = keyframe_only;
+    request.numbering = numbering;
 
     request_queue.push(request);
-    queue_cv.notify_one();
+    ScheduleBatchTasksLocked();
 }
 
 // Additional implementation methods would continue here...
@@ -897,8 +1224,11 @@ bool MediaBackgroundExtractor::IsFrameAlreadyCached(int frame_number) const {
 void MediaBackgroundExtractor::SetState(ExtractorState new_state) {
     ExtractorState old_state = current_state.exchange(new_state);
     if (old_state != new_state) {
-        // State changed - notify all worker threads
-        worker_cv.notify_all();
+        // Resumed - restart batch tasks for queued work
+        if (new_state == ExtractorState::EXTRACTING) {
+            std::lock_guard<std::mutex> lock(queue_mutex);
+            ScheduleBatchTasksLocked();
+        }
 
         // Log state transition for debugging
         const char* state_names[] = {"STOPPED", "EXTRACTING", "PAUSED_PLAYBACK", "PAUSED_REPOSITION", "PAUSED_MANUAL"};
@@ -931,8 +1261,7 @@ void MediaBackgroundExtractor::RequestWindowAroundPlayhead(double center_timesta
     }
     last_center = center_timestamp;
 
-    double fps = frame_rate.load();
-    int center_frame = static_cast<int>(center_timestamp * fps);
+    int center_frame = FrameAtTimestamp(center_timestamp);
 
     //Debug::Log("MediaBackgroundExtractor: Starting RAM-bounded spiral from frame " + std::to_string(center_frame));
 
@@ -952,15 +1281,116 @@ void MediaBackgroundExtractor::RequestWindowAroundPlayhead(double center_timesta
         // Frame before center
         int before_frame = center_frame - dist;
         if (before_frame >= 0) {
-            RequestFrame(before_frame, before_frame / fps, priority);
+            RequestFrame(before_frame, FrameTimestamp(before_frame), priority);
         }
 
         // Frame after center (skip dist=0 to avoid duplicate)
         if (dist > 0) {
             int after_frame = center_frame + dist;
-            RequestFrame(after_frame, after_frame / fps, priority);
+            RequestFrame(after_frame, FrameTimestamp(after_frame), priority);
+        }
+    }
+}
+
+void MediaBackgroundExtractor::RequestReverseWindow(double playhead_timestamp) {
+    // Playhead frame first, then backwards: BuildNextBatch turns the queue into
+    // GOP runs newest first, so each worker decodes the next GOP back
+    const int playhead_frame = FrameAtTimestamp(playhead_timestamp);
+    const int window_frames = static_cast<int>(std::ceil(config.reverse_read_ahead_seconds * frame_rate.load()));
+
+    for (int dist = 0; dist <= window_frames && playhead_frame - dist >= 0; ++dist) {
+        if (!CanRequestMoreFrames()) {
+            break;
+        }
+        const int frame = playhead_frame - dist;
+        RequestFrame(frame, FrameTimestamp(frame), kReversePriority - dist);
+    }
+}
+
+void MediaBackgroundExtractor::SetReversePlayback(bool reverse, double playhead_timestamp) {
+    if (reverse_playback.exchange(reverse) == reverse) {
+        return;
+    }
+
+    // Queued requests belong to the other direction's window
+    ClearPendingRequests();
+
+    if (reverse) {
+        if (current_state.load() == ExtractorState::PAUSED_PLAYBACK) {
+            SetState(ExtractorState::EXTRACTING);
+        }
+        current_playhead_position = playhead_timestamp;
+        RequestReverseWindow(playhead_timestamp);
+    } else if (playback_active.load() && config.pause_during_playback &&
+               current_state.load() == ExtractorState::EXTRACTING) {
+        SetState(ExtractorState::PAUSED_PLAYBACK);
+    }
+
+    Debug::Log(std::string("MediaBackgroundExtractor: Reverse playback ") + (reverse ? "started" : "stopped"));
+}
+
+void MediaBackgroundExtractor::SetTrickPlay(bool enabled) {
+    if (trick_play.exchange(enabled) == enabled) {
+        return;
+    }
+
+    // Full-GOP window requests are what stalls a fast shuttle
+    ClearPendingRequests();
+    {
+        std::lock_guard<std::mutex> lock(queue_mutex);
+        last_trick_keyframe = -1;
+    }
+
+    Debug::Log(std::string("MediaBackgroundExtractor: Trick play ") + (enabled ? "started" : "stopped"));
+}
+
+bool MediaBackgroundExtractor::RequestKeyframe(double timestamp, bool forward, double& keyframe_timestamp) {
+    const int frame = FrameAtTimestamp(timestamp);
+    int keyframe = -1;
+    int next_keyframe = -1;
+
+    if (auto index = GetPacketIndex()) {
+        if (index->KeyframeCount() == 0) {
+            return false;
+        }
+        keyframe = index->GopStart(frame);
+        next_keyframe = forward ? index->GopEnd(frame) : (keyframe > 0 ? index->GopStart(keyframe - 1) : -1);
+    } else {
+        // Keyframes from the container index or learned while decoding
+        std::lock_guard<std::mutex> lock(queue_mutex);
+        auto after = keyframe_frames.upper_bound(frame);
+        if (after == keyframe_frames.begin()) {
+            return false;
+        }
+        auto at = std::prev(after);
+        keyframe = *at;
+        if (forward) {
+            next_keyframe = after != keyframe_frames.end() ? *after : -1;
+        } else {
+            next_keyframe = at != keyframe_frames.begin() ? *std::prev(at) : -1;
         }
     }
+
+    keyframe_timestamp = FrameTimestamp(keyframe);
+
+    // Passed a keyframe: whatever is still queued is behind the shuttle
+    {
+        std::lock_guard<std::mutex> lock(queue_mutex);
+        if (keyframe == last_trick_keyframe) {
+            return true;
+        }
+        last_trick_keyframe = keyframe;
+        while (!request_queue.empty()) {
+            request_queue.pop();
+        }
+        requested_frames.clear();
+    }
+
+    RequestFrame(keyframe, keyframe_timestamp, kTrickPlayPriority, true);
+    if (next_keyframe >= 0) {
+        RequestFrame(next_keyframe, FrameTimestamp(next_keyframe), kTrickPlayPriority - 1, true);
+    }
+    return true;
 }
 
 // Note: CalculateWindowSize removed - using RAM-bounded spiral instead
@@ -987,8 +1417,10 @@ void MediaBackgroundExtractor::ForceWindowRefresh() {
 
 void MediaBackgroundExtractor::NotifyPlaybackState(bool is_playing) {
     ExtractorState current = current_state.load();
+    playback_active = is_playing;
 
-    if (is_playing && config.pause_during_playback) {
+    // Reverse playback is served from the cache: keep decoding behind the playhead
+    if (is_playing && config.pause_during_playback && !reverse_playback.load()) {
         // Pause for playback - only if currently extracting or paused for reposition
         if (current == ExtractorState::EXTRACTING || current == ExtractorState::PAUSED_REPOSITION) {
             SetState(ExtractorState::PAUSED_PLAYBACK);
@@ -1053,8 +1485,11 @@ void MediaBackgroundExtractor::UpdateStats(const ExtractionResult& result) {
 MediaBackgroundExtractor::ExtractorStats MediaBackgroundExtractor::GetStats() const {
     std::lock_guard<std::mutex> lock(stats_mutex);
     ExtractorStats current_stats = stats;
+    current_stats.decode_ratio = stats.total_frames_extracted > 0 ?
+        static_cast<double>(stats.total_frames_decoded) / stats.total_frames_extracted : 0.0;
     current_stats.current_hardware_decoder = current_hw_decoder_name;
     current_stats.is_hardware_accelerated = (current_hw_mode != HardwareDecodeMode::SOFTWARE_ONLY);
+    current_stats.intra_only = IsIntraOnlyStream();
 
     {
         std::lock_guard<std::mutex> queue_lock(queue_mutex);
@@ -1085,7 +1520,9 @@ void MediaBackgroundExtractor::SetPlayheadPosition(double timestamp) {
 
     // If playhead moved significantly, update window
     double position_change = std::abs(timestamp - old_position);
-    if (position_change > 0.1) { // More than 0.1 second movement for responsive timeline
+    if (trick_play.load() || reverse_playback.load()) {
+        return;     // Shuttle / FrameCache's reverse branch request their frames themselves
+    } else if (position_change > 0.1) { // More than 0.1 second movement for responsive timeline
         RequestWindowAroundPlayhead(timestamp);
         //Debug::Log("MediaBackgroundExtractor: Updated window for playhead position " +
         //          std::to_string(timestamp) + "s");
@@ -1104,8 +1541,7 @@ void MediaBackgroundExtractor::UpdateHardwareConfig(const HardwareDecodeConfig&
 void MediaBackgroundExtractor::RequestFrameRange(int start_frame, int end_frame, int base_priority) {
     for (int frame = start_frame; frame <= end_frame; ++frame) {
         if (frame >= 0) {
-            double fps = frame_rate.load();
-            double timestamp = frame / fps;
+            double timestamp = FrameTimestamp(frame);
             int priority = (std::max)(1, base_priority - abs(frame - start_frame));
             RequestFrame(frame, timestamp, priority);
         }
@@ -1190,11 +1626,17 @@ void MediaBackgroundExtractor::ProcessCompletedFrames() {
 
     // Process results on main thread (with proper OpenGL context)
     for (const auto& result : results_to_process) {
+        // Requested under frame-rate numbering before the packet index arrived:
+        // its frame_number may name a different frame now (the request set was cleared)
+        if (result.numbering != index_numbering.load()) {
+            continue;
+        }
+
         if (result.success && parent_cache) {
             // Add extracted frame to parent cache with pixel data
             parent_cache->AddExtractedFrame(result.frame_number, result.timestamp,
                                            result.pixel_data, result.width, result.height,
-                                           result.from_native_image);
+                                           result.from_native_image, result.packed_10bit, result.fingerprint);
         }
 
         // Remove from requested set regardless of success/failure
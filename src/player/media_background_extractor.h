@@ -18,11 +18,14 @@ struct AVCodecContext;
 struct AVBufferRef;
 struct SwsContext;
 struct AVFrame;
+struct AVPacket;
 
 // Forward declarations
 struct VideoMetadata;
 class FrameCache;
 #include "video_player.h"
+#include "../utils/content_hash.h"
+#include "video_packet_index.h"
 
 // Color matrix processing modes for different pixel formats
 enum class ColorMatrixMode {
@@ -84,17 +87,22 @@ struct FrameExtractionRequest {
     double timestamp;
     int priority;  // Higher = more urgent
     std::chrono::steady_clock::time_point requested_at;
+    bool keyframe_only = false;  // Trick play: a keyframe, decoded with non-key packets discarded
+    uint32_t numbering = 0;      // Packet index generation frame_number was counted in
 
     bool operator<(const FrameExtractionRequest& other) const {
         return priority < other.priority;  // Higher priority first
     }
 };
 
+// One GOP-aligned run: frames (sorted by timestamp) decoded after a single seek
 struct ExtractionBatch {
     std::vector<FrameExtractionRequest> frames;
     bool is_sequential = true;  // Optimization hint
     double start_timestamp = 0.0;
     double end_timestamp = 0.0;
+    int gop_start_frame = -1;   // Keyframe the run belongs to (claimed while decoding)
+    bool keyframes_only = false; // Only keyframe requests: decoder skips non-key frames
 
     ExtractionBatch() = default;
     ExtractionBatch(std::vector<FrameExtractionRequest> f, bool seq = true)
@@ -118,6 +126,9 @@ struct ExtractionResult {
     std::string error_message;
     std::vector<uint8_t> pixel_data;  // Raw pixel data for texture creation on main thread (format depends on pipeline mode)
     bool from_native_image = false;  // True if extracted from native TIFF/PNG/JPEG loader (not FFmpeg)
+    bool packed_10bit = false;  // pixel_data is RGB10_A2 (HIGH_RES, sources of 10 bits or less)
+    ump::ContentFingerprint fingerprint;  // Of pixel_data when content hashing is on (dedup)
+    uint32_t numbering = 0;  // Copied from the request
 };
 
 class MediaBackgroundExtractor {
@@ -130,6 +141,7 @@ public:
         int max_queue_size = 200;                  // Safety limit for request queue
         int texture_pool_size = 50;                // Pre-allocated textures
         PipelineMode pipeline_mode = PipelineMode::NORMAL;
+        double reverse_read_ahead_seconds = 4.0;   // Decoded behind the playhead in reverse playback
     };
 
     explicit MediaBackgroundExtractor(FrameCache* parent_cache, const ExtractorConfig& config = ExtractorConfig{});
@@ -153,8 +165,21 @@ public:
     void NotifyPlaybackState(bool is_playing);           // Pause/resume based on playback
     void SetPlayheadPosition(double timestamp);          // Update priority calculations
 
+    // Reverse playback: GOPs behind the playhead are decoded newest first, in
+    // parallel, and the forward window is dropped. Keeps extracting during playback.
+    // The caller re-requests the window as the playhead moves back.
+    void SetReversePlayback(bool reverse, double playhead_timestamp = 0.0);
+    void RequestReverseWindow(double playhead_timestamp);  // Playhead back through the reverse read-ahead
+    bool IsReversePlayback() const { return reverse_playback.load(); }
+
+    // Trick play (high-speed shuttle): only keyframes are requested, one decode
+    // each. RequestKeyframe queues the keyframe the playhead last passed plus the
+    // next one in the direction of travel; false until keyframes are known.
+    void SetTrickPlay(bool enabled);
+    bool RequestKeyframe(double timestamp, bool forward, double& keyframe_timestamp);
+
     // Request management
-    void RequestFrame(int frame_number, double timestamp, int priority = 0);
+    void RequestFrame(int frame_number, double timestamp, int priority = 0, bool keyframe_only = false);
     void RequestFrameRange(int start_frame, int end_frame, int base_priority = 0);
     void ClearPendingRequests();  // Cancel all queued work
     void ForceWindowRefresh();     // Force refresh window around current playhead
@@ -166,9 +191,21 @@ public:
     double GetFrameRate() const { return frame_rate; }
     int64_t GetStartTime() const { return start_time; }
 
+    // Frame <-> timestamp: exact from the file's packet index once built, else by frame rate
+    std::shared_ptr<const ump::VideoPacketIndex> GetPacketIndex() const;
+    int FrameAtTimestamp(double timestamp) const;
+    double FrameTimestamp(int frame_number) const;
+    // True once after the packet index arrives: frame numbers handed out before
+    // were counted by frame rate and no longer name the same frames
+    bool TakePacketIndexArrival() { return packet_index_arrived.exchange(false); }
+
     // Configuration
     void UpdateHardwareConfig(const HardwareDecodeConfig& config);
     void SetBatchSize(int size) { config.max_batch_size = std::max(1, size); }
+    void SetReverseReadAhead(double seconds) { config.reverse_read_ahead_seconds = std::max(0.5, seconds); }
+
+    // Fingerprint every extracted frame on the worker (FrameCache deduplication)
+    void SetContentHashing(bool enabled) { content_hashing = enabled; }
 
     // Metadata-driven conversion (NEW: Conditional 4444 color matrix support)
     void SetConversionStrategy(const ConversionStrategy& strategy);
@@ -181,9 +218,13 @@ public:
         size_t total_frames_extracted = 0;
         size_t total_batches_processed = 0;
         size_t failed_extractions = 0;
+        size_t total_frames_decoded = 0;        // Including GOP pre-roll before requested frames
+        double decode_ratio = 0.0;              // Decoded per delivered frame (1.0 = nothing wasted)
         double average_extraction_time_ms = 0.0;
         double frames_per_second = 0.0;
         size_t pending_requests = 0;
+        bool intra_only = false;                // Frames decoded independently, in parallel
+        size_t direct_packet_reads = 0;         // Intra frames read by index offset (no demuxer seek)
         std::string current_hardware_decoder;
         bool is_hardware_accelerated = false;
     };
@@ -229,13 +270,24 @@ private:
     std::atomic<double> frame_rate{30.0};
     std::atomic<int64_t> start_time{0};
     std::atomic<bool> initialized{false};
+    std::atomic<bool> intra_only{false};            // ProRes, DNxHR, MJPEG...: no GOP context needed
+    std::atomic<bool> addressable_packets{false};   // MOV/MP4: index offset + size are the raw packet bytes
+    std::atomic<bool> reverse_playback{false};
+    std::atomic<bool> playback_active{false};       // Last NotifyPlaybackState
+    std::atomic<bool> trick_play{false};
+    int last_trick_keyframe = -1;                   // queue_mutex
+
+    // Packet index (cached once VideoIndexStore has it)
+    mutable std::mutex index_mutex;
+    mutable std::shared_ptr<const ump::VideoPacketIndex> packet_index;
+    mutable std::atomic<uint32_t> index_numbering{0};      // Bumped when packet_index arrives
+    mutable std::atomic<bool> packet_index_arrived{false};
 
     // Metadata-driven conversion
     std::unique_ptr<ConversionStrategy> conversion_strategy;
     bool has_conversion_strategy = false;
 
-    // Threading
-    std::vector<std::thread> worker_threads;
+    // Threading (batches run as tasks on the shared ump::TaskScheduler)
     std::atomic<bool> shutdown_requested{false};
     std::atomic<ExtractorState> current_state{ExtractorState::STOPPED};
 
@@ -243,9 +295,10 @@ private:
     std::priority_queue<FrameExtractionRequest> request_queue;
     std::set<int> requested_frames;             // Simple duplicate prevention
     std::set<int> extracted_frames;             // Successfully extracted frames for timeline visualization
+    std::set<int> keyframe_frames;              // Known GOP starts: container index + keyframes seen while decoding
+    std::set<int> active_gops;                  // GOPs being decoded by a batch task
     mutable std::mutex queue_mutex;
-    std::condition_variable queue_cv;
-    std::condition_variable worker_cv;
+    std::condition_variable queue_cv;           // Signalled when the last batch task finishes
 
     // Results queue (for main thread processing)
     std::queue<ExtractionResult> completed_results;
@@ -253,6 +306,7 @@ private:
 
     // Timeline state
     std::atomic<double> current_playhead_position{0.0};
+    std::atomic<bool> content_hashing{false};
 
     // Texture pool for efficient batching
     std::vector<GLuint> texture_pool;
@@ -282,10 +336,25 @@ private:
         bool Initialize(const std::string& video_path, const HardwareDecodeConfig& hw_config);
     };
 
+    // Decoder contexts are pooled and checked out by batch tasks (guarded by queue_mutex)
+    std::vector<std::unique_ptr<WorkerContext>> idle_worker_contexts;
+    int active_batch_tasks = 0;                 // Posted or running (max: max_concurrent_batches)
+
     // Internal methods
-    void WorkerThread();
+    void ScheduleBatchTasksLocked();            // Caller holds queue_mutex
+    void RunBatchTask();
     ExtractionBatch BuildNextBatch();
-    std::vector<ExtractionResult> ProcessBatch(const ExtractionBatch& batch, WorkerContext& worker_ctx);
+    void ProcessBatch(const ExtractionBatch& batch, WorkerContext& worker_ctx);
+    void ProcessIntraBatch(const ExtractionBatch& batch, WorkerContext& worker_ctx);
+    bool ReadFramePacket(const FrameExtractionRequest& request, const ump::VideoPacketIndex* index,
+                         AVPacket* packet, WorkerContext& worker_ctx);
+    bool IsIntraOnlyStream() const;
+    size_t MaxBatchTasks() const;
+    void DeliverResult(ExtractionResult&& result);
+
+    // GOP planning: keyframes seeded from the container index, refined while decoding
+    void SeedKeyframeIndex();
+    void FindGopLocked(int frame_number, int& gop_start, int& gop_end) const;  // gop_end -1 = unknown
 
     // State management
     void SetState(ExtractorState new_state);
@@ -298,9 +367,8 @@ private:
     void CleanupHardwareContext();
 
     // Frame extraction
-    ExtractionResult ExtractSingleFrame(const FrameExtractionRequest& request, AVFrame* frame, WorkerContext& worker_ctx);
-    bool DecodeFrameAtTimestamp(double timestamp, AVFrame* output_frame, WorkerContext& worker_ctx);
-    bool ConvertFrameToPixelBuffer(AVFrame* frame, std::vector<uint8_t>& pixel_data, int& width, int& height);
+    ExtractionResult ExtractDecodedFrame(const FrameExtractionRequest& request, AVFrame* frame);
+    bool ConvertFrameToPixelBuffer(AVFrame* frame, std::vector<uint8_t>& pixel_data, int& width, int& height, bool& packed_10bit);
     GLuint CreateTextureFromPixels(const std::vector<uint8_t>& pixel_data, int width, int height);
 
     // Texture management
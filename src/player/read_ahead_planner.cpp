@@ -0,0 +1,198 @@
+#include "read_ahead_planner.h"
+#include "../utils/debug_utils.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+
+namespace ump {
+
+namespace {
+    constexpr size_t kDefaultFrameBytes = size_t(3840) * 2160 * 4 * 2;  // 4K RGBA half until measured
+}
+
+ReadAheadPlanner::ReadAheadPlanner() {
+    Reset(0);
+}
+
+void ReadAheadPlanner::Reset(size_t bytesPerFrameHint) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    avgLoadMs_ = 0.0;
+    avgBytes_ = 0.0;
+    avgFileBytes_ = 0.0;
+    fileSamples_ = 0;
+    samples_ = 0;
+    bytesHint_ = bytesPerFrameHint > 0 ? bytesPerFrameHint : kDefaultFrameBytes;
+
+    // Loads from the previous sequence may still finish - keep 'running_' consistent
+    lastChange_ = Clock::now();
+    windowBusySec_ = 0.0;
+    windowLoadSec_ = 0.0;
+    windowCompleted_ = 0;
+    measuredFps_ = 0.0;
+    measuredConcurrency_ = 0.0;
+
+    plan_ = Plan();
+    plan_.bytesPerFrame = bytesHint_;
+}
+
+void ReadAheadPlanner::AccumulateBusyLocked(Clock::time_point now) {
+    if (running_ > 0) {
+        const double dt = std::chrono::duration<double>(now - lastChange_).count();
+        windowBusySec_ += dt;
+        windowLoadSec_ += dt * running_;
+    }
+    lastChange_ = now;
+}
+
+void ReadAheadPlanner::OnLoadStarted() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    AccumulateBusyLocked(Clock::now());
+    running_++;
+}
+
+void ReadAheadPlanner::OnLoadFinished(double loadMs, size_t bytes, bool completed, size_t fileBytes) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    AccumulateBusyLocked(Clock::now());
+    running_ = std::max(0, running_ - 1);
+
+    // Cancelled loads still occupied a worker, but say nothing about frame cost
+    if (!completed) {
+        return;
+    }
+
+    windowCompleted_++;
+    samples_++;
+    if (samples_ == 1) {
+        avgLoadMs_ = loadMs;
+        avgBytes_ = static_cast<double>(bytes);
+    } else {
+        avgLoadMs_ += (loadMs - avgLoadMs_) * kSmoothing;
+        avgBytes_ += (static_cast<double>(bytes) - avgBytes_) * kSmoothing;
+    }
+    if (fileBytes > 0) {
+        fileSamples_++;
+        avgFileBytes_ = (fileSamples_ == 1) ? static_cast<double>(fileBytes)
+                                            : avgFileBytes_ + (fileBytes - avgFileBytes_) * kSmoothing;
+    }
+
+    // Close a throughput sample once enough busy time has accumulated
+    if (windowBusySec_ >= kMeasureWindowSec) {
+        const double fps = windowCompleted_ / windowBusySec_;
+        const double concurrency = windowLoadSec_ / windowBusySec_;
+        const bool first = (measuredFps_ == 0.0);
+        measuredFps_ = first ? fps : measuredFps_ + (fps - measuredFps_) * 0.3;
+        measuredConcurrency_ = first ? concurrency
+                                     : measuredConcurrency_ + (concurrency - measuredConcurrency_) * 0.3;
+        windowBusySec_ = 0.0;
+        windowLoadSec_ = 0.0;
+        windowCompleted_ = 0;
+    }
+}
+
+ReadAheadPlanner::Plan ReadAheadPlanner::Update(const Inputs& inputs) {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    Plan plan;
+    plan.samples = samples_;
+    plan.bytesPerFrame = samples_ > 0 ? static_cast<size_t>(avgBytes_) : bytesHint_;
+    plan.bytesPerFrame = std::max<size_t>(plan.bytesPerFrame, 1);
+    plan.avgLoadMs = avgLoadMs_;
+    plan.measuredFps = measuredFps_;
+    plan.avgConcurrency = measuredConcurrency_;
+    plan.fileBytesPerFrame = static_cast<size_t>(avgFileBytes_);
+
+    const double fps = inputs.fps > 0.0 ? inputs.fps : 24.0;
+    const int concurrency = std::max(1, inputs.concurrency);
+    const int totalFrames = std::max(1, inputs.totalFrames);
+
+    // Everything ahead of the playhead that fits in the budget next to read-behind
+    const int budgetFrames = static_cast<int>(inputs.cacheBytes / plan.bytesPerFrame);
+    const int budgetAhead = std::clamp(budgetFrames - inputs.readBehindFrames, 1, totalFrames);
+    plan.keepAheadFrames = budgetAhead;
+
+    if (samples_ == 0 || avgLoadMs_ <= 0.0) {
+        // Nothing measured yet: ~3 seconds, like the old fixed window
+        plan.readAheadFrames = std::min(budgetAhead, static_cast<int>(std::ceil(fps * 3.0)));
+        plan.realtimeWarning = plan_.realtimeWarning;
+        plan.advice = plan_.advice;
+        plan_ = plan;
+        return plan;
+    }
+
+    // Capacity: latency x parallelism. Once the loads have actually run near
+    // full parallelism, the measured rate is the better number (it includes
+    // disk contention the per-load latency hides at low occupancy)
+    plan.predictedFps = concurrency * 1000.0 / avgLoadMs_;
+    const bool saturated = measuredFps_ > 0.0 && measuredConcurrency_ >= 0.75 * concurrency;
+    plan.sustainableFps = saturated ? measuredFps_ : plan.predictedFps;
+    plan.realtimeRatio = plan.sustainableFps / fps;
+    plan.realtime = plan.realtimeRatio >= 1.0;
+
+    if (plan.realtime) {
+        // Cover two load latencies plus a margin, and keep every worker fed
+        const double leadSec = 2.0 * avgLoadMs_ / 1000.0 + kLeadSeconds;
+        plan.readAheadFrames = std::max(static_cast<int>(std::ceil(fps * leadSec)), 2 * concurrency);
+    } else {
+        // Can't keep up: buffer as much as the budget allows to delay the stall
+        plan.readAheadFrames = budgetAhead;
+    }
+    plan.readAheadFrames = std::clamp(plan.readAheadFrames, 1, budgetAhead);
+
+    if (!plan.realtime) {
+        plan.secondsUntilStall = plan.readAheadFrames / (fps - plan.sustainableFps);
+    }
+
+    // Page-cache warming past the read-ahead window: files are consumed at
+    // min(fps, sustainable rate), so hint what that rate uses in the next lead
+    // time plus one load latency. Bounded so the hinted files stay a small
+    // fraction of the budget, and skipped when the window already covers the rest.
+    if (avgFileBytes_ > 0.0) {
+        plan.readMBps = plan.sustainableFps * avgFileBytes_ / (1024.0 * 1024.0);
+        const double rate = std::min(fps, plan.sustainableFps);
+        const double leadSec = kPageCacheLeadSec + avgLoadMs_ / 1000.0;
+        const size_t budgetBytes = std::min(kPageCacheMaxBytes, inputs.cacheBytes / 8);
+        const int budgetFiles = static_cast<int>(budgetBytes / std::max(avgFileBytes_, 1.0));
+        const int remaining = totalFrames - plan.readAheadFrames;
+        plan.pageCacheFrames = std::clamp(std::max(static_cast<int>(std::ceil(rate * leadSec)), concurrency),
+                                          0, std::max(0, std::min(budgetFiles, remaining)));
+    }
+
+    // Hysteresis so the warning doesn't flicker around 1.0x
+    plan.realtimeWarning = plan_.realtimeWarning;
+    if (!plan.realtimeWarning && samples_ >= kMinSamples && plan.realtimeRatio < kWarnBelow) {
+        plan.realtimeWarning = true;
+        Debug::Log("ReadAheadPlanner: Realtime playback not sustainable - " +
+                   std::to_string(plan.sustainableFps) + " of " + std::to_string(fps) + " fps (" +
+                   std::to_string(static_cast<int>(avgLoadMs_)) + "ms/frame x " +
+                   std::to_string(concurrency) + " loads)");
+    } else if (plan.realtimeWarning && plan.realtimeRatio > kClearAbove) {
+        plan.realtimeWarning = false;
+        Debug::Log("ReadAheadPlanner: Realtime playback sustainable again (" +
+                   std::to_string(plan.sustainableFps) + " fps)");
+    }
+
+    if (plan.realtimeWarning) {
+        char buffer[256];
+        std::snprintf(buffer, sizeof(buffer),
+                      "Loads sustain %.1f of %.1f fps (%.0fms/frame) - transcode to a faster "
+                      "compression or use a proxy for realtime playback",
+                      plan.sustainableFps, fps, avgLoadMs_);
+        plan.advice = buffer;
+    }
+
+    plan_ = plan;
+    return plan;
+}
+
+ReadAheadPlanner::Plan ReadAheadPlanner::GetPlan() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return plan_;
+}
+
+size_t ReadAheadPlanner::GetBytesPerFrame() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return samples_ > 0 ? std::max<size_t>(static_cast<size_t>(avgBytes_), 1) : bytesHint_;
+}
+
+} // namespace ump
@@ -0,0 +1,116 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+
+namespace ump {
+
+//=============================================================================
+// ReadAheadPlanner - sizes the cache fill from measured load throughput
+//
+// DirectEXRCache used fixed numbers (72 frames after a seek, 180 kept ahead,
+// a 4K half-float size estimate) that fit neither a 2K JPEG sequence nor a
+// 31-channel DWAB EXR. The planner measures what the sequence actually costs:
+// - per-frame load latency (decode time on a worker, EMA)
+// - bytes per frame
+// - load throughput while loads are running, and how many ran in parallel
+// - file bytes per frame, for the read bandwidth the loads achieve
+// and turns that into a plan the cache thread re-reads every tick: how far
+// ahead to prefetch, how far ahead to keep, how many files to warm in the
+// page cache past that, and whether the sequence can be played in realtime
+// at all (if not, it suggests a transcode or proxy).
+//
+// Thread-safe: load tasks report, the cache thread updates, the UI reads.
+//=============================================================================
+
+class ReadAheadPlanner {
+public:
+    struct Inputs {
+        double fps = 24.0;
+        size_t cacheBytes = 0;        // Pixel cache budget
+        int readBehindFrames = 0;     // Configured read-behind
+        int concurrency = 1;          // Parallel loads allowed (threadCount vs scheduler cap)
+        int totalFrames = 0;
+    };
+
+    struct Plan {
+        // Decisions
+        int readAheadFrames = 72;     // Prefetch horizon ahead of the playhead
+        int keepAheadFrames = 180;    // Cached frames beyond this are evicted
+        size_t bytesPerFrame = 0;     // For in-flight budget accounting
+        int pageCacheFrames = 0;      // Files to hint to the OS past readAheadFrames (0 = none)
+
+        // Predicted vs actual
+        double avgLoadMs = 0.0;       // Measured per-frame load latency
+        double predictedFps = 0.0;    // concurrency / latency
+        double measuredFps = 0.0;     // Frames completed per second while loading (0 = no sample yet)
+        double avgConcurrency = 0.0;  // Loads running in parallel during the measurement
+        double sustainableFps = 0.0;  // Rate the plan assumes
+        double realtimeRatio = 0.0;   // sustainableFps / sequence fps
+        size_t fileBytesPerFrame = 0; // Compressed size on disk (0 = unknown)
+        double readMBps = 0.0;        // File bytes/s at sustainableFps
+        uint64_t samples = 0;
+
+        // Realtime verdict
+        bool realtime = true;
+        bool realtimeWarning = false;     // Sustained deficit (hysteresis applied)
+        double secondsUntilStall = 0.0;   // From a full read-ahead buffer, when !realtime
+        std::string advice;               // Transcode/proxy suggestion when warning
+    };
+
+    ReadAheadPlanner();
+
+    // New sequence: drop measurements, seed the frame size (0 = keep default)
+    void Reset(size_t bytesPerFrameHint);
+
+    // Called by load tasks around the actual decode
+    void OnLoadStarted();
+    // fileBytes = size on disk (0 = unknown)
+    void OnLoadFinished(double loadMs, size_t bytes, bool completed, size_t fileBytes = 0);
+
+    // Recompute the plan (cache thread, every tick)
+    Plan Update(const Inputs& inputs);
+
+    Plan GetPlan() const;
+    size_t GetBytesPerFrame() const;
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    void AccumulateBusyLocked(Clock::time_point now);
+
+    static constexpr double kSmoothing = 0.1;          // EMA weight for new samples
+    static constexpr double kMeasureWindowSec = 1.0;   // Busy time per throughput sample
+    static constexpr double kLeadSeconds = 1.0;        // Safety margin beyond load latency
+    static constexpr double kWarnBelow = 0.95;         // realtimeRatio hysteresis
+    static constexpr double kClearAbove = 1.05;
+    static constexpr uint64_t kMinSamples = 8;
+    static constexpr double kPageCacheLeadSec = 1.0;   // Warm this much playback past read-ahead
+    static constexpr size_t kPageCacheMaxBytes = size_t(2) << 30;  // Never hint more than 2GB
+
+    mutable std::mutex mutex_;
+
+    // Measurements
+    double avgLoadMs_ = 0.0;
+    double avgBytes_ = 0.0;
+    double avgFileBytes_ = 0.0;
+    uint64_t fileSamples_ = 0;
+    uint64_t samples_ = 0;
+    size_t bytesHint_ = 0;
+
+    // Throughput while busy (at least one load running)
+    int running_ = 0;
+    Clock::time_point lastChange_;
+    double windowBusySec_ = 0.0;
+    double windowLoadSec_ = 0.0;      // Integral of running loads over busy time
+    int windowCompleted_ = 0;
+    double measuredFps_ = 0.0;
+    double measuredConcurrency_ = 0.0;
+
+    Plan plan_;
+};
+
+} // namespace ump
@@ -0,0 +1,334 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+namespace ump {
+
+//=============================================================================
+// ShardedLRU - O(1) byte-budgeted LRU for the frame caches
+//
+// Replaces SimpleLRU (std::map + std::list::remove, one global mutex).
+// - Keys are spread over kShardCount shards, each with its own mutex, hash
+//   index and intrusive doubly-linked recency list -> Touch/Add/Remove are O(1)
+// - Recency is global: every touch stamps the node with a tick, eviction picks
+//   the shard whose LRU tail has the oldest tick (O(shards) per eviction)
+// - Contains() for non-negative integral keys (frame numbers) reads an atomic
+//   presence bitmap and never takes a lock
+// - Byte accounting and the eviction callback behave like SimpleLRU: the
+//   callback runs before the value is dropped, under that entry's shard lock
+//=============================================================================
+
+template<typename K, typename V, typename Hash = std::hash<K>>
+class ShardedLRU {
+public:
+    using EvictionCallback = std::function<void(const K& key, const V& value)>;
+
+    static constexpr size_t kShardCount = 16;
+
+    ShardedLRU() = default;
+    ~ShardedLRU() { Clear(); }
+
+    ShardedLRU(const ShardedLRU&) = delete;
+    ShardedLRU& operator=(const ShardedLRU&) = delete;
+
+    void SetMaxSize(size_t bytes) {
+        maxBytes_.store(bytes, std::memory_order_relaxed);
+        EvictToBudget();
+    }
+    size_t GetMaxSize() const { return maxBytes_.load(std::memory_order_relaxed); }
+    size_t GetSize() const { return currentBytes_.load(std::memory_order_relaxed); }
+    size_t GetCount() const { return count_.load(std::memory_order_relaxed); }
+
+    // Must be set before the cache is shared between threads
+    void SetEvictionCallback(EvictionCallback callback) { evictionCallback_ = std::move(callback); }
+
+    bool Contains(const K& key) const {
+        int bit = presence_.Test(key);
+        if (bit >= 0) return bit != 0;
+
+        const Shard& shard = ShardFor(key);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        return shard.index.find(key) != shard.index.end();
+    }
+
+    bool Get(const K& key, V& value) {
+        Shard& shard = ShardFor(key);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        auto it = shard.index.find(key);
+        if (it == shard.index.end()) return false;
+        value = it->second->value;
+        Touch(shard, it->second);
+        return true;
+    }
+
+    bool Get(const K& key, V& value) const {
+        return Peek(key, value);  // Don't touch in const version
+    }
+
+    // Peek without updating LRU (for playback - don't keep old frames fresh)
+    bool Peek(const K& key, V& value) const {
+        const Shard& shard = ShardFor(key);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        auto it = shard.index.find(key);
+        if (it == shard.index.end()) return false;
+        value = it->second->value;
+        return true;
+    }
+
+    void Add(const K& key, const V& value, size_t bytes) {
+        {
+            Shard& shard = ShardFor(key);
+            std::lock_guard<std::mutex> lock(shard.mutex);
+
+            auto it = shard.index.find(key);
+            if (it != shard.index.end()) {
+                // Replace in place
+                Node* node = it->second;
+                currentBytes_.fetch_sub(node->bytes, std::memory_order_relaxed);
+                node->value = value;
+                node->bytes = bytes;
+                currentBytes_.fetch_add(bytes, std::memory_order_relaxed);
+                Touch(shard, node);
+            } else {
+                Node* node = new Node{key, value, bytes, 0, nullptr, nullptr};
+                shard.index.emplace(key, node);
+                LinkBack(shard, node);
+                node->tick = NextTick();
+                currentBytes_.fetch_add(bytes, std::memory_order_relaxed);
+                count_.fetch_add(1, std::memory_order_relaxed);
+                presence_.Set(key, true);
+            }
+        }
+
+        // Evict outside the insert lock: eviction locks shards one at a time
+        EvictToBudget();
+    }
+
+    void Clear() {
+        for (auto& shard : shards_) {
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            Node* node = shard.head;
+            while (node) {
+                Node* next = node->next;
+                presence_.Set(node->key, false);
+                currentBytes_.fetch_sub(node->bytes, std::memory_order_relaxed);
+                count_.fetch_sub(1, std::memory_order_relaxed);
+                delete node;
+                node = next;
+            }
+            shard.head = shard.tail = nullptr;
+            shard.index.clear();
+        }
+    }
+
+    // Re-charge an entry (a shared value's full size moving to another holder)
+    bool SetBytes(const K& key, size_t bytes) {
+        {
+            Shard& shard = ShardFor(key);
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            auto it = shard.index.find(key);
+            if (it == shard.index.end()) return false;
+            Node* node = it->second;
+            currentBytes_.fetch_sub(node->bytes, std::memory_order_relaxed);
+            node->bytes = bytes;
+            currentBytes_.fetch_add(bytes, std::memory_order_relaxed);
+        }
+
+        EvictToBudget();
+        return true;
+    }
+
+    // Remove without returning the value (for eviction without texture deletion callback)
+    void Remove(const K& key) {
+        V unused;
+        RemoveAndGet(key, unused);
+    }
+
+    // Remove and return the value (so caller can extract GL texture ID for deletion)
+    bool RemoveAndGet(const K& key, V& value) {
+        Shard& shard = ShardFor(key);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        auto it = shard.index.find(key);
+        if (it == shard.index.end()) return false;
+        Node* node = it->second;
+        value = std::move(node->value);
+        shard.index.erase(it);
+        Erase(shard, node);
+        return true;
+    }
+
+    // Snapshot of resident keys (unordered). Locks one shard at a time.
+    std::vector<K> GetKeys() const {
+        std::vector<K> keys;
+        keys.reserve(GetCount());
+        for (const auto& shard : shards_) {
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            for (Node* node = shard.head; node; node = node->next) {
+                keys.push_back(node->key);
+            }
+        }
+        return keys;
+    }
+
+private:
+    struct Node {
+        K key;
+        V value;
+        size_t bytes;
+        uint64_t tick;   // Global recency stamp (higher = more recent)
+        Node* prev;
+        Node* next;
+    };
+
+    // Recency list: head = least recently used, tail = most recently used
+    struct Shard {
+        mutable std::mutex mutex;
+        std::unordered_map<K, Node*, Hash> index;
+        Node* head = nullptr;
+        Node* tail = nullptr;
+    };
+
+    //=========================================================================
+    // Lock-free presence bitmap for non-negative integral keys.
+    // Two-level: a fixed table of lazily allocated 64K-bit pages, so it
+    // never reallocates under a concurrent reader. Keys outside the covered
+    // range (or non-integral keys) report "unknown" and fall back to a lookup.
+    //=========================================================================
+    class PresenceBitmap {
+    public:
+        ~PresenceBitmap() {
+            for (auto& page : pages_) delete[] page.load(std::memory_order_relaxed);
+        }
+
+        // 1 = present, 0 = absent, -1 = not tracked
+        int Test(const K& key) const {
+            if constexpr (std::is_integral_v<K>) {
+                if (key < 0 || static_cast<uint64_t>(key) >= kMaxKeys) return -1;
+                const auto k = static_cast<uint64_t>(key);
+                const std::atomic<uint64_t>* page = pages_[k >> kPageShift].load(std::memory_order_acquire);
+                if (!page) return 0;
+                const uint64_t word = page[(k & kPageMask) >> 6].load(std::memory_order_acquire);
+                return (word >> (k & 63)) & 1 ? 1 : 0;
+            } else {
+                (void)key;
+                return -1;
+            }
+        }
+
+        // Called under the owning shard's lock
+        void Set(const K& key, bool present) {
+            if constexpr (std::is_integral_v<K>) {
+                if (key < 0 || static_cast<uint64_t>(key) >= kMaxKeys) return;
+                const auto k = static_cast<uint64_t>(key);
+                std::atomic<uint64_t>* page = pages_[k >> kPageShift].load(std::memory_order_acquire);
+                if (!page) {
+                    if (!present) return;
+                    auto* fresh = new std::atomic<uint64_t>[kWordsPerPage];
+                    for (size_t i = 0; i < kWordsPerPage; ++i) fresh[i].store(0, std::memory_order_relaxed);
+                    if (pages_[k >> kPageShift].compare_exchange_strong(page, fresh, std::memory_order_acq_rel)) {
+                        page = fresh;
+                    } else {
+                        delete[] fresh;  // Another shard won the race; 'page' now holds its pointer
+                    }
+                }
+                const uint64_t mask = uint64_t(1) << (k & 63);
+                auto& word = page[(k & kPageMask) >> 6];
+                if (present) word.fetch_or(mask, std::memory_order_release);
+                else word.fetch_and(~mask, std::memory_order_release);
+            } else {
+                (void)key;
+                (void)present;
+            }
+        }
+
+    private:
+        static constexpr uint64_t kPageShift = 16;                      // 65536 keys per page
+        static constexpr uint64_t kPageMask = (uint64_t(1) << kPageShift) - 1;
+        static constexpr size_t kWordsPerPage = size_t(1) << (kPageShift - 6);
+        static constexpr size_t kPageCount = 1024;                      // Covers keys [0, 64M)
+        static constexpr uint64_t kMaxKeys = uint64_t(kPageCount) << kPageShift;
+
+        std::array<std::atomic<std::atomic<uint64_t>*>, kPageCount> pages_{};
+    };
+
+    Shard& ShardFor(const K& key) { return shards_[Hash{}(key) % kShardCount]; }
+    const Shard& ShardFor(const K& key) const { return shards_[Hash{}(key) % kShardCount]; }
+
+    uint64_t NextTick() { return tick_.fetch_add(1, std::memory_order_relaxed) + 1; }
+
+    static void Unlink(Shard& shard, Node* node) {
+        if (node->prev) node->prev->next = node->next; else shard.head = node->next;
+        if (node->next) node->next->prev = node->prev; else shard.tail = node->prev;
+        node->prev = node->next = nullptr;
+    }
+
+    static void LinkBack(Shard& shard, Node* node) {
+        node->prev = shard.tail;
+        node->next = nullptr;
+        if (shard.tail) shard.tail->next = node; else shard.head = node;
+        shard.tail = node;
+    }
+
+    void Touch(Shard& shard, Node* node) {
+        node->tick = NextTick();
+        if (shard.tail == node) return;
+        Unlink(shard, node);
+        LinkBack(shard, node);
+    }
+
+    // Node must already be removed from shard.index; caller holds shard lock
+    void Erase(Shard& shard, Node* node) {
+        Unlink(shard, node);
+        presence_.Set(node->key, false);
+        currentBytes_.fetch_sub(node->bytes, std::memory_order_relaxed);
+        count_.fetch_sub(1, std::memory_order_relaxed);
+        delete node;
+    }
+
+    void EvictToBudget() {
+        while (currentBytes_.load(std::memory_order_relaxed) > maxBytes_.load(std::memory_order_relaxed)) {
+            // Find the shard holding the globally oldest entry
+            size_t victim = kShardCount;
+            uint64_t oldest = std::numeric_limits<uint64_t>::max();
+            for (size_t i = 0; i < kShardCount; ++i) {
+                std::lock_guard<std::mutex> lock(shards_[i].mutex);
+                if (shards_[i].head && shards_[i].head->tick < oldest) {
+                    oldest = shards_[i].head->tick;
+                    victim = i;
+                }
+            }
+            if (victim == kShardCount) return;  // Empty
+
+            Shard& shard = shards_[victim];
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            Node* node = shard.head;
+            if (!node) continue;  // Raced with another evictor - rescan
+
+            // Call eviction callback BEFORE erasing (so callback can access the value)
+            if (evictionCallback_) {
+                evictionCallback_(node->key, node->value);
+            }
+            shard.index.erase(node->key);
+            Erase(shard, node);
+        }
+    }
+
+    std::array<Shard, kShardCount> shards_;
+    PresenceBitmap presence_;
+    std::atomic<size_t> maxBytes_{0};
+    std::atomic<size_t> currentBytes_{0};
+    std::atomic<size_t> count_{0};
+    std::atomic<uint64_t> tick_{0};
+    EvictionCallback evictionCallback_;
+};
+
+} // namespace ump
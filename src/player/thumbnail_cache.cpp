@@ -1,5 +1,6 @@
 #include "thumbnail_cache.h"
 #include "../utils/debug_utils.h"
+#include "../utils/task_scheduler.h"
 #include <algorithm>
 #include <cmath>
 #include <glad/gl.h>
@@ -38,27 +39,21 @@ ThumbnailCache::ThumbnailCache(
         return;
     }
 
-    // Start background worker thread
-    worker_thread_ = std::thread(&ThumbnailCache::WorkerThread, this);
-    Debug::Log("ThumbnailCache: Started async worker thread");
+    // Generation runs as tasks on the shared TaskScheduler (thumbnail class)
+    Debug::Log("ThumbnailCache: Using shared task scheduler for generation");
 }
 
 ThumbnailCache::~ThumbnailCache() {
-    Debug::Log("ThumbnailCache: Destructor - stopping worker thread");
-
-    // Signal shutdown and wake worker thread
-    Debug::Log("ThumbnailCache: Setting shutdown flag to true");
-    shutdown_.store(true);
-    Debug::Log("ThumbnailCache: Notifying worker thread to wake up");
-    queue_cv_.notify_all();
-
-    // Wait for worker thread to finish
-    if (worker_thread_.joinable()) {
-        Debug::Log("ThumbnailCache: Waiting for worker thread to join (this may block if thread is stuck)...");
-        worker_thread_.join();
-        Debug::Log("ThumbnailCache: Worker thread joined successfully");
-    } else {
-        Debug::Log("ThumbnailCache: Worker thread was not joinable");
+    Debug::Log("ThumbnailCache: Destructor - stopping generation task");
+
+    // Signal shutdown; the drain task finishes its current frame and does not re-post
+    {
+        std::unique_lock<std::mutex> lock(queue_mutex_);
+        shutdown_.store(true);
+        if (worker_active_) {
+            Debug::Log("ThumbnailCache: Waiting for in-flight generation task...");
+        }
+        queue_cv_.wait(lock, [this]() { return !worker_active_; });
     }
 
     Debug::Log("ThumbnailCache: Clearing cache...");
@@ -95,7 +90,7 @@ GLuint ThumbnailCache::GetThumbnail(int frame, bool allow_fallback) {
         if (requested_frames_.find(frame) == requested_frames_.end()) {
             request_queue_.push({frame, RequestPriority::HIGH});
             requested_frames_.insert(frame);
-            queue_cv_.notify_one();  // Wake worker thread
+            ScheduleWorkLocked();
         }
     }
 
@@ -124,47 +119,49 @@ void ThumbnailCache::CancelPendingRequests() {
     requested_frames_.clear();
 }
 
-// Worker thread function - runs in background
-void ThumbnailCache::WorkerThread() {
-    Debug::Log("ThumbnailCache: Worker thread started");
-
-    while (!shutdown_.load()) {
-        int frame = -1;
-
-        // Wait for work
-        {
-            std::unique_lock<std::mutex> lock(queue_mutex_);
-            queue_cv_.wait(lock, [this]() {
-                return shutdown_.load() || !request_queue_.empty();
-            });
-
-            if (shutdown_.load()) break;
+// Post a drain task if none is running (caller holds queue_mutex_)
+// One task at a time per cache: loaders (e.g. VideoImageLoader) are not thread-safe
+void ThumbnailCache::ScheduleWorkLocked() {
+    if (worker_active_ || shutdown_.load() || request_queue_.empty()) {
+        return;
+    }
+    worker_active_ = true;
+    TaskScheduler::Shared().Post(TaskPriority::Thumbnail, [this]() { ProcessNextRequest(); });
+}
 
-            if (!request_queue_.empty()) {
-                // Get highest priority request
-                ThumbnailRequest req = request_queue_.top();
-                request_queue_.pop();
-                frame = req.frame;
-            }
+// Generate one thumbnail, then re-post so higher-priority work can run in between
+void ThumbnailCache::ProcessNextRequest() {
+    int frame = -1;
+    {
+        std::lock_guard<std::mutex> lock(queue_mutex_);
+        if (!shutdown_.load() && !request_queue_.empty()) {
+            // Get highest priority request
+            ThumbnailRequest req = request_queue_.top();
+            request_queue_.pop();
+            frame = req.frame;
         }
+    }
 
-        // Generate thumbnail pixels (CPU-only, no GL calls)
-        if (frame >= 0) {
-            auto pending = GenerateThumbnailPixels(frame);
-
-            if (pending) {
-                // Add to pending uploads queue for main thread
-                std::lock_guard<std::mutex> lock(queue_mutex_);
-                pending_uploads_.push(std::move(pending));
-            }
+    // Generate thumbnail pixels (CPU-only, no GL calls)
+    std::unique_ptr<PendingThumbnail> pending;
+    if (frame >= 0) {
+        pending = GenerateThumbnailPixels(frame);
+    }
 
-            // Remove from requested set
-            std::lock_guard<std::mutex> lock(queue_mutex_);
-            requested_frames_.erase(frame);
-        }
+    std::lock_guard<std::mutex> lock(queue_mutex_);
+    if (pending) {
+        // Add to pending uploads queue for main thread
+        pending_uploads_.push(std::move(pending));
+    }
+    if (frame >= 0) {
+        requested_frames_.erase(frame);
     }
 
-    Debug::Log("ThumbnailCache: Worker thread stopped");
+    worker_active_ = false;
+    ScheduleWorkLocked();
+    if (!worker_active_) {
+        queue_cv_.notify_all();  // Destructor may be waiting
+    }
 }
 
 // Generate thumbnail pixel data (runs on background thread)
@@ -204,7 +201,7 @@ std::unique_ptr<PendingThumbnail> ThumbnailCache::GenerateThumbnailPixels(int fr
     }
 
     // Allocate buffer for resized thumbnail
-    std::vector<uint8_t> thumbnail_pixels;
+    PixelBuffer thumbnail_pixels;
     GLenum thumbnail_gl_type;
 
     if (pixel_data->gl_type == GL_HALF_FLOAT) {
@@ -215,8 +212,9 @@ std::unique_ptr<PendingThumbnail> ThumbnailCache::GenerateThumbnailPixels(int fr
         thumbnail_gl_type = GL_HALF_FLOAT;
 
         // Convert half → float for stb_image_resize (which doesn't support half directly)
-        std::vector<float> source_float(source_width * source_height * 4);
-        std::vector<float> thumb_float(thumb_width * thumb_height * 4);
+        // Pooled scratch: skips the zero-fill and reuses the buffer for the next thumbnail
+        std::vector<float, PooledFrameAllocator<float>> source_float(source_width * source_height * 4);
+        std::vector<float, PooledFrameAllocator<float>> thumb_float(thumb_width * thumb_height * 4);
 
         const Imath::half* src_half = reinterpret_cast<const Imath::half*>(pixel_data->pixels.data());
         for (size_t i = 0; i < source_float.size(); i++) {
@@ -269,7 +267,7 @@ std::unique_ptr<PendingThumbnail> ThumbnailCache::GenerateThumbnailPixels(int fr
         thumbnail_pixels.resize(thumb_width * thumb_height * 4);
         thumbnail_gl_type = GL_UNSIGNED_BYTE;
 
-        std::vector<uint8_t> source_8bit(source_width * source_height * 4);
+        PixelBuffer source_8bit(source_width * source_height * 4);
         const uint16_t* source_16 = reinterpret_cast<const uint16_t*>(pixel_data->pixels.data());
         for (size_t i = 0; i < source_8bit.size(); i++) {
             source_8bit[i] = static_cast<uint8_t>(source_16[i] >> 8);
@@ -296,37 +294,48 @@ std::unique_ptr<PendingThumbnail> ThumbnailCache::GenerateThumbnailPixels(int fr
     pending->gl_format = GL_RGBA;
     pending->gl_type = thumbnail_gl_type;  // GL_HALF_FLOAT for EXR, GL_UNSIGNED_BYTE for others
 
+    // Copy into the upload ring while still on the worker (falls back to pixels if full)
+    UploadFormat format;
+    format.width = pending->width;
+    format.height = pending->height;
+    format.internal_format = StorageInternalFormat(pending->gl_format, pending->gl_type);
+    format.format = pending->gl_format;
+    format.type = pending->gl_type;
+    pending->staged = TextureUploader::Shared().Stage(format, pending->pixels.data());
+    if (pending->staged) {
+        pending->pixels = PixelBuffer();
+    }
+
     return pending;
 }
 
 // Create GL texture from pixels (runs on main thread only)
 GLuint ThumbnailCache::CreateGLTexture(const PendingThumbnail& pending) {
+    TextureUploader& uploader = TextureUploader::Shared();
     GLuint texture_id = 0;
-    glGenTextures(1, &texture_id);
+    if (pending.staged) {
+        texture_id = uploader.Upload(pending.staged);
+    } else {
+        UploadFormat format;
+        format.width = pending.width;
+        format.height = pending.height;
+        format.internal_format = StorageInternalFormat(pending.gl_format, pending.gl_type);
+        format.format = pending.gl_format;
+        format.type = pending.gl_type;
+        texture_id = uploader.UploadNow(format, pending.pixels.data());
+    }
+
     if (texture_id == 0) {
         Debug::Log("ThumbnailCache: Failed to create GL texture for frame " + std::to_string(pending.frame));
         generation_failures_++;
         return 0;
     }
 
-    // Select internal format based on pixel type
-    GLenum internal_format = (pending.gl_type == GL_HALF_FLOAT) ? GL_RGBA16F : GL_RGBA8;
-
-    glBindTexture(GL_TEXTURE_2D, texture_id);
-    glTexImage2D(GL_TEXTURE_2D, 0, internal_format, pending.width, pending.height, 0,
-                 pending.gl_format, pending.gl_type, pending.pixels.data());
-
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-
-    glBindTexture(GL_TEXTURE_2D, 0);
-
     return texture_id;
 }
 
 // Process pending uploads (MUST be called from main/GL thread)
+// Shares the per-frame upload budget with the frame caches - the rest waits for next frame
 void ThumbnailCache::ProcessPendingUploads() {
     std::queue<std::unique_ptr<PendingThumbnail>> uploads_to_process;
 
@@ -344,8 +353,9 @@ void ThumbnailCache::ProcessPendingUploads() {
                std::to_string(uploads_to_process.size()) + " pending thumbnails");*/
 
     // Process uploads (create GL textures and add to cache)
+    TextureUploader& uploader = TextureUploader::Shared();
     int uploaded_count = 0;
-    while (!uploads_to_process.empty()) {
+    while (!uploads_to_process.empty() && uploader.HasFrameBudget()) {
         auto pending = std::move(uploads_to_process.front());
         uploads_to_process.pop();
 
@@ -373,6 +383,16 @@ void ThumbnailCache::ProcessPendingUploads() {
         }
     }
 
+    // Out of budget - put the remainder back ahead of anything queued meanwhile
+    if (!uploads_to_process.empty()) {
+        std::lock_guard<std::mutex> lock(queue_mutex_);
+        while (!pending_uploads_.empty()) {
+            uploads_to_process.push(std::move(pending_uploads_.front()));
+            pending_uploads_.pop();
+        }
+        pending_uploads_.swap(uploads_to_process);
+    }
+
    /* Debug::Log("ThumbnailCache::ProcessPendingUploads: Uploaded " + std::to_string(uploaded_count) +
                " thumbnails, cache now has " + std::to_string(cache_.size()) + " entries");*/
 }
@@ -419,7 +439,7 @@ ThumbnailCache::Stats ThumbnailCache::GetStats() const {
 
 void ThumbnailCache::ClearCache() {
     std::lock_guard<std::mutex> lock(cache_mutex_);
-    cache_.clear();  // Unique_ptr destructors will delete GL textures
+    cache_.clear();  // Unique_ptr destructors hand GL textures back to the uploader
 
     // Reset stats
     cache_hits_ = 0;
@@ -480,10 +500,7 @@ void ThumbnailCache::PrefetchStrategicFrames(int total_frames) {
             }
         }
 
-        // Wake worker thread if needed
-        if (!prefetch_frames.empty()) {
-            queue_cv_.notify_one();
-        }
+        ScheduleWorkLocked();
     }
 
     Debug::Log("ThumbnailCache: Queued " + std::to_string(prefetch_frames.size()) +
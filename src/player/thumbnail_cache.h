@@ -12,6 +12,7 @@
 #include <queue>
 #include <glad/gl.h>
 #include "image_loader_interface.h"
+#include "../gpu/texture_uploader.h"
 
 namespace ump {
 
@@ -34,7 +35,7 @@ struct ThumbnailEntry {
 
     ~ThumbnailEntry() {
         if (texture_id != 0) {
-            glDeleteTextures(1, &texture_id);
+            TextureUploader::Shared().ReleaseTexture(texture_id);  // Recycled for the next thumbnail
             texture_id = 0;
         }
     }
@@ -45,9 +46,10 @@ struct PendingThumbnail {
     int frame = 0;
     int width = 0;
     int height = 0;
-    std::vector<uint8_t> pixels;  // Raw pixel data (format determined by gl_type)
+    PixelBuffer pixels;           // Raw pixel data (format determined by gl_type)
     GLenum gl_format = GL_RGBA;   // Always GL_RGBA
     GLenum gl_type = GL_UNSIGNED_BYTE;  // GL_UNSIGNED_BYTE (8-bit) or GL_HALF_FLOAT (16-bit HDR)
+    std::shared_ptr<StagedUpload> staged;  // Pixels already copied into the upload ring (pixels then empty)
 };
 
 /**
@@ -56,7 +58,7 @@ struct PendingThumbnail {
  * Features:
  * - RAM-only caching (no disk persistence)
  * - LRU eviction when cache is full
- * - ASYNC generation on background thread (non-blocking UI)
+ * - ASYNC generation on the shared TaskScheduler (non-blocking UI)
  * - Works with all IImageLoader formats (EXR/TIFF/PNG/JPEG)
  * - Configurable thumbnail size and cache capacity
  * - Thread-safe GL texture upload on main thread
@@ -143,8 +145,9 @@ public:
     void ClearCache();
 
 private:
-    // Background worker thread function
-    void WorkerThread();
+    // Background generation (runs as TaskScheduler tasks, one at a time)
+    void ScheduleWorkLocked();
+    void ProcessNextRequest();
 
     // Generate thumbnail pixel data (runs on background thread)
     std::unique_ptr<PendingThumbnail> GenerateThumbnailPixels(int frame);
@@ -193,8 +196,8 @@ private:
     std::unordered_set<int> requested_frames_;  // Deduplication set
     std::queue<std::unique_ptr<PendingThumbnail>> pending_uploads_;  // Ready for GL upload
     std::mutex queue_mutex_;
-    std::condition_variable queue_cv_;
-    std::thread worker_thread_;
+    std::condition_variable queue_cv_;   // Signalled when the drain task goes idle
+    bool worker_active_ = false;         // Drain task posted/running (guarded by queue_mutex_)
     std::atomic<bool> shutdown_{false};
 
     // Statistics
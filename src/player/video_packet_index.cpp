@@ -0,0 +1,402 @@
+#include "video_packet_index.h"
+#include "../utils/content_hash.h"
+#include "../utils/debug_utils.h"
+#include "../utils/task_scheduler.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+
+extern "C" {
+#include <libavcodec/avcodec.h>
+#include <libavformat/avformat.h>
+}
+
+namespace ump {
+
+namespace {
+    constexpr char kMagic[8] = { 'U', 'M', 'P', 'P', 'I', 'D', 'X', '2' };
+
+    template<typename T>
+    void WriteValue(std::ofstream& out, const T& value) {
+        out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    template<typename T>
+    bool ReadValue(std::ifstream& in, T& value) {
+        return static_cast<bool>(in.read(reinterpret_cast<char*>(&value), sizeof(T)));
+    }
+
+    int64_t PresentationTimestamp(const VideoPacketIndex::Packet& packet) {
+        return packet.pts != AV_NOPTS_VALUE ? packet.pts : packet.dts;
+    }
+}
+
+//=============================================================================
+// VideoPacketIndex
+//=============================================================================
+
+std::shared_ptr<VideoPacketIndex> VideoPacketIndex::Build(const std::string& path) {
+    AVFormatContext* format_context = nullptr;
+    if (avformat_open_input(&format_context, path.c_str(), nullptr, nullptr) < 0) {
+        return nullptr;
+    }
+    if (avformat_find_stream_info(format_context, nullptr) < 0) {
+        avformat_close_input(&format_context);
+        return nullptr;
+    }
+
+    const int stream_index = av_find_best_stream(format_context, AVMEDIA_TYPE_VIDEO, -1, -1, nullptr, 0);
+    if (stream_index < 0) {
+        avformat_close_input(&format_context);
+        return nullptr;
+    }
+
+    // Demux only: other streams are dropped by the demuxer
+    for (unsigned int i = 0; i < format_context->nb_streams; ++i) {
+        if (static_cast<int>(i) != stream_index) {
+            format_context->streams[i]->discard = AVDISCARD_ALL;
+        }
+    }
+
+    auto index = std::make_shared<VideoPacketIndex>();
+    const AVStream* stream = format_context->streams[stream_index];
+    index->time_base_num_ = stream->time_base.num;
+    index->time_base_den_ = stream->time_base.den;
+    index->time_base_ = av_q2d(stream->time_base);
+    if (stream->nb_frames > 0) {
+        index->packets_.reserve(static_cast<size_t>(stream->nb_frames));
+    }
+
+    AVPacket* packet = av_packet_alloc();
+    while (packet && av_read_frame(format_context, packet) >= 0) {
+        if (packet->stream_index == stream_index) {
+            Packet entry;
+            entry.pts = packet->pts;
+            entry.dts = packet->dts;
+            entry.pos = packet->pos;
+            entry.size = packet->size;
+            entry.keyframe = (packet->flags & AV_PKT_FLAG_KEY) != 0;
+            index->packets_.push_back(entry);
+        }
+        av_packet_unref(packet);
+    }
+    av_packet_free(&packet);
+    avformat_close_input(&format_context);
+
+    index->Finalize();
+    if (index->FrameCount() == 0 || index->FrameCount() * 2 < static_cast<int>(index->packets_.size())) {
+        return nullptr;  // Raw elementary streams: too few timestamps to order frames
+    }
+    return index;
+}
+
+void VideoPacketIndex::Finalize() {
+    frame_pts_.clear();
+    keyframes_.clear();
+    keyframe_seek_.clear();
+
+    frame_pts_.reserve(packets_.size());
+    for (const Packet& packet : packets_) {
+        const int64_t pts = PresentationTimestamp(packet);
+        if (pts != AV_NOPTS_VALUE) {
+            frame_pts_.push_back(pts);
+        }
+    }
+    std::sort(frame_pts_.begin(), frame_pts_.end());
+    frame_pts_.erase(std::unique(frame_pts_.begin(), frame_pts_.end()), frame_pts_.end());
+
+    frame_packets_.assign(frame_pts_.size(), -1);
+    for (size_t i = 0; i < packets_.size(); ++i) {
+        const int64_t pts = PresentationTimestamp(packets_[i]);
+        const int frame = pts != AV_NOPTS_VALUE ? FrameAtPts(pts) : -1;
+        if (frame >= 0 && frame_packets_[frame] < 0) {
+            frame_packets_[frame] = static_cast<int>(i);
+        }
+    }
+
+    std::vector<std::pair<int, int64_t>> keyframes;
+    for (const Packet& packet : packets_) {
+        const int64_t pts = PresentationTimestamp(packet);
+        if (!packet.keyframe || pts == AV_NOPTS_VALUE) {
+            continue;
+        }
+        const int frame = FrameAtPts(pts);
+        const int64_t seek = packet.dts != AV_NOPTS_VALUE ? (std::min)(pts, packet.dts) : pts;
+        keyframes.emplace_back(frame, seek);
+    }
+    std::sort(keyframes.begin(), keyframes.end());
+    for (const auto& keyframe : keyframes) {
+        if (keyframes_.empty() || keyframes_.back() != keyframe.first) {
+            keyframes_.push_back(keyframe.first);
+            keyframe_seek_.push_back(keyframe.second);
+        }
+    }
+}
+
+int64_t VideoPacketIndex::FramePts(int frame) const {
+    if (frame_pts_.empty()) {
+        return 0;
+    }
+    return frame_pts_[std::clamp(frame, 0, FrameCount() - 1)];
+}
+
+double VideoPacketIndex::FrameTime(int frame) const {
+    return FramePts(frame) * time_base_;
+}
+
+int VideoPacketIndex::FrameAtTime(double seconds) const {
+    if (frame_pts_.empty()) {
+        return 0;
+    }
+    const int64_t pts = static_cast<int64_t>(std::llround(seconds / time_base_));
+    auto it = std::lower_bound(frame_pts_.begin(), frame_pts_.end(), pts);
+    if (it == frame_pts_.end()) {
+        return FrameCount() - 1;
+    }
+    if (it != frame_pts_.begin() && pts - *std::prev(it) <= *it - pts) {
+        --it;
+    }
+    return static_cast<int>(it - frame_pts_.begin());
+}
+
+int VideoPacketIndex::FrameAtPts(int64_t pts) const {
+    auto it = std::lower_bound(frame_pts_.begin(), frame_pts_.end(), pts);
+    return (it != frame_pts_.end() && *it == pts) ? static_cast<int>(it - frame_pts_.begin()) : -1;
+}
+
+const VideoPacketIndex::Packet* VideoPacketIndex::FramePacket(int frame) const {
+    if (frame < 0 || frame >= FrameCount() || frame_packets_[frame] < 0) {
+        return nullptr;
+    }
+    return &packets_[frame_packets_[frame]];
+}
+
+int VideoPacketIndex::GopStart(int frame) const {
+    auto it = std::upper_bound(keyframes_.begin(), keyframes_.end(), frame);
+    return it != keyframes_.begin() ? *std::prev(it) : 0;
+}
+
+int VideoPacketIndex::GopEnd(int frame) const {
+    auto it = std::upper_bound(keyframes_.begin(), keyframes_.end(), frame);
+    return it != keyframes_.end() ? *it : -1;
+}
+
+int64_t VideoPacketIndex::SeekTimestamp(int frame) const {
+    auto it = std::upper_bound(keyframes_.begin(), keyframes_.end(), frame);
+    if (it == keyframes_.begin()) {
+        return frame_pts_.empty() ? 0 : frame_pts_.front();
+    }
+    return keyframe_seek_[(it - keyframes_.begin()) - 1];
+}
+
+bool VideoPacketIndex::Save(const std::string& file, const std::string& source_path,
+                            uint64_t source_size, int64_t source_mtime) const {
+    // Written aside and renamed: a reader never sees a partial index
+    const std::string temp = file + ".tmp";
+    {
+        std::ofstream out(temp, std::ios::binary | std::ios::trunc);
+        if (!out) {
+            return false;
+        }
+        out.write(kMagic, sizeof(kMagic));
+        WriteValue(out, source_size);
+        WriteValue(out, source_mtime);
+        WriteValue(out, static_cast<uint32_t>(source_path.size()));
+        out.write(source_path.data(), static_cast<std::streamsize>(source_path.size()));
+        WriteValue(out, static_cast<int32_t>(time_base_num_));
+        WriteValue(out, static_cast<int32_t>(time_base_den_));
+        WriteValue(out, static_cast<uint64_t>(packets_.size()));
+        for (const Packet& packet : packets_) {
+            WriteValue(out, packet.pts);
+            WriteValue(out, packet.dts);
+            WriteValue(out, packet.pos);
+            WriteValue(out, packet.size);
+            WriteValue(out, static_cast<uint8_t>(packet.keyframe ? 1 : 0));
+        }
+        if (!out) {
+            return false;
+        }
+    }
+
+    std::error_code ec;
+    std::filesystem::rename(temp, file, ec);
+    if (ec) {
+        std::filesystem::remove(temp, ec);
+        return false;
+    }
+    return true;
+}
+
+std::shared_ptr<VideoPacketIndex> VideoPacketIndex::Load(const std::string& file, const std::string& source_path,
+                                                         uint64_t source_size, int64_t source_mtime) {
+    std::ifstream in(file, std::ios::binary);
+    if (!in) {
+        return nullptr;
+    }
+
+    char magic[sizeof(kMagic)] = {};
+    uint64_t size = 0;
+    int64_t mtime = 0;
+    uint32_t path_length = 0;
+    if (!in.read(magic, sizeof(magic)) || !std::equal(magic, magic + sizeof(magic), kMagic) ||
+        !ReadValue(in, size) || !ReadValue(in, mtime) || !ReadValue(in, path_length) ||
+        size != source_size || mtime != source_mtime || path_length != source_path.size()) {
+        return nullptr;
+    }
+    std::string path(path_length, '\0');
+    if (!in.read(&path[0], path_length) || path != source_path) {
+        return nullptr;     // Hash collision with another file's index
+    }
+
+    auto index = std::make_shared<VideoPacketIndex>();
+    int32_t num = 0;
+    int32_t den = 0;
+    uint64_t count = 0;
+    if (!ReadValue(in, num) || !ReadValue(in, den) || !ReadValue(in, count) || num <= 0 || den <= 0 ||
+        count > source_size) {
+        return nullptr;
+    }
+    index->time_base_num_ = num;
+    index->time_base_den_ = den;
+    index->time_base_ = static_cast<double>(num) / den;
+
+    index->packets_.resize(static_cast<size_t>(count));
+    for (Packet& packet : index->packets_) {
+        uint8_t keyframe = 0;
+        if (!ReadValue(in, packet.pts) || !ReadValue(in, packet.dts) ||
+            !ReadValue(in, packet.pos) || !ReadValue(in, packet.size) || !ReadValue(in, keyframe)) {
+            return nullptr;
+        }
+        packet.keyframe = keyframe != 0;
+    }
+
+    index->Finalize();
+    return index->FrameCount() > 0 ? index : nullptr;
+}
+
+//=============================================================================
+// VideoIndexStore
+//=============================================================================
+
+VideoIndexStore& VideoIndexStore::Shared() {
+    // Never destroyed: indexing tasks may still be running during static destruction
+    static VideoIndexStore* store = new VideoIndexStore();
+    return *store;
+}
+
+VideoIndexStore::VideoIndexStore() {
+    SetCacheDirectory("");
+}
+
+void VideoIndexStore::SetCacheDirectory(const std::string& custom_path) {
+    std::filesystem::path root;
+    if (!custom_path.empty()) {
+        root = custom_path;
+    } else if (const char* localappdata = std::getenv("LOCALAPPDATA")) {
+        root = std::filesystem::path(localappdata) / "ump";
+    } else {
+        std::error_code ec;
+        root = std::filesystem::temp_directory_path(ec) / "ump";
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    directory_ = (root / "video_index").string();
+}
+
+std::string VideoIndexStore::IndexFilePath(const std::string& path, uint64_t size, int64_t mtime) const {
+    const uint64_t key[3] = { HashBytes(path.data(), path.size()), size, static_cast<uint64_t>(mtime) };
+    char name[32];
+    std::snprintf(name, sizeof(name), "%016llx.pidx", static_cast<unsigned long long>(HashBytes(key, sizeof(key))));
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    return (std::filesystem::path(directory_) / name).string();
+}
+
+void VideoIndexStore::Request(const std::string& path) {
+    std::error_code ec;
+    const uint64_t size = std::filesystem::file_size(path, ec);
+    if (ec) {
+        return;
+    }
+    const int64_t mtime = std::filesystem::last_write_time(path, ec).time_since_epoch().count();
+    if (ec) {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = entries_.find(path);
+        if (it != entries_.end() && it->second.size == size && it->second.mtime == mtime &&
+            (it->second.pending || it->second.index || it->second.failed)) {
+            return;
+        }
+
+        if (it == entries_.end() && entries_.size() >= kMaxIndexes) {
+            for (auto e = entries_.begin(); e != entries_.end(); ++e) {
+                if (!e->second.pending) {
+                    entries_.erase(e);
+                    break;
+                }
+            }
+        }
+
+        Entry& entry = entries_[path];
+        entry.index.reset();
+        entry.size = size;
+        entry.mtime = mtime;
+        entry.pending = true;
+        entry.failed = false;
+    }
+
+    TaskScheduler::Shared().Post(TaskPriority::Metadata, [this, path, size, mtime]() {
+        LoadOrBuild(path, size, mtime);
+    });
+}
+
+std::shared_ptr<const VideoPacketIndex> VideoIndexStore::Get(const std::string& path) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = entries_.find(path);
+    return it != entries_.end() ? it->second.index : nullptr;
+}
+
+void VideoIndexStore::LoadOrBuild(const std::string& path, uint64_t size, int64_t mtime) {
+    const std::string file = IndexFilePath(path, size, mtime);
+    const auto start = std::chrono::steady_clock::now();
+
+    std::shared_ptr<VideoPacketIndex> index = VideoPacketIndex::Load(file, path, size, mtime);
+    const bool loaded = index != nullptr;
+    if (!index) {
+        index = VideoPacketIndex::Build(path);
+        if (index) {
+            std::error_code ec;
+            std::filesystem::create_directories(std::filesystem::path(file).parent_path(), ec);
+            if (!index->Save(file, path, size, mtime)) {
+                Debug::Log("VideoIndexStore: Failed to write index for " + path);
+            }
+        }
+    }
+
+    const double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    if (index) {
+        Debug::Log("VideoIndexStore: " + std::string(loaded ? "Loaded" : "Built") + " index for " + path + " - " +
+                   std::to_string(index->FrameCount()) + " frames, " + std::to_string(index->KeyframeCount()) +
+                   " keyframes in " + std::to_string(static_cast<int>(ms)) + "ms");
+    } else {
+        Debug::Log("VideoIndexStore: No usable packet index for " + path);
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = entries_.find(path);
+    if (it != entries_.end() && it->second.size == size && it->second.mtime == mtime) {
+        it->second.failed = !index;
+        it->second.index = std::move(index);
+        it->second.pending = false;
+    }
+}
+
+} // namespace ump
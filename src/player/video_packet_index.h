@@ -0,0 +1,125 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace ump {
+
+//=============================================================================
+// VideoPacketIndex - every video packet of a file, from one demux pass
+//
+// Frame-accurate video access used to rest on timestamp arithmetic (frame / fps)
+// and trial seeking: VFR material maps to the wrong frames, and finding a
+// frame's GOP meant seeking and decoding until the right timestamp showed up.
+// The index records each video packet's pts/dts, keyframe flag and byte offset
+// (demux only - nothing is decoded), and derives:
+// - Frame N in presentation order and its exact pts (VFR safe)
+// - GOP boundaries: the keyframe each frame decodes from, and the next one
+// - A seek timestamp that lands av_seek_frame(BACKWARD) on that keyframe
+// Times are stream seconds (pts * time base), like the players' timestamps.
+//=============================================================================
+
+class VideoPacketIndex {
+public:
+    struct Packet {
+        int64_t pts = 0;        // AV_NOPTS_VALUE when the container has none
+        int64_t dts = 0;
+        int64_t pos = -1;       // Byte offset in the file (-1 unknown)
+        int32_t size = 0;
+        bool keyframe = false;
+    };
+
+    // Demuxes 'path' once; nullptr if it has no video stream or its packets carry no timestamps
+    static std::shared_ptr<VideoPacketIndex> Build(const std::string& path);
+
+    // On-disk form, validated against the source file's size and mtime
+    static std::shared_ptr<VideoPacketIndex> Load(const std::string& file, const std::string& source_path,
+                                                  uint64_t source_size, int64_t source_mtime);
+    bool Save(const std::string& file, const std::string& source_path,
+              uint64_t source_size, int64_t source_mtime) const;
+
+    int FrameCount() const { return static_cast<int>(frame_pts_.size()); }
+    int KeyframeCount() const { return static_cast<int>(keyframes_.size()); }
+    const std::vector<Packet>& Packets() const { return packets_; }     // Decode order
+    double TimeBase() const { return time_base_; }
+
+    // Every frame is a keyframe: any frame decodes on its own
+    bool IsIntraOnly() const { return !frame_pts_.empty() && keyframes_.size() == frame_pts_.size(); }
+
+    // Packet holding 'frame' (nullptr out of range)
+    const Packet* FramePacket(int frame) const;
+
+    // Frames in presentation order (frame is clamped to the file)
+    int64_t FramePts(int frame) const;
+    double FrameTime(int frame) const;
+    int FrameAtTime(double seconds) const;      // Frame whose timestamp is nearest
+    int FrameAtPts(int64_t pts) const;          // -1 if no frame has exactly this pts
+
+    // GOPs: the keyframe 'frame' decodes from, the first keyframe after it (-1 in
+    // the last GOP), and the stream timestamp av_seek_frame(BACKWARD) lands there with
+    int GopStart(int frame) const;
+    int GopEnd(int frame) const;
+    int64_t SeekTimestamp(int frame) const;
+
+private:
+    void Finalize();    // Presentation order and keyframes from packets_
+
+    int time_base_num_ = 1;
+    int time_base_den_ = 1;
+    double time_base_ = 1.0;
+    std::vector<Packet> packets_;
+    std::vector<int64_t> frame_pts_;            // Sorted
+    std::vector<int> frame_packets_;            // Per frame: its index in packets_
+    std::vector<int> keyframes_;                // Frame numbers, ascending
+    std::vector<int64_t> keyframe_seek_;        // Per keyframe: min(pts, dts) of its packet
+};
+
+//=============================================================================
+// VideoIndexStore - one index per file, built once and kept on disk
+//
+// Request() returns immediately: the index is read from the on-disk store
+// (keyed by path + size + mtime) or built by a demux pass on the shared
+// TaskScheduler. Until it is ready Get() returns nullptr and callers keep their
+// timestamp arithmetic. Reopening a file loads its index instead of rebuilding.
+//=============================================================================
+
+class VideoIndexStore {
+public:
+    static VideoIndexStore& Shared();
+
+    // Start loading/building the index for 'path' (no-op when current)
+    void Request(const std::string& path);
+
+    // Index of 'path' once ready, else nullptr
+    std::shared_ptr<const VideoPacketIndex> Get(const std::string& path) const;
+
+    // Same root as the other disk caches (empty = %LOCALAPPDATA%/ump)
+    void SetCacheDirectory(const std::string& custom_path);
+
+private:
+    VideoIndexStore();
+
+    struct Entry {
+        std::shared_ptr<const VideoPacketIndex> index;
+        uint64_t size = 0;
+        int64_t mtime = 0;
+        bool pending = false;
+        bool failed = false;    // Not indexable - not retried until the file changes
+    };
+
+    std::string IndexFilePath(const std::string& path, uint64_t size, int64_t mtime) const;
+    void LoadOrBuild(const std::string& path, uint64_t size, int64_t mtime);
+
+    static constexpr size_t kMaxIndexes = 64;
+
+    mutable std::mutex mutex_;
+    std::unordered_map<std::string, Entry> entries_;
+    std::string directory_;
+};
+
+} // namespace ump
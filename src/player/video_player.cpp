@@ -7,6 +7,7 @@
 #include "direct_exr_cache.h"
 #include "image_loaders.h"  // For TIFF/PNG/JPEG loaders
 #include "thumbnail_cache.h"
+#include "video_packet_index.h"
 
 #include <algorithm>
 #include <chrono>
@@ -806,19 +807,32 @@ void VideoPlayer::UpdateFastSeek() {
     double seek_amount = 0.1 * fast_seek_speed;
     if (!fast_forward) seek_amount = -seek_amount;
 
-    double new_pos = cached_position + seek_amount;
+    // Trick play advances its own target: keyframe seeks land on the keyframe
+    // before it, so stepping from the landed position would never get past a long GOP
+    double new_pos = (IsTrickPlay() ? fast_seek_position : cached_position) + seek_amount;
     if (new_pos < 0) new_pos = 0;
     if (new_pos > cached_duration) new_pos = cached_duration;
 
-    Seek(new_pos);
+    if (IsTrickPlay()) {
+        fast_seek_position = new_pos;
+        std::string pos_str = std::to_string(new_pos);
+        const char* cmd[] = { "seek", pos_str.c_str(), "absolute", "keyframes", nullptr };
+        mpv_command_async(mpv, 0, cmd);
+    } else {
+        Seek(new_pos);
+    }
+}
 
-    // Gradually increase speed
-    static int frame_counter = 0;
-    frame_counter++;
-    if (frame_counter > 60 && fast_seek_speed < 8) {
-        fast_seek_speed++;
-        frame_counter = 0;
+void VideoPlayer::UpdateFastSeekSpeed() {
+    if (!is_fast_seeking) return;
+
+    // Gradually increase speed: one step per second held
+    auto held = std::chrono::duration_cast<std::chrono::seconds>(std::chrono::steady_clock::now() - fast_seek_start);
+    int speed = (std::min)(8, 1 + static_cast<int>(held.count()));
+    if (speed >= kTrickPlaySpeed && fast_seek_speed < kTrickPlaySpeed) {
+        fast_seek_position = cached_position;
     }
+    fast_seek_speed = speed;
 }
 
 // ============================================================================
@@ -1229,6 +1243,13 @@ void VideoPlayer::RenderVideoTexture() {
         return;
     }
 
+    // Mipmapped EXR sequences load the level matching the on-screen size
+    if (is_exr_mode && exr_cache_) {
+        const ImVec2 scale = ImGui::GetIO().DisplayFramebufferScale;
+        exr_cache_->SetDisplaySize(static_cast<int>(image_size.x * scale.x),
+                                   static_cast<int>(image_size.y * scale.y));
+    }
+
     // Display the texture
     ImGui::Image((void*)(intptr_t)display_texture, image_size);
 }
@@ -1313,6 +1334,213 @@ void VideoPlayer::RenderControls() {
         } else {
             ImGui::Text("Background Processing: Inactive");
         }
+
+        // Adaptive I/O concurrency: loads allowed in flight for this storage
+        const auto& io = cache_stats.ioConcurrency;
+        ImGui::Text("I/O Concurrency: %zu in flight / limit %zu [%zu-%zu]%s, %.0fms (base %.0fms), %.0f MB/s",
+                    io.in_flight, io.limit, io.min_limit, io.max_limit, io.enabled ? "" : " fixed",
+                    io.avg_latency_ms, io.baseline_latency_ms, io.throughput_mbps);
+
+        // Simulated NAS (also UMP_SIMULATE_STORAGE): with it on, the limit should
+        // settle near the knee and drop back when the bandwidth is lowered
+        ump::ThrottledStorageSimulator& storage = ump::ThrottledStorageSimulator::Shared();
+        auto sim = storage.GetSettings();
+        bool simulate = sim.enabled;
+        if (ImGui::Checkbox("Simulate Slow Storage", &simulate)) {
+            if (sim.mbps <= 0.0) {
+                sim.base_ms = 20.0;
+                sim.mbps = 400.0;
+                sim.knee = 4;
+            }
+            storage.Configure(sim.base_ms, simulate ? sim.mbps : 0.0, sim.knee);
+        }
+        if (sim.enabled) {
+            float base_ms = static_cast<float>(sim.base_ms);
+            float mbps = static_cast<float>(sim.mbps);
+            int knee = sim.knee;
+            bool changed = ImGui::SliderFloat("Latency (ms)##SimStorage", &base_ms, 0.0f, 100.0f, "%.0f");
+            changed |= ImGui::SliderFloat("Bandwidth (MB/s)##SimStorage", &mbps, 25.0f, 2000.0f, "%.0f");
+            changed |= ImGui::SliderInt("Knee (reads)##SimStorage", &knee, 1, 16);
+            if (changed) {
+                storage.Configure(base_ms, mbps, knee);
+            }
+        }
+
+        // Read-ahead planner: predicted vs measured load throughput
+        const auto& plan = cache_stats.readAhead;
+        ImGui::Text("Read-Ahead: %d frames (keep %d), %zu MB/frame",
+                    plan.readAheadFrames, plan.keepAheadFrames, plan.bytesPerFrame / (1024 * 1024));
+        if (plan.samples > 0) {
+            ImGui::Text("Throughput: %.1f fps predicted / %.1f measured (%.0fms/frame, %.1f parallel) = %.2fx realtime",
+                        plan.predictedFps, plan.measuredFps, plan.avgLoadMs, plan.avgConcurrency,
+                        plan.realtimeRatio);
+        }
+
+        // OS page-cache warming past the read-ahead window
+        const auto& pc = cache_stats.pageCache;
+        if (pc.supported) {
+            ImGui::Text("Page Cache: %d files ahead (%d hinted), %.1f MB/file, %.0f MB/s read, %llu hinted / %llu released",
+                        pc.window, pc.outstanding, plan.fileBytesPerFrame / (1024.0 * 1024.0), plan.readMBps,
+                        (unsigned long long)pc.hintedFiles, (unsigned long long)pc.releasedFiles);
+        }
+        if (plan.realtimeWarning) {
+            ImGui::TextColored(ImVec4(1.0f, 0.5f, 0.3f, 1.0f), "%s (stall after ~%.0fs)",
+                               plan.advice.c_str(), plan.secondsUntilStall);
+        }
+
+        // Frame file reads: backend in use, and a side-by-side benchmark on this sequence
+        const auto& rd = cache_stats.reader;
+        const auto& backendReads = rd.reads[static_cast<int>(rd.backend)];
+        ImGui::Text("Frame Reads: %s%s, %llu files, %.1fms avg",
+                    ump::ReadBackendName(rd.backend), rd.directIO ? " O_DIRECT" : "",
+                    static_cast<unsigned long long>(backendReads.files),
+                    backendReads.files > 0 ? backendReads.totalMs / backendReads.files : 0.0);
+        ump::FrameFileReader& reader = ump::FrameFileReader::Shared();
+        ImGui::SameLine();
+        if (reader.IsBenchmarkRunning()) {
+            ImGui::TextDisabled("(benchmarking...)");
+        } else if (ImGui::SmallButton("Benchmark##ReadBackends")) {
+            std::vector<std::string> files = exr_cache_->GetSequenceFiles();
+            files.resize(std::min<size_t>(files.size(), 48));
+            reader.StartBenchmark(std::move(files), static_cast<int>(exr_cache_->GetConfig().threadCount));
+        }
+        for (const auto& result : reader.GetBenchmarkResults()) {
+            ImGui::Text("  %-8s%-9s %6.0f MB/s, %5.1f files/s%s",
+                        ump::ReadBackendName(result.backend), result.directIO ? " O_DIRECT" : "",
+                        result.mbps, result.filesPerSec, result.ok ? "" : " (errors)");
+        }
+
+        // EXR header layouts reused across the frames of a sequence
+        const auto& hl = cache_stats.headerLayouts;
+        ImGui::Text("Header Layouts: %zu sequences, %llu frames reused, %llu parsed (%llu changed)",
+                    hl.sequences, static_cast<unsigned long long>(hl.hits),
+                    static_cast<unsigned long long>(hl.builds + hl.mismatches),
+                    static_cast<unsigned long long>(hl.mismatches));
+
+        // Mipmapped sequences: stored level matching the on-screen size
+        if (cache_stats.resolutionLevels > 1) {
+            ImGui::Text("Mip Level: %d of %d (1/%d resolution on screen)",
+                        cache_stats.zoomLevel, cache_stats.resolutionLevels - 1, 1 << cache_stats.zoomLevel);
+        }
+
+        // Draft playback: reduced resolution while decode can't keep up
+        ImGui::Text("Draft Playback: %s, %llu draft loads, %llu upgraded to finer",
+                    cache_stats.draftLevel == 0 ? "full resolution" :
+                    cache_stats.draftLevel == 1 ? "1/2 resolution" : "1/4 resolution",
+                    static_cast<unsigned long long>(cache_stats.draftLoads),
+                    static_cast<unsigned long long>(cache_stats.draftUpgrades));
+
+        // Deduplication: identical files sharing one decoded buffer / texture
+        if (exr_cache_->GetConfig().dedupFrames) {
+            ImGui::Text("Shared Frames: %d (%.1f MB saved), %d shared textures, %llu confirmed / %llu rejected",
+                        cache_stats.dedupFrames, cache_stats.dedupBytes / (1024.0 * 1024.0),
+                        cache_stats.sharedTextures,
+                        static_cast<unsigned long long>(cache_stats.dedup.confirmed),
+                        static_cast<unsigned long long>(cache_stats.dedup.rejected));
+        }
+
+        // Compressed tier: evicted frames kept deflated, decompressed on a hit
+        const auto& ct = cache_stats.compressedTier;
+        if (ct.enabled) {
+            ImGui::Text("Compressed Tier: %d frames, %.1f / %.1f GB (%.2fx), %llu hits",
+                        ct.frames, ct.bytes / (1024.0 * 1024.0 * 1024.0), ct.maxBytes / (1024.0 * 1024.0 * 1024.0),
+                        ct.ratio, static_cast<unsigned long long>(ct.hits));
+            ImGui::Text("  decompress %.1fms, compress %.1fms per frame, %llu skipped (queue full)",
+                        ct.avgDecompressMs, ct.avgCompressMs, static_cast<unsigned long long>(ct.dropped));
+        }
+
+        // Multi-layer caching: inactive layers decoded alongside the active one
+        if (cache_stats.cachedLayers > 1) {
+            ImGui::Text("Layers: %d cached per frame, %d inactive frames (%.1f MB)",
+                        cache_stats.cachedLayers, cache_stats.layerFrames,
+                        cache_stats.layerBytes / (1024.0 * 1024.0));
+        }
+
+        // Overscan frames: per-scanline vs chunk-aligned decode of the windowed files
+        ImGui::Text("Windowed Decode:");
+        ImGui::SameLine();
+        if (exr_cache_->IsWindowReadBenchmarkRunning()) {
+            ImGui::TextDisabled("(benchmarking...)");
+        } else if (ImGui::SmallButton("Benchmark##WindowRead")) {
+            exr_cache_->StartWindowReadBenchmark(24);
+        }
+        const auto window_bench = exr_cache_->GetWindowReadBenchmark();
+        if (window_bench.files > 0) {
+            if (window_bench.windowedFiles == 0) {
+                ImGui::Text("  no overscan frames in %d files", window_bench.files);
+            } else {
+                ImGui::Text("  %d frames: per-scanline %.1fms, blocks %.1fms per frame (%.1fx)%s",
+                            window_bench.windowedFiles,
+                            window_bench.scanlineMs / window_bench.windowedFiles,
+                            window_bench.blockMs / window_bench.windowedFiles,
+                            window_bench.blockMs > 0.0 ? window_bench.scanlineMs / window_bench.blockMs : 0.0,
+                            window_bench.ok ? "" : " (errors)");
+            }
+        }
+
+        // Pixel cache LRU: sharded against the single-mutex map + list it replaced
+        ImGui::Text("Cache LRU:");
+        ImGui::SameLine();
+        if (exr_cache_->IsLRUBenchmarkRunning()) {
+            ImGui::TextDisabled("(benchmarking...)");
+        } else if (ImGui::SmallButton("Benchmark##LRU")) {
+            exr_cache_->StartLRUBenchmark();
+        }
+        const auto lru_bench = exr_cache_->GetLRUBenchmark();
+        if (lru_bench.ok && lru_bench.operations > 0) {
+            ImGui::Text("  %d threads, %d frames: map + list %.0fns, sharded %.0fns per op (%.1fx)",
+                        lru_bench.threads, lru_bench.entries,
+                        lru_bench.listMs * 1e6 / lru_bench.operations,
+                        lru_bench.shardedMs * 1e6 / lru_bench.operations,
+                        lru_bench.shardedMs > 0.0 ? lru_bench.listMs / lru_bench.shardedMs : 0.0);
+        }
+
+        // Seek responsiveness: time from seek to the target frame being cached
+        if (cache_stats.seekCount > 0) {
+            ImGui::Text("Seek First Frame: %.0fms (avg %.0fms over %llu seeks, %llu loads cancelled)",
+                        cache_stats.lastSeekFirstFrameMs, cache_stats.avgSeekFirstFrameMs,
+                        static_cast<unsigned long long>(cache_stats.seekCount),
+                        static_cast<unsigned long long>(cache_stats.cancelledLoads));
+        }
+
+        // Frame buffer pool: reuse rate of recycled frame buffers
+        const auto& pool = cache_stats.bufferPool;
+        ImGui::Text("Buffer Pool: %zu MB idle / %zu MB (%llu reused, %llu allocated)",
+                    pool.pooled_bytes / (1024 * 1024), pool.max_pooled_bytes / (1024 * 1024),
+                    static_cast<unsigned long long>(pool.hits),
+                    static_cast<unsigned long long>(pool.misses));
+
+        // Texture uploads: PBO ring occupancy and main-thread time per frame
+        const auto& up = cache_stats.uploader;
+        ImGui::Text("Uploads: %.1f / %.1fms per frame, ring %zu / %zu MB, %d staged (%llu ring, %llu direct, %llu ring full)",
+                    up.last_frame_ms, up.budget_ms,
+                    up.ring_used_bytes / (1024 * 1024), up.ring_bytes / (1024 * 1024),
+                    cache_stats.stagedFrames,
+                    static_cast<unsigned long long>(up.staged_uploads),
+                    static_cast<unsigned long long>(up.direct_uploads),
+                    static_cast<unsigned long long>(up.stage_failures));
+        ump::TextureUploader& uploader = ump::TextureUploader::Shared();
+        ImGui::SameLine();
+        if (ImGui::SmallButton("Self-check##Uploads")) {
+            uploader.RunSelfCheck();
+        }
+        const auto& upload_check = uploader.GetLastSelfCheck();
+        if (upload_check.ran) {
+            ImGui::TextColored(upload_check.ok ? ImVec4(0.5f, 1.0f, 0.5f, 1.0f) : ImVec4(1.0f, 0.5f, 0.3f, 1.0f),
+                               "  %s %d/%d (%s, %s clear)%s%s",
+                               upload_check.ok ? "Passed" : "FAILED", upload_check.passed, upload_check.total,
+                               upload_check.ring ? "PBO ring" : "direct only",
+                               upload_check.clear_texture ? "glClearTexImage + FBO" : "FBO",
+                               upload_check.failure.empty() ? "" : " - ", upload_check.failure.c_str());
+        }
+
+        // Shared task scheduler: queue depth and latency per priority class
+        ImGui::Text("Task Scheduler:");
+        for (const auto& cls : cache_stats.scheduler) {
+            ImGui::Text("  %-9s %zu queued, %zu/%zu running, wait %.1fms (max %.0fms), run %.1fms",
+                        cls.name.c_str(), cls.queued, cls.running, cls.cap,
+                        cls.avg_queue_ms, cls.max_queue_ms, cls.avg_run_ms);
+        }
     }
 }
 
@@ -4294,6 +4522,9 @@ void VideoPlayer::SetCacheSettings(const std::string& custom_path, int retention
     // Apply to DummyVideoGenerator
     dummy_generator.SetCacheConfig(custom_path, retention_days, dummy_max_gb, clear_on_exit);
 
+    // Video packet indexes live beside the other disk caches
+    ump::VideoIndexStore::Shared().SetCacheDirectory(custom_path);
+
     Debug::Log("VideoPlayer: Disk cache settings updated - retention=" + std::to_string(retention_days) +
               " days, dummy limit=" + std::to_string(dummy_max_gb) + " GB, transcode limit=" +
               std::to_string(transcode_max_gb) + " GB, clear on exit=" + std::string(clear_on_exit ? "ON" : "OFF"));
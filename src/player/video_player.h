@@ -108,10 +108,15 @@ public:
     void StartRewind();
     void StopFastSeek();
     void UpdateFastSeek();
+    void UpdateFastSeekSpeed();     // Ramps while held; call every frame, even when the cache serves frames
     bool IsFastSeeking() const { return is_fast_seeking; }
     bool IsFastForward() const { return fast_forward; }
     int GetFastSeekSpeed() const { return fast_seek_speed; }
 
+    // Trick play: at high shuttle speeds only keyframes are shown
+    static constexpr int kTrickPlaySpeed = 4;   // ~24x at 60 Hz (0.1s per UI frame per speed step)
+    bool IsTrickPlay() const { return is_fast_seeking && fast_seek_speed >= kTrickPlaySpeed; }
+
     // Audio control
     void SetVolume(int vol);        // Legacy int version
     void SetVolume(float volume);   // New float version
@@ -349,6 +354,7 @@ private:
     bool fast_forward = false;  // true = FF, false = RW
     std::chrono::steady_clock::time_point fast_seek_start;
     int fast_seek_speed = 1;    // Multiplier for seek speed
+    double fast_seek_position = 0.0;    // Trick play target (keyframe seeks land short of it)
 
     // Playlist management
     std::function<void()> playlist_position_callback;
@@ -10,6 +10,7 @@
 #include <set>
 #include <regex>
 #include "../utils/debug_utils.h"
+#include "../utils/task_scheduler.h"
 #include <nfd.h>
 #include <nlohmann/json.hpp>
 #include <fstream>
@@ -123,13 +124,13 @@ namespace ump {
                 });
         }
 
-        StartAdobeWorkerThread();
-        StartVideoMetadataWorkerThread();
+        StartAdobeWorker();
+        StartVideoMetadataWorker();
     }
 
     ProjectManager::~ProjectManager() {
-        StopVideoMetadataWorkerThread();
-        StopAdobeWorkerThread();
+        StopVideoMetadataWorker();
+        StopAdobeWorker();
     }
 
     // ============================================================================
@@ -2710,34 +2711,49 @@ namespace ump {
     // METADATA MANAGEMENT
     // ============================================================================
 
-    void ProjectManager::StartAdobeWorkerThread() {
+    // Metadata extraction runs as TaskScheduler tasks (metadata class).
+    // Each queue is drained by at most one task at a time, which re-posts
+    // itself per item so higher-priority work can interleave.
+
+    void ProjectManager::StartAdobeWorker() {
+        std::lock_guard<std::mutex> lock(queue_mutex);
         worker_running = true;
-        adobe_worker_thread = std::thread(&ProjectManager::AdobeWorkerLoop, this);
+        ScheduleAdobeWorkLocked();
     }
 
-    void ProjectManager::StopAdobeWorkerThread() {
+    void ProjectManager::StopAdobeWorker() {
+        std::unique_lock<std::mutex> lock(queue_mutex);
         worker_running = false;
-        if (adobe_worker_thread.joinable()) {
-            adobe_worker_thread.join();
+        adobe_idle_cv.wait(lock, [this] { return !adobe_task_active; });
+    }
+
+    void ProjectManager::ScheduleAdobeWorkLocked() {
+        if (adobe_task_active || !worker_running || adobe_metadata_queue.empty()) {
+            return;
         }
+        adobe_task_active = true;
+        ump::TaskScheduler::Shared().Post(ump::TaskPriority::Metadata, [this]() { ProcessNextAdobeItem(); });
     }
 
-    void ProjectManager::AdobeWorkerLoop() {
-        while (worker_running) {
-            std::string file_path;
-            {
-                std::lock_guard<std::mutex> lock(queue_mutex);
-                if (!adobe_metadata_queue.empty()) {
-                    file_path = adobe_metadata_queue.front();
-                    adobe_metadata_queue.pop();
-                }
+    void ProjectManager::ProcessNextAdobeItem() {
+        std::string file_path;
+        {
+            std::lock_guard<std::mutex> lock(queue_mutex);
+            if (worker_running && !adobe_metadata_queue.empty()) {
+                file_path = adobe_metadata_queue.front();
+                adobe_metadata_queue.pop();
             }
+        }
 
-            if (!file_path.empty()) {
-                ProcessAdobeMetadata(file_path);
-            }
+        if (!file_path.empty()) {
+            ProcessAdobeMetadata(file_path);
+        }
 
-            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        std::lock_guard<std::mutex> lock(queue_mutex);
+        adobe_task_active = false;
+        ScheduleAdobeWorkLocked();
+        if (!adobe_task_active) {
+            adobe_idle_cv.notify_all();
         }
     }
 
@@ -2766,6 +2782,7 @@ namespace ump {
 
         std::lock_guard<std::mutex> lock(queue_mutex);
         adobe_metadata_queue.push(file_path);
+        ScheduleAdobeWorkLocked();
     }
 
     const ProjectManager::CombinedMetadata* ProjectManager::GetCachedMetadata(const std::string& file_path) const {
@@ -2903,47 +2920,51 @@ namespace ump {
         {
             std::lock_guard<std::mutex> lock(video_queue_mutex);
             video_metadata_queue.push({file_path, high_priority});
+            ScheduleVideoMetadataWorkLocked();
         }
 
         // Debug removed
     }
 
-    void ProjectManager::StartVideoMetadataWorkerThread() {
+    void ProjectManager::StartVideoMetadataWorker() {
+        std::lock_guard<std::mutex> lock(video_queue_mutex);
         video_worker_running = true;
-        video_metadata_worker_thread = std::thread(&ProjectManager::VideoMetadataWorkerLoop, this);
-        // Debug removed
+        ScheduleVideoMetadataWorkLocked();
     }
 
-    void ProjectManager::StopVideoMetadataWorkerThread() {
+    void ProjectManager::StopVideoMetadataWorker() {
+        std::unique_lock<std::mutex> lock(video_queue_mutex);
         video_worker_running = false;
-        if (video_metadata_worker_thread.joinable()) {
-            video_metadata_worker_thread.join();
-        }
-        // Debug removed
+        video_idle_cv.wait(lock, [this] { return !video_task_active; });
     }
 
-    void ProjectManager::VideoMetadataWorkerLoop() {
-        while (video_worker_running) {
-            std::string file_path;
-            bool high_priority = false;
+    void ProjectManager::ScheduleVideoMetadataWorkLocked() {
+        if (video_task_active || !video_worker_running || video_metadata_queue.empty()) {
+            return;
+        }
+        video_task_active = true;
+        ump::TaskScheduler::Shared().Post(ump::TaskPriority::Metadata, [this]() { ProcessNextVideoMetadataItem(); });
+    }
 
-            {
-                std::lock_guard<std::mutex> lock(video_queue_mutex);
-                if (!video_metadata_queue.empty()) {
-                    auto item = video_metadata_queue.front();
-                    file_path = item.first;
-                    high_priority = item.second;
-                    video_metadata_queue.pop();
-                }
+    void ProjectManager::ProcessNextVideoMetadataItem() {
+        std::string file_path;
+        {
+            std::lock_guard<std::mutex> lock(video_queue_mutex);
+            if (video_worker_running && !video_metadata_queue.empty()) {
+                file_path = video_metadata_queue.front().first;
+                video_metadata_queue.pop();
             }
+        }
 
-            if (!file_path.empty()) {
-                ProcessVideoMetadata(file_path);
-            }
-            else {
-                // No work to do, sleep briefly
-                std::this_thread::sleep_for(std::chrono::milliseconds(100));
-            }
+        if (!file_path.empty()) {
+            ProcessVideoMetadata(file_path);
+        }
+
+        std::lock_guard<std::mutex> lock(video_queue_mutex);
+        video_task_active = false;
+        ScheduleVideoMetadataWorkLocked();
+        if (!video_task_active) {
+            video_idle_cv.notify_all();
         }
     }
 
@@ -4611,6 +4632,10 @@ namespace ump {
             // Removed: Memory usage aggregation (memory-based eviction removed)
             total_stats.cache_hits += stats.cache_hits;
             total_stats.cache_misses += stats.cache_misses;
+            total_stats.dedup_frames += stats.dedup_frames;
+            total_stats.dedup_bytes += stats.dedup_bytes;
+            total_stats.frames_decoded += stats.frames_decoded;
+            total_stats.frames_delivered += stats.frames_delivered;
         }
         
         if (total_stats.cache_hits + total_stats.cache_misses > 0) {
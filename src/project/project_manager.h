@@ -3,6 +3,7 @@
 #include <algorithm>
 #include <atomic>
 #include <chrono>
+#include <condition_variable>
 #include <cstdlib>
 #include <functional>
 #include <list>
@@ -385,12 +386,14 @@ namespace ump {
         std::unordered_map<std::string, CombinedMetadata> metadata_cache;
         std::queue<std::string> adobe_metadata_queue;
         std::queue<std::pair<std::string, bool>> video_metadata_queue;  // <file_path, high_priority>
-        std::thread adobe_worker_thread;
-        std::thread video_metadata_worker_thread;
         std::mutex queue_mutex;
         std::mutex video_queue_mutex;
         std::atomic<bool> worker_running{ false };
         std::atomic<bool> video_worker_running{ false };
+        bool adobe_task_active = false;         // Drain task posted (guarded by queue_mutex)
+        bool video_task_active = false;         // Drain task posted (guarded by video_queue_mutex)
+        std::condition_variable adobe_idle_cv;
+        std::condition_variable video_idle_cv;
 
         // ========================================================================
         // UI RENDERING HELPERS
@@ -435,16 +438,18 @@ namespace ump {
         // METADATA PROCESSING
         // ========================================================================
 
-        void StartAdobeWorkerThread();
-        void StopAdobeWorkerThread();
-        void AdobeWorkerLoop();
+        void StartAdobeWorker();
+        void StopAdobeWorker();
+        void ScheduleAdobeWorkLocked();         // Caller holds queue_mutex
+        void ProcessNextAdobeItem();
         void ProcessAdobeMetadata(const std::string& file_path);
         void QueueAdobeMetadata(const std::string& file_path);
 
         // Video metadata background processing
-        void StartVideoMetadataWorkerThread();
-        void StopVideoMetadataWorkerThread();
-        void VideoMetadataWorkerLoop();
+        void StartVideoMetadataWorker();
+        void StopVideoMetadataWorker();
+        void ScheduleVideoMetadataWorkLocked();  // Caller holds video_queue_mutex
+        void ProcessNextVideoMetadataItem();
         void ProcessVideoMetadata(const std::string& file_path);
 
         // Metadata filtering
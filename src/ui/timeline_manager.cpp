@@ -2,6 +2,7 @@
 #include "../player/video_player.h"
 #include "../project/project_manager.h"
 #include "../utils/debug_utils.h"
+#include <algorithm>
 #include <cmath>
 #ifdef _WIN32
 #include <Windows.h>
@@ -73,6 +74,15 @@ void TimelineManager::Update(VideoPlayer* video_player) {
         ProcessPendingSeek(video_player);
     }
 
+    // Rewind released (or turned into fast forward / trick play): back to forward caching
+    if (reverse_playback_active && (!video_player->IsFastSeeking() || video_player->IsFastForward() ||
+                                    video_player->IsTrickPlay() || is_scrubbing)) {
+        StopReversePlayback();
+    }
+    if (trick_play_active && (!video_player->IsTrickPlay() || is_scrubbing)) {
+        StopTrickPlay();
+    }
+
     // Handle fast seeking with cache integration
     if (video_player->IsFastSeeking() && !is_scrubbing) {
         // Fast seeking uses cache for smooth preview, similar to scrubbing
@@ -446,6 +456,99 @@ void TimelineManager::NotifyPlaybackState(bool is_playing) {
     }
 }
 
+bool TimelineManager::HandleReversePlayback(VideoPlayer* video_player) {
+    FrameCache* cache = project_manager->GetCurrentVideoCache();
+    if (!cache || !cache->IsInitialized()) {
+        return false;   // Fall back to MPV seeking
+    }
+
+    auto now = std::chrono::steady_clock::now();
+    if (!reverse_playback_active) {
+        // MPV stays paused: frames come from GOPs decoded behind the playhead
+        was_playing_before_reverse = video_player->IsPlaying();
+        if (was_playing_before_reverse) {
+            video_player->Pause();
+        }
+        cache->UpdateScrubPosition(ui_position, nullptr);
+        cache->SetReversePlayback(true, ui_position);
+        reverse_playback_active = true;
+        reverse_clock = now;
+    } else {
+        // Real time at the fast-seek speed; a frame that isn't decoded yet holds
+        // the current one rather than skipping ahead
+        double elapsed = std::chrono::duration<double>(now - reverse_clock).count();
+        double new_position = (std::max)(0.0, ui_position - elapsed * video_player->GetFastSeekSpeed());
+        if (cache->HasFrameAt(new_position)) {
+            ui_position = new_position;
+        }
+        reverse_clock = now;
+        cache->UpdateScrubPosition(ui_position, nullptr);
+    }
+
+    hold_cached_frame = true;
+    pending_seek_position = -1.0;
+    return true;
+}
+
+void TimelineManager::StopReversePlayback() {
+    reverse_playback_active = false;
+    if (project_manager) {
+        if (FrameCache* cache = project_manager->GetCurrentVideoCache()) {
+            cache->SetReversePlayback(false);
+        }
+    }
+
+    // The fast-seek release path seeks MPV to ui_position; resume once it lands
+    if (was_playing_before_reverse) {
+        restore_playback_after_seek = true;
+        was_playing_before_reverse = false;
+    }
+}
+
+bool TimelineManager::HandleTrickPlay(VideoPlayer* video_player) {
+    FrameCache* cache = project_manager->GetCurrentVideoCache();
+    if (!cache || !cache->IsInitialized()) {
+        return false;
+    }
+
+    if (!trick_play_active) {
+        cache->SetTrickPlay(true);
+        trick_play_active = true;
+    }
+
+    // Same seek cadence as regular fast seeking
+    double seek_amount = 0.1 * video_player->GetFastSeekSpeed();
+    if (!video_player->IsFastForward()) seek_amount = -seek_amount;
+    double new_position = (std::min)(ui_duration, (std::max)(0.0, ui_position + seek_amount));
+
+    // Keyframes unknown yet: MPV keyframe seeks (VideoPlayer::UpdateFastSeek)
+    double keyframe_timestamp = 0.0;
+    if (!cache->RequestTrickPlayKeyframe(new_position, video_player->IsFastForward(), keyframe_timestamp)) {
+        return false;
+    }
+    ui_position = new_position;
+
+    // Show the keyframe the playhead last passed once it's decoded; keep the previous one until then
+    if (cache->HasFrameAt(keyframe_timestamp)) {
+        trick_display_position = keyframe_timestamp;
+    }
+    hold_cached_frame = trick_display_position >= 0.0;
+    if (hold_cached_frame) {
+        pending_seek_position = -1.0;
+    }
+    return true;
+}
+
+void TimelineManager::StopTrickPlay() {
+    trick_play_active = false;
+    trick_display_position = -1.0;
+    if (project_manager) {
+        if (FrameCache* cache = project_manager->GetCurrentVideoCache()) {
+            cache->SetTrickPlay(false);
+        }
+    }
+}
+
 std::vector<FrameCache::CacheSegment> TimelineManager::GetCacheSegments() const {
     if (!project_manager) return std::vector<FrameCache::CacheSegment>();
 
@@ -454,6 +557,15 @@ std::vector<FrameCache::CacheSegment> TimelineManager::GetCacheSegments() const
 
 void TimelineManager::HandleFastSeeking(VideoPlayer* video_player) {
     if (!video_player || !project_manager) return;
+
+    // High speeds show keyframes only; rewind below that plays backwards from
+    // the cache (both need the background extractor)
+    if (video_player->IsTrickPlay() && HandleTrickPlay(video_player)) {
+        return;
+    }
+    if (!video_player->IsFastForward() && !video_player->IsTrickPlay() && HandleReversePlayback(video_player)) {
+        return;
+    }
     
     // Calculate seek amount based on video player's fast seek parameters
     double seek_amount = 0.1 * video_player->GetFastSeekSpeed();
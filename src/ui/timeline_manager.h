@@ -32,6 +32,7 @@ public:
     double GetUIDuration() const { return ui_duration; }
     bool IsScrubbing() const { return is_scrubbing; }
     bool IsHoldingCachedFrame() const { return hold_cached_frame; }
+    double GetDisplayPosition() const { return trick_display_position >= 0.0 ? trick_display_position : ui_position; }
     
     // Frame cache interface
     bool GetCachedFrameForScrubbing(double timestamp, GLuint& texture_id, int& width, int& height);
@@ -52,6 +53,15 @@ private:
     int stable_frame_count = 0;  // Count of consecutive stable frames at target position
     double last_stable_position = -1.0;  // Last stable position for stability tracking
     bool restore_playback_after_seek = false;  // Restore playback when seek completes
+
+    // Reverse playback (rewind served from the frame cache)
+    bool reverse_playback_active = false;
+    bool was_playing_before_reverse = false;
+    std::chrono::steady_clock::time_point reverse_clock;  // Last reverse playhead advance
+
+    // Trick play (keyframes only at high shuttle speeds)
+    bool trick_play_active = false;
+    double trick_display_position = -1.0;   // Keyframe on screen, -1 when none
     
     // MPV sync state  
     double mpv_position = 0.0;
@@ -72,4 +82,8 @@ private:
     void SyncFromMPV(VideoPlayer* video_player);
     void ProcessPendingSeek(VideoPlayer* video_player);
     void HandleFastSeeking(VideoPlayer* video_player);
+    bool HandleReversePlayback(VideoPlayer* video_player);
+    void StopReversePlayback();
+    bool HandleTrickPlay(VideoPlayer* video_player);
+    void StopTrickPlay();
 };
\ No newline at end of file
@@ -0,0 +1,227 @@
+#include "adaptive_concurrency.h"
+#include "debug_utils.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+
+namespace ump {
+
+namespace {
+    constexpr double kBaselineAging = 1.02;      // Baseline drifts up 2% per window
+    constexpr double kThroughputGain = 1.05;     // "Improved" = 5% more bytes/s
+    constexpr double kThroughputCollapse = 0.7;  // Sharp drop = congestion regardless of latency
+}
+
+AdaptiveConcurrencyController::AdaptiveConcurrencyController(std::string name)
+    : AdaptiveConcurrencyController(std::move(name), Config{}) {
+}
+
+AdaptiveConcurrencyController::AdaptiveConcurrencyController(std::string name, const Config& config)
+    : name_(std::move(name)) {
+    SetConfig(config);
+    Reset();
+}
+
+void AdaptiveConcurrencyController::SetConfig(const Config& config) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    config_ = config;
+    config_.min_limit = std::max<size_t>(1, config_.min_limit);
+    config_.max_limit = std::max(config_.min_limit, config_.max_limit);
+    config_.initial_limit = std::clamp(config_.initial_limit, config_.min_limit, config_.max_limit);
+    config_.decrease_factor = std::clamp(config_.decrease_factor, 0.1, 0.95);
+
+    if (!config_.enabled) {
+        limit_ = config_.max_limit;
+    } else {
+        limit_ = std::clamp(limit_.load() == 0 ? config_.initial_limit : limit_.load(),
+                            config_.min_limit, config_.max_limit);
+    }
+}
+
+AdaptiveConcurrencyController::Config AdaptiveConcurrencyController::GetConfig() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return config_;
+}
+
+void AdaptiveConcurrencyController::Reset() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    limit_ = config_.enabled ? config_.initial_limit : config_.max_limit;
+    baseline_latency_ms_ = 0.0;
+    last_latency_ms_ = 0.0;
+    last_throughput_ = 0.0;
+    cooldown_ = false;
+    ResetWindowLocked(Clock::now());
+}
+
+void AdaptiveConcurrencyController::ResetWindowLocked(Clock::time_point now) {
+    window_start_ = now;
+    window_samples_ = 0;
+    window_latency_sum_ = 0.0;
+    window_bytes_ = 0;
+    window_peak_in_flight_ = in_flight_.load();
+}
+
+void AdaptiveConcurrencyController::OnStart() {
+    const size_t running = in_flight_.fetch_add(1) + 1;
+    std::lock_guard<std::mutex> lock(mutex_);
+    window_peak_in_flight_ = std::max(window_peak_in_flight_, running);
+}
+
+void AdaptiveConcurrencyController::OnComplete(double latency_ms, size_t bytes, bool success) {
+    in_flight_.fetch_sub(1);
+
+    // Failed reads (missing file, decode error) say nothing about the storage
+    if (!success) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    samples_++;
+    window_samples_++;
+    window_latency_sum_ += latency_ms;
+    window_bytes_ += bytes;
+
+    if (!config_.enabled) {
+        return;
+    }
+
+    const auto now = Clock::now();
+    const double window_ms = std::chrono::duration<double, std::milli>(now - window_start_).count();
+    const size_t needed = std::max(config_.min_window_samples, limit_.load());
+    if (window_samples_ >= needed && window_ms >= config_.min_window_ms) {
+        EvaluateWindowLocked(now);
+    }
+}
+
+void AdaptiveConcurrencyController::EvaluateWindowLocked(Clock::time_point now) {
+    const double window_sec = std::chrono::duration<double>(now - window_start_).count();
+    const double latency = window_latency_sum_ / window_samples_;
+    const double throughput = window_sec > 0.0 ? window_bytes_ / window_sec : 0.0;
+    const size_t limit = limit_.load();
+    const bool used_limit = window_peak_in_flight_ >= limit;
+
+    if (baseline_latency_ms_ <= 0.0) {
+        baseline_latency_ms_ = latency;
+    } else {
+        baseline_latency_ms_ = std::min(baseline_latency_ms_ * kBaselineAging, latency);
+    }
+
+    const bool latency_inflated = latency > baseline_latency_ms_ * config_.latency_tolerance;
+    const bool throughput_gained = last_throughput_ <= 0.0 || throughput >= last_throughput_ * kThroughputGain;
+    const bool throughput_collapsed = last_throughput_ > 0.0 && throughput < last_throughput_ * kThroughputCollapse;
+
+    size_t next = limit;
+    if (cooldown_) {
+        cooldown_ = false;  // Let the previous decrease take effect before judging again
+    } else if ((latency_inflated && !throughput_gained) || (throughput_collapsed && used_limit)) {
+        next = std::max(config_.min_limit,
+                        static_cast<size_t>(std::floor(limit * config_.decrease_factor)));
+        cooldown_ = true;
+    } else if (used_limit && !latency_inflated) {
+        next = std::min(config_.max_limit, limit + 1);
+    }
+
+    if (next < limit) {
+        decreases_++;
+        Debug::Log("AdaptiveConcurrency[" + name_ + "]: " + std::to_string(limit) + " -> " +
+                   std::to_string(next) + " (latency " + std::to_string(static_cast<int>(latency)) +
+                   "ms vs baseline " + std::to_string(static_cast<int>(baseline_latency_ms_)) + "ms, " +
+                   std::to_string(static_cast<int>(throughput / (1024 * 1024))) + " MB/s)");
+    } else if (next > limit) {
+        increases_++;
+    }
+    limit_ = next;
+
+    last_latency_ms_ = latency;
+    last_throughput_ = throughput;
+    ResetWindowLocked(now);
+}
+
+AdaptiveConcurrencyController::Stats AdaptiveConcurrencyController::GetStats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    Stats stats;
+    stats.limit = limit_.load();
+    stats.in_flight = in_flight_.load();
+    stats.min_limit = config_.min_limit;
+    stats.max_limit = config_.max_limit;
+    stats.enabled = config_.enabled;
+    stats.avg_latency_ms = last_latency_ms_;
+    stats.baseline_latency_ms = baseline_latency_ms_;
+    stats.throughput_mbps = last_throughput_ / (1024.0 * 1024.0);
+    stats.increases = increases_;
+    stats.decreases = decreases_;
+    stats.samples = samples_;
+    return stats;
+}
+
+//=============================================================================
+// ThrottledStorageSimulator
+//=============================================================================
+
+ThrottledStorageSimulator& ThrottledStorageSimulator::Shared() {
+    static ThrottledStorageSimulator simulator;
+    return simulator;
+}
+
+ThrottledStorageSimulator::ThrottledStorageSimulator() {
+    const char* spec = std::getenv("UMP_SIMULATE_STORAGE");
+    if (!spec || !*spec) {
+        return;
+    }
+
+    double base_ms = 0.0;
+    double mbps = 0.0;
+    int knee = 4;
+    if (std::sscanf(spec, "%lf,%lf,%d", &base_ms, &mbps, &knee) < 2 || mbps <= 0.0) {
+        Debug::Log("ThrottledStorageSimulator: Ignoring malformed UMP_SIMULATE_STORAGE '" + std::string(spec) + "'");
+        return;
+    }
+    Configure(base_ms, mbps, knee);
+}
+
+void ThrottledStorageSimulator::Configure(double base_ms, double mbps, int knee) {
+    if (mbps <= 0.0) {
+        if (enabled_.exchange(false)) {
+            Debug::Log("ThrottledStorageSimulator: Simulation off");
+        }
+        return;
+    }
+
+    base_ms_ = std::max(0.0, base_ms);
+    mbps_ = mbps;
+    knee_ = std::max(1, knee);
+    if (enabled_.exchange(true)) {
+        return;  // Adjusted while on (panel sliders) - logged when turned on
+    }
+    Debug::Log("ThrottledStorageSimulator: Simulating " + std::to_string(static_cast<int>(base_ms_.load())) + "ms + " +
+               std::to_string(static_cast<int>(mbps)) + " MB/s shared storage (knee " + std::to_string(knee_.load()) + ")");
+}
+
+ThrottledStorageSimulator::Settings ThrottledStorageSimulator::GetSettings() const {
+    Settings settings;
+    settings.enabled = enabled_.load();
+    settings.base_ms = base_ms_.load();
+    settings.mbps = mbps_.load();
+    settings.knee = knee_.load();
+    return settings;
+}
+
+void ThrottledStorageSimulator::SimulateRead(size_t bytes) {
+    if (!enabled_) return;
+
+    // Bandwidth is shared by everyone reading; past the knee, seeks/contention
+    // make every read slower on top of that (the NAS collapse)
+    const int active = active_.fetch_add(1) + 1;
+    const double overload = std::max(0, active - knee_.load());
+    const double bytes_per_ms = mbps_.load() * 1024.0 * 1024.0 / 1000.0;
+    const double ms = base_ms_.load() * (1.0 + 0.25 * overload * overload) +
+                      bytes * static_cast<double>(active) / bytes_per_ms;
+
+    std::this_thread::sleep_for(std::chrono::microseconds(static_cast<int64_t>(ms * 1000.0)));
+    active_.fetch_sub(1);
+}
+
+} // namespace ump
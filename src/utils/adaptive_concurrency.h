@@ -0,0 +1,145 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+
+namespace ump {
+
+    //=========================================================================
+    // AdaptiveConcurrencyController - AIMD limit on parallel reads
+    //
+    // A fixed reader count is wrong for every storage: 16 concurrent readers
+    // collapse NAS throughput (latency climbs, bytes/s drops), while local
+    // NVMe has bandwidth to spare. Like TCP congestion control, the limit
+    // grows additively while throughput keeps improving and latency stays
+    // near its uncongested baseline, and shrinks multiplicatively once latency
+    // inflates without a throughput gain (or throughput falls).
+    // - Decisions are made per measurement window (>= min samples and time)
+    // - The limit only grows if the window actually used it
+    // - Baseline latency is the best window seen, aged upward slowly so a
+    //   permanently slower source re-baselines
+    //=========================================================================
+
+    class AdaptiveConcurrencyController {
+    public:
+        struct Config {
+            bool enabled = true;             // false = fixed at max_limit
+            size_t min_limit = 2;
+            size_t max_limit = 16;
+            size_t initial_limit = 4;
+            double decrease_factor = 0.7;    // Multiplicative decrease
+            double latency_tolerance = 2.0;  // Congested when latency > baseline * this
+            size_t min_window_samples = 4;   // Completions per decision (at least the limit)
+            double min_window_ms = 250.0;
+        };
+
+        struct Stats {
+            size_t limit = 0;                // Current allowed in-flight reads
+            size_t in_flight = 0;
+            size_t min_limit = 0;
+            size_t max_limit = 0;
+            bool enabled = true;
+            double avg_latency_ms = 0.0;     // Last window
+            double baseline_latency_ms = 0.0;
+            double throughput_mbps = 0.0;    // Last window, MB/s while reading
+            uint64_t increases = 0;
+            uint64_t decreases = 0;
+            uint64_t samples = 0;
+        };
+
+        // No Config() default argument: Config's member initializers are not
+        // usable until the class is complete (GCC/Clang reject it)
+        explicit AdaptiveConcurrencyController(std::string name);
+        AdaptiveConcurrencyController(std::string name, const Config& config);
+
+        // Bounds change keeps the current limit when it is still inside them
+        void SetConfig(const Config& config);
+        Config GetConfig() const;
+
+        // Forget measurements and restart from initial_limit (new source)
+        void Reset();
+
+        size_t GetLimit() const { return limit_.load(); }
+        size_t GetInFlight() const { return in_flight_.load(); }
+
+        // Around every read (any thread)
+        void OnStart();
+        void OnComplete(double latency_ms, size_t bytes, bool success);
+
+        Stats GetStats() const;
+
+    private:
+        using Clock = std::chrono::steady_clock;
+
+        void EvaluateWindowLocked(Clock::time_point now);
+        void ResetWindowLocked(Clock::time_point now);
+
+        const std::string name_;
+
+        mutable std::mutex mutex_;
+        Config config_;
+        std::atomic<size_t> limit_{0};
+        std::atomic<size_t> in_flight_{0};
+
+        // Current window (guarded by mutex_)
+        Clock::time_point window_start_;
+        size_t window_samples_ = 0;
+        double window_latency_sum_ = 0.0;
+        size_t window_bytes_ = 0;
+        size_t window_peak_in_flight_ = 0;
+
+        // History (guarded by mutex_)
+        double baseline_latency_ms_ = 0.0;
+        double last_latency_ms_ = 0.0;
+        double last_throughput_ = 0.0;       // Bytes/s of the previous window
+        bool cooldown_ = false;              // Skip one window after a decrease
+        uint64_t increases_ = 0;
+        uint64_t decreases_ = 0;
+        uint64_t samples_ = 0;
+    };
+
+    //=========================================================================
+    // ThrottledStorageSimulator - injects NAS-like latency into local reads
+    //
+    // Lets the controller be exercised without a NAS. Enabled by the
+    // UMP_SIMULATE_STORAGE environment variable: "base_ms,MBps,knee", e.g.
+    // "20,400,4" = 20ms per read, 400 MB/s shared across concurrent readers,
+    // and latency that grows quadratically once more than 4 reads overlap -
+    // or at runtime from the cache panel (Configure()).
+    //=========================================================================
+
+    class ThrottledStorageSimulator {
+    public:
+        struct Settings {
+            bool enabled = false;
+            double base_ms = 0.0;
+            double mbps = 0.0;
+            int knee = 4;
+        };
+
+        static ThrottledStorageSimulator& Shared();
+
+        bool IsEnabled() const { return enabled_.load(); }
+
+        // Replaces the environment setting; mbps <= 0 turns the simulation off
+        void Configure(double base_ms, double mbps, int knee);
+        Settings GetSettings() const;
+
+        // Sleep as if 'bytes' were read from the simulated storage
+        void SimulateRead(size_t bytes);
+
+    private:
+        ThrottledStorageSimulator();
+
+        std::atomic<bool> enabled_{false};
+        std::atomic<double> base_ms_{0.0};
+        std::atomic<double> mbps_{0.0};
+        std::atomic<int> knee_{4};
+        std::atomic<int> active_{0};
+    };
+
+} // namespace ump
@@ -0,0 +1,137 @@
+#include "content_hash.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <vector>
+
+namespace ump {
+
+    namespace {
+        constexpr uint64_t kPrime1 = 0x9E3779B97F4A7C15ull;
+        constexpr uint64_t kPrime2 = 0xC2B2AE3D27D4EB4Full;
+
+        constexpr size_t kHeadBytes = 64 * 1024;    // Covers EXR/TIFF/DPX headers
+        constexpr size_t kBlockBytes = 4096;
+        constexpr int kSampleBlocks = 8;
+        constexpr size_t kFileChunkBytes = 1024 * 1024;
+
+        inline uint64_t Rotl(uint64_t value, int bits) {
+            return (value << bits) | (value >> (64 - bits));
+        }
+
+        inline uint64_t Mix(uint64_t hash, uint64_t value) {
+            return Rotl(hash ^ (value * kPrime1), 31) * kPrime2;
+        }
+
+        inline uint64_t Finalize(uint64_t hash) {
+            hash ^= hash >> 33;
+            hash *= 0xFF51AFD7ED558CCDull;
+            hash ^= hash >> 33;
+            hash *= 0xC4CEB9FE1A85EC53ull;
+            hash ^= hash >> 33;
+            return hash ? hash : 1;     // 0 is reserved for "none"
+        }
+
+        inline uint64_t Load64(const uint8_t* p) {
+            uint64_t value;
+            std::memcpy(&value, p, sizeof(value));
+            return value;
+        }
+
+        // Regions sampled from content of 'size' bytes: head, then blocks spread
+        // evenly over the rest (the last one ending at the end)
+        template<typename Read>
+        uint64_t SampleRegions(size_t size, Read&& read) {
+            uint64_t hash = Mix(kPrime2, size);
+            const size_t head = std::min(size, kHeadBytes);
+            hash = Mix(hash, read(0, head));
+            if (size <= head) {
+                return Finalize(hash);
+            }
+            const size_t rest = size - head;
+            for (int i = 1; i <= kSampleBlocks; ++i) {
+                const size_t end = head + rest * i / kSampleBlocks;
+                const size_t begin = end - std::min(kBlockBytes, end - head);
+                hash = Mix(hash, read(begin, end - begin));
+            }
+            return Finalize(hash);
+        }
+    }
+
+    uint64_t HashBytes(const void* data, size_t size) {
+        const uint8_t* p = static_cast<const uint8_t*>(data);
+
+        // Four independent lanes keep the multiplies in flight
+        uint64_t lanes[4] = { kPrime1, kPrime2, kPrime1 ^ kPrime2, Rotl(kPrime1, 17) };
+        size_t offset = 0;
+        for (; offset + 32 <= size; offset += 32) {
+            lanes[0] = Mix(lanes[0], Load64(p + offset));
+            lanes[1] = Mix(lanes[1], Load64(p + offset + 8));
+            lanes[2] = Mix(lanes[2], Load64(p + offset + 16));
+            lanes[3] = Mix(lanes[3], Load64(p + offset + 24));
+        }
+
+        uint64_t hash = Mix(Mix(Mix(Mix(size, lanes[0]), lanes[1]), lanes[2]), lanes[3]);
+        for (; offset + 8 <= size; offset += 8) {
+            hash = Mix(hash, Load64(p + offset));
+        }
+        if (offset < size) {
+            uint64_t tail = 0;
+            std::memcpy(&tail, p + offset, size - offset);
+            hash = Mix(hash, tail);
+        }
+        return Finalize(hash);
+    }
+
+    uint64_t SampleHashBytes(const void* data, size_t size) {
+        const uint8_t* p = static_cast<const uint8_t*>(data);
+        return SampleRegions(size, [p](size_t offset, size_t bytes) {
+            return HashBytes(p + offset, bytes);
+        });
+    }
+
+    uint64_t SampleHashFile(const std::string& path) {
+        std::ifstream file(path, std::ios::binary | std::ios::ate);
+        if (!file) {
+            return 0;
+        }
+        const std::streamoff end = file.tellg();
+        if (end <= 0) {
+            return 0;
+        }
+
+        bool ok = true;
+        std::vector<char> buffer;
+        const uint64_t hash = SampleRegions(static_cast<size_t>(end), [&](size_t offset, size_t bytes) {
+            buffer.resize(bytes);
+            file.seekg(static_cast<std::streamoff>(offset));
+            ok = ok && file.read(buffer.data(), static_cast<std::streamsize>(bytes)).good();
+            return HashBytes(buffer.data(), bytes);
+        });
+        return ok ? hash : 0;
+    }
+
+    uint64_t HashFile(const std::string& path) {
+        std::ifstream file(path, std::ios::binary);
+        if (!file) {
+            return 0;
+        }
+
+        std::vector<char> buffer(kFileChunkBytes);
+        uint64_t hash = kPrime1;
+        uint64_t total = 0;
+        while (file) {
+            file.read(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+            const size_t bytes = static_cast<size_t>(file.gcount());
+            if (bytes == 0) break;
+            hash = Mix(hash, HashBytes(buffer.data(), bytes));
+            total += bytes;
+        }
+        if (file.bad() || total == 0) {
+            return 0;
+        }
+        return Finalize(Mix(hash, total));
+    }
+
+} // namespace ump
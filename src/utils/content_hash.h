@@ -0,0 +1,46 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace ump {
+
+    //=========================================================================
+    // Content fingerprints for frame deduplication
+    //
+    // Held frames, slates and gap fillers repeat the same image. Caches find
+    // them in two steps:
+    // - Sampled fingerprint: size, the leading bytes (a file's header) and a
+    //   few evenly spaced blocks - cheap enough to take for every frame, and
+    //   equal for identical content
+    // - Full hash of every byte, only to confirm a sampled match
+    // Hashes are 64-bit and non-cryptographic; 0 means "no fingerprint".
+    //=========================================================================
+
+    struct ContentFingerprint {
+        uint64_t sample = 0;
+        uint64_t full = 0;
+
+        bool IsValid() const { return sample != 0; }
+        bool operator==(const ContentFingerprint& other) const {
+            return sample == other.sample && full == other.full;
+        }
+    };
+
+    uint64_t HashBytes(const void* data, size_t size);
+
+    // Size + leading bytes + sampled blocks of a buffer
+    uint64_t SampleHashBytes(const void* data, size_t size);
+
+    // Same sampling read from a file (a few small reads); 0 if unreadable
+    uint64_t SampleHashFile(const std::string& path);
+
+    // Every byte of a file; 0 if unreadable
+    uint64_t HashFile(const std::string& path);
+
+    inline ContentFingerprint FingerprintBytes(const void* data, size_t size) {
+        return ContentFingerprint{ SampleHashBytes(data, size), HashBytes(data, size) };
+    }
+
+} // namespace ump
@@ -1,4 +1,5 @@
 #include "exr_layer_detector.h"
+#include "exr_layout_cache.h"
 
 // Fix Windows min/max macro conflicts with OpenEXR
 #ifdef _WIN32
@@ -11,9 +12,6 @@
 #endif
 
 // OpenEXR includes - using direct API as per lessons learned
-#include <ImfInputFile.h>
-#include <ImfChannelList.h>
-#include <ImfHeader.h>
 #include <ImfPixelType.h>
 
 #include <algorithm>
@@ -43,9 +41,6 @@ namespace ump {
                 return false;
             }
 
-            // Memory-mapped stream for fast I/O
-            std::unique_ptr<Imf::IStream> stream;
-
 #ifdef _WIN32
             // Windows memory-mapped file
             int wlen = MultiByteToWideChar(CP_UTF8, 0, file_path.c_str(), -1, nullptr, 0);
@@ -58,49 +53,40 @@ namespace ump {
                 last_error_ = "Cannot open file: " + file_path;
                 return false;
             }
-            CloseHandle(fileHandle); // Just checking existence, InputFile will open it
+            CloseHandle(fileHandle); // Just checking existence, the layout cache opens it
 #endif
 
-            Imf::InputFile input_file(file_path.c_str());
-            const Imf::Header& header = input_file.header();
-            const Imf::ChannelList& channel_list = header.channels();
+            // Header layout shared with the loaders - parsed once per sequence
+            const auto layout = EXRLayoutCache::Shared().Get(file_path);
 
             // Collect all channels
             std::vector<EXRChannel> channels;
 
-            for (Imf::ChannelList::ConstIterator it = channel_list.begin(); it != channel_list.end(); ++it) {
-                try {
-                    const std::string& channel_name = it.name();
-                    const Imf::Channel& channel = it.channel();
-
-                    EXRChannel exr_channel;
-                    exr_channel.name = channel_name;
-
-                    // Get pixel type
-                    switch (channel.type) {
-                        case Imf::HALF:
-                            exr_channel.pixel_type = "half";
-                            break;
-                        case Imf::FLOAT:
-                            exr_channel.pixel_type = "float";
-                            break;
-                        case Imf::UINT:
-                            exr_channel.pixel_type = "uint";
-                            break;
-                        default:
-                            exr_channel.pixel_type = "unknown";
-                            break;
-                    }
-
-                    exr_channel.x_sampling = channel.xSampling;
-                    exr_channel.y_sampling = channel.ySampling;
-                    exr_channel.linear = channel.pLinear;
-
-                    channels.push_back(exr_channel);
-                } catch (const std::exception& e) {
-                    // Silently skip problematic channels
-                    continue;
+            for (const EXRChannelLayout& channel : layout->channels) {
+                EXRChannel exr_channel;
+                exr_channel.name = channel.name;
+
+                // Get pixel type
+                switch (channel.type) {
+                    case Imf::HALF:
+                        exr_channel.pixel_type = "half";
+                        break;
+                    case Imf::FLOAT:
+                        exr_channel.pixel_type = "float";
+                        break;
+                    case Imf::UINT:
+                        exr_channel.pixel_type = "uint";
+                        break;
+                    default:
+                        exr_channel.pixel_type = "unknown";
+                        break;
                 }
+
+                exr_channel.x_sampling = channel.x_sampling;
+                exr_channel.y_sampling = channel.y_sampling;
+                exr_channel.linear = channel.linear;
+
+                channels.push_back(exr_channel);
             }
 
             if (channels.empty()) {
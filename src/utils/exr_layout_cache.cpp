@@ -0,0 +1,300 @@
+#include "exr_layout_cache.h"
+
+#include <OpenEXR/ImfChannelList.h>
+#include <OpenEXR/ImfChromaticitiesAttribute.h>
+#include <OpenEXR/ImfHeader.h>
+#include <OpenEXR/ImfMultiPartInputFile.h>
+#include <OpenEXR/ImfStringAttribute.h>
+
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <filesystem>
+
+namespace ump {
+
+    //=========================================================================
+    // EXRHeaderLayout
+    //=========================================================================
+
+    EXRHeaderLayout::EXRHeaderLayout(const Imf::MultiPartInputFile& file) {
+        const Imf::Header& header = file.header(0);
+        display_window = header.displayWindow();
+        data_window = header.dataWindow();
+        compression = header.compression();
+        parts = file.parts();
+        tiled = header.hasTileDescription();
+        if (tiled) {
+            tiles = header.tileDescription();
+        }
+
+        const Imf::ChannelList& list = header.channels();
+        for (Imf::ChannelList::ConstIterator it = list.begin(); it != list.end(); ++it) {
+            EXRChannelLayout channel;
+            channel.name = it.name();
+            channel.type = it.channel().type;
+            channel.x_sampling = it.channel().xSampling;
+            channel.y_sampling = it.channel().ySampling;
+            channel.linear = it.channel().pLinear;
+            channels.push_back(std::move(channel));
+        }
+
+        if (const auto* attr = header.findTypedAttribute<Imf::StringAttribute>("colorspace")) {
+            colorspace = attr->value();
+        }
+        if (const auto* attr = header.findTypedAttribute<Imf::ChromaticitiesAttribute>("chromaticities")) {
+            chromaticities = attr->value();
+        }
+    }
+
+    bool EXRHeaderLayout::Matches(const Imf::MultiPartInputFile& file) const {
+        const Imf::Header& header = file.header(0);
+        if (file.parts() != parts ||
+            header.displayWindow() != display_window ||
+            header.dataWindow() != data_window ||
+            header.compression() != compression ||
+            header.hasTileDescription() != tiled ||
+            (tiled && !(header.tileDescription() == *tiles))) {
+            return false;
+        }
+
+        // Both lists are sorted by name, so one walk compares them
+        const Imf::ChannelList& list = header.channels();
+        size_t index = 0;
+        for (Imf::ChannelList::ConstIterator it = list.begin(); it != list.end(); ++it, ++index) {
+            if (index >= channels.size()) {
+                return false;
+            }
+            const EXRChannelLayout& channel = channels[index];
+            if (channel.type != it.channel().type ||
+                channel.x_sampling != it.channel().xSampling ||
+                channel.y_sampling != it.channel().ySampling ||
+                std::strcmp(channel.name.c_str(), it.name()) != 0) {
+                return false;
+            }
+        }
+        return index == channels.size();
+    }
+
+    int EXRHeaderLayout::ResolutionLevels() const {
+        if (!tiles || tiles->mode == Imf::ONE_LEVEL) {
+            return 1;
+        }
+
+        // Halve until 1 pixel, rounding as the file does
+        auto levelCount = [this](int size) {
+            int levels = 1;
+            while (size > 1) {
+                size = (tiles->roundingMode == Imf::ROUND_UP) ? (size + 1) / 2 : size / 2;
+                levels++;
+            }
+            return levels;
+        };
+        const int width = data_window.max.x - data_window.min.x + 1;
+        const int height = data_window.max.y - data_window.min.y + 1;
+        if (tiles->mode == Imf::MIPMAP_LEVELS) {
+            return levelCount(std::max(width, height));
+        }
+        return std::min(levelCount(width), levelCount(height));
+    }
+
+    const EXRChannelLayout* EXRHeaderLayout::Find(const std::string& name) const {
+        auto it = std::lower_bound(channels.begin(), channels.end(), name,
+            [](const EXRChannelLayout& channel, const std::string& value) {
+                return std::strcmp(channel.name.c_str(), value.c_str()) < 0;
+            });
+        return (it != channels.end() && it->name == name) ? &*it : nullptr;
+    }
+
+    const EXRLayerMapping& EXRHeaderLayout::Resolve(const std::string& layer) const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto existing = mappings_.find(layer);
+        if (existing != mappings_.end()) {
+            return existing->second;
+        }
+
+        static const char* const kComponents[4] = { "R", "G", "B", "A" };
+
+        // Layer prefix first, then root-level channels (single-layer files)
+        EXRLayerMapping mapping;
+        const EXRChannelLayout* found[4] = {};
+        const std::string prefix = layer.empty() ? "" : layer + ".";
+        for (int c = 0; c < 4; ++c) {
+            mapping.names[c] = prefix + kComponents[c];
+            found[c] = Find(mapping.names[c]);
+        }
+        // Single/dual channel AOVs: the channel named 'layer' ("depth.Z") or
+        // the layer's channels ("mask.A", "motion.U/V"), stored as R or RG
+        if (!(found[0] && found[1] && found[2]) && !layer.empty()) {
+            std::vector<const EXRChannelLayout*> own;
+            for (const EXRChannelLayout& channel : channels) {
+                if (channel.name == layer || channel.name.compare(0, prefix.size(), prefix) == 0) {
+                    own.push_back(&channel);
+                }
+            }
+            if (!own.empty() && own.size() <= 2) {
+                EXRLayerMapping aov;
+                aov.valid = true;
+                aov.components = static_cast<int>(own.size());
+                aov.type = own[0]->type;
+                aov.uniform_type = true;
+                aov.full_sampling = true;
+                for (size_t c = 0; c < own.size(); ++c) {
+                    aov.names[c] = own[c]->name;
+                    aov.uniform_type = aov.uniform_type && own[c]->type == aov.type;
+                    aov.full_sampling = aov.full_sampling && own[c]->x_sampling == 1 && own[c]->y_sampling == 1;
+                }
+                return mappings_.emplace(layer, std::move(aov)).first->second;
+            }
+        }
+
+        if (!found[0] && !layer.empty()) {
+            for (int c = 0; c < 4; ++c) {
+                mapping.names[c] = kComponents[c];
+                found[c] = Find(mapping.names[c]);
+            }
+        }
+
+        mapping.valid = found[0] && found[1] && found[2];
+        mapping.has_alpha = found[3] != nullptr;
+        if (mapping.valid) {
+            mapping.components = mapping.has_alpha ? 4 : 3;
+            mapping.type = found[0]->type;
+            mapping.uniform_type = true;
+            mapping.full_sampling = true;
+            for (const EXRChannelLayout* channel : found) {
+                if (!channel) continue;
+                mapping.uniform_type = mapping.uniform_type && channel->type == mapping.type;
+                mapping.full_sampling = mapping.full_sampling && channel->x_sampling == 1 && channel->y_sampling == 1;
+            }
+        }
+
+        return mappings_.emplace(layer, std::move(mapping)).first->second;
+    }
+
+    //=========================================================================
+    // EXRLayoutCache
+    //=========================================================================
+
+    EXRLayoutCache& EXRLayoutCache::Shared() {
+        static EXRLayoutCache cache;
+        return cache;
+    }
+
+    std::string EXRLayoutCache::SequenceKey(const std::string& path) {
+        // Last digit run of the file name (directories keep their digits)
+        const size_t slash = path.find_last_of("/\\");
+        const size_t nameStart = slash == std::string::npos ? 0 : slash + 1;
+        size_t end = path.size();
+        while (end > nameStart && !std::isdigit(static_cast<unsigned char>(path[end - 1]))) {
+            end--;
+        }
+        size_t begin = end;
+        while (begin > nameStart && std::isdigit(static_cast<unsigned char>(path[begin - 1]))) {
+            begin--;
+        }
+        if (begin == end) {
+            return path;
+        }
+        return path.substr(0, begin) + "#" + path.substr(end);
+    }
+
+    std::shared_ptr<const EXRHeaderLayout> EXRLayoutCache::Get(const std::string& path,
+                                                               const Imf::MultiPartInputFile& file) {
+        const std::string key = SequenceKey(path);
+        std::shared_ptr<const EXRHeaderLayout> cached;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            auto it = layouts_.find(key);
+            if (it != layouts_.end()) {
+                cached = it->second;
+            }
+        }
+
+        if (cached && cached->Matches(file)) {
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                hits_++;
+            }
+            StoreChecked(path, cached);
+            return cached;
+        }
+
+        auto layout = std::make_shared<const EXRHeaderLayout>(file);
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            (cached ? mismatches_ : builds_)++;
+        }
+        Store(key, layout);
+        StoreChecked(path, layout);
+        return layout;
+    }
+
+    std::shared_ptr<const EXRHeaderLayout> EXRLayoutCache::Get(const std::string& path) {
+        // Frames of a sequence can differ (data window, channels): only a file
+        // already checked, and unchanged since, skips its header
+        uint64_t size = 0;
+        int64_t mtime = 0;
+        if (StatFile(path, size, mtime)) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            auto it = checked_.find(path);
+            if (it != checked_.end() && it->second.size == size && it->second.mtime == mtime) {
+                hits_++;
+                return it->second.layout;
+            }
+        }
+
+        Imf::MultiPartInputFile file(path.c_str());
+        return Get(path, file);
+    }
+
+    bool EXRLayoutCache::StatFile(const std::string& path, uint64_t& size, int64_t& mtime) {
+        std::error_code ec;
+        size = std::filesystem::file_size(path, ec);
+        if (ec) {
+            return false;
+        }
+        mtime = std::filesystem::last_write_time(path, ec).time_since_epoch().count();
+        return !ec;
+    }
+
+    void EXRLayoutCache::StoreChecked(const std::string& path, std::shared_ptr<const EXRHeaderLayout> layout) {
+        CheckedFile entry;
+        if (!StatFile(path, entry.size, entry.mtime)) {
+            return;
+        }
+        entry.layout = std::move(layout);
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (checked_.size() >= kMaxCheckedFiles && checked_.find(path) == checked_.end()) {
+            checked_.clear();
+        }
+        checked_[path] = std::move(entry);
+    }
+
+    void EXRLayoutCache::Store(const std::string& key, std::shared_ptr<const EXRHeaderLayout> layout) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        // Browsing many sequences: start over rather than track recency
+        if (layouts_.size() >= kMaxSequences && layouts_.find(key) == layouts_.end()) {
+            layouts_.clear();
+        }
+        layouts_[key] = std::move(layout);
+    }
+
+    void EXRLayoutCache::Clear() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        layouts_.clear();
+        checked_.clear();
+    }
+
+    EXRLayoutCache::Stats EXRLayoutCache::GetStats() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        Stats stats;
+        stats.sequences = layouts_.size();
+        stats.hits = hits_;
+        stats.builds = builds_;
+        stats.mismatches = mismatches_;
+        return stats;
+    }
+
+} // namespace ump
@@ -0,0 +1,145 @@
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <OpenEXR/ImfChromaticities.h>
+#include <OpenEXR/ImfCompression.h>
+#include <OpenEXR/ImfForward.h>
+#include <OpenEXR/ImfPixelType.h>
+#include <OpenEXR/ImfTileDescription.h>
+#include <Imath/ImathBox.h>
+
+namespace ump {
+
+    //=========================================================================
+    // EXRLayoutCache - header layout shared by the frames of a sequence
+    //
+    // Frames of a render sequence almost always share one header layout, but
+    // every load used to walk the channel list, resolve the layer's RGBA
+    // channels by name and validate types/sampling again. The first frame's
+    // layout is kept per sequence (file name with its frame number masked):
+    // - Loaders check each later frame against it (windows, compression, part
+    //   count, channel names/types - no allocation) and reuse the resolved
+    //   channel mapping and destination geometry; a mismatch rebuilds it
+    // - Layer detection, metadata and frame size queries read the cached
+    //   layout of frames already checked (same size and mtime) instead of
+    //   parsing a header of their own; other frames are checked first
+    //=========================================================================
+
+    struct EXRChannelLayout {
+        std::string name;
+        Imf::PixelType type = Imf::HALF;
+        int x_sampling = 1;
+        int y_sampling = 1;
+        bool linear = false;
+    };
+
+    // Channels a layer resolves to: layer prefix R/G/B(/A) first, then the
+    // layer's own one or two channels (depth, mask AOVs), then root R/G/B/A
+    struct EXRLayerMapping {
+        bool valid = false;             // R, G and B present, or a 1-2 channel AOV
+        bool has_alpha = false;
+        bool uniform_type = false;      // Channels share one pixel type
+        bool full_sampling = false;     // No subsampled channels
+        int components = 0;             // Channels stored: 4 RGBA, 3 RGB, 2/1 AOV
+        Imf::PixelType type = Imf::HALF;
+        std::string names[4];           // Channel names in the file (R, G, B, A order; AOVs first 1-2)
+
+        bool IsRGB() const { return components >= 3; }
+    };
+
+    class EXRHeaderLayout {
+    public:
+        explicit EXRHeaderLayout(const Imf::MultiPartInputFile& file);
+
+        Imath::Box2i display_window;
+        Imath::Box2i data_window;
+        Imf::Compression compression = Imf::NO_COMPRESSION;
+        int parts = 1;
+        bool tiled = false;
+        std::optional<Imf::TileDescription> tiles;      // Tiled files: tile size, level mode/rounding
+        std::vector<EXRChannelLayout> channels;         // Channel list order (sorted by name)
+        std::string colorspace;                         // "colorspace" attribute, if present
+        std::optional<Imf::Chromaticities> chromaticities;
+
+        int Width() const { return display_window.max.x - display_window.min.x + 1; }
+        int Height() const { return display_window.max.y - display_window.min.y + 1; }
+        bool FastPath() const { return display_window == data_window; }
+
+        // Whole-image resolution levels stored in the file: MIPMAP levels, or
+        // RIPMAP's square (l, l) levels. 1 for scanline and ONE_LEVEL files.
+        int ResolutionLevels() const;
+
+        // Same layout as the header of 'file' (per-frame check)
+        bool Matches(const Imf::MultiPartInputFile& file) const;
+
+        // Resolved once per layer name, then shared by every frame
+        const EXRLayerMapping& Resolve(const std::string& layer) const;
+
+    private:
+        const EXRChannelLayout* Find(const std::string& name) const;
+
+        mutable std::mutex mutex_;
+        mutable std::map<std::string, EXRLayerMapping> mappings_;  // Never erased - references stay valid
+    };
+
+    class EXRLayoutCache {
+    public:
+        struct Stats {
+            size_t sequences = 0;
+            uint64_t hits = 0;          // Frame matched its sequence's layout
+            uint64_t builds = 0;        // Layout parsed (first frame or no cached layout)
+            uint64_t mismatches = 0;    // Frame differed from the cached layout - rebuilt
+        };
+
+        static EXRLayoutCache& Shared();
+
+        // Frame number masked: /shots/a.0101.exr -> /shots/a.#.exr
+        static std::string SequenceKey(const std::string& path);
+
+        // Layout of an open frame: the sequence's cached layout if this header
+        // still matches it, else built from this header (and cached)
+        std::shared_ptr<const EXRHeaderLayout> Get(const std::string& path, const Imf::MultiPartInputFile& file);
+
+        // Layout for a path with no open file (layers, metadata, frame size).
+        // Parses the header only when this file (size, mtime) hasn't been checked
+        // against its sequence's layout yet. Throws like OpenEXR.
+        std::shared_ptr<const EXRHeaderLayout> Get(const std::string& path);
+
+        void Clear();
+        Stats GetStats() const;
+
+    private:
+        EXRLayoutCache() = default;
+
+        // Size and mtime of a file whose header matched 'layout'
+        struct CheckedFile {
+            uint64_t size = 0;
+            int64_t mtime = 0;
+            std::shared_ptr<const EXRHeaderLayout> layout;
+        };
+
+        static bool StatFile(const std::string& path, uint64_t& size, int64_t& mtime);
+
+        void Store(const std::string& key, std::shared_ptr<const EXRHeaderLayout> layout);
+        void StoreChecked(const std::string& path, std::shared_ptr<const EXRHeaderLayout> layout);
+
+        static constexpr size_t kMaxSequences = 256;
+        static constexpr size_t kMaxCheckedFiles = 16384;
+
+        mutable std::mutex mutex_;
+        std::unordered_map<std::string, std::shared_ptr<const EXRHeaderLayout>> layouts_;
+        std::unordered_map<std::string, CheckedFile> checked_;   // By full path
+        uint64_t hits_ = 0;
+        uint64_t builds_ = 0;
+        uint64_t mismatches_ = 0;
+    };
+
+} // namespace ump
@@ -0,0 +1,380 @@
+#include "task_scheduler.h"
+#include "debug_utils.h"
+
+#include <algorithm>
+#include <exception>
+
+namespace ump {
+
+namespace {
+    // Identifies the scheduler/worker that owns the current thread
+    thread_local const TaskScheduler* tls_scheduler = nullptr;
+    thread_local size_t tls_worker_index = 0;
+    thread_local size_t tls_helper_budget = 0;
+
+    constexpr double kStatsSmoothing = 0.1;  // EMA weight for new samples
+}
+
+const char* TaskPriorityName(TaskPriority priority) {
+    switch (priority) {
+        case TaskPriority::PlaybackCritical: return "playback";
+        case TaskPriority::Prefetch:         return "prefetch";
+        case TaskPriority::Thumbnail:        return "thumbnail";
+        case TaskPriority::Transcode:        return "transcode";
+        case TaskPriority::Metadata:         return "metadata";
+        default:                             return "unknown";
+    }
+}
+
+TaskScheduler& TaskScheduler::Shared() {
+    static TaskScheduler scheduler;
+    return scheduler;
+}
+
+TaskScheduler::TaskScheduler(size_t worker_count) {
+    if (worker_count == 0) {
+        worker_count = std::max<size_t>(4, std::thread::hardware_concurrency());
+    }
+
+    // Default caps: playback may use every core; background classes are
+    // limited so they can never starve playback I/O. Prefetch leaves one
+    // worker free, so a playback-critical load never queues behind a full
+    // pool of read-ahead
+    classes_[static_cast<size_t>(TaskPriority::PlaybackCritical)].cap = worker_count;
+    classes_[static_cast<size_t>(TaskPriority::Prefetch)].cap = std::max<size_t>(1, worker_count - 1);
+    classes_[static_cast<size_t>(TaskPriority::Thumbnail)].cap = std::max<size_t>(1, worker_count / 4);
+    classes_[static_cast<size_t>(TaskPriority::Transcode)].cap = std::max<size_t>(1, worker_count / 2);
+    classes_[static_cast<size_t>(TaskPriority::Metadata)].cap = 2;
+
+    running_ = true;
+    workers_.reserve(worker_count);
+    for (size_t i = 0; i < worker_count; ++i) {
+        workers_.push_back(std::make_unique<Worker>());
+    }
+    for (size_t i = 0; i < worker_count; ++i) {
+        workers_[i]->thread = std::thread(&TaskScheduler::WorkerLoop, this, i);
+    }
+
+    Debug::Log("TaskScheduler: Started " + std::to_string(worker_count) + " workers");
+}
+
+TaskScheduler::~TaskScheduler() {
+    running_ = false;
+    Wake(true);
+    for (auto& worker : workers_) {
+        if (worker->thread.joinable()) {
+            worker->thread.join();
+        }
+    }
+    Debug::Log("TaskScheduler: Stopped");
+}
+
+void TaskScheduler::Post(TaskPriority priority, std::function<void()> task) {
+    const size_t cls = static_cast<size_t>(priority);
+    if (cls >= kClassCount || !task) return;
+
+    ClassState& state = classes_[cls];
+    Task entry{std::move(task), Clock::now()};
+
+    // Count before publishing so a fast taker never drives 'queued' below zero
+    state.queued.fetch_add(1);
+    if (tls_scheduler == this) {
+        Worker& worker = *workers_[tls_worker_index];
+        std::lock_guard<std::mutex> lock(worker.mutex);
+        worker.local[cls].push_back(std::move(entry));
+    } else {
+        std::lock_guard<std::mutex> lock(state.queue_mutex);
+        state.queue.push_back(std::move(entry));
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(state.stats_mutex);
+        state.submitted++;
+    }
+    Wake();
+}
+
+void TaskScheduler::SetConcurrencyCap(TaskPriority priority, size_t cap) {
+    const size_t cls = static_cast<size_t>(priority);
+    if (cls >= kClassCount) return;
+    // Only playback may take every worker
+    const size_t workers = workers_.size();
+    const size_t max_cap = priority == TaskPriority::PlaybackCritical ? workers : workers - 1;
+    classes_[cls].cap = std::clamp<size_t>(cap, 1, std::max<size_t>(1, max_cap));
+    Wake(true);
+}
+
+size_t TaskScheduler::GetConcurrencyCap(TaskPriority priority) const {
+    const size_t cls = static_cast<size_t>(priority);
+    return cls < kClassCount ? classes_[cls].cap.load() : 0;
+}
+
+bool TaskScheduler::IsWorkerThread() const {
+    return tls_scheduler == this;
+}
+
+size_t TaskScheduler::GetIdleWorkerCount() const {
+    size_t running = 0;
+    for (const auto& state : classes_) {
+        running += state.running.load();
+    }
+    return running < workers_.size() ? workers_.size() - running : 0;
+}
+
+void TaskScheduler::ParallelFor(TaskPriority priority, int count, size_t max_helpers,
+                                const std::function<void(int index, size_t slot)>& fn) {
+    if (count <= 0) return;
+
+    struct Shared {
+        const std::function<void(int, size_t)>* fn = nullptr;
+        int count = 0;
+        std::atomic<int> next{0};
+        std::atomic<bool> failed{false};
+        std::mutex mutex;
+        std::condition_variable cv;
+        int done = 0;                   // Guarded by mutex
+        std::exception_ptr error;       // Guarded by mutex
+    };
+
+    auto shared = std::make_shared<Shared>();
+    shared->fn = &fn;
+    shared->count = count;
+
+    // Claims indices until none are left. Helpers that start after the last
+    // index was claimed return without touching fn (the caller may be gone).
+    auto drain = [](Shared& s, size_t slot) {
+        int completed = 0;
+        std::exception_ptr error;
+        for (int index = s.next.fetch_add(1); index < s.count; index = s.next.fetch_add(1)) {
+            if (!s.failed.load()) {
+                try {
+                    (*s.fn)(index, slot);
+                } catch (...) {
+                    if (!error) error = std::current_exception();
+                    s.failed = true;
+                }
+            }
+            completed++;
+        }
+        if (completed == 0) return;
+        std::lock_guard<std::mutex> lock(s.mutex);
+        if (error && !s.error) s.error = error;
+        s.done += completed;
+        if (s.done == s.count) s.cv.notify_all();
+    };
+
+    const size_t helpers = std::min({max_helpers, static_cast<size_t>(count - 1), GetIdleWorkerCount()});
+    for (size_t slot = 1; slot <= helpers; ++slot) {
+        Post(priority, [shared, drain, slot]() { drain(*shared, slot); });
+    }
+
+    drain(*shared, 0);
+
+    std::unique_lock<std::mutex> lock(shared->mutex);
+    shared->cv.wait(lock, [&] { return shared->done == shared->count; });
+    if (shared->error) {
+        std::rethrow_exception(shared->error);
+    }
+}
+
+size_t TaskScheduler::GetThreadHelperBudget() {
+    return tls_helper_budget;
+}
+
+TaskScheduler::ScopedHelperBudget::ScopedHelperBudget(size_t helpers)
+    : previous_(tls_helper_budget) {
+    tls_helper_budget = helpers;
+}
+
+TaskScheduler::ScopedHelperBudget::~ScopedHelperBudget() {
+    tls_helper_budget = previous_;
+}
+
+std::vector<TaskClassStats> TaskScheduler::GetStats() const {
+    std::vector<TaskClassStats> result;
+    result.reserve(kClassCount);
+    for (size_t cls = 0; cls < kClassCount; ++cls) {
+        const ClassState& state = classes_[cls];
+        TaskClassStats stats;
+        stats.name = TaskPriorityName(static_cast<TaskPriority>(cls));
+        stats.queued = state.queued.load();
+        stats.running = state.running.load();
+        stats.cap = state.cap.load();
+        {
+            std::lock_guard<std::mutex> lock(state.stats_mutex);
+            stats.submitted = state.submitted;
+            stats.completed = state.completed;
+            stats.avg_queue_ms = state.avg_queue_ms;
+            stats.max_queue_ms = state.max_queue_ms;
+            stats.avg_run_ms = state.avg_run_ms;
+        }
+        result.push_back(stats);
+    }
+    return result;
+}
+
+void TaskScheduler::ResetStats() {
+    for (auto& state : classes_) {
+        std::lock_guard<std::mutex> lock(state.stats_mutex);
+        state.submitted = 0;
+        state.completed = 0;
+        state.avg_queue_ms = 0.0;
+        state.max_queue_ms = 0.0;
+        state.avg_run_ms = 0.0;
+    }
+}
+
+//=============================================================================
+// Worker side
+//=============================================================================
+
+void TaskScheduler::WorkerLoop(size_t index) {
+    tls_scheduler = this;
+    tls_worker_index = index;
+
+    while (running_) {
+        uint64_t epoch;
+        {
+            std::lock_guard<std::mutex> lock(sleep_mutex_);
+            epoch = wake_epoch_;
+        }
+
+        Task task;
+        size_t cls = 0;
+        if (TryAcquire(index, task, cls)) {
+            RunTask(cls, task);
+            continue;
+        }
+
+        // Nothing runnable: sleep until something is posted or a slot frees up.
+        // The timeout covers work that becomes runnable without a wake (cap raised).
+        std::unique_lock<std::mutex> lock(sleep_mutex_);
+        sleep_cv_.wait_for(lock, std::chrono::milliseconds(50), [&] {
+            return !running_ || wake_epoch_ != epoch;
+        });
+    }
+
+    tls_scheduler = nullptr;
+}
+
+bool TaskScheduler::TryReserve(ClassState& state) {
+    size_t current = state.running.load();
+    while (current < state.cap.load()) {
+        if (state.running.compare_exchange_weak(current, current + 1)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool TaskScheduler::TryAcquire(size_t index, Task& task, size_t& cls) {
+    // Highest priority class first
+    for (size_t c = 0; c < kClassCount; ++c) {
+        ClassState& state = classes_[c];
+        if (state.queued.load() == 0) continue;
+        if (!TryReserve(state)) continue;
+
+        if (TakeFromClass(index, c, task)) {
+            state.queued.fetch_sub(1);
+            cls = c;
+            return true;
+        }
+
+        // Raced with another worker - give the slot back
+        state.running.fetch_sub(1);
+    }
+    return false;
+}
+
+bool TaskScheduler::TakeFromClass(size_t index, size_t cls, Task& task) {
+    // 1. Own local deque (newest first - hot in cache)
+    {
+        Worker& self = *workers_[index];
+        std::lock_guard<std::mutex> lock(self.mutex);
+        auto& queue = self.local[cls];
+        if (!queue.empty()) {
+            task = std::move(queue.back());
+            queue.pop_back();
+            return true;
+        }
+    }
+
+    // 2. Shared injection queue (oldest first)
+    {
+        ClassState& state = classes_[cls];
+        std::lock_guard<std::mutex> lock(state.queue_mutex);
+        if (!state.queue.empty()) {
+            task = std::move(state.queue.front());
+            state.queue.pop_front();
+            return true;
+        }
+    }
+
+    // 3. Steal from other workers (oldest first)
+    const size_t count = workers_.size();
+    for (size_t offset = 1; offset < count; ++offset) {
+        Worker& victim = *workers_[(index + offset) % count];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        auto& queue = victim.local[cls];
+        if (!queue.empty()) {
+            task = std::move(queue.front());
+            queue.pop_front();
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void TaskScheduler::RunTask(size_t cls, Task& task) {
+    ClassState& state = classes_[cls];
+
+    auto start = Clock::now();
+    double queue_ms = std::chrono::duration<double, std::milli>(start - task.enqueued).count();
+
+    try {
+        task.fn();
+    } catch (const std::exception& e) {
+        Debug::Log("TaskScheduler: Uncaught exception in " +
+                   std::string(TaskPriorityName(static_cast<TaskPriority>(cls))) + " task - " + e.what());
+    } catch (...) {
+        Debug::Log("TaskScheduler: Uncaught unknown exception in " +
+                   std::string(TaskPriorityName(static_cast<TaskPriority>(cls))) + " task");
+    }
+    task.fn = nullptr;  // Release captures before signalling completion
+
+    double run_ms = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+
+    state.running.fetch_sub(1);
+    {
+        std::lock_guard<std::mutex> lock(state.stats_mutex);
+        state.completed++;
+        if (state.completed == 1) {
+            state.avg_queue_ms = queue_ms;
+            state.avg_run_ms = run_ms;
+        } else {
+            state.avg_queue_ms += (queue_ms - state.avg_queue_ms) * kStatsSmoothing;
+            state.avg_run_ms += (run_ms - state.avg_run_ms) * kStatsSmoothing;
+        }
+        state.max_queue_ms = std::max(state.max_queue_ms, queue_ms);
+    }
+
+    // A slot freed up - capped work may be runnable now
+    for (const auto& other : classes_) {
+        if (other.queued.load() > 0) {
+            Wake();
+            break;
+        }
+    }
+}
+
+void TaskScheduler::Wake(bool all) {
+    {
+        std::lock_guard<std::mutex> lock(sleep_mutex_);
+        wake_epoch_++;
+    }
+    if (all) sleep_cv_.notify_all();
+    else sleep_cv_.notify_one();
+}
+
+} // namespace ump
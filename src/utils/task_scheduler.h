@@ -0,0 +1,168 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace ump {
+
+    //=========================================================================
+    // TaskScheduler - one shared work-stealing pool for all background work
+    //
+    // Replaces per-subsystem threads (EXR I/O std::async, thumbnail worker,
+    // transcoder std::async, extractor workers, project metadata threads).
+    // - Priority classes are scanned in order, so playback I/O always runs
+    //   before prefetch/thumbnail/transcode/metadata work
+    // - Each class has a concurrency cap so background classes can never take
+    //   every core away from playback
+    // - Tasks posted from a worker go to that worker's local deque (LIFO for
+    //   the owner, FIFO for thieves); tasks from other threads go to a shared
+    //   per-class injection queue
+    //=========================================================================
+
+    enum class TaskPriority : int {
+        PlaybackCritical = 0,  // Frames the playhead needs next
+        Prefetch,              // Cache read-ahead / read-behind
+        Thumbnail,             // Project panel / timeline thumbnails
+        Transcode,             // EXR transcoding
+        Metadata,              // Project metadata (Adobe, video probes)
+        Count
+    };
+
+    const char* TaskPriorityName(TaskPriority priority);
+
+    struct TaskClassStats {
+        std::string name;
+        size_t queued = 0;              // Waiting to start
+        size_t running = 0;             // Currently executing
+        size_t cap = 0;                 // Max concurrently executing
+        uint64_t submitted = 0;
+        uint64_t completed = 0;
+        double avg_queue_ms = 0.0;      // Exponential moving average of wait time
+        double max_queue_ms = 0.0;      // Worst wait since last ResetStats()
+        double avg_run_ms = 0.0;        // Exponential moving average of run time
+    };
+
+    class TaskScheduler {
+    public:
+        static constexpr size_t kClassCount = static_cast<size_t>(TaskPriority::Count);
+
+        // Process-wide scheduler shared by all subsystems
+        static TaskScheduler& Shared();
+
+        explicit TaskScheduler(size_t worker_count = 0);  // 0 = hardware concurrency
+        ~TaskScheduler();
+
+        TaskScheduler(const TaskScheduler&) = delete;
+        TaskScheduler& operator=(const TaskScheduler&) = delete;
+
+        // Fire-and-forget task
+        void Post(TaskPriority priority, std::function<void()> task);
+
+        // Task with result (future never blocks in its destructor, unlike std::async)
+        template<typename F>
+        auto Submit(TaskPriority priority, F&& fn) -> std::future<std::invoke_result_t<std::decay_t<F>>> {
+            using R = std::invoke_result_t<std::decay_t<F>>;
+            auto task = std::make_shared<std::packaged_task<R()>>(std::forward<F>(fn));
+            auto future = task->get_future();
+            Post(priority, [task]() { (*task)(); });
+            return future;
+        }
+
+        // Concurrency caps (clamped to [1, worker count]; background classes
+        // to [1, worker count - 1] so one worker is always left for playback)
+        void SetConcurrencyCap(TaskPriority priority, size_t cap);
+        size_t GetConcurrencyCap(TaskPriority priority) const;
+        size_t GetWorkerCount() const { return workers_.size(); }
+
+        // True when called from one of this scheduler's worker threads
+        bool IsWorkerThread() const;
+
+        // Workers not running a task right now (approximate)
+        size_t GetIdleWorkerCount() const;
+
+        // Run fn(index, slot) for index in [0, count). The caller takes part as
+        // slot 0 and up to max_helpers idle workers join as slots 1..N, so the
+        // call never waits on a task that hasn't started and is safe from a
+        // worker. Slots are stable per participant (per-slot scratch state).
+        // The first exception is rethrown in the caller once all indices finish.
+        void ParallelFor(TaskPriority priority, int count, size_t max_helpers,
+                         const std::function<void(int index, size_t slot)>& fn);
+
+        // Helpers the current thread may request for ParallelFor (0 = serial).
+        // Owners of a task set it with ScopedHelperBudget; nested use is serial.
+        static size_t GetThreadHelperBudget();
+
+        class ScopedHelperBudget {
+        public:
+            explicit ScopedHelperBudget(size_t helpers);
+            ~ScopedHelperBudget();
+            ScopedHelperBudget(const ScopedHelperBudget&) = delete;
+            ScopedHelperBudget& operator=(const ScopedHelperBudget&) = delete;
+        private:
+            size_t previous_;
+        };
+
+        // Per-class queue depth and latency
+        std::vector<TaskClassStats> GetStats() const;
+        void ResetStats();
+
+    private:
+        using Clock = std::chrono::steady_clock;
+
+        struct Task {
+            std::function<void()> fn;
+            Clock::time_point enqueued;
+        };
+
+        struct Worker {
+            std::mutex mutex;
+            std::array<std::deque<Task>, kClassCount> local;
+            std::thread thread;
+        };
+
+        struct ClassState {
+            std::atomic<size_t> cap{1};
+            std::atomic<size_t> running{0};
+            std::atomic<size_t> queued{0};
+
+            // Injection queue for tasks posted from non-worker threads
+            std::mutex queue_mutex;
+            std::deque<Task> queue;
+
+            // Stats (guarded by stats_mutex)
+            mutable std::mutex stats_mutex;
+            uint64_t submitted = 0;
+            uint64_t completed = 0;
+            double avg_queue_ms = 0.0;
+            double max_queue_ms = 0.0;
+            double avg_run_ms = 0.0;
+        };
+
+        void WorkerLoop(size_t index);
+        bool TryAcquire(size_t index, Task& task, size_t& cls);
+        bool TryReserve(ClassState& state);
+        bool TakeFromClass(size_t index, size_t cls, Task& task);
+        void RunTask(size_t cls, Task& task);
+        void Wake(bool all = false);
+
+        std::vector<std::unique_ptr<Worker>> workers_;
+        std::array<ClassState, kClassCount> classes_;
+
+        std::atomic<bool> running_{false};
+        std::mutex sleep_mutex_;
+        std::condition_variable sleep_cv_;
+        uint64_t wake_epoch_ = 0;  // Bumped on post/completion (guarded by sleep_mutex_)
+    };
+
+} // namespace ump